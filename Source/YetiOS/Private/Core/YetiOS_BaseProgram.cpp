@@ -40,6 +40,9 @@ UYetiOS_BaseProgram::UYetiOS_BaseProgram()
 	bCanCallOnClose = true;
 	bCanCallOnInstall = true;
 
+	bCanBePooled = false;
+	PoolWarmCount = 0;
+
 	bOverrideWindowSize = false;
 	OverrideWindowSize = FVector2D(640.f, 480.f);
 
@@ -129,16 +132,45 @@ UYetiOS_BaseProgram* UYetiOS_BaseProgram::Internal_StartProgram(FYetiOsError& Ou
 	}
 
 	check(OwningOS);
-	UYetiOS_BaseProgram* ProxyProgram = DuplicateObject(this, OwningOS, *FString::Printf(TEXT("%s_%s"), *GetName(), *FGuid::NewGuid().ToString(EGuidFormats::UniqueObjectGuid)));
+	FYetiOsPooledProgram Local_Pooled;
+	UYetiOS_BaseProgram* ProxyProgram = nullptr;
+	if (OwningOS->AcquirePooledProgram(GetClass(), Local_Pooled))
+	{
+		ProxyProgram = Local_Pooled.Program;
+		ProxyProgram->Internal_ResetForReuse(this);
+	}
+	else
+	{
+		ProxyProgram = Internal_DuplicateProgram();
+	}
+
 	if (ProxyProgram)
 	{
 		const int32 MyProcessID = ProxyProgram->OwningOS->AddRunningProgram(ProxyProgram, OutErrorMessage);
 		if (MyProcessID != INDEX_NONE)
 		{
 			ProxyProgram->bIsSystemInstalledProgram = bIsSystemInstalledProgram;
-			ProxyProgram->ProgramWidget = UYetiOS_AppWidget::Internal_CreateAppWidget(ProxyProgram);
+			if (Local_Pooled.ProgramWidget)
+			{
+				ProxyProgram->ProgramWidget = Local_Pooled.ProgramWidget;
+				ProxyProgram->ProgramWidget->Internal_ReuseAppWidget(ProxyProgram);
+			}
+			else
+			{
+				ProxyProgram->ProgramWidget = UYetiOS_AppWidget::Internal_CreateAppWidget(ProxyProgram);
+			}
+
 			ProxyProgram->ProcessID = MyProcessID;
-			ProxyProgram->OwningWindow = ProxyProgram->OwningOS->GetOsWidget()->CreateNewWindow(ProxyProgram, ProxyProgram->ProgramWidget, ProxyProgram->bOverrideWindowSize ? ProxyProgram->OverrideWindowSize : FVector2D::ZeroVector);
+			const FVector2D Local_WindowSize = ProxyProgram->bOverrideWindowSize ? ProxyProgram->OverrideWindowSize : FVector2D::ZeroVector;
+			if (Local_Pooled.Window)
+			{
+				ProxyProgram->OwningWindow = Local_Pooled.Window;
+				ProxyProgram->OwningWindow->Internal_RestoreWindow(ProxyProgram, ProxyProgram->ProgramWidget, Local_WindowSize);
+			}
+			else
+			{
+				ProxyProgram->OwningWindow = ProxyProgram->OwningOS->GetOsWidget()->CreateNewWindow(ProxyProgram, ProxyProgram->ProgramWidget, Local_WindowSize);
+			}
 			printlog(FString::Printf(TEXT("Executing program %s..."), *ProxyProgram->ProgramName.ToString()));
 			if (ProxyProgram->bCanCallOnStart)
 			{
@@ -149,7 +181,9 @@ UYetiOS_BaseProgram* UYetiOS_BaseProgram::Internal_StartProgram(FYetiOsError& Ou
 		}
 		else
 		{
-			ProxyProgram->ConditionalBeginDestroy();
+			// Could not run. Keep the instance for next launch if possible.
+			Local_Pooled.Program = ProxyProgram;
+			OwningOS->ReleaseProgramToPool(Local_Pooled);
 			ProxyProgram = nullptr;
 		}
 	}
@@ -157,12 +191,69 @@ UYetiOS_BaseProgram* UYetiOS_BaseProgram::Internal_StartProgram(FYetiOsError& Ou
 	return ProxyProgram;
 }
 
+UYetiOS_BaseProgram* UYetiOS_BaseProgram::Internal_DuplicateProgram()
+{
+	return DuplicateObject(this, OwningOS, *FString::Printf(TEXT("%s_%s"), *GetName(), *FGuid::NewGuid().ToString(EGuidFormats::UniqueObjectGuid)));
+}
+
+void UYetiOS_BaseProgram::Internal_ResetForReuse(const UYetiOS_BaseProgram* InInstalledProgram)
+{
+	// Blueprint variables go back to installed values, same as a fresh DuplicateObject would give.
+	for (TFieldIterator<FProperty> It(GetClass()); It; ++It)
+	{
+		const UClass* Local_OwnerClass = It->GetOwnerClass();
+		if (Local_OwnerClass && Local_OwnerClass->HasAnyClassFlags(CLASS_Native) == false)
+		{
+			It->CopyCompleteValue_InContainer(this, InInstalledProgram);
+		}
+	}
+
+	OwningOS = InInstalledProgram->OwningOS;
+	ProgramIconWidget = InInstalledProgram->ProgramIconWidget;
+	bOverrideWindowSize = InInstalledProgram->bOverrideWindowSize;
+	OverrideWindowSize = InInstalledProgram->OverrideWindowSize;
+	CurrentVisibilityState = InInstalledProgram->CurrentVisibilityState;
+	CurrentFileOpened = nullptr;
+	ProcessID = INDEX_NONE;
+
+	ResetForReuse();
+}
+
+void UYetiOS_BaseProgram::Internal_WarmInstancePool()
+{
+	if (PoolWarmCount <= 0 || OwningOS == nullptr || OwningOS->CanPoolProgram(this) == false)
+	{
+		return;
+	}
+
+	for (int32 i = OwningOS->GetProgramPool().NumOfClass(GetClass()); i < PoolWarmCount; ++i)
+	{
+		FYetiOsPooledProgram Local_Entry;
+		Local_Entry.Program = Internal_DuplicateProgram();
+		if (Local_Entry.Program == nullptr)
+		{
+			break;
+		}
+
+		Local_Entry.ProgramWidget = UYetiOS_AppWidget::Internal_CreateAppWidget(Local_Entry.Program);
+		if (Local_Entry.ProgramWidget)
+		{
+			// Pooled widgets are kept unbound until reused.
+			Local_Entry.ProgramWidget->DestroyProgramWidget();
+		}
+
+		OwningOS->ReleaseProgramToPool(Local_Entry);
+	}
+}
+
 void UYetiOS_BaseProgram::ProgramInstalled()
 {
 	if (bCanCallOnInstall)
 	{
 		K2_OnInstall();
 	}
+
+	Internal_WarmInstancePool();
 }
 
 const bool UYetiOS_BaseProgram::StartProgram()
@@ -204,6 +295,26 @@ void UYetiOS_BaseProgram::AddProgramIconWidget(class UYetiOS_AppIconWidget* InIc
 	ProgramIconWidget = InIconWidget;
 }
 
+class UYetiOS_AppIconWidget* UYetiOS_BaseProgram::GetProgramIconWidget()
+{
+	if (ProgramIconWidget == nullptr && ProgramIconWidgetClass)
+	{
+		FYetiOsError OutError;
+		UYetiOS_AppIconWidget::CreateProgramIconWidget(this, OutError);
+	}
+
+	return ProgramIconWidget;
+}
+
+void UYetiOS_BaseProgram::ReleaseProgramIconWidget()
+{
+	if (ProgramIconWidget)
+	{
+		ProgramIconWidget->RemoveFromParent();
+		ProgramIconWidget = nullptr;
+	}
+}
+
 bool UYetiOS_BaseProgram::OpenFile(class UYetiOS_FileBase* InFileToOpen, const bool bInForceOpenInSameInstance)
 {
 	bool bLocal_ShouldStartProgram = true;
@@ -266,10 +377,16 @@ void UYetiOS_BaseProgram::CloseProgram(FYetiOsError& OutErrorMessage, const bool
 		CurrentFileOpened = nullptr;
 	}
 
+	// Program, widget and window are kept for next launch unless the Operating System is going away.
+	const bool bLocal_ReturnToPool = bIsOperatingSystemShuttingDown == false && OwningOS->CanPoolProgram(this);
+	FYetiOsPooledProgram Local_Pooled;
+	Local_Pooled.Program = this;
+
 	if (ProgramWidget)
 	{
 		ProgramWidget->SetFileWidget(nullptr);
 		ProgramWidget->DestroyProgramWidget();
+		Local_Pooled.ProgramWidget = ProgramWidget;
 		ProgramWidget = nullptr;
 	}
 
@@ -279,11 +396,36 @@ void UYetiOS_BaseProgram::CloseProgram(FYetiOsError& OutErrorMessage, const bool
 		ProgramSettings = nullptr;
 	}
 
-	OwningWindow->CloseWindow();
+	if (bLocal_ReturnToPool)
+	{
+		OwningWindow->Internal_ParkWindow();
+		Local_Pooled.Window = OwningWindow;
+	}
+	else
+	{
+		OwningWindow->CloseWindow();
+	}
 	OwningWindow = nullptr;
 
 	printlog(FString::Printf(TEXT("Program %s closed."), *ProgramName.ToString()));
-	ConditionalBeginDestroy();
+	if (bLocal_ReturnToPool)
+	{
+		OwningOS->ReleaseProgramToPool(Local_Pooled);
+	}
+	else
+	{
+		ConditionalBeginDestroy();
+	}
+}
+
+int32 UYetiOS_BaseProgram::RegisterUpdate(const FOnProgramUpdate& Callback, const EYetiOsProgramUpdatePriority Priority /*= EYetiOsProgramUpdatePriority::PRIORITY_Normal*/)
+{
+	return OwningOS ? OwningOS->RegisterProgramUpdate(this, Callback, Priority) : INDEX_NONE;
+}
+
+bool UYetiOS_BaseProgram::UnregisterUpdate(const int32 Handle)
+{
+	return OwningOS ? OwningOS->UnregisterProgramUpdate(Handle) : false;
 }
 
 bool UYetiOS_BaseProgram::IsRunning() const
@@ -0,0 +1,309 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_ChangeJournal.h"
+#include "Core/YetiOS_SaveSchema.h"
+#include "Core/YetiOS_DirectoryBase.h"
+#include "Core/YetiOS_FileBase.h"
+#include "Core/YetiOS_FileContent.h"
+#include "Core/YetiOS_BaseProgram.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Crc.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsChangeJournal, All, All)
+
+#define printlog_error(Param1)			UE_LOG(LogYetiOsChangeJournal, Error, TEXT("%s"), *FString(Param1))
+#define printlog_veryverbose(Param1)	UE_LOG(LogYetiOsChangeJournal, VeryVerbose, TEXT("%s"), *FString(Param1))
+
+/** Each record on disk starts with its payload size and checksum. */
+static const int32 JOURNAL_FRAME_HEADER_SIZE = sizeof(int32) + sizeof(uint32);
+
+FYetiOsJournalRecord FYetiOsJournalRecord::MakeDirectoryCreated(const class UYetiOS_DirectoryBase* InDirectory)
+{
+	FYetiOsJournalRecord Local_Record(EYetiOsJournalOp::DirectoryCreated);
+	Local_Record.Flags = InDirectory->IsHidden() ? EYetiOsSaveRecordFlags::Hidden : EYetiOsSaveRecordFlags::None;
+	Local_Record.Strings.Add(InDirectory->GetParentDirectory()->GetFullPath());
+	Local_Record.Strings.Add(InDirectory->GetDirectoryName().ToString());
+	Local_Record.Strings.Add(InDirectory->GetClass()->GetPathName());
+	return Local_Record;
+}
+
+FYetiOsJournalRecord FYetiOsJournalRecord::MakeDirectoryRenamed(const FString& InOldPath, const FText& InNewName)
+{
+	FYetiOsJournalRecord Local_Record(EYetiOsJournalOp::DirectoryRenamed);
+	Local_Record.Strings.Add(InOldPath);
+	Local_Record.Strings.Add(InNewName.ToString());
+	return Local_Record;
+}
+
+FYetiOsJournalRecord FYetiOsJournalRecord::MakeFileCreated(const class UYetiOS_FileBase* InFile)
+{
+	FYetiOsJournalRecord Local_Record(EYetiOsJournalOp::FileCreated);
+	Local_Record.Flags = InFile->IsHidden() ? EYetiOsSaveRecordFlags::Hidden : EYetiOsSaveRecordFlags::None;
+	Local_Record.Strings.Add(InFile->GetParentDirectory()->GetFullPath());
+	Local_Record.Strings.Add(InFile->GetClass()->GetPathName());
+	Local_Record.Strings.Add(InFile->GetFilename(false).ToString());
+	Local_Record.Strings.Add(InFile->GetFileExtension().ToString());
+	return Local_Record;
+}
+
+FYetiOsJournalRecord FYetiOsJournalRecord::MakeFileDeleted(const class UYetiOS_FileBase* InFile)
+{
+	FYetiOsJournalRecord Local_Record(EYetiOsJournalOp::FileDeleted);
+	Local_Record.Strings.Add(InFile->GetParentDirectory()->GetFullPath());
+	Local_Record.Strings.Add(InFile->GetFilename(false).ToString());
+	Local_Record.Strings.Add(InFile->GetFileExtension().ToString());
+	return Local_Record;
+}
+
+FYetiOsJournalRecord FYetiOsJournalRecord::MakeFileRenamed(const class UYetiOS_FileBase* InFile, const FText& InOldName, const FText& InOldExtension)
+{
+	FYetiOsJournalRecord Local_Record(EYetiOsJournalOp::FileRenamed);
+	Local_Record.Strings.Add(InFile->GetParentDirectory()->GetFullPath());
+	Local_Record.Strings.Add(InOldName.ToString());
+	Local_Record.Strings.Add(InOldExtension.ToString());
+	Local_Record.Strings.Add(InFile->GetFilename(false).ToString());
+	Local_Record.Strings.Add(InFile->GetFileExtension().ToString());
+	return Local_Record;
+}
+
+FYetiOsJournalRecord FYetiOsJournalRecord::MakeProgramInstalled(const class UYetiOS_BaseProgram* InProgram)
+{
+	FYetiOsJournalRecord Local_Record(EYetiOsJournalOp::ProgramInstalled);
+	Local_Record.Strings.Add(InProgram->GetClass()->GetPathName());
+	return Local_Record;
+}
+
+FYetiOsJournalRecord FYetiOsJournalRecord::MakeFileContentChanged(const class UYetiOS_FileBase* InFile, const class UYetiOS_FileContent* InContent)
+{
+	FYetiOsJournalRecord Local_Record(EYetiOsJournalOp::FileContentChanged);
+	Local_Record.Strings.Add(InFile->GetParentDirectory()->GetFullPath());
+	Local_Record.Strings.Add(InFile->GetFilename(false).ToString());
+	Local_Record.Strings.Add(InFile->GetFileExtension().ToString());
+	if (InContent)
+	{
+		Local_Record.Data.Reserve(static_cast<int32>(InContent->GetContentSize()));
+		InContent->ForEachChunk([&Local_Record](const uint8* InData, const int32 InSize)
+		{
+			Local_Record.Data.Append(InData, InSize);
+			return true;
+		});
+	}
+
+	return Local_Record;
+}
+
+void FYetiOsJournalRecord::SetStructData(const UScriptStruct* InStruct, const void* InStructData)
+{
+	Data.Reset();
+	FMemoryWriter Local_Writer(Data, true);
+	FObjectAndNameAsStringProxyArchive Local_Archive(Local_Writer, false);
+	const_cast<UScriptStruct*>(InStruct)->SerializeItem(Local_Archive, const_cast<void*>(InStructData), nullptr);
+}
+
+bool FYetiOsJournalRecord::GetStructData(const UScriptStruct* InStruct, void* OutStructData) const
+{
+	if (Data.Num() == 0)
+	{
+		return false;
+	}
+
+	FMemoryReader Local_Reader(Data, true);
+	FObjectAndNameAsStringProxyArchive Local_Archive(Local_Reader, true);
+	const_cast<UScriptStruct*>(InStruct)->SerializeItem(Local_Archive, OutStructData, nullptr);
+	return Local_Archive.IsError() == false;
+}
+
+FArchive& operator<<(FArchive& Ar, FYetiOsJournalRecord& InRecord)
+{
+	uint8 Local_Op = static_cast<uint8>(InRecord.Op);
+	Ar << Local_Op;
+	InRecord.Op = Local_Op < EYetiOsJournalOp::Max ? static_cast<EYetiOsJournalOp::Type>(Local_Op) : EYetiOsJournalOp::Max;
+	Ar << InRecord.Flags;
+	Ar << InRecord.Strings;
+	Ar << InRecord.Data;
+	return Ar;
+}
+
+FYetiOsChangeJournal::FYetiOsChangeJournal()
+{
+	Generation = 0;
+	JournalSize = 0;
+}
+
+void FYetiOsChangeJournal::Open(const FString& InDirectory, const FString& InName, const uint32 InGeneration)
+{
+	Close();
+	JournalDirectory = InDirectory;
+	JournalName = InName;
+	Generation = InGeneration;
+	IFileManager::Get().MakeDirectory(*JournalDirectory, true);
+
+	TArray<uint32> Local_Generations;
+	Internal_GetGenerations(Local_Generations);
+	for (const uint32& It : Local_Generations)
+	{
+		JournalSize += FMath::Max<int64>(IFileManager::Get().FileSize(*Internal_GetFilePath(It)), 0);
+	}
+
+	printlog_veryverbose(FString::Printf(TEXT("Opened journal %s at generation %u with %lld byte(s) on disk."), *JournalName, Generation, JournalSize));
+}
+
+void FYetiOsChangeJournal::Close()
+{
+	JournalDirectory.Empty();
+	JournalName.Empty();
+	Generation = 0;
+	PendingBytes.Empty();
+	JournalSize = 0;
+}
+
+void FYetiOsChangeJournal::Append(const FYetiOsJournalRecord& InRecord)
+{
+	// Header is written once the payload size is known.
+	const int32 Local_FrameStart = PendingBytes.AddUninitialized(JOURNAL_FRAME_HEADER_SIZE);
+	FMemoryWriter Local_Writer(PendingBytes, false, true);
+	Local_Writer << const_cast<FYetiOsJournalRecord&>(InRecord);
+
+	int32 Local_PayloadSize = PendingBytes.Num() - Local_FrameStart - JOURNAL_FRAME_HEADER_SIZE;
+	uint32 Local_Checksum = FCrc::MemCrc32(PendingBytes.GetData() + Local_FrameStart + JOURNAL_FRAME_HEADER_SIZE, Local_PayloadSize);
+	FMemoryWriter Local_HeaderWriter(PendingBytes, false, false);
+	Local_HeaderWriter.Seek(Local_FrameStart);
+	Local_HeaderWriter << Local_PayloadSize;
+	Local_HeaderWriter << Local_Checksum;
+}
+
+bool FYetiOsChangeJournal::Flush()
+{
+	if (IsOpen() == false || PendingBytes.Num() == 0)
+	{
+		return true;
+	}
+
+	const FString Local_FilePath = Internal_GetFilePath(Generation);
+	TUniquePtr<FArchive> Local_Writer(IFileManager::Get().CreateFileWriter(*Local_FilePath, FILEWRITE_Append));
+	if (Local_Writer.IsValid() == false)
+	{
+		// Records stay pending so the next flush tries again.
+		printlog_error(FString::Printf(TEXT("Failed to open journal file %s."), *Local_FilePath));
+		return false;
+	}
+
+	Local_Writer->Serialize(PendingBytes.GetData(), PendingBytes.Num());
+	const bool bLocal_Success = Local_Writer->Close();
+	if (bLocal_Success)
+	{
+		JournalSize += PendingBytes.Num();
+		PendingBytes.Reset();
+	}
+	else
+	{
+		// Part of the records may be on disk already. Retrying in a new generation keeps the damaged file from hiding later records.
+		printlog_error(FString::Printf(TEXT("Failed to write journal file %s."), *Local_FilePath));
+		++Generation;
+	}
+
+	return bLocal_Success;
+}
+
+uint32 FYetiOsChangeJournal::Rotate()
+{
+	Flush();
+	++Generation;
+	return Generation;
+}
+
+void FYetiOsChangeJournal::DeleteGenerationsBefore(const uint32 InGeneration)
+{
+	TArray<uint32> Local_Generations;
+	Internal_GetGenerations(Local_Generations);
+	for (const uint32& It : Local_Generations)
+	{
+		if (It >= InGeneration)
+		{
+			break;
+		}
+
+		const FString Local_FilePath = Internal_GetFilePath(It);
+		const int64 Local_FileSize = FMath::Max<int64>(IFileManager::Get().FileSize(*Local_FilePath), 0);
+		if (IFileManager::Get().Delete(*Local_FilePath, false, true, true))
+		{
+			JournalSize = FMath::Max<int64>(JournalSize - Local_FileSize, 0);
+		}
+	}
+}
+
+uint32 FYetiOsChangeJournal::ReadRecords(const uint32 InFromGeneration, TArray<FYetiOsJournalRecord>& OutRecords) const
+{
+	uint32 Local_LastGeneration = InFromGeneration;
+	TArray<uint32> Local_Generations;
+	Internal_GetGenerations(Local_Generations);
+	for (const uint32& It : Local_Generations)
+	{
+		if (It < InFromGeneration)
+		{
+			continue;
+		}
+
+		Local_LastGeneration = It;
+		TArray<uint8> Local_Bytes;
+		if (FFileHelper::LoadFileToArray(Local_Bytes, *Internal_GetFilePath(It), FILEREAD_Silent) == false)
+		{
+			continue;
+		}
+
+		FMemoryReader Local_Reader(Local_Bytes, true);
+		while (Local_Reader.TotalSize() - Local_Reader.Tell() >= JOURNAL_FRAME_HEADER_SIZE)
+		{
+			int32 Local_PayloadSize = 0;
+			uint32 Local_Checksum = 0;
+			Local_Reader << Local_PayloadSize;
+			Local_Reader << Local_Checksum;
+
+			const int64 Local_PayloadStart = Local_Reader.Tell();
+			if (Local_PayloadSize < 0 || Local_PayloadStart + Local_PayloadSize > Local_Reader.TotalSize() || FCrc::MemCrc32(Local_Bytes.GetData() + Local_PayloadStart, Local_PayloadSize) != Local_Checksum)
+			{
+				printlog_error(FString::Printf(TEXT("Journal generation %u is damaged after %lld byte(s). Remaining records of this generation are skipped."), It, Local_PayloadStart - JOURNAL_FRAME_HEADER_SIZE));
+				break;
+			}
+
+			FYetiOsJournalRecord& Local_Record = OutRecords.AddDefaulted_GetRef();
+			Local_Reader << Local_Record;
+			Local_Reader.Seek(Local_PayloadStart + Local_PayloadSize);
+		}
+	}
+
+	return Local_LastGeneration;
+}
+
+void FYetiOsChangeJournal::Internal_GetGenerations(TArray<uint32>& OutGenerations) const
+{
+	OutGenerations.Reset();
+	TArray<FString> Local_Files;
+	IFileManager::Get().FindFiles(Local_Files, *FPaths::Combine(JournalDirectory, JournalName + TEXT("_*.journal")), true, false);
+
+	const int32 Local_PrefixLength = JournalName.Len() + 1;
+	for (const FString& It : Local_Files)
+	{
+		const FString Local_GenerationString = FPaths::GetBaseFilename(It).RightChop(Local_PrefixLength);
+		if (Local_GenerationString.IsNumeric())
+		{
+			OutGenerations.Add(static_cast<uint32>(FCString::Strtoui64(*Local_GenerationString, nullptr, 10)));
+		}
+	}
+
+	OutGenerations.Sort();
+}
+
+FString FYetiOsChangeJournal::Internal_GetFilePath(const uint32 InGeneration) const
+{
+	return FPaths::Combine(JournalDirectory, FString::Printf(TEXT("%s_%u.journal"), *JournalName, InGeneration));
+}
+
+#undef printlog_error
+#undef printlog_veryverbose
@@ -22,9 +22,11 @@
 #include "Hardware/YetiOS_Motherboard.h"
 #include "Hardware/YetiOS_HardDisk.h"
 #include "Core/YetiOS_FileBase.h"
+#include "Core/YetiOS_FileContent.h"
 #include "Misc/YetiOS_ProgramsRepository.h"
 #include "Widgets/YetiOS_DialogWidget.h"
 #include "Core/YetiOS_BaseDialogProgram.h"
+#include "Misc/YetiOS_ProgramSettings.h"
 
 FOnUserLocked		FYetiOS_Lock::OnUserLocked;
 FOnUserUnLocked		FYetiOS_Lock::OnUserUnlocked;
@@ -39,15 +41,15 @@ DEFINE_LOG_CATEGORY_STATIC(LogYetiOsOperatingSystem, All, All)
 
 #define LOCTEXT_NAMESPACE "YetiOS"
 
-static const int32 MIN_PROCES_ID_TO_GENERATE = 1;
-static const int32 MAX_PROCES_ID_TO_GENERATE = 99999;
-
 const FString UYetiOS_Core::PATH_DELIMITER = "/";
 
 static const FText INSTALL_ERROR_CODE = LOCTEXT("YetiOS_InstallProgramErrorCode", "ERR_INSTALL_FAIL");
 static const FText CLOSE_ERROR_CODE = LOCTEXT("YetiOS_CloseProgramErrorCode", "ERR_CLOSE_PROGRAM");
 static const FText RUN_ERROR_CODE = LOCTEXT("YetiOS_RunProgramInstanceErrorCode", "ERR_RUN_PROGRAM");
 
+/** Seconds program settings are kept in memory before they are written, so settings of programs closed together go in one write. */
+static const float PROGRAM_SETTINGS_WRITE_DELAY = 1.f;
+
 UYetiOS_Core::UYetiOS_Core()
 {
 	OsName = FText::GetEmpty();
@@ -59,6 +61,11 @@ UYetiOS_Core::UYetiOS_Core()
 	MaxInstallationTime = 60.f;
 
 	CurrentZOrder = INDEX_NONE;
+	bIsInstallBatchOpen = false;
+	bIsNotificationFlushPending = false;
+	bIsFileIndexComplete = false;
+	SaveGameLoadStep = EYetiOsSaveGameLoadStep::Done;
+	CompactingJournalGeneration = 0;
 
 	RootUser = FYetiOsUser("root");
 	RootCommand = FText::AsCultureInvariant("sudo");
@@ -90,8 +97,9 @@ UYetiOS_Core* UYetiOS_Core::CreateOperatingSystem(class UYetiOS_BaseDevice* InPa
 			ProxyOS->bIsPreInstalled = InParentDevice->IsOperatingSystemPreInstalled();
 			UYetiOS_OsWidget::Internal_CreateOsWidget(ProxyOS);
 			UYetiOS_Taskbar::CreateTaskbar(ProxyOS);
-			ProxyOS->NotificationManager = FYetiOsNotificationManager::CreateNotificationManager();
-			ProxyOS->InstalledPrograms.Empty();
+			ProxyOS->NotificationManager = FYetiOsNotificationManager::CreateNotificationManager(ProxyOS->NotificationSettings);
+			ProxyOS->ProgramSettingsStore.Open(UYetiOS_ProgramSettings::GetStoreSlotName(InParentDevice), UYetiOS_ProgramSettings::GetStoreUserIndex());
+			ProxyOS->InstalledPrograms.Reset();
 			return ProxyOS;
 		}
 
@@ -279,11 +287,37 @@ void UYetiOS_Core::ListenForUnlock(class UObject* Object, const FYetiOsUser& InU
 
 void UYetiOS_Core::CreateOsNotification(const FYetiOsNotification InNewNotification)
 {
-	if (NotificationSettings.bEnableNotifications)
+	if (NotificationSettings.bEnableNotifications && NotificationManager)
+	{
+		if (NotificationManager->LogNotification(InNewNotification) && bIsNotificationFlushPending == false)
+		{
+			if (OsWorld)
+			{
+				bIsNotificationFlushPending = true;
+				OsWorld->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_Core::Internal_FlushNotifications);
+			}
+			else
+			{
+				Internal_FlushNotifications();
+			}
+		}
+	}
+}
+
+int32 UYetiOS_Core::GetNotificationHistoryCount() const
+{
+	return NotificationManager ? NotificationManager->Num() : 0;
+}
+
+int32 UYetiOS_Core::GetNotificationHistoryPage(const int32 InPage, const int32 InPageSize, TArray<FYetiOsNotification>& OutNotifications) const
+{
+	if (NotificationManager)
 	{
-		OsWidget->ReceiveNotification(InNewNotification);
-		NotificationManager->LogNotification(InNewNotification);
+		return NotificationManager->GetNotificationsPage(InPage, InPageSize, OutNotifications);
 	}
+
+	OutNotifications.Empty();
+	return 0;
 }
 
 void UYetiOS_Core::ToggleLockOnFile(class UYetiOS_FileBase* TargetFile, bool bLock, const FYetiOsUser& InUser)
@@ -397,12 +431,17 @@ void UYetiOS_Core::RestartOS()
 
 void UYetiOS_Core::CloseAllPrograms(const bool bIsOperatingSystemShuttingDown)
 {
-	TArray<UYetiOS_BaseProgram*> ProgramsArray;
-	RunningPrograms.GenerateValueArray(ProgramsArray);
-	for (const auto& It : ProgramsArray)
+	// Closing a program removes it from the process table so walk a snapshot of process IDs instead of the table itself.
+	TArray<int32> ProcessIDs;
+	ProcessTable.GetProcessIDs(ProcessIDs);
+	for (const int32& It : ProcessIDs)
 	{
-		FYetiOsError OutError;
-		It->CloseProgram(OutError, bIsOperatingSystemShuttingDown);
+		UYetiOS_BaseProgram* Local_Program = ProcessTable.Find(It);
+		if (Local_Program)
+		{
+			FYetiOsError OutError;
+			Local_Program->CloseProgram(OutError, bIsOperatingSystemShuttingDown);
+		}
 	}
 }
 
@@ -420,6 +459,7 @@ bool UYetiOS_Core::AddNewUser(FYetiOsUser InNewUser, FYetiOsError& OutErrorMessa
 	}
 	
 	OsUsers.Add(InNewUser);
+	Internal_JournalOsData();
 	return true;
 }
 
@@ -442,22 +482,19 @@ UYetiOS_BaseProgram* UYetiOS_Core::InstallProgram(TSubclassOf<UYetiOS_BaseProgra
 		return nullptr;
 	}
 
-	for (const auto& It : InstalledPrograms)
+	if (InstalledPrograms.ContainsClass(InProgramToInstall) || InstalledPrograms.ContainsIdentifier(DefaultConstructed->GetProgramIdentifierName()))
 	{
-		if (It->GetClass() == InProgramToInstall)
-		{
-			const FText Title = FText::Format(LOCTEXT("YetiOS_InstallProgramError", "{0} already installed."), MyProgramName);
-			const FText Description = FText::Format(LOCTEXT("YetiOS_InstallProgramErrorDescription", "{0} is already installed. Uninstall the existing app to install {0} again."), MyProgramName);			
-			const FYetiOsNotification NewNotification = FYetiOsNotification(EYetiOsNotificationCategory::CATEGORY_App, Title, Description, INSTALL_ERROR_CODE, EYetiOsNotificationType::TYPE_Error);
-			CreateOsNotification(NewNotification);
+		const FText Title = FText::Format(LOCTEXT("YetiOS_InstallProgramError", "{0} already installed."), MyProgramName);
+		const FText Description = FText::Format(LOCTEXT("YetiOS_InstallProgramErrorDescription", "{0} is already installed. Uninstall the existing app to install {0} again."), MyProgramName);			
+		const FYetiOsNotification NewNotification = FYetiOsNotification(EYetiOsNotificationCategory::CATEGORY_App, Title, Description, INSTALL_ERROR_CODE, EYetiOsNotificationType::TYPE_Error);
+		CreateOsNotification(NewNotification);
 
-			OutErrorMessage.ErrorCode = INSTALL_ERROR_CODE;
-			OutErrorMessage.ErrorException = Title;
-			OutErrorMessage.ErrorDetailedException = Description;
+		OutErrorMessage.ErrorCode = INSTALL_ERROR_CODE;
+		OutErrorMessage.ErrorException = Title;
+		OutErrorMessage.ErrorDetailedException = Description;
 
-			printlog_error(Description.ToString());
-			return nullptr;
-		}
+		printlog_error(Description.ToString());
+		return nullptr;
 	}
 
 	if (GetOwningDevice()->GetMotherboard()->GetHardDisk()->HasEnoughSpace(DefaultConstructed->GetProgramSpace()) == false)
@@ -482,6 +519,11 @@ UYetiOS_BaseProgram* UYetiOS_Core::InstallProgram(TSubclassOf<UYetiOS_BaseProgra
 		GetOwningDevice()->GetMotherboard()->GetHardDisk()->ConsumeSpace(NewProgram->GetProgramSpace());
 		OutIconWidget = UYetiOS_AppIconWidget::CreateProgramIconWidget(NewProgram, OutErrorMessage);
 		InstalledPrograms.Add(NewProgram);
+		if (IsJournalingChanges() && NewProgram->IsSystemInstalledProgram() == false)
+		{
+			JournalChange(FYetiOsJournalRecord::MakeProgramInstalled(NewProgram));
+		}
+
 		printlog(FString::Printf(TEXT("Program %s installed."), *NewProgram->GetProgramName().ToString()));
 		if (NewProgram->CanAddToDesktop())
 		{
@@ -498,6 +540,7 @@ UYetiOS_BaseProgram* UYetiOS_Core::InstallProgram(TSubclassOf<UYetiOS_BaseProgra
 
 		NewProgram->ProgramInstalled();
 		OnProgramInstalled.Broadcast(NewProgram);
+		OnProgramsInstalled.Broadcast(TArray<UYetiOS_BaseProgram*>({ NewProgram }));
 		return NewProgram;
 	}
 	
@@ -514,6 +557,182 @@ UYetiOS_BaseProgram* UYetiOS_Core::InstallProgram(TSubclassOf<UYetiOS_BaseProgra
 	return nullptr;
 }
 
+bool UYetiOS_Core::BeginInstallBatch()
+{
+	if (bIsInstallBatchOpen)
+	{
+		printlog_warn("An install batch is already open.");
+		return false;
+	}
+
+	bIsInstallBatchOpen = true;
+	PendingInstallBatch.Reset();
+	return true;
+}
+
+bool UYetiOS_Core::AddToInstallBatch(TSubclassOf<UYetiOS_BaseProgram> InProgramToInstall)
+{
+	if (ensureMsgf(bIsInstallBatchOpen, TEXT("AddToInstallBatch called without an open install batch. Call BeginInstallBatch first.")) && InProgramToInstall)
+	{
+		PendingInstallBatch.Add(InProgramToInstall);
+		return true;
+	}
+
+	return false;
+}
+
+int32 UYetiOS_Core::CommitInstallBatch(FYetiOsError& OutErrorMessage, const bool bShowSummaryNotification /*= true*/)
+{
+	if (bIsInstallBatchOpen == false)
+	{
+		printlog_warn("CommitInstallBatch called without an open install batch.");
+		return 0;
+	}
+
+	TArray<TSubclassOf<UYetiOS_BaseProgram>> Local_Batch = MoveTemp(PendingInstallBatch);
+	PendingInstallBatch.Reset();
+	bIsInstallBatchOpen = false;
+
+	if (Local_Batch.Num() == 0)
+	{
+		return 0;
+	}
+
+	if (Device->IsInBsodState())
+	{
+		static const FText Title = LOCTEXT("YetiOS_InstallBatchBsodError", "Cannot install programs.");
+		static const FText Description = LOCTEXT("YetiOS_InstallBatchBsodErrorDescription", "Cannot install programs. System unstable.");
+		const FYetiOsNotification NewNotification = FYetiOsNotification(EYetiOsNotificationCategory::CATEGORY_App, Title, Description, INSTALL_ERROR_CODE, EYetiOsNotificationType::TYPE_Error);
+		CreateOsNotification(NewNotification);
+		OutErrorMessage = GetErrorStruct(INSTALL_ERROR_CODE, Title, Description);
+		printlog_error(Description.ToString());
+		return 0;
+	}
+
+	// Validate the whole batch up front. Drop programs that are already installed or queued twice and sum the space once.
+	TArray<TSubclassOf<UYetiOS_BaseProgram>> Local_ToInstall;
+	Local_ToInstall.Reserve(Local_Batch.Num());
+	TSet<FName> Local_BatchIdentifiers;
+	Local_BatchIdentifiers.Reserve(Local_Batch.Num());
+	float Local_RequiredSpace = 0.f;
+	int32 Local_SkippedCount = 0;
+	for (const auto& It : Local_Batch)
+	{
+		const UYetiOS_BaseProgram* Local_CDO = It->GetDefaultObject<UYetiOS_BaseProgram>();
+		const FName Local_Identifier = Local_CDO->GetProgramIdentifierName();
+		bool bIsAlreadyInBatch = false;
+		Local_BatchIdentifiers.Add(Local_Identifier, &bIsAlreadyInBatch);
+		if (bIsAlreadyInBatch || InstalledPrograms.ContainsClass(It) || InstalledPrograms.ContainsIdentifier(Local_Identifier))
+		{
+			printlog_veryverbose(FString::Printf(TEXT("%s already installed or queued. Skipping from install batch."), *Local_Identifier.ToString()));
+			Local_SkippedCount++;
+			continue;
+		}
+
+		Local_ToInstall.Add(It);
+		Local_RequiredSpace += Local_CDO->GetProgramSpace();
+	}
+
+	// Dependencies are only required when a program starts so report missing ones instead of blocking the install.
+	int32 Local_MissingDependencyCount = 0;
+	for (const auto& It : Local_ToInstall)
+	{
+		const UYetiOS_BaseProgram* Local_CDO = It->GetDefaultObject<UYetiOS_BaseProgram>();
+		for (const auto& DependencyIt : Local_CDO->GetDependantPrograms())
+		{
+			const UClass* Local_DependencyClass = DependencyIt.Get();
+			const FName Local_DependencyIdentifier = Local_DependencyClass ? Local_DependencyClass->GetDefaultObject<UYetiOS_BaseProgram>()->GetProgramIdentifierName() : NAME_None;
+			if (Local_DependencyIdentifier.IsNone() || (Local_BatchIdentifiers.Contains(Local_DependencyIdentifier) == false && InstalledPrograms.ContainsIdentifier(Local_DependencyIdentifier) == false))
+			{
+				printlog_warn(FString::Printf(TEXT("%s is missing dependency %s."), *Local_CDO->GetProgramIdentifierName().ToString(), *DependencyIt.ToString()));
+				Local_MissingDependencyCount++;
+			}
+		}
+	}
+
+	UYetiOS_HardDisk* Local_HardDisk = GetOwningDevice()->GetMotherboard()->GetHardDisk();
+	if (Local_HardDisk->HasEnoughSpace(Local_RequiredSpace) == false)
+	{
+		static const FText Title = LOCTEXT("YetiOS_InstallBatchNoSpaceError", "Not enough space.");
+		const FText Description = FText::Format(LOCTEXT("YetiOS_InstallBatchNoSpaceErrorDescription", "Not enough space to install {0} program(s). Free up space by uninstalling existing apps or expand your storage."), FText::AsNumber(Local_ToInstall.Num()));
+		const FYetiOsNotification NewNotification = FYetiOsNotification(EYetiOsNotificationCategory::CATEGORY_App, Title, Description, INSTALL_ERROR_CODE, EYetiOsNotificationType::TYPE_Error);
+		CreateOsNotification(NewNotification);
+		OutErrorMessage = GetErrorStruct(INSTALL_ERROR_CODE, Title, Description);
+		printlog_error(Description.ToString());
+		return 0;
+	}
+
+	TArray<UYetiOS_BaseProgram*> Local_InstalledPrograms;
+	Local_InstalledPrograms.Reserve(Local_ToInstall.Num());
+	float Local_ConsumedSpace = 0.f;
+	for (const auto& It : Local_ToInstall)
+	{
+		const bool bIsPredefinedProgram = HasRepositoryLibrary() ? ProgramsRepository->IsInstalledWithOS(It) : false;
+		UYetiOS_BaseProgram* NewProgram = UYetiOS_BaseProgram::CreateProgram(this, It, OutErrorMessage, bIsPredefinedProgram);
+		if (NewProgram)
+		{
+			InstalledPrograms.Add(NewProgram);
+			Local_InstalledPrograms.Add(NewProgram);
+			Local_ConsumedSpace += NewProgram->GetProgramSpace();
+			if (IsJournalingChanges() && NewProgram->IsSystemInstalledProgram() == false)
+			{
+				JournalChange(FYetiOsJournalRecord::MakeProgramInstalled(NewProgram));
+			}
+		}
+		else
+		{
+			Local_SkippedCount++;
+		}
+	}
+
+	Local_HardDisk->ConsumeSpace(Local_ConsumedSpace);
+
+	// Icon widgets are only created once every program in the batch is registered.
+	int32 Local_NotifyCount = 0;
+	for (UYetiOS_BaseProgram* It : Local_InstalledPrograms)
+	{
+		if (It->CanShowPostInstallNotification())
+		{
+			Local_NotifyCount++;
+		}
+
+		FYetiOsError Local_IconError;
+		UYetiOS_AppIconWidget* Local_IconWidget = UYetiOS_AppIconWidget::CreateProgramIconWidget(It, Local_IconError);
+		if (Local_IconWidget && It->CanAddToDesktop())
+		{
+			OsWidget->AddIconWidgetToDesktop(Local_IconWidget);
+		}
+
+		It->ProgramInstalled();
+		OnProgramInstalled.Broadcast(It);
+	}
+
+	printlog(FString::Printf(TEXT("Install batch finished. %i installed, %i skipped, %i missing dependencies."), Local_InstalledPrograms.Num(), Local_SkippedCount, Local_MissingDependencyCount));
+
+	// Programs that do not want a post install notification are left out of the summary. Problems are always reported.
+	if (bShowSummaryNotification && (Local_NotifyCount > 0 || Local_SkippedCount > 0 || Local_MissingDependencyCount > 0))
+	{
+		const FText Title = LOCTEXT("YetiOS_InstallBatchSuccess", "Installed Programs.");
+		const FText Description = FText::Format(LOCTEXT("YetiOS_InstallBatchSuccessDescription", "{0} program(s) installed. {1} skipped. {2} missing dependencies."), FText::AsNumber(Local_NotifyCount), FText::AsNumber(Local_SkippedCount), FText::AsNumber(Local_MissingDependencyCount));
+		const EYetiOsNotificationType Local_Level = (Local_SkippedCount > 0 || Local_MissingDependencyCount > 0) ? EYetiOsNotificationType::TYPE_Warning : EYetiOsNotificationType::TYPE_Info;
+		const FYetiOsNotification NewNotification = FYetiOsNotification(EYetiOsNotificationCategory::CATEGORY_App, Title, Description, FText::FromString("INSTALL_SUCCESS"), Local_Level);
+		CreateOsNotification(NewNotification);
+	}
+
+	if (Local_InstalledPrograms.Num() > 0)
+	{
+		OnProgramsInstalled.Broadcast(Local_InstalledPrograms);
+	}
+
+	return Local_InstalledPrograms.Num();
+}
+
+void UYetiOS_Core::CancelInstallBatch()
+{
+	PendingInstallBatch.Reset();
+	bIsInstallBatchOpen = false;
+}
+
 UYetiOS_BaseProgram* UYetiOS_Core::InstallProgramFromPackage(const FString& InProgramIdentifier, FYetiOsError& OutErrorMessage, UYetiOS_AppIconWidget*& OutIconWidget)
 {
 	OutIconWidget = nullptr;
@@ -578,24 +797,13 @@ const bool UYetiOS_Core::IsProgramRunning(const class UYetiOS_BaseProgram* InPro
 
 const bool UYetiOS_Core::IsProgramRunning(const FName& InProgramIdentifier, class UYetiOS_BaseProgram*& OutProgram) const
 {
-	OutProgram = nullptr;
-	TArray<UYetiOS_BaseProgram*> OutArray;
-	RunningPrograms.GenerateValueArray(OutArray);
-	for (const auto& It : OutArray)
-	{
-		if (It->GetProgramIdentifierName().IsEqual(InProgramIdentifier))
-		{
-			OutProgram = It;
-			return true;
-		}
-	}
-
-	return false;
+	OutProgram = ProcessTable.FindFirstByIdentifier(InProgramIdentifier);
+	return (OutProgram != nullptr);
 }
 
 const bool UYetiOS_Core::IsProcessIdValid(const int32& InProcessID, class UYetiOS_BaseProgram*& OutProgram)
 {
-	OutProgram = RunningPrograms.FindRef(InProcessID);
+	OutProgram = ProcessTable.Find(InProcessID);
 	return (OutProgram != nullptr);
 }
 
@@ -659,16 +867,22 @@ int32 UYetiOS_Core::AddRunningProgram(const class UYetiOS_BaseProgram* InNewProg
 		return INDEX_NONE;
 	}
 
-	int32 NewProcessID = FMath::RandRange(MIN_PROCES_ID_TO_GENERATE, MAX_PROCES_ID_TO_GENERATE);
-	TArray<int32> ProcessIDs;
-	RunningPrograms.GenerateKeyArray(ProcessIDs);
-	while (ProcessIDs.Contains(NewProcessID))
+	const int32 NewProcessID = ProcessTable.Add(const_cast<UYetiOS_BaseProgram*>(InNewProgram));
+	if (NewProcessID == INDEX_NONE)
 	{
-		NewProcessID = FMath::RandRange(MIN_PROCES_ID_TO_GENERATE, MAX_PROCES_ID_TO_GENERATE);
+		const FText Title = FText::Format(LOCTEXT("YetiOS_RunProgramProcessTableError", "Cannot start {0}."), MyProgramName);
+		static const FText Description = LOCTEXT("YetiOS_RunProgramProcessTableErrorDescription", "Too many programs are running. Close some programs and try again.");
+		const FYetiOsNotification NewNotification = FYetiOsNotification(EYetiOsNotificationCategory::CATEGORY_App, Title, Description, RUN_ERROR_CODE, EYetiOsNotificationType::TYPE_Error);
+		CreateOsNotification(NewNotification);
+
+		OutErrorMessage.ErrorCode = RUN_ERROR_CODE;
+		OutErrorMessage.ErrorException = Title;
+		OutErrorMessage.ErrorDetailedException = Description;
+
+		return INDEX_NONE;
 	}
 
-	RunningPrograms.Add(NewProcessID, const_cast<UYetiOS_BaseProgram*>(InNewProgram));
-	// #TERMINALPLUGIN TODO Consume resources after adding program.
+	// Per frame work is registered by the program itself through RegisterProgramUpdate and released in CloseRunningProgram.
 	return NewProcessID;
 }
 
@@ -708,7 +922,7 @@ void UYetiOS_Core::CloseRunningProgram(class UYetiOS_BaseProgram* InProgram, FYe
 	}
 
 	const int32 Local_ProcessID = InProgram->GetProcessID();
-	if (RunningPrograms.Contains(Local_ProcessID) == false)
+	if (ProcessTable.Contains(Local_ProcessID) == false)
 	{
 		const FText Title = FText::Format(LOCTEXT("YetiOS_CloseProgramBsodError", "Cannot change {0} state."), MyProgramName);
 		static const FText Description = LOCTEXT("YetiOS_CloseProgramBsodErrorDescription", "Cannot close program that is not running.");		
@@ -724,9 +938,191 @@ void UYetiOS_Core::CloseRunningProgram(class UYetiOS_BaseProgram* InProgram, FYe
 		return;
 	}
 
-	RunningPrograms.Remove(Local_ProcessID);
-	RunningPrograms.Compact();
-	// #TERMINALPLUGIN TODO Free resources after closing program.
+	ProcessTable.Remove(Local_ProcessID);
+	ProgramScheduler.UnregisterProgram(InProgram);
+}
+
+int32 UYetiOS_Core::RegisterProgramUpdate(class UYetiOS_BaseProgram* InProgram, const FYetiOsProgramUpdateDelegate& InCallback, const EYetiOsProgramUpdatePriority InPriority /*= EYetiOsProgramUpdatePriority::PRIORITY_Normal*/)
+{
+	if (InProgram == nullptr || ProcessTable.Find(InProgram->GetProcessID()) != InProgram)
+	{
+		printlog_warn("Only running programs can register updates.");
+		return INDEX_NONE;
+	}
+
+	const int32 Local_Handle = ProgramScheduler.Register(InProgram, InCallback, InPriority);
+	if (Local_Handle != INDEX_NONE && OsWorld && TimerHandle_ProgramScheduler.IsValid() == false)
+	{
+		TimerHandle_ProgramScheduler = OsWorld->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_Core::Internal_TickProgramScheduler);
+	}
+
+	return Local_Handle;
+}
+
+int32 UYetiOS_Core::RegisterProgramUpdate(class UYetiOS_BaseProgram* InProgram, const FOnProgramUpdate& InCallback, const EYetiOsProgramUpdatePriority InPriority /*= EYetiOsProgramUpdatePriority::PRIORITY_Normal*/)
+{
+	if (InCallback.IsBound() == false)
+	{
+		return INDEX_NONE;
+	}
+
+	// Blueprint callbacks are wrapped in a native one so both overloads share validation and scheduling.
+	return RegisterProgramUpdate(InProgram, FYetiOsProgramUpdateDelegate::CreateWeakLambda(InProgram, [InCallback](const float InDeltaTime)
+	{
+		InCallback.ExecuteIfBound(InDeltaTime);
+	}), InPriority);
+}
+
+int32 UYetiOS_Core::StartSearch(UYetiOS_DirectoryBase* InStartDirectory, const FYetiOsSearchQuery& InQuery, const FOnSearchResults& OnResults, const FOnSearchFinished& OnFinished)
+{
+	UYetiOS_DirectoryBase* Local_StartDirectory = InStartDirectory ? InStartDirectory : GetRootDirectory();
+	const int32 Local_SearchID = SearchService.StartSearch(Local_StartDirectory, InQuery, OnResults, OnFinished);
+	if (Local_SearchID != INDEX_NONE && OsWorld && TimerHandle_SearchService.IsValid() == false)
+	{
+		TimerHandle_SearchService = OsWorld->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_Core::Internal_TickSearchService);
+	}
+
+	return Local_SearchID;
+}
+
+bool UYetiOS_Core::CancelSearch(const int32 InSearchID)
+{
+	return SearchService.CancelSearch(InSearchID);
+}
+
+bool UYetiOS_Core::IsSearchRunning(const int32 InSearchID) const
+{
+	return SearchService.IsSearchRunning(InSearchID);
+}
+
+void UYetiOS_Core::QueryFileIndex(const FString& InQuery, TArray<class UYetiOS_FileBase*>& OutFiles, const int32 InMaxResults /*= 50*/)
+{
+	OutFiles.Reset();
+	if (FileIndexSettings.bEnableFileIndex == false)
+	{
+		return;
+	}
+
+	if (bIsFileIndexComplete == false)
+	{
+		RebuildFileIndex();
+	}
+	else if (PendingContentIndexUpdates.Num() > 0)
+	{
+		Internal_FlushFileIndexUpdates();
+	}
+
+	FileIndex.Query(InQuery, InMaxResults, OutFiles);
+}
+
+void UYetiOS_Core::RebuildFileIndex()
+{
+	FileIndex.Reset();
+	PendingContentIndexUpdates.Empty();
+	bIsFileIndexComplete = false;
+	if (FileIndexSettings.bEnableFileIndex == false)
+	{
+		return;
+	}
+
+	const double Local_StartTime = FPlatformTime::Seconds();
+	MaterializeAllDirectories();
+	for (const UYetiOS_DirectoryBase* It : GetAllCreatedDirectories())
+	{
+		for (UYetiOS_FileBase* FileIt : It->GetDirectoryFiles())
+		{
+			NotifyFileChanged(FileIt);
+			Internal_IndexFileContent(FileIt);
+		}
+	}
+
+	bIsFileIndexComplete = true;
+	printlog_veryverbose(FString::Printf(TEXT("Indexed %i file(s) with %i word(s) in %f ms. Index uses %lld bytes."), FileIndex.Num(), FileIndex.NumWords(), (FPlatformTime::Seconds() - Local_StartTime) * 1000.0, GetFileIndexMemoryUsage()));
+}
+
+int64 UYetiOS_Core::GetFileIndexMemoryUsage() const
+{
+	return static_cast<int64>(FileIndex.GetAllocatedSize());
+}
+
+void UYetiOS_Core::NotifyFileChanged(class UYetiOS_FileBase* InFile)
+{
+	if (InFile && FileIndexSettings.bEnableFileIndex)
+	{
+		TArray<FString> Local_Words;
+		FYetiOsFileIndex::SplitWords(InFile->GetFilename(true).ToString(), 1, Local_Words);
+		FileIndex.SetNameWords(InFile, Local_Words);
+	}
+}
+
+void UYetiOS_Core::NotifyFileContentChanged(class UYetiOS_FileBase* InFile)
+{
+	if (InFile == nullptr)
+	{
+		return;
+	}
+
+	if (IsJournalingChanges())
+	{
+		// Every content record holds the whole content, so it is journaled once when the journal is flushed.
+		PendingJournalContents.Add(InFile);
+		if (OsWorld && TimerHandle_ChangeJournal.IsValid() == false)
+		{
+			TimerHandle_ChangeJournal = OsWorld->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_Core::Internal_FlushChangeJournal);
+		}
+	}
+
+	if (FileIndexSettings.bEnableFileIndex == false || FileIndexSettings.bIndexContent == false)
+	{
+		return;
+	}
+
+	PendingContentIndexUpdates.Add(InFile);
+	if (OsWorld && TimerHandle_FileIndex.IsValid() == false)
+	{
+		TimerHandle_FileIndex = OsWorld->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_Core::Internal_FlushFileIndexUpdates);
+	}
+}
+
+void UYetiOS_Core::JournalChange(const FYetiOsJournalRecord& InRecord)
+{
+	if (ChangeJournal.IsOpen() == false)
+	{
+		return;
+	}
+
+	ChangeJournal.Append(InRecord);
+	if (OsWorld && TimerHandle_ChangeJournal.IsValid() == false)
+	{
+		TimerHandle_ChangeJournal = OsWorld->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_Core::Internal_FlushChangeJournal);
+	}
+}
+
+void UYetiOS_Core::StoreProgramSettings(const FName& InProgramIdentifier, TArray<uint8>&& InSettingsData)
+{
+	ProgramSettingsStore.Set(InProgramIdentifier, MoveTemp(InSettingsData));
+	if (OsWorld && TimerHandle_ProgramSettings.IsValid() == false)
+	{
+		OsWorld->GetTimerManager().SetTimer(TimerHandle_ProgramSettings, this, &UYetiOS_Core::Internal_FlushProgramSettings, PROGRAM_SETTINGS_WRITE_DELAY, false);
+	}
+}
+
+void UYetiOS_Core::NotifyFileRemoved(const class UYetiOS_FileBase* InFile)
+{
+	PendingContentIndexUpdates.Remove(const_cast<UYetiOS_FileBase*>(InFile));
+	PendingJournalContents.Remove(const_cast<UYetiOS_FileBase*>(InFile));
+	FileIndex.RemoveFile(InFile);
+}
+
+bool UYetiOS_Core::UnregisterProgramUpdate(const int32 InHandle)
+{
+	return ProgramScheduler.Unregister(InHandle);
+}
+
+float UYetiOS_Core::GetProgramUpdateBudget() const
+{
+	const float Local_CpuSpeed = (Device && Device->GetMotherboard()) ? Device->GetMotherboard()->GetTotalCpuSpeed() : SchedulerSettings.ReferenceCpuSpeedMHZ;
+	return static_cast<float>(FYetiOsProgramScheduler::CalculateFrameBudget(SchedulerSettings, Local_CpuSpeed) * 1000.0);
 }
 
 void UYetiOS_Core::SetActiveUser(FYetiOsUser InNewUser)
@@ -744,6 +1140,7 @@ bool UYetiOS_Core::ChangePassword(FYetiOsUser& InNewUser, FText InNewPassword)
 			{
 				InNewUser.Password = InNewPassword;
 				It.Password = InNewPassword;
+				Internal_JournalOsData();
 
 				const FText Title = FText::Format(LOCTEXT("YetiOS_UserPasswordChange", "{0} Password Change."), It.UserName);
 				static const FText Description = LOCTEXT("YetiOS_UserPasswordChangeDescription", "Password has been updated for this user.");
@@ -762,9 +1159,36 @@ void UYetiOS_Core::DestroyOS()
 {
 	FYetiOsNotificationManager::Destroy(NotificationManager);
 	NotificationManager = nullptr;
+	bIsNotificationFlushPending = false;
+	if (OsWorld)
+	{
+		OsWorld->GetTimerManager().ClearTimer(TimerHandle_ProgramScheduler);
+		OsWorld->GetTimerManager().ClearTimer(TimerHandle_SearchService);
+		OsWorld->GetTimerManager().ClearTimer(TimerHandle_FileIndex);
+		OsWorld->GetTimerManager().ClearTimer(TimerHandle_ChangeJournal);
+		OsWorld->GetTimerManager().ClearTimer(TimerHandle_ProgramSettings);
+	}
+	// Programs were closed before this so their settings are already in the store.
+	ProgramSettingsStore.Close();
+	// Changes since the last save stay in the journal and are replayed by the next load.
+	if (ChangeJournal.HasPendingRecords())
+	{
+		Internal_JournalDeviceData();
+		ChangeJournal.Flush();
+	}
+	ChangeJournal.Close();
+	ProgramScheduler.Reset();
+	SearchService.Reset();
+	FileIndex.Reset();
+	PendingContentIndexUpdates.Empty();
+	bIsFileIndexComplete = false;
+	SaveTreeLoadState.Reset();
+	SaveGameLoadStep = EYetiOsSaveGameLoadStep::Done;
+	ProgramPool.Reset();
+	ProcessTable.Reset();
 	Device = nullptr;
 	OsWidget = nullptr;
-	AllCreatedDirectories.Empty();
+	PathResolver.Invalidate();
 	if (RootDirectory && RootDirectory->IsValidLowLevel())
 	{
 		RootDirectory->DestroyDirectory();
@@ -822,26 +1246,11 @@ TSubclassOf<class UYetiOS_BaseProgram> UYetiOS_Core::Internal_FindProgramFromPac
 	TSubclassOf<class UYetiOS_BaseProgram> ProgramClassToReturn = nullptr;
 	if (HasRepositoryLibrary() && InProgramIdentifier.IsNone() == false)
 	{
-		TSet<FYetiOS_RepoProgram> AllProgramsFromRepo = ProgramsRepository->GetProgramsFromRepository();
-
-		printlog(FString::Printf(TEXT("Looking for %s from %i package(s) in repo."), *InProgramIdentifier.ToString(), AllProgramsFromRepo.Num()));
-		if (AllProgramsFromRepo.Num() > 0)
-		{			
-			for (const auto& It : AllProgramsFromRepo)
-			{
-				if (It.ProgramClass)
-				{
-					UYetiOS_BaseProgram* MyLoadedProgram = NewObject<UYetiOS_BaseProgram>(this, It.ProgramClass);
-					if (MyLoadedProgram->GetProgramIdentifierName().IsEqual(InProgramIdentifier))
-					{
-						printlog(FString::Printf(TEXT("Found %s from package repo."), *InProgramIdentifier.ToString()));
-						ProgramClassToReturn = MyLoadedProgram->GetClass();
-						MyLoadedProgram->ConditionalBeginDestroy();
-						MyLoadedProgram = nullptr;
-						break;
-					}
-				}
-			}
+		printlog(FString::Printf(TEXT("Looking for %s from %i package(s) in repo."), *InProgramIdentifier.ToString(), ProgramsRepository->GetProgramsFromRepository().Num()));
+		ProgramClassToReturn = ProgramsRepository->FindProgramClass(InProgramIdentifier);
+		if (ProgramClassToReturn)
+		{
+			printlog(FString::Printf(TEXT("Found %s from package repo."), *InProgramIdentifier.ToString()));
 		}
 	}
 
@@ -857,63 +1266,752 @@ void UYetiOS_Core::Internal_InstallStartupPrograms()
 {
 	if (HasRepositoryLibrary())
 	{
-		UYetiOS_AppIconWidget* OutIconWidget = nullptr;
-		TSet<FYetiOS_RepoProgram> AllProgramsFromRepo = ProgramsRepository->GetProgramsFromRepository();
-		FYetiOsError OutError;
-		for (const auto& It : AllProgramsFromRepo)
+		// Loading a save game installs startup programs together with saved programs in a batch it already opened.
+		const bool bOwnsBatch = bIsInstallBatchOpen == false && BeginInstallBatch();
+		for (const auto& It : ProgramsRepository->GetStartupProgramClasses())
+		{
+			AddToInstallBatch(It);
+		}
+
+		if (bOwnsBatch)
 		{
-			if (It.bInstallWithOS)
+			FYetiOsError OutError;
+			CommitInstallBatch(OutError);
+			if (OutError.ErrorDetailedException.IsEmpty() == false)
 			{
-				UYetiOS_BaseProgram* Local_InstalledProgram = InstallProgram(It.ProgramClass, OutError, OutIconWidget);
-				if (Local_InstalledProgram == nullptr)
-				{
-					printlog_warn(OutError.ErrorDetailedException.ToString());
-				}
+				printlog_warn(OutError.ErrorDetailedException.ToString());
 			}
 		}
 	}
 }
 
-void UYetiOS_Core::OnOperatingSystemLoadedFromSaveGame(const class UYetiOS_SaveGame*& LoadGameInstance, FYetiOsError& OutErrorMessage)
+void UYetiOS_Core::Internal_FlushNotifications()
 {
-	if (LoadGameInstance)
+	bIsNotificationFlushPending = false;
+	if (NotificationManager == nullptr)
+	{
+		return;
+	}
+
+	TArray<FYetiOsNotification> Local_Notifications;
+	NotificationManager->ConsumePendingNotifications(Local_Notifications);
+	if (OsWidget && Local_Notifications.Num() > 0)
+	{
+		OsWidget->ReceiveNotifications(Local_Notifications);
+	}
+}
+
+bool UYetiOS_Core::CanPoolProgram(const class UYetiOS_BaseProgram* InProgram) const
+{
+	return InProgram && InProgram->CanBePooled() && ProgramPoolSettings.bEnablePooling && OsWidget != nullptr;
+}
+
+bool UYetiOS_Core::AcquirePooledProgram(const UClass* InProgramClass, FYetiOsPooledProgram& OutEntry)
+{
+	return ProgramPool.Acquire(InProgramClass, OutEntry);
+}
+
+void UYetiOS_Core::ReleaseProgramToPool(const FYetiOsPooledProgram& InEntry)
+{
+	if (CanPoolProgram(InEntry.Program))
+	{
+		const int32 Local_MaxForClass = FMath::Max(ProgramPoolSettings.MaxPooledInstancesPerClass, InEntry.Program->GetPoolWarmCount());
+		ProgramPool.Release(InEntry, Local_MaxForClass, ProgramPoolSettings.MaxPooledPrograms);
+	}
+	else
+	{
+		FYetiOsProgramPool::DisposeEntry(InEntry);
+	}
+}
+
+int32 UYetiOS_Core::TrimProgramPool(const int32 InMaxToKeep /*= 0*/)
+{
+	return ProgramPool.Trim(InMaxToKeep);
+}
+
+void UYetiOS_Core::Internal_FlushFileIndexUpdates()
+{
+	TimerHandle_FileIndex.Invalidate();
+	const TSet<TWeakObjectPtr<UYetiOS_FileBase>> Local_Pending = MoveTemp(PendingContentIndexUpdates);
+	PendingContentIndexUpdates.Reset();
+	for (const TWeakObjectPtr<UYetiOS_FileBase>& It : Local_Pending)
+	{
+		// Deleted files were already removed from the index and must not be added back.
+		if (It.IsValid() && FileIndex.Contains(It.Get()))
+		{
+			Internal_IndexFileContent(It.Get());
+		}
+	}
+}
+
+void UYetiOS_Core::Internal_IndexFileContent(class UYetiOS_FileBase* InFile)
+{
+	if (FileIndexSettings.bIndexContent == false)
+	{
+		return;
+	}
+
+	TArray<FString> Local_Words;
+	FYetiOsFileIndex::SplitContentWords(InFile->GetFileContent(), static_cast<int64>(FileIndexSettings.MaxIndexedContentInKB) * 1024, FileIndexSettings.MinContentWordLength, Local_Words);
+	FileIndex.SetContentWords(InFile, Local_Words);
+}
+
+void UYetiOS_Core::Internal_FlushChangeJournal()
+{
+	TimerHandle_ChangeJournal.Invalidate();
+	if (ChangeJournal.IsOpen())
 	{
-		printlog_veryverbose("Loading OS save data...");
-		GetOwningDevice()->GetMotherboard()->GetHardDisk()->ConsumeSpace(InstallationSpaceInMB);
-		OsVersion = LoadGameInstance->GetOsLoadData().SaveLoad_OSVersion;
-		OsUsers = LoadGameInstance->GetOsLoadData().SaveLoad_OsUsers;
-		if (GetRootDirectory())
+		for (const TWeakObjectPtr<UYetiOS_FileBase>& It : PendingJournalContents)
 		{
-			TArray<FYetiOsDirectorySaveLoad> SavedDirectories = LoadGameInstance->GetDirectoriesData();
-			printlog_veryverbose(FString::Printf(TEXT("Loading %i saved directories..."), SavedDirectories.Num()));
-			for (const FYetiOsDirectorySaveLoad& It : SavedDirectories)
+			if (It.IsValid())
 			{
-				UYetiOS_DirectoryBase* LoadedDirectory = CreateDirectoryInPath(It.SaveLoad_DirPath, It.bSaveLoad_IsHidden, OutErrorMessage, It.SaveLoad_DirectoryName);
-				if (LoadedDirectory && It.SaveLoad_Files.Num() > 0)
+				ChangeJournal.Append(FYetiOsJournalRecord::MakeFileContentChanged(It.Get(), It->GetCreatedFileContent()));
+			}
+		}
+	}
+
+	PendingJournalContents.Empty();
+	if (ChangeJournal.HasPendingRecords() == false)
+	{
+		return;
+	}
+
+	// Changes of one frame share a single device data record since only the latest one is replayed.
+	Internal_JournalDeviceData();
+	ChangeJournal.Flush();
+
+	const int64 Local_CompactionThreshold = static_cast<int64>(Device->GetChangeJournalCompactionThresholdInKB()) * 1024;
+	if (Device->IsSaving() == false && Local_CompactionThreshold > 0 && ChangeJournal.GetSize() > Local_CompactionThreshold)
+	{
+		printlog_veryverbose(FString::Printf(TEXT("Change journal reached %lld byte(s). Compacting into save game..."), ChangeJournal.GetSize()));
+		Device->SaveDevice();
+	}
+}
+
+void UYetiOS_Core::Internal_JournalOsData()
+{
+	if (IsJournalingChanges())
+	{
+		FYetiOsOperatingSystemSaveLoad Local_OsData;
+		Local_OsData.SaveLoad_OSVersion = OsVersion;
+		Local_OsData.SaveLoad_OsUsers = OsUsers;
+
+		FYetiOsJournalRecord Local_Record(EYetiOsJournalOp::OsData);
+		Local_Record.SetStructData(FYetiOsOperatingSystemSaveLoad::StaticStruct(), &Local_OsData);
+		JournalChange(Local_Record);
+	}
+}
+
+void UYetiOS_Core::Internal_JournalDeviceData()
+{
+	FYetiOsDeviceSaveLoad Local_DeviceData;
+	Local_DeviceData.bSaveLoad_OsInstalled = Device->IsOperatingSystemInstalled();
+	Local_DeviceData.SaveLoad_RemainingSpace = Device->GetMotherboard()->GetHardDisk()->GetRemainingSpace();
+	const UYetiOS_PortableDevice* Local_PortableDevice = Cast<UYetiOS_PortableDevice>(Device);
+	Local_DeviceData.SaveLoad_BatteryLevel = Local_PortableDevice ? Local_PortableDevice->GetBatteryLevel() : 0.f;
+
+	FYetiOsJournalRecord Local_Record(EYetiOsJournalOp::DeviceData);
+	Local_Record.SetStructData(FYetiOsDeviceSaveLoad::StaticStruct(), &Local_DeviceData);
+	ChangeJournal.Append(Local_Record);
+}
+
+void UYetiOS_Core::Internal_FlushProgramSettings()
+{
+	TimerHandle_ProgramSettings.Invalidate();
+	if (ProgramSettingsStore.Flush() == false && OsWorld)
+	{
+		OsWorld->GetTimerManager().SetTimer(TimerHandle_ProgramSettings, this, &UYetiOS_Core::Internal_FlushProgramSettings, PROGRAM_SETTINGS_WRITE_DELAY, false);
+	}
+}
+
+void UYetiOS_Core::Internal_DetachFromWorld(TArray<FName>& OutRunningPrograms)
+{
+	FYetiOS_Lock::OnUserLocked.Remove(DelegateHandle_Lock);
+	FYetiOS_Lock::OnUserUnlocked.Remove(DelegateHandle_Unlock);
+
+	// Program widgets and windows belong to the player controller of the old world, so programs are closed and started again once attached.
+	OutRunningPrograms.Reset();
+	for (const UYetiOS_BaseProgram* It : GetRunningPrograms())
+	{
+		if (It->IsA<UYetiOS_BaseDialogProgram>() == false)
+		{
+			OutRunningPrograms.AddUnique(It->GetProgramIdentifierName());
+		}
+	}
+
+	CloseAllPrograms(true);
+	ProgramPool.Reset();
+	ProgramScheduler.Reset();
+	SearchService.Reset();
+	for (UYetiOS_DialogWidget* It : CurrentDialogWidgets)
+	{
+		It->RemoveFromParent();
+	}
+	CurrentDialogWidgets.Empty();
+
+	// Timers go away with the world so their pending work is done right now.
+	Internal_FlushFileIndexUpdates();
+	if (ChangeJournal.HasPendingRecords())
+	{
+		Internal_JournalDeviceData();
+		ChangeJournal.Flush();
+	}
+	ProgramSettingsStore.Flush();
+	if (OsWorld)
+	{
+		OsWorld->GetTimerManager().ClearAllTimersForObject(this);
+	}
+
+	TimerHandle_OsInstallation.Invalidate();
+	TimerHandle_ProgramScheduler.Invalidate();
+	TimerHandle_SearchService.Invalidate();
+	TimerHandle_FileIndex.Invalidate();
+	TimerHandle_ChangeJournal.Invalidate();
+	TimerHandle_ProgramSettings.Invalidate();
+
+	// Notifications stay in the notification manager and are delivered to the new OS widget.
+	bIsNotificationFlushPending = false;
+
+	for (const UYetiOS_DirectoryBase* It : GetAllCreatedDirectories())
+	{
+		const_cast<UYetiOS_DirectoryBase*>(It)->ReleaseIconWidgets();
+	}
+
+	for (UYetiOS_BaseProgram* It : InstalledPrograms.GetPrograms())
+	{
+		It->ReleaseProgramIconWidget();
+	}
+
+	if (OsWidget)
+	{
+		OsWidget->Internal_UnbindThemeChanged();
+		OsWidget = nullptr;
+	}
+
+	if (Taskbar)
+	{
+		// Taskbar is created again with the same name, so the old one has to move out of the way.
+		Taskbar->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional | REN_ForceNoResetLoaders);
+		Taskbar->MarkPendingKill();
+		Taskbar = nullptr;
+	}
+
+	OsWorld = nullptr;
+	printlog(FString::Printf(TEXT("%s detached from world with %i running program(s)."), *OsName.ToString(), OutRunningPrograms.Num()));
+}
+
+void UYetiOS_Core::Internal_AttachToWorld(const TArray<FName>& InRunningPrograms)
+{
+	OsWorld = Device->GetWorld();
+	UYetiOS_OsWidget::Internal_CreateOsWidget(this);
+	UYetiOS_Taskbar::CreateTaskbar(this);
+
+	DelegateHandle_Lock = FYetiOS_Lock::OnUserLocked.AddUObject(this, &UYetiOS_Core::ListenForLock);
+	DelegateHandle_Unlock = FYetiOS_Lock::OnUserUnlocked.AddUObject(this, &UYetiOS_Core::ListenForUnlock);
+
+	for (UYetiOS_BaseProgram* It : InstalledPrograms.GetPrograms())
+	{
+		FYetiOsError Local_IconError;
+		UYetiOS_AppIconWidget* Local_IconWidget = UYetiOS_AppIconWidget::CreateProgramIconWidget(It, Local_IconError);
+		if (Local_IconWidget && It->CanAddToDesktop())
+		{
+			OsWidget->AddIconWidgetToDesktop(Local_IconWidget);
+		}
+	}
+
+	OsWidget->ResumeOS();
+	Internal_FlushNotifications();
+
+	for (const FName& It : InRunningPrograms)
+	{
+		FYetiOsError Local_Error;
+		if (StartProgram(It, Local_Error) == false)
+		{
+			printlog_warn(FString::Printf(TEXT("Failed to start %s again after attaching. %s"), *It.ToString(), *Local_Error.ErrorException.ToString()));
+		}
+	}
+
+	// Changes made while detached had no timer to write them.
+	if (ChangeJournal.HasPendingRecords())
+	{
+		TimerHandle_ChangeJournal = OsWorld->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_Core::Internal_FlushChangeJournal);
+	}
+
+	if (ProgramSettingsStore.IsDirty() || ProgramSettingsStore.IsWriting())
+	{
+		OsWorld->GetTimerManager().SetTimer(TimerHandle_ProgramSettings, this, &UYetiOS_Core::Internal_FlushProgramSettings, PROGRAM_SETTINGS_WRITE_DELAY, false);
+	}
+
+	printlog(FString::Printf(TEXT("%s attached to world %s."), *OsName.ToString(), *OsWorld->GetName()));
+}
+
+void UYetiOS_Core::Internal_OpenChangeJournal(const class UYetiOS_SaveGame* InLoadGameInstance)
+{
+	ChangeJournal.Close();
+	const AYetiOS_DeviceManagerActor* Local_DeviceManager = Cast<AYetiOS_DeviceManagerActor>(Device->GetOuter());
+	if (Device->IsChangeJournalEnabled() == false || Device->GetSaveGameClass() == nullptr || Local_DeviceManager == nullptr || Local_DeviceManager->CanSaveGame() == false)
+	{
+		return;
+	}
+
+	const FString Local_JournalDirectory = FPaths::Combine(UYetiOS_BaseDevice::Internal_GetSavePath(Device), *FString("Journal"));
+	// Journal belongs to the save slot of this device only, so devices replay their own changes.
+	const FString Local_JournalName = UYetiOS_SaveGame::GetDeviceSlotName(Device);
+	if (InLoadGameInstance == nullptr)
+	{
+		// Journal left by an earlier run has no save game to be replayed on top of.
+		ChangeJournal.Open(Local_JournalDirectory, Local_JournalName, 0);
+		ChangeJournal.DeleteGenerationsBefore(MAX_uint32);
+		return;
+	}
+
+	const uint32 Local_SavedGeneration = InLoadGameInstance->GetJournalGeneration();
+	TArray<FYetiOsJournalRecord> Local_Records;
+	ChangeJournal.Open(Local_JournalDirectory, Local_JournalName, Local_SavedGeneration);
+	const uint32 Local_LastGeneration = ChangeJournal.ReadRecords(Local_SavedGeneration, Local_Records);
+
+	// Journal stays closed while replaying so replayed changes are not journaled again.
+	ChangeJournal.Close();
+	if (Local_Records.Num() > 0)
+	{
+		printlog(FString::Printf(TEXT("Replaying %i journaled change(s)..."), Local_Records.Num()));
+		Internal_ReplayChangeJournal(Local_Records);
+	}
+
+	// Replayed generations are kept until a save game contains them. Generations older than the save game were already compacted.
+	ChangeJournal.Open(Local_JournalDirectory, Local_JournalName, Local_LastGeneration + 1);
+	ChangeJournal.DeleteGenerationsBefore(Local_SavedGeneration);
+}
+
+void UYetiOS_Core::Internal_ReplayChangeJournal(const TArray<FYetiOsJournalRecord>& InRecords)
+{
+	FYetiOsError Local_ErrorMessage;
+	const FYetiOsJournalRecord* Local_DeviceDataRecord = nullptr;
+	int32 Local_SkippedCount = 0;
+	BeginInstallBatch();
+	for (const FYetiOsJournalRecord& It : InRecords)
+	{
+		bool bLocal_Applied = false;
+		UYetiOS_DirectoryBase* Local_Directory = nullptr;
+		switch (It.Op)
+		{
+			case EYetiOsJournalOp::DirectoryCreated:
+				if (DirectoryExists(It.GetString(0), Local_Directory))
+				{
+					UClass* Local_Class = FSoftClassPath(It.GetString(2)).TryLoadClass<UObject>();
+					TSubclassOf<UYetiOS_DirectoryBase> Local_DirectoryClass = Local_Class && Local_Class->IsChildOf<UYetiOS_DirectoryBase>() ? Local_Class : TemplateDirectory.Get();
+					Local_Directory->Materialize();
+					bLocal_Applied = Local_Directory->Internal_LoadChildDirectory(Local_DirectoryClass, It.GetString(1), (It.Flags & EYetiOsSaveRecordFlags::Hidden) != 0) != nullptr;
+				}
+				break;
+			case EYetiOsJournalOp::DirectoryRenamed:
+				if (DirectoryExists(It.GetString(0), Local_Directory))
+				{
+					bLocal_Applied = Local_Directory->RenameDirectory(FText::FromString(It.GetString(1)), Local_ErrorMessage);
+				}
+				break;
+			case EYetiOsJournalOp::FileCreated:
+				if (DirectoryExists(It.GetString(0), Local_Directory))
+				{
+					UClass* Local_Class = FSoftClassPath(It.GetString(1)).TryLoadClass<UObject>();
+					if (Local_Class && Local_Class->IsChildOf<UYetiOS_FileBase>())
+					{
+						Local_Directory->Materialize();
+						NotifyFileChanged(Local_Directory->Internal_LoadFile(Local_Class, FText::FromString(It.GetString(2)), FText::FromString(It.GetString(3)), (It.Flags & EYetiOsSaveRecordFlags::Hidden) != 0));
+						bLocal_Applied = true;
+					}
+				}
+				break;
+			case EYetiOsJournalOp::FileDeleted:
+				if (DirectoryExists(It.GetString(0), Local_Directory))
+				{
+					UYetiOS_FileBase* Local_File = Local_Directory->FindFileByName(FText::FromString(It.GetString(1)), FText::FromString(It.GetString(2)));
+					bLocal_Applied = Local_File && Local_Directory->DeleteFileFromDirectory(Local_File, Local_ErrorMessage, true);
+				}
+				break;
+			case EYetiOsJournalOp::FileRenamed:
+				if (DirectoryExists(It.GetString(0), Local_Directory))
+				{
+					UYetiOS_FileBase* Local_File = Local_Directory->FindFileByName(FText::FromString(It.GetString(1)), FText::FromString(It.GetString(2)));
+					bLocal_Applied = Local_File && Local_File->RenameFile(FText::FromString(It.GetString(3)), FText::FromString(It.GetString(4)), Local_ErrorMessage);
+				}
+				break;
+			case EYetiOsJournalOp::FileContentChanged:
+				if (DirectoryExists(It.GetString(0), Local_Directory))
+				{
+					UYetiOS_FileBase* Local_File = Local_Directory->FindFileByName(FText::FromString(It.GetString(1)), FText::FromString(It.GetString(2)));
+					UYetiOS_FileContent* Local_Content = Local_File ? Local_File->GetFileContent() : nullptr;
+					if (Local_Content)
+					{
+						// Space of the content is part of the latest device data record applied below.
+						Local_Content->Internal_LoadBytes(It.Data);
+						NotifyFileContentChanged(Local_File);
+						bLocal_Applied = true;
+					}
+				}
+				break;
+			case EYetiOsJournalOp::ProgramInstalled:
+				// Programs that are already installed are skipped by the install batch.
+				bLocal_Applied = AddToInstallBatch(FSoftClassPath(It.GetString(0)).TryLoadClass<UYetiOS_BaseProgram>());
+				break;
+			case EYetiOsJournalOp::OsData:
 				{
-					printlog_veryverbose(FString::Printf(TEXT("Loading %i file(s) from save data for %s..."), It.SaveLoad_Files.Num(), *LoadedDirectory->GetDirectoryName().ToString()));
-					for (const auto& LoadFileIt : It.SaveLoad_Files)
+					FYetiOsOperatingSystemSaveLoad Local_OsData;
+					if (It.GetStructData(FYetiOsOperatingSystemSaveLoad::StaticStruct(), &Local_OsData))
 					{
-						UYetiOS_FileBase* OutFile;
-						LoadedDirectory->CreateNewFileByClass(LoadFileIt->GetClass(), OutFile, OutErrorMessage);
+						OsVersion = Local_OsData.SaveLoad_OSVersion;
+						OsUsers = Local_OsData.SaveLoad_OsUsers;
+						bLocal_Applied = true;
 					}
 				}
+				break;
+			case EYetiOsJournalOp::DeviceData:
+				// Only the latest device data matters. It is applied once journaled programs took their space.
+				Local_DeviceDataRecord = &It;
+				bLocal_Applied = true;
+				break;
+			default:
+				break;
+		}
+
+		if (bLocal_Applied == false)
+		{
+			Local_SkippedCount++;
+		}
+	}
+
+	CommitInstallBatch(Local_ErrorMessage, false);
+
+	FYetiOsDeviceSaveLoad Local_DeviceData;
+	if (Local_DeviceDataRecord && Local_DeviceDataRecord->GetStructData(FYetiOsDeviceSaveLoad::StaticStruct(), &Local_DeviceData))
+	{
+		GetOwningDevice()->GetMotherboard()->GetHardDisk()->Internal_UpdateRemainingSpace(Local_DeviceData.SaveLoad_RemainingSpace);
+	}
+
+	if (Local_SkippedCount > 0)
+	{
+		printlog_warn(FString::Printf(TEXT("Skipped %i journaled change(s) that no longer apply."), Local_SkippedCount));
+	}
+}
+
+void UYetiOS_Core::Internal_BeginJournalCompaction()
+{
+	if (ChangeJournal.IsOpen())
+	{
+		// Save game is captured right after this, so it contains every change of older generations.
+		CompactingJournalGeneration = ChangeJournal.Rotate();
+	}
+}
+
+void UYetiOS_Core::Internal_EndJournalCompaction(const bool bWasSuccessful)
+{
+	if (bWasSuccessful && ChangeJournal.IsOpen())
+	{
+		ChangeJournal.DeleteGenerationsBefore(CompactingJournalGeneration);
+		printlog_veryverbose(FString::Printf(TEXT("Compacted change journal. %lld byte(s) left."), ChangeJournal.GetSize()));
+	}
+}
+
+UClass* UYetiOS_Core::Internal_ResolveSavedClass(const struct FYetiOsSaveTree& InSaveTree, const int32 InClassIndex)
+{
+	if (InClassIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	// Many records share a class so each class path is resolved only once. Missing classes are cached as explicitly null.
+	if (const TWeakObjectPtr<UClass>* Local_Found = SaveTreeLoadState.ClassCache.Find(InClassIndex))
+	{
+		if (Local_Found->IsValid() || Local_Found->IsExplicitlyNull())
+		{
+			return Local_Found->Get();
+		}
+	}
+
+	UClass* Local_Class = FSoftClassPath(InSaveTree.Strings.Get(InClassIndex)).TryLoadClass<UObject>();
+	SaveTreeLoadState.ClassCache.Add(InClassIndex, Local_Class);
+	return Local_Class;
+}
+
+void UYetiOS_Core::Internal_LoadSavedDirectory(const struct FYetiOsSaveTree& InSaveTree)
+{
+	const int32 Local_RecordIndex = SaveTreeLoadState.LoadedDirectories.Num();
+	const FYetiOsSaveDirectoryRecord& Local_Record = InSaveTree.Directories[Local_RecordIndex];
+	UYetiOS_DirectoryBase* Local_Directory = nullptr;
+	if (Local_Record.ParentIndex == INDEX_NONE)
+	{
+		Local_Directory = GetRootDirectory();
+	}
+	else if (Local_Record.ParentIndex < Local_RecordIndex && SaveTreeLoadState.LoadedDirectories[Local_Record.ParentIndex])
+	{
+		// Records are sorted by depth so the parent of every record is already loaded when it is reached.
+		UClass* Local_Class = Internal_ResolveSavedClass(InSaveTree, Local_Record.ClassIndex);
+		TSubclassOf<UYetiOS_DirectoryBase> Local_DirectoryClass = Local_Class && Local_Class->IsChildOf<UYetiOS_DirectoryBase>() ? Local_Class : TemplateDirectory.Get();
+		Local_Directory = SaveTreeLoadState.LoadedDirectories[Local_Record.ParentIndex]->Internal_LoadChildDirectory(Local_DirectoryClass, InSaveTree.Strings.Get(Local_Record.NameIndex), (Local_Record.Flags & EYetiOsSaveRecordFlags::Hidden) != 0);
+	}
+	else
+	{
+		printlog_error(FString::Printf(TEXT("Skipped saved directory %s. Its parent was not loaded before it."), *InSaveTree.Strings.Get(Local_Record.NameIndex)));
+	}
+
+	const int32 Local_NumChildDirectories = SaveTreeLoadState.NumChildDirectories[Local_RecordIndex];
+	const int32 Local_NumFiles = SaveTreeLoadState.NumFiles[Local_RecordIndex];
+	const bool bLocal_IsComplete = (Local_Record.Flags & EYetiOsSaveRecordFlags::Complete) != 0;
+	if (Local_Directory && (bLocal_IsComplete || Local_NumChildDirectories > 0 || Local_NumFiles > 0))
+	{
+		if (Local_Directory->Internal_ReserveForLoad(Local_NumChildDirectories, Local_NumFiles, bLocal_IsComplete))
+		{
+			SaveTreeLoadState.DirectoriesToReconcile.Add(Local_Directory);
+		}
+	}
+
+	SaveTreeLoadState.LoadedDirectories.Add(Local_Directory);
+}
+
+void UYetiOS_Core::Internal_LoadSavedFile(const struct FYetiOsSaveTree& InSaveTree)
+{
+	const int32 Local_RecordIndex = SaveTreeLoadState.LoadedFiles.Num();
+	const FYetiOsSaveFileRecord& Local_Record = InSaveTree.Files[Local_RecordIndex];
+	UYetiOS_FileBase* Local_File = nullptr;
+	UYetiOS_DirectoryBase* Local_Directory = SaveTreeLoadState.LoadedDirectories.IsValidIndex(Local_Record.DirectoryIndex) ? SaveTreeLoadState.LoadedDirectories[Local_Record.DirectoryIndex] : nullptr;
+	UClass* Local_Class = Internal_ResolveSavedClass(InSaveTree, Local_Record.ClassIndex);
+	if (Local_Directory && Local_Class && Local_Class->IsChildOf<UYetiOS_FileBase>())
+	{
+		Local_File = Local_Directory->Internal_LoadFile(Local_Class, FText::FromString(InSaveTree.Strings.Get(Local_Record.NameIndex)), FText::FromString(InSaveTree.Strings.Get(Local_Record.ExtensionIndex)), (Local_Record.Flags & EYetiOsSaveRecordFlags::Hidden) != 0);
+	}
+	else
+	{
+		printlog_error(FString::Printf(TEXT("Failed to load file %s.%s."), *InSaveTree.Strings.Get(Local_Record.NameIndex), *InSaveTree.Strings.Get(Local_Record.ExtensionIndex)));
+	}
+
+	// Content records are in file record order, so only the next ones can belong to this file.
+	while (InSaveTree.Contents.IsValidIndex(SaveTreeLoadState.NextContentRecord) && InSaveTree.Contents[SaveTreeLoadState.NextContentRecord].FileIndex <= Local_RecordIndex)
+	{
+		const FYetiOsSaveFileContentRecord& Local_ContentRecord = InSaveTree.Contents[SaveTreeLoadState.NextContentRecord++];
+		UYetiOS_FileContent* Local_Content = Local_File && Local_ContentRecord.FileIndex == Local_RecordIndex ? Local_File->GetFileContent() : nullptr;
+		if (Local_Content)
+		{
+			Local_Content->Internal_LoadBytes(Local_ContentRecord.Bytes);
+		}
+	}
+
+	SaveTreeLoadState.LoadedFiles.Add(Local_File);
+}
+
+void UYetiOS_Core::Internal_RemoveUnsavedFiles()
+{
+	if (SaveTreeLoadState.DirectoriesToReconcile.Num() == 0)
+	{
+		return;
+	}
+
+	// Default files that are missing from a complete directory were deleted before saving. Journal is not open yet so this is not journaled.
+	const TSet<UYetiOS_FileBase*> Local_SavedFiles(SaveTreeLoadState.LoadedFiles);
+	int32 Local_RemovedCount = 0;
+	FYetiOsError Local_ErrorMessage;
+	for (UYetiOS_DirectoryBase* It : SaveTreeLoadState.DirectoriesToReconcile)
+	{
+		for (UYetiOS_FileBase* FileIt : It->GetDirectoryFiles())
+		{
+			if (Local_SavedFiles.Contains(FileIt) == false && It->DeleteFileFromDirectory(FileIt, Local_ErrorMessage, true))
+			{
+				Local_RemovedCount++;
 			}
 		}
+	}
+
+	printlog_veryverbose(FString::Printf(TEXT("Removed %i default file(s) that were deleted before saving."), Local_RemovedCount));
+}
+
+void UYetiOS_Core::Internal_LoadFileIndex(const struct FYetiOsSaveTree& InSaveTree, const TArray<class UYetiOS_FileBase*>& InLoadedFiles)
+{
+	if (FileIndexSettings.bEnableFileIndex == false || InSaveTree.FileIndex.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FString> Local_NameWords, Local_ContentWords;
+	for (const FYetiOsSaveFileIndexRecord& It : InSaveTree.FileIndex)
+	{
+		UYetiOS_FileBase* Local_File = InLoadedFiles.IsValidIndex(It.FileIndex) ? InLoadedFiles[It.FileIndex] : nullptr;
+		if (Local_File == nullptr)
+		{
+			continue;
+		}
+
+		Local_NameWords.Reset(It.NameWords.Num());
+		for (const int32& WordIt : It.NameWords)
+		{
+			Local_NameWords.Add(InSaveTree.Strings.Get(WordIt));
+		}
 
-		Internal_InstallStartupPrograms();
-		TArray<FYetiOsProgramSaveLoad> SavedPrograms = LoadGameInstance->GetProgramData();
-		printlog_veryverbose(FString::Printf(TEXT("Loading %i saved programs..."), SavedPrograms.Num()));
-		for (const auto& It : SavedPrograms)
+		Local_ContentWords.Reset(It.ContentWords.Num());
+		for (const int32& WordIt : It.ContentWords)
 		{
-			UYetiOS_AppIconWidget* OutWidget;
-			InstallProgram(It.SaveLoad_ProgramClass, OutErrorMessage, OutWidget);
+			Local_ContentWords.Add(InSaveTree.Strings.Get(WordIt));
 		}
 
-		GetOwningDevice()->GetMotherboard()->GetHardDisk()->Internal_UpdateRemainingSpace(LoadGameInstance->GetDeviceLoadData().SaveLoad_RemainingSpace);
+		FileIndex.SetNameWords(Local_File, Local_NameWords);
+		FileIndex.SetContentWords(Local_File, Local_ContentWords);
+	}
+
+	// Files that were not part of the saved index still need to be indexed. Directories that are not materialized index their files when they are.
+	for (const UYetiOS_DirectoryBase* It : GetAllCreatedDirectories())
+	{
+		if (It->IsMaterialized() == false)
+		{
+			continue;
+		}
+
+		for (UYetiOS_FileBase* FileIt : It->GetDirectoryFiles())
+		{
+			if (FileIndex.Contains(FileIt) == false)
+			{
+				NotifyFileChanged(FileIt);
+				Internal_IndexFileContent(FileIt);
+			}
+		}
+	}
+
+	bIsFileIndexComplete = true;
+	printlog_veryverbose(FString::Printf(TEXT("Loaded file index with %i file(s) and %i word(s)."), FileIndex.Num(), FileIndex.NumWords()));
+}
+
+void UYetiOS_Core::Internal_TickSearchService()
+{
+	TimerHandle_SearchService.Invalidate();
+	if (OsWorld == nullptr || SearchService.HasSearches() == false)
+	{
+		return;
+	}
+
+	SearchService.Tick(GetProgramUpdateBudget() / 1000.0);
+	if (SearchService.HasSearches() && TimerHandle_SearchService.IsValid() == false)
+	{
+		TimerHandle_SearchService = OsWorld->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_Core::Internal_TickSearchService);
+	}
+}
+
+void UYetiOS_Core::Internal_TickProgramScheduler()
+{
+	TimerHandle_ProgramScheduler.Invalidate();
+	if (OsWorld == nullptr || ProgramScheduler.HasUpdates() == false)
+	{
+		return;
+	}
+
+	ProgramScheduler.Tick(OsWorld->GetDeltaSeconds(), GetProgramUpdateBudget() / 1000.0);
+	if (ProgramScheduler.HasUpdates() && TimerHandle_ProgramScheduler.IsValid() == false)
+	{
+		TimerHandle_ProgramScheduler = OsWorld->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_Core::Internal_TickProgramScheduler);
 	}
 }
 
+void UYetiOS_Core::OnOperatingSystemLoadedFromSaveGame(const class UYetiOS_SaveGame*& LoadGameInstance, FYetiOsError& OutErrorMessage)
+{
+	if (LoadGameInstance)
+	{
+		BeginLoadFromSaveGame(LoadGameInstance);
+		ContinueLoadFromSaveGame(LoadGameInstance, 0.0, OutErrorMessage);
+	}
+	else
+	{
+		Internal_OpenChangeJournal(nullptr);
+	}
+}
+
+void UYetiOS_Core::BeginLoadFromSaveGame(const class UYetiOS_SaveGame* LoadGameInstance)
+{
+	check(LoadGameInstance);
+	printlog_veryverbose("Loading OS save data...");
+	GetOwningDevice()->GetMotherboard()->GetHardDisk()->ConsumeSpace(InstallationSpaceInMB);
+	OsVersion = LoadGameInstance->GetOsLoadData().SaveLoad_OSVersion;
+	OsUsers = LoadGameInstance->GetOsLoadData().SaveLoad_OsUsers;
+
+	SaveTreeLoadState.Begin(LoadGameInstance->GetSaveTree());
+	SaveGameLoadStep = EYetiOsSaveGameLoadStep::Directories;
+}
+
+const bool UYetiOS_Core::ContinueLoadFromSaveGame(const class UYetiOS_SaveGame* LoadGameInstance, const double InTimeBudgetSeconds, FYetiOsError& OutErrorMessage)
+{
+	const FYetiOsSaveTree& SaveTree = LoadGameInstance->GetSaveTree();
+	const double Local_EndTime = FPlatformTime::Seconds() + InTimeBudgetSeconds;
+	do
+	{
+		switch (SaveGameLoadStep)
+		{
+			case EYetiOsSaveGameLoadStep::Directories:
+				if (SaveTreeLoadState.LoadedDirectories.Num() < SaveTree.Directories.Num())
+				{
+					Internal_LoadSavedDirectory(SaveTree);
+				}
+				else
+				{
+					SaveGameLoadStep = EYetiOsSaveGameLoadStep::Files;
+				}
+				break;
+			case EYetiOsSaveGameLoadStep::Files:
+				if (SaveTreeLoadState.LoadedFiles.Num() < SaveTree.Files.Num())
+				{
+					Internal_LoadSavedFile(SaveTree);
+				}
+				else
+				{
+					Internal_RemoveUnsavedFiles();
+					printlog_veryverbose(FString::Printf(TEXT("Loaded %i directories and %i file(s)."), SaveTree.Directories.Num(), SaveTree.Files.Num()));
+					SaveGameLoadStep = EYetiOsSaveGameLoadStep::Programs;
+				}
+				break;
+			case EYetiOsSaveGameLoadStep::Programs:
+				{
+					const bool bOwnsBatch = BeginInstallBatch();
+					Internal_InstallStartupPrograms();
+					const TArray<FYetiOsProgramSaveLoad>& SavedPrograms = LoadGameInstance->GetProgramData();
+					printlog_veryverbose(FString::Printf(TEXT("Loading %i saved programs..."), SavedPrograms.Num()));
+					for (const auto& It : SavedPrograms)
+					{
+						AddToInstallBatch(It.SaveLoad_ProgramClass);
+					}
+
+					if (bOwnsBatch)
+					{
+						CommitInstallBatch(OutErrorMessage, false);
+					}
+
+					SaveGameLoadStep = EYetiOsSaveGameLoadStep::FileIndex;
+				}
+				break;
+			case EYetiOsSaveGameLoadStep::FileIndex:
+				Internal_LoadFileIndex(SaveTree, SaveTreeLoadState.LoadedFiles);
+				GetOwningDevice()->GetMotherboard()->GetHardDisk()->Internal_UpdateRemainingSpace(LoadGameInstance->GetDeviceLoadData().SaveLoad_RemainingSpace);
+				SaveTreeLoadState.Reset();
+				SaveGameLoadStep = EYetiOsSaveGameLoadStep::Journal;
+				break;
+			case EYetiOsSaveGameLoadStep::Journal:
+				Internal_OpenChangeJournal(LoadGameInstance);
+				SaveGameLoadStep = EYetiOsSaveGameLoadStep::Done;
+				break;
+			default:
+				break;
+		}
+	} while (SaveGameLoadStep != EYetiOsSaveGameLoadStep::Done && (InTimeBudgetSeconds <= 0.0 || FPlatformTime::Seconds() < Local_EndTime));
+
+	return SaveGameLoadStep == EYetiOsSaveGameLoadStep::Done;
+}
+
+const float UYetiOS_Core::GetSaveGameLoadProgress(const class UYetiOS_SaveGame* LoadGameInstance) const
+{
+	if (SaveGameLoadStep == EYetiOsSaveGameLoadStep::Done || LoadGameInstance == nullptr)
+	{
+		return 1.f;
+	}
+
+	const FYetiOsSaveTree& SaveTree = LoadGameInstance->GetSaveTree();
+	const int32 Local_NumRecords = SaveTree.Directories.Num() + SaveTree.Files.Num() + 3;
+	const int32 Local_NumLoaded = SaveTreeLoadState.LoadedDirectories.Num() + SaveTreeLoadState.LoadedFiles.Num() + (SaveGameLoadStep == EYetiOsSaveGameLoadStep::FileIndex ? 1 : SaveGameLoadStep == EYetiOsSaveGameLoadStep::Journal ? 2 : 0);
+	return static_cast<float>(Local_NumLoaded) / static_cast<float>(Local_NumRecords);
+}
+
 void UYetiOS_Core::NotifyBatteryLevelChange(const float& CurrentBatteryLevel)
 {
 	K2_OnBatteryLevelChanged(CurrentBatteryLevel);
@@ -937,13 +2035,10 @@ const bool UYetiOS_Core::IsProgramInstalled(const FName& InProgramIdentifier, UY
 	
 	if (InProgramIdentifier.IsNone() == false)
 	{
-		for (const auto& It : InstalledPrograms)
+		OutFoundProgram = InstalledPrograms.FindByIdentifier(InProgramIdentifier);
+		if (OutFoundProgram)
 		{
-			if (It->GetProgramIdentifierName().IsEqual(InProgramIdentifier))
-			{
-				OutFoundProgram = It;
-				return true;
-			}
+			return true;
 		}
 
 		OutErrorMessage.ErrorCode = LOCTEXT("YetiOS_NoProgramInstalledError", "PROGRAM_NOT_FOUND");
@@ -965,14 +2060,46 @@ bool UYetiOS_Core::IsProgramInstalled(const FName& InProgramIdentifier) const
 	return IsProgramInstalled(InProgramIdentifier, DummyProgram, DummyError);
 }
 
-void UYetiOS_Core::AddToCreatedDirectories(const UYetiOS_DirectoryBase* InDirectory)
+void UYetiOS_Core::AddToCreatedDirectories(UYetiOS_DirectoryBase* InDirectory)
 {
-	AllCreatedDirectories.AddUnique(InDirectory);
+	if (RootDirectory)
+	{
+		RootDirectory->RegisterDirectory(InDirectory);
+	}
+}
+
+const TArray<const UYetiOS_DirectoryBase*> UYetiOS_Core::GetAllCreatedDirectories() const
+{
+	TArray<const UYetiOS_DirectoryBase*> ReturnResult;
+	if (RootDirectory)
+	{
+		RootDirectory->GetDirectoryRegistry().GetAllDirectories(ReturnResult);
+	}
+
+	return ReturnResult;
+}
+
+UYetiOS_DirectoryBase* UYetiOS_Core::FindDirectoryByID(const int32 InDirectoryID) const
+{
+	return RootDirectory ? RootDirectory->GetDirectoryRegistry().Find(InDirectoryID) : nullptr;
+}
+
+void UYetiOS_Core::InvalidateResolvedPaths()
+{
+	PathResolver.Invalidate();
+}
+
+void UYetiOS_Core::MaterializeAllDirectories() const
+{
+	if (RootDirectory)
+	{
+		RootDirectory->Materialize(true);
+	}
 }
 
 bool UYetiOS_Core::HasRepositoryLibrary() const
 {
-	return ProgramsRepository != nullptr && ProgramsRepository->GetProgramsFromRepository().Num() > 0;
+	return ProgramsRepository != nullptr && ProgramsRepository->HasPrograms();
 }
 
 UYetiOS_DirectoryRoot* UYetiOS_Core::GetRootDirectory()
@@ -982,7 +2109,7 @@ UYetiOS_DirectoryRoot* UYetiOS_Core::GetRootDirectory()
 		RootDirectory = NewObject<UYetiOS_DirectoryRoot>(this, Device->GetRootDirectoryClass());
 		AddToCreatedDirectories(RootDirectory);
 		FYetiOsError OutError;
-		RootDirectory->CreateNativeChildDirectories(this, OutError, true);
+		RootDirectory->CreateNativeChildDirectories(this, OutError, true, false);
 	}
 
 	return RootDirectory;
@@ -990,32 +2117,41 @@ UYetiOS_DirectoryRoot* UYetiOS_Core::GetRootDirectory()
 
 const bool UYetiOS_Core::DirectoryExists(const FString& InDirectoryPath, UYetiOS_DirectoryBase*& OutFoundDirectory) const
 {
+	OutFoundDirectory = nullptr;
 	if (RootDirectory == nullptr)
 	{
 		return false;
 	}
 
-	if (RootDirectory->GetDirectoryName().ToLower().ToString() == InDirectoryPath.ToLower())
+	if (RootDirectory->GetDirectoryName().ToString().Equals(InDirectoryPath, ESearchCase::IgnoreCase))
 	{
+		OutFoundDirectory = RootDirectory;
 		return true;
 	}
 
-	TArray<FString> OutPathArray;
-	const FString DirectoryString = InDirectoryPath;
-	DirectoryString.ParseIntoArray(OutPathArray, *UYetiOS_Core::PATH_DELIMITER, true);
-	const int32 ArrayLength = OutPathArray.Num() - 1;
+	const FString Local_NormalizedPath = FYetiOsPathResolver::Normalize(InDirectoryPath);
+	OutFoundDirectory = PathResolver.Find(Local_NormalizedPath);
+	if (OutFoundDirectory)
+	{
+		return true;
+	}
+
+	TArray<FName> Local_Components;
+	FYetiOsPathResolver::Split(Local_NormalizedPath, Local_Components);
 
 	UYetiOS_DirectoryBase* MyCurrentDirectory = RootDirectory;
-	for (int32 i = 0; i < ArrayLength; ++i)
+	for (const FName& It : Local_Components)
 	{
-		MyCurrentDirectory = MyCurrentDirectory->GetChildDirectoryByName(FName(*OutPathArray[i]), false);
+		MyCurrentDirectory = MyCurrentDirectory->GetChildDirectoryByName(It, false);
 		if (MyCurrentDirectory == nullptr)
 		{
 			return false;
 		}
 	}
-	
-	return MyCurrentDirectory->HasChildDirectory(FText::FromString(OutPathArray.Last()), OutFoundDirectory);
+
+	PathResolver.Add(Local_NormalizedPath, MyCurrentDirectory);
+	OutFoundDirectory = MyCurrentDirectory;
+	return true;
 }
 
 const bool UYetiOS_Core::DirectoryExists(const FString& InDirectoryPath) const
@@ -1026,22 +2162,22 @@ const bool UYetiOS_Core::DirectoryExists(const FString& InDirectoryPath) const
 
 UYetiOS_DirectoryBase* UYetiOS_Core::CreateDirectoryInPath(const FString& InDirectoryPath, const bool bHidden, FYetiOsError& OutErrorMessage, const FText& InDirName /*= FText::GetEmpty()*/)
 {
-	TArray<FString> OutPathArray;
+	TArray<FName> OutPathArray;
 	const FString DirectoryString = InDirectoryPath;
-	DirectoryString.ParseIntoArray(OutPathArray, *UYetiOS_Core::PATH_DELIMITER, true);
+	FYetiOsPathResolver::Split(DirectoryString, OutPathArray);
 	const int32 ArrayLength = OutPathArray.Num();
 
 	UYetiOS_DirectoryBase* MyCurrentDirectory = RootDirectory;
 	for (int32 i = 0; i < ArrayLength; ++i)
 	{		
-		UYetiOS_DirectoryBase* ExistingDir = MyCurrentDirectory->GetChildDirectoryByName(FName(*OutPathArray[i]), false);
+		UYetiOS_DirectoryBase* ExistingDir = MyCurrentDirectory->GetChildDirectoryByName(OutPathArray[i], false);
 		if (ExistingDir == nullptr)
 		{			
 			ExistingDir = MyCurrentDirectory->CreateChildDirectory(this, TemplateDirectory, OutErrorMessage, InDirName, bHidden, true);
 			if (ExistingDir)
 			{
 				FString LeftS, RightS;
-				DirectoryString.Split(OutPathArray[i], &LeftS, &RightS);
+				DirectoryString.Split(OutPathArray[i].ToString(), &LeftS, &RightS);
 				printlog(FString::Printf(TEXT("Created child directory in %s"), *LeftS));
 				return ExistingDir;
 			}
@@ -1059,26 +2195,13 @@ UYetiOS_DirectoryBase* UYetiOS_Core::CreateDirectoryInPath(const FString& InDire
 TArray<class UYetiOS_BaseProgram*> UYetiOS_Core::GetRunningPrograms() const
 {
 	TArray<UYetiOS_BaseProgram*> OutArray;
-	RunningPrograms.GenerateValueArray(OutArray);
+	ProcessTable.GetProcesses().GenerateValueArray(OutArray);
 	return OutArray;
 }
 
 class UYetiOS_BaseProgram* UYetiOS_Core::GetRunningProgramByIdentifier(const FName& InIdentifier) const
 {
-	TArray<UYetiOS_BaseProgram*> OutArray;
-	RunningPrograms.GenerateValueArray(OutArray);
-	UYetiOS_BaseProgram** FoundDevice = nullptr;
-	FoundDevice = OutArray.FindByPredicate([InIdentifier](const UYetiOS_BaseProgram* InProgram)
-	{
-		return InProgram->GetProgramIdentifierName().IsEqual(InIdentifier);
-	});
-
-	if (FoundDevice == nullptr)
-	{
-		return nullptr;
-	}
-
-	return *FoundDevice;
+	return ProcessTable.FindFirstByIdentifier(InIdentifier);
 }
 
 bool UYetiOS_Core::GetTaskbar(UYetiOS_Taskbar*& OutTaskbar) const
@@ -1122,48 +2245,19 @@ bool UYetiOS_Core::IsModalDialogOpen() const
 
 class UYetiOS_BaseProgram* UYetiOS_Core::GetProgramFromInstalled(const FName& InIdentifier) const
 {
-	for (const auto& It : InstalledPrograms)
-	{
-		if (It->GetProgramIdentifierName().IsEqual(InIdentifier))
-		{
-			return It;
-		}
-	}
-
-	return nullptr;
+	return InstalledPrograms.FindByIdentifier(InIdentifier);
 }
 
 const TArray<class UYetiOS_BaseProgram*> UYetiOS_Core::GetInstalledPrograms(const bool bSystemProgramsOnly /*= false*/) const
 {
-	if (bSystemProgramsOnly)
-	{
-		TArray<UYetiOS_BaseProgram*> ReturnResult;
-		for (const auto& It : InstalledPrograms)
-		{
-			if (It->IsSystemInstalledProgram())
-			{
-				ReturnResult.Add(It);
-			}
-		}
-
-		return ReturnResult;
-	}
-	
-	return InstalledPrograms;
+	return bSystemProgramsOnly ? InstalledPrograms.GetSystemPrograms() : InstalledPrograms.GetPrograms();
 }
 
 const bool UYetiOS_Core::GetAllProgramsFromRepositoryLibrary(TArray<TSubclassOf<class UYetiOS_BaseProgram>>& OutPrograms)
 {
 	if (HasRepositoryLibrary())
 	{
-		TSet<FYetiOS_RepoProgram> AllProgramsFromRepo = ProgramsRepository->GetProgramsFromRepository();
-
-		for (const auto& It : AllProgramsFromRepo)
-		{
-			UYetiOS_BaseProgram* MyLoadedProgram = NewObject<UYetiOS_BaseProgram>(this, It.ProgramClass);
-			OutPrograms.Add(MyLoadedProgram->GetClass());
-		}
-
+		OutPrograms = ProgramsRepository->GetProgramClasses();
 		return true;
 	}
 
@@ -7,7 +7,9 @@
 #include "Devices/YetiOS_BaseDevice.h"
 #include "Devices/YetiOS_DeviceManagerActor.h"
 #include "Core/YetiOS_FileBase.h"
+#include "Core/YetiOS_FileContent.h"
 #include "Widgets/YetiOS_AppIconWidget.h"
+#include "Widgets/YetiOS_FileIconWidget.h"
 #include "Core/YetiOS_BaseProgram.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogYetiOsDirectoryBase, All, All)
@@ -24,14 +26,15 @@ UYetiOS_DirectoryBase::UYetiOS_DirectoryBase()
 	bIsHidden = false;
 	ParentDirectory = nullptr;
 	DirectoryType = EDirectoryType::Other;
+	bIsMaterialized = false;
+	DirectoryID = INDEX_NONE;
 }
 
 bool UYetiOS_DirectoryBase::AddProgramToDirectory(UYetiOS_DirectoryBase* InDirectory, class UYetiOS_BaseProgram* ProgramToAdd)
 {
 	if (InDirectory && ProgramToAdd)
 	{
-		FYetiOsError DummyError;
-		UYetiOS_AppIconWidget::CreateProgramIconWidget(ProgramToAdd, DummyError);
+		InDirectory->Materialize();
 		InDirectory->Programs.Add(ProgramToAdd);
 		return true;
 	}
@@ -49,6 +52,7 @@ void UYetiOS_DirectoryBase::RemoveProgramFromDirectory(UYetiOS_DirectoryBase* In
 
 UYetiOS_DirectoryBase* UYetiOS_DirectoryBase::GetChildDirectory(TSubclassOf<UYetiOS_DirectoryBase> InDirectoryClass) const
 {
+	Materialize();
 	for (const auto& Itr : ChildDirectories)
 	{
 		if (Itr->GetClass() == InDirectoryClass)
@@ -62,22 +66,36 @@ UYetiOS_DirectoryBase* UYetiOS_DirectoryBase::GetChildDirectory(TSubclassOf<UYet
 
 UYetiOS_DirectoryBase* UYetiOS_DirectoryBase::GetChildDirectoryByType(EDirectoryType InType) const
 {
+	// System directories are registered by type so a directory that was already created is found without searching.
+	if (InType != EDirectoryType::Other && OwningOS)
+	{
+		TArray<UYetiOS_DirectoryBase*> Local_Registered;
+		OwningOS->GetRootDirectory()->GetDirectoryRegistry().FindByType(InType, Local_Registered);
+		for (const auto& It : Local_Registered)
+		{
+			if (It->IsInsideDirectory(this))
+			{
+				return It;
+			}
+		}
+	}
+
+	Materialize();
 	for (auto const& It : ChildDirectories)
 	{
 		if (It->DirectoryType == InType)
 		{
 			return It;
 		}
+	}
 
-		// Look in child directories too.
-		for (auto const& ChildIt : It->ChildDirectories)
+	// Look in child directories too. Branches that can never hold this type are skipped so they stay unmaterialized.
+	const auto Local_MatchesType = [InType](const EDirectoryType InOtherType) { return InOtherType == InType; };
+	for (auto const& It : ChildDirectories)
+	{
+		if (It->Internal_CanContainDirectory(Local_MatchesType))
 		{
-			if (ChildIt->DirectoryType == InType)
-			{
-				return ChildIt;
-			}
-
-			UYetiOS_DirectoryBase* Local_Child = ChildIt->GetChildDirectoryByType(InType);
+			UYetiOS_DirectoryBase* Local_Child = It->GetChildDirectoryByType(InType);
 			if (Local_Child)
 			{
 				return Local_Child;
@@ -90,33 +108,25 @@ UYetiOS_DirectoryBase* UYetiOS_DirectoryBase::GetChildDirectoryByType(EDirectory
 
 UYetiOS_DirectoryBase* UYetiOS_DirectoryBase::GetChildDirectoryByName(const FName& InDirectoryName, const bool bRecursive /*= true*/) const
 {
+	Materialize();
 	if (ChildDirectories.Num() > 0 && InDirectoryName.IsNone() == false)
 	{
-		const FText DirectoryNameToCheck = FText::FromName(InDirectoryName).ToLower();
-
 		// First check the child directories only. If its there then return that.
-		for (const auto& It : ChildDirectories)
+		UYetiOS_DirectoryBase* Local_Found = DirectoryIndex.FindDirectory(InDirectoryName);
+		if (Local_Found)
 		{
-			const FText ItDirectoryName = It->DirectoryName.ToLower();
-			if (ItDirectoryName.EqualToCaseIgnored(DirectoryNameToCheck))
-			{
-				return It;
-			}
+			return Local_Found;
 		}
 
 		if (bRecursive)
 		{
 			for (auto const& It : ChildDirectories)
 			{
-				for (auto const& ChildIt : It->ChildDirectories)
+				It->Materialize();
+				Local_Found = It->DirectoryIndex.FindDirectory(InDirectoryName);
+				if (Local_Found)
 				{
-					const FText ChildItDirectoryName = ChildIt->DirectoryName.ToLower();
-					if (ChildItDirectoryName.EqualToCaseIgnored(DirectoryNameToCheck))
-					{
-						return ChildIt;
-					}
-
-					ChildIt->GetChildDirectoryByName(InDirectoryName);
+					return Local_Found;
 				}
 			}
 		}
@@ -151,23 +161,91 @@ UYetiOS_DirectoryBase* UYetiOS_DirectoryBase::GetDirectoryFromPath(const FString
 	return nullptr;
 }
 
+bool UYetiOS_DirectoryBase::IsInsideDirectory(const UYetiOS_DirectoryBase* InDirectory) const
+{
+	for (const UYetiOS_DirectoryBase* It = ParentDirectory; It; It = It->ParentDirectory)
+	{
+		if (It == InDirectory)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+TArray<class UYetiOS_DirectoryBase*> UYetiOS_DirectoryBase::GetAllChildDirectories() const
+{
+	Materialize();
+	return ChildDirectories;
+}
+
 TSet<class UYetiOS_FileBase*> UYetiOS_DirectoryBase::GetDirectoryFiles(const FString WithExtension /*= "*"*/) const
 {
+	Materialize();
 	if (WithExtension == "" || WithExtension == "*" || WithExtension == ".")
 	{
 		return Files;
 	}
 
 	TSet<UYetiOS_FileBase*> OutSet;
-	for (const auto& It : Files)
+	DirectoryIndex.FindFilesWithExtension(WithExtension, OutSet);
+	return OutSet;
+}
+
+class UYetiOS_FileBase* UYetiOS_DirectoryBase::FindFileByName(const FText& InName, const FText& InExtension) const
+{
+	Materialize();
+	return DirectoryIndex.FindFile(InName.ToString(), InExtension.ToString());
+}
+
+TArray<class UYetiOS_BaseProgram*> UYetiOS_DirectoryBase::GetPrograms() const
+{
+	Materialize();
+	return Programs.Array();
+}
+
+void UYetiOS_DirectoryBase::GetIconWidgets(TArray<class UYetiOS_FileIconWidget*>& OutFileIconWidgets, TArray<class UYetiOS_AppIconWidget*>& OutProgramIconWidgets, const bool bIncludeHiddenFiles /*= false*/)
+{
+	Materialize();
+	OutFileIconWidgets.Reset(Files.Num());
+	OutProgramIconWidgets.Reset(Programs.Num());
+
+	for (UYetiOS_FileBase* It : Files)
 	{
-		if (It->GetFileExtension().ToString().Equals(WithExtension, ESearchCase::IgnoreCase))
+		if (bIncludeHiddenFiles || It->IsHidden() == false)
 		{
-			OutSet.Add(It);
+			UYetiOS_FileIconWidget* Local_IconWidget = It->GetFileIconWidget();
+			if (Local_IconWidget)
+			{
+				OutFileIconWidgets.Add(Local_IconWidget);
+			}
 		}
 	}
 
-	return OutSet;
+	for (UYetiOS_BaseProgram* It : Programs)
+	{
+		UYetiOS_AppIconWidget* Local_IconWidget = It->GetProgramIconWidget();
+		if (Local_IconWidget)
+		{
+			OutProgramIconWidgets.Add(Local_IconWidget);
+		}
+	}
+}
+
+void UYetiOS_DirectoryBase::ReleaseIconWidgets()
+{
+	for (UYetiOS_FileBase* It : Files)
+	{
+		It->ReleaseFileIconWidget();
+	}
+
+	for (UYetiOS_BaseProgram* It : Programs)
+	{
+		It->ReleaseProgramIconWidget();
+	}
+
+	printlog_veryverbose(FString::Printf(TEXT("Released icon widgets in %s"), *DirectoryName.ToString()));
 }
 
 void UYetiOS_DirectoryBase::ToggleLock(const bool bLock, const FYetiOsUser& InUser)
@@ -204,7 +282,9 @@ TArray<UYetiOS_DirectoryBase*> UYetiOS_DirectoryBase::CreateChildDirectories(cla
 
 TArray<UYetiOS_DirectoryBase*> UYetiOS_DirectoryBase::CreateNativeChildDirectories(class UYetiOS_Core* InOwningOS, FYetiOsError& OutErrorMessage, const bool bForceCreate /*= false*/, const bool bCreateGrandChildDirectories /*= true*/)
 {
-	return Internal_CreateChildDirectories(InOwningOS, ChildDirectoryClasses, OutErrorMessage, bForceCreate, bCreateGrandChildDirectories, FText::GetEmpty());
+	EnsureOS(InOwningOS);
+	Materialize(bCreateGrandChildDirectories);
+	return ChildDirectories;
 }
 
 void UYetiOS_DirectoryBase::EnsureOS(const class UYetiOS_Core* InOS)
@@ -228,16 +308,58 @@ bool UYetiOS_DirectoryBase::CreateNewFileByClass(TSubclassOf<class UYetiOS_FileB
 	OutFile = nullptr;
 	if (bLocal_CreateFile)
 	{
+		Materialize();
 		OutFile = UYetiOS_FileBase::CreateFile(this, InNewFileClass, OutErrorMessage);
 		if (OutFile)
 		{
 			Files.Add(OutFile);
+			DirectoryIndex.AddFile(OutFile);
+			OwningOS->NotifyFileChanged(OutFile);
+			if (OwningOS->IsJournalingChanges())
+			{
+				OwningOS->JournalChange(FYetiOsJournalRecord::MakeFileCreated(OutFile));
+			}
 		}
 	}
 
 	return OutFile != nullptr;
 }
 
+bool UYetiOS_DirectoryBase::DeleteFileFromDirectory(class UYetiOS_FileBase* InFile, FYetiOsError& OutErrorMessage, const bool bRequirePermission /*= false*/)
+{
+	Materialize();
+	if (InFile == nullptr || Files.Contains(InFile) == false)
+	{
+		OutErrorMessage = GetErrorStruct(FText::FromString("ERR_FILE_NOT_FOUND"), FText::FromString(FString::Printf(TEXT("File does not exist in directory '%s'."), *DirectoryName.ToString())));
+		return false;
+	}
+
+	if (InFile->IsDeletable() == false && bRequirePermission == false)
+	{
+		OutErrorMessage = GetErrorStruct(FText::FromString("ERR_ACCESS_DENIED"), FText::FromString(FString::Printf(TEXT("File '%s' cannot be deleted."), *InFile->GetFilename(true).ToString())));
+		return false;
+	}
+
+	if (OwningOS->IsJournalingChanges())
+	{
+		OwningOS->JournalChange(FYetiOsJournalRecord::MakeFileDeleted(InFile));
+	}
+
+	InFile->CloseFile();
+	InFile->ReleaseFileIconWidget();
+	if (InFile->FileContent)
+	{
+		// Releases consumed hard disk space and spilled chunks before the file goes away.
+		InFile->FileContent->EmptyContent();
+	}
+
+	DirectoryIndex.RemoveFile(InFile);
+	Files.Remove(InFile);
+	OwningOS->NotifyFileRemoved(InFile);
+	InFile->ConditionalBeginDestroy();
+	return true;
+}
+
 TArray<UYetiOS_DirectoryBase*> UYetiOS_DirectoryBase::GetAllParentDirectories(const bool bIncludeRootFolder /*= false*/) const
 {
 	UYetiOS_DirectoryBase* CurrentDirectory = const_cast<UYetiOS_DirectoryBase*>(this);
@@ -277,16 +399,8 @@ TArray<UYetiOS_DirectoryBase*> UYetiOS_DirectoryBase::Internal_CreateChildDirect
 	TArray<UYetiOS_DirectoryBase*> ReturnResult;
 	const bool bLocal_CanCreateNewDir = bForceCreate ? true : bCanCreateNewFolder;
 
-	if (Programs.Num() == 0)
-	{
-		Programs.Reserve(ProgramClasses.Num());
-		for (const auto& It : ProgramClasses)
-		{
-			FYetiOsError DummyError;
-			UYetiOS_BaseProgram* NewProgram = UYetiOS_BaseProgram::CreateProgram(InOwningOS, It, DummyError, false);
-			UYetiOS_DirectoryBase::AddProgramToDirectory(this, NewProgram);
-		}
-	}
+	// Default contents must exist before anything is added next to them.
+	Materialize();
 
 	if (bLocal_CanCreateNewDir)
 	{
@@ -303,31 +417,16 @@ TArray<UYetiOS_DirectoryBase*> UYetiOS_DirectoryBase::Internal_CreateChildDirect
 		{
 			for (int32 i = 0; i < InDirectoryClasses.Num(); ++i)
 			{
-				UYetiOS_DirectoryBase* ChildDirectory = NewObject<UYetiOS_DirectoryBase>(this, InDirectoryClasses[i]);
-				ChildDirectory->ParentDirectory = this;
-				if (CheckDirectoryName.IsEmptyOrWhitespace() == false)
-				{
-					ChildDirectory->DirectoryName = CheckDirectoryName;
-				}
-
-				ChildDirectories.Add(ChildDirectory);
-				if (ChildDirectory->IsSystemDirectory())
-				{
-					InOwningOS->GetRootDirectory()->AddSystemDirectory(ChildDirectory);
-				}
+				UYetiOS_DirectoryBase* ChildDirectory = Internal_AddChildDirectory(InOwningOS, InDirectoryClasses[i], CheckDirectoryName);
 				ReturnResult.Add(ChildDirectory);
-				OwningOS->AddToCreatedDirectories(ChildDirectory);
-				printlog_veryverbose(FString::Printf(TEXT("Created child directory [%s] in %s."), *ChildDirectory->DirectoryName.ToString(), *DirectoryName.ToString()));
-				ChildDirectory->EnsureOS(InOwningOS);
-				for (const auto& It : ChildDirectory->FileClasses)
+				if (InOwningOS->IsJournalingChanges())
 				{
-					UYetiOS_FileBase* OutFile;
-					ChildDirectory->CreateNewFileByClass(It, OutFile, OutErrorMessage);
+					InOwningOS->JournalChange(FYetiOsJournalRecord::MakeDirectoryCreated(ChildDirectory));
 				}
 
 				if (bCreateGrandChildDirectories)
 				{
-					ChildDirectory->Internal_CreateChildDirectories(InOwningOS, ChildDirectory->ChildDirectoryClasses, OutErrorMessage, bForceCreate);
+					ChildDirectory->Materialize(true);
 				}
 			}
 		}
@@ -344,6 +443,172 @@ TArray<UYetiOS_DirectoryBase*> UYetiOS_DirectoryBase::Internal_CreateChildDirect
 	return ReturnResult;
 }
 
+void UYetiOS_DirectoryBase::Materialize(const bool bRecursive /*= false*/) const
+{
+	if (bIsMaterialized == false && ensureMsgf(OwningOS != nullptr, TEXT("Directory %s cannot be materialized without an owning OS."), *DirectoryName.ToString()))
+	{
+		// Materializing only fills in contents that are already implied by the class defaults, so it is allowed from const accessors.
+		const_cast<UYetiOS_DirectoryBase*>(this)->Internal_Materialize();
+	}
+
+	if (bRecursive)
+	{
+		for (const auto& It : ChildDirectories)
+		{
+			It->Materialize(true);
+		}
+	}
+}
+
+void UYetiOS_DirectoryBase::Internal_MaterializeTowards(TFunctionRef<bool(const EDirectoryType)> InPredicate) const
+{
+	Materialize();
+	for (const auto& It : ChildDirectories)
+	{
+		if (It->Internal_CanContainDirectory(InPredicate))
+		{
+			It->Internal_MaterializeTowards(InPredicate);
+		}
+	}
+}
+
+bool UYetiOS_DirectoryBase::Internal_CanContainDirectory(TFunctionRef<bool(const EDirectoryType)> InPredicate) const
+{
+	if (bIsMaterialized)
+	{
+		for (const auto& It : ChildDirectories)
+		{
+			if (InPredicate(It->DirectoryType) || It->Internal_CanContainDirectory(InPredicate))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	return Internal_ClassCanContainDirectory(GetClass(), InPredicate);
+}
+
+bool UYetiOS_DirectoryBase::Internal_ClassCanContainDirectory(TSubclassOf<UYetiOS_DirectoryBase> InDirectoryClass, TFunctionRef<bool(const EDirectoryType)> InPredicate)
+{
+	const UYetiOS_DirectoryBase* Local_DefaultDirectory = InDirectoryClass->GetDefaultObject<UYetiOS_DirectoryBase>();
+	for (const auto& It : Local_DefaultDirectory->ChildDirectoryClasses)
+	{
+		if (It && (InPredicate(It->GetDefaultObject<UYetiOS_DirectoryBase>()->DirectoryType) || Internal_ClassCanContainDirectory(It, InPredicate)))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UYetiOS_DirectoryBase::Internal_Materialize()
+{
+	// Set first so creating files and programs below does not try to materialize this directory again.
+	bIsMaterialized = true;
+	Internal_CreateDefaultPrograms();
+
+	for (const auto& It : FileClasses)
+	{
+		FYetiOsError DummyError;
+		UYetiOS_FileBase* OutFile;
+		CreateNewFileByClass(It, OutFile, DummyError);
+	}
+
+	ChildDirectories.Reserve(ChildDirectories.Num() + ChildDirectoryClasses.Num());
+	for (const auto& It : ChildDirectoryClasses)
+	{
+		if (It)
+		{
+			Internal_AddChildDirectory(OwningOS, It, FText::GetEmpty());
+		}
+	}
+
+	printlog_veryverbose(FString::Printf(TEXT("Materialized directory %s"), *DirectoryName.ToString()));
+}
+
+void UYetiOS_DirectoryBase::Internal_CreateDefaultPrograms()
+{
+	Programs.Reserve(ProgramClasses.Num());
+	for (const auto& It : ProgramClasses)
+	{
+		FYetiOsError DummyError;
+		UYetiOS_BaseProgram* NewProgram = UYetiOS_BaseProgram::CreateProgram(OwningOS, It, DummyError, false);
+		UYetiOS_DirectoryBase::AddProgramToDirectory(this, NewProgram);
+	}
+}
+
+UYetiOS_DirectoryBase* UYetiOS_DirectoryBase::Internal_AddChildDirectory(class UYetiOS_Core* InOwningOS, TSubclassOf<UYetiOS_DirectoryBase> InDirectoryClass, const FText& InDirectoryName)
+{
+	UYetiOS_DirectoryBase* ChildDirectory = NewObject<UYetiOS_DirectoryBase>(this, InDirectoryClass);
+	ChildDirectory->ParentDirectory = this;
+	if (InDirectoryName.IsEmptyOrWhitespace() == false)
+	{
+		ChildDirectory->DirectoryName = InDirectoryName;
+	}
+
+	ChildDirectories.Add(ChildDirectory);
+	DirectoryIndex.AddDirectory(ChildDirectory);
+	ChildDirectory->EnsureOS(InOwningOS);
+	OwningOS->AddToCreatedDirectories(ChildDirectory);
+	printlog_veryverbose(FString::Printf(TEXT("Created child directory [%s] in %s."), *ChildDirectory->DirectoryName.ToString(), *DirectoryName.ToString()));
+	return ChildDirectory;
+}
+
+bool UYetiOS_DirectoryBase::Internal_ReserveForLoad(const int32 InNumChildDirectories, const int32 InNumFiles, const bool bIsComplete)
+{
+	bool bLocal_NeedsReconcile = false;
+	if (bIsComplete && bIsMaterialized == false)
+	{
+		// Save has the files and child directories. Programs are not saved with directories so they still come from the class.
+		bIsMaterialized = true;
+		Internal_CreateDefaultPrograms();
+		printlog_veryverbose(FString::Printf(TEXT("Materialized directory %s from save game"), *DirectoryName.ToString()));
+	}
+	else
+	{
+		// Saved entries are merged with default contents so those have to exist first.
+		bLocal_NeedsReconcile = bIsComplete && Files.Num() > 0;
+		Materialize();
+	}
+
+	ChildDirectories.Reserve(ChildDirectories.Num() + InNumChildDirectories);
+	Files.Reserve(Files.Num() + InNumFiles);
+	DirectoryIndex.Reserve(InNumChildDirectories, InNumFiles);
+	return bLocal_NeedsReconcile;
+}
+
+UYetiOS_DirectoryBase* UYetiOS_DirectoryBase::Internal_LoadChildDirectory(TSubclassOf<UYetiOS_DirectoryBase> InDirectoryClass, const FString& InDirectoryName, const bool bHidden)
+{
+	UYetiOS_DirectoryBase* Local_ChildDirectory = DirectoryIndex.FindDirectory(FName(*InDirectoryName));
+	if (Local_ChildDirectory == nullptr)
+	{
+		Local_ChildDirectory = Internal_AddChildDirectory(OwningOS, InDirectoryClass, FText::FromString(InDirectoryName));
+		Local_ChildDirectory->bIsHidden = bHidden;
+	}
+
+	return Local_ChildDirectory;
+}
+
+class UYetiOS_FileBase* UYetiOS_DirectoryBase::Internal_LoadFile(TSubclassOf<class UYetiOS_FileBase> InFileClass, const FText& InName, const FText& InExtension, const bool bHidden)
+{
+	UYetiOS_FileBase* Local_File = DirectoryIndex.FindFile(InName.ToString(), InExtension.ToString());
+	if (Local_File == nullptr)
+	{
+		Local_File = NewObject<UYetiOS_FileBase>(this, InFileClass);
+		Local_File->Name = InName;
+		Local_File->Extension = InExtension;
+		Local_File->bIsHidden = bHidden;
+		Files.Add(Local_File);
+		DirectoryIndex.AddFile(Local_File);
+		Local_File->Internal_OnFileCreate();
+	}
+
+	return Local_File;
+}
+
 void UYetiOS_DirectoryBase::DestroyDirectory()
 {
 	for (const auto& It : ChildDirectories)
@@ -358,6 +623,19 @@ void UYetiOS_DirectoryBase::DestroyDirectory()
 
 	Programs.Empty();
 	ChildDirectories.Empty();
+	DirectoryIndex.Reset();
+
+	const UYetiOS_DirectoryBase* Local_TopDirectory = this;
+	while (Local_TopDirectory->ParentDirectory)
+	{
+		Local_TopDirectory = Local_TopDirectory->ParentDirectory;
+	}
+
+	if (UYetiOS_DirectoryRoot* Local_RootDirectory = const_cast<UYetiOS_DirectoryRoot*>(Cast<UYetiOS_DirectoryRoot>(Local_TopDirectory)))
+	{
+		Local_RootDirectory->UnregisterDirectory(this);
+	}
+
 	ParentDirectory = nullptr;
 	printlog_veryverbose(FString::Printf(TEXT("Destroying directory %s"), *DirectoryName.ToString()));
 	ConditionalBeginDestroy();
@@ -370,46 +648,87 @@ FText UYetiOS_DirectoryBase::GetDirectoryPath() const
 
 inline FString UYetiOS_DirectoryBase::GetFullPath(const bool bDoNoIncludeHome /*= false*/) const
 {
-	UYetiOS_DirectoryBase* CurrentDirectory = const_cast<UYetiOS_DirectoryBase*>(this);
-	UYetiOS_DirectoryRoot* MyRootDirectory = OwningOS->GetRootDirectory();
-
-	if (MyRootDirectory == Cast<UYetiOS_DirectoryRoot>(CurrentDirectory))
+	if (CachedFullPath.IsEmpty())
 	{
-		return UYetiOS_Core::PATH_DELIMITER;
+		if (ParentDirectory == nullptr || IsA<UYetiOS_DirectoryRoot>())
+		{
+			CachedFullPath = UYetiOS_Core::PATH_DELIMITER;
+		}
+		else
+		{
+			// Parent path is cached too, so this only walks up to the first directory that already knows its path.
+			CachedFullPath = ParentDirectory->GetFullPath();
+			if (CachedFullPath.EndsWith(UYetiOS_Core::PATH_DELIMITER) == false)
+			{
+				CachedFullPath += UYetiOS_Core::PATH_DELIMITER;
+			}
+
+			CachedFullPath += DirectoryName.ToString();
+		}
 	}
 
-	FString FullPath = "";
-	TArray<FText> Paths;	
-	bool bReachedRootDirectory = false;
-	while (bReachedRootDirectory == false)
+	if (bDoNoIncludeHome)
 	{
-		CurrentDirectory = CurrentDirectory->ParentDirectory;
-		Paths.Add(CurrentDirectory->DirectoryName);
-		if (MyRootDirectory == Cast<UYetiOS_DirectoryRoot>(CurrentDirectory))
+		if (CachedFullPathWithoutHome.IsEmpty())
 		{
-			bReachedRootDirectory = true;
+			static const FString HomePathName = UYetiOS_Core::PATH_DELIMITER + "home" + UYetiOS_Core::PATH_DELIMITER;
+			CachedFullPathWithoutHome = CachedFullPath.StartsWith(HomePathName) ? UYetiOS_Core::PATH_DELIMITER + CachedFullPath.RightChop(HomePathName.Len()) : CachedFullPath;
 		}
+
+		return CachedFullPathWithoutHome;
 	}
 
-	Algo::Reverse(Paths);
-	for (auto const& It : Paths)
+	return CachedFullPath;
+}
+
+void UYetiOS_DirectoryBase::InvalidateCachedPath()
+{
+	CachedFullPath.Empty();
+	CachedFullPathWithoutHome.Empty();
+	for (const auto& It : ChildDirectories)
 	{
-		if (It.ToString() != MyRootDirectory->DirectoryName.ToString())
-		{
-			FullPath += (It.ToString() + UYetiOS_Core::PATH_DELIMITER);
-		}
+		It->InvalidateCachedPath();
+	}
+}
+
+bool UYetiOS_DirectoryBase::RenameDirectory(const FText& InNewName, FYetiOsError& OutErrorMessage)
+{
+	if (ParentDirectory == nullptr || IsSystemDirectory())
+	{
+		OutErrorMessage.ErrorCode = LOCTEXT("YetiOS_DirectoryRenameSystemDir", "ERR_PERMISSION_DENIED");
+		OutErrorMessage.ErrorException = FText::Format(LOCTEXT("YetiOS_DirectoryRenameSystemDirException", "Cannot rename {0}."), DirectoryName);
+		OutErrorMessage.ErrorDetailedException = FText::Format(LOCTEXT("YetiOS_DirectoryRenameSystemDirDetailedException", "{0} is a system directory and cannot be renamed."), DirectoryName);
+		return false;
 	}
 
-	if (bDoNoIncludeHome)
+	if (InNewName.IsEmptyOrWhitespace() || InNewName.EqualToCaseIgnored(DirectoryName))
 	{
-		static const FString HomePathName = "home/";
-		if (FullPath.StartsWith(HomePathName))
-		{
-			FullPath.RemoveFromStart(HomePathName);
-		}
+		return false;
 	}
 
-	return FString::Printf(TEXT("%s%s%s"), *UYetiOS_Core::PATH_DELIMITER, *FullPath, *DirectoryName.ToString());
+	UYetiOS_DirectoryBase* DummyOut;
+	if (ParentDirectory->HasChildDirectory(InNewName, DummyOut))
+	{
+		OutErrorMessage.ErrorCode = LOCTEXT("YetiOS_DirectoryRenameDuplicateDir", "ERR_DIRECTORY_EXISTS");
+		OutErrorMessage.ErrorException = FText::Format(LOCTEXT("YetiOS_DirectoryRenameDuplicateDirException", "A directory with name '{0}' already exists in '{1}'."), InNewName, ParentDirectory->DirectoryName);
+		OutErrorMessage.ErrorDetailedException = FText::Format(LOCTEXT("YetiOS_DirectoryRenameDuplicateDirDetailedException", "User cannot rename '{0}' to '{1}'. Directory already exists."), DirectoryName, InNewName);
+		return false;
+	}
+
+	if (OwningOS->IsJournalingChanges())
+	{
+		OwningOS->JournalChange(FYetiOsJournalRecord::MakeDirectoryRenamed(GetFullPath(), InNewName));
+	}
+
+	// Parent index is keyed by name so the directory has to be removed before the name changes.
+	ParentDirectory->DirectoryIndex.RemoveDirectory(this);
+	DirectoryName = InNewName;
+	ParentDirectory->DirectoryIndex.AddDirectory(this);
+
+	InvalidateCachedPath();
+	OwningOS->InvalidateResolvedPaths();
+	printlog_veryverbose(FString::Printf(TEXT("Renamed directory to %s"), *GetFullPath()));
+	return true;
 }
 
 inline const bool UYetiOS_DirectoryBase::HasChildDirectory(const FText& InDirectoryName, UYetiOS_DirectoryBase*& OutFoundDirectory, const bool bIgnoreCase /*= true*/) const
@@ -417,13 +736,23 @@ inline const bool UYetiOS_DirectoryBase::HasChildDirectory(const FText& InDirect
 	OutFoundDirectory = nullptr;
 	if (InDirectoryName.IsEmptyOrWhitespace() == false)
 	{
-		for (const auto& It : ChildDirectories)
+		Materialize();
+		const FName Local_Name = FName(*InDirectoryName.ToString());
+		if (bIgnoreCase)
+		{
+			OutFoundDirectory = DirectoryIndex.FindDirectory(Local_Name);
+		}
+		else
 		{
-			const bool bHasDirectory = bIgnoreCase ? It->DirectoryName.EqualToCaseIgnored(InDirectoryName) : It->DirectoryName.EqualTo(InDirectoryName);
-			if (bHasDirectory)
+			TArray<UYetiOS_DirectoryBase*> Local_Candidates;
+			DirectoryIndex.FindDirectories(Local_Name, Local_Candidates);
+			for (const auto& It : Local_Candidates)
 			{
-				OutFoundDirectory = It;
-				break;
+				if (It->DirectoryName.EqualTo(InDirectoryName))
+				{
+					OutFoundDirectory = It;
+					break;
+				}
 			}
 		}
 	}
@@ -0,0 +1,71 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_DirectoryIndex.h"
+#include "Core/YetiOS_DirectoryBase.h"
+#include "Core/YetiOS_FileBase.h"
+
+void FYetiOsDirectoryIndex::AddDirectory(class UYetiOS_DirectoryBase* InDirectory)
+{
+	DirectoriesByName.Add(FName(*InDirectory->GetDirectoryName().ToString()), InDirectory);
+}
+
+void FYetiOsDirectoryIndex::RemoveDirectory(class UYetiOS_DirectoryBase* InDirectory)
+{
+	DirectoriesByName.RemoveSingle(FName(*InDirectory->GetDirectoryName().ToString()), InDirectory);
+}
+
+void FYetiOsDirectoryIndex::AddFile(class UYetiOS_FileBase* InFile)
+{
+	const FString Local_Name = InFile->GetFilename(false).ToString();
+	const FString Local_Extension = InFile->GetFileExtension().ToString();
+	FilesByName.Add(MakeFileKey(Local_Name, Local_Extension), InFile);
+	FilesByExtension.Add(MakeKey(Local_Extension), InFile);
+}
+
+void FYetiOsDirectoryIndex::RemoveFile(class UYetiOS_FileBase* InFile)
+{
+	const FString Local_Name = InFile->GetFilename(false).ToString();
+	const FString Local_Extension = InFile->GetFileExtension().ToString();
+	FilesByName.RemoveSingle(MakeFileKey(Local_Name, Local_Extension), InFile);
+	FilesByExtension.RemoveSingle(MakeKey(Local_Extension), InFile);
+}
+
+void FYetiOsDirectoryIndex::FindDirectories(const FName& InName, TArray<class UYetiOS_DirectoryBase*>& OutDirectories) const
+{
+	OutDirectories.Reset();
+	DirectoriesByName.MultiFind(InName, OutDirectories, true);
+}
+
+class UYetiOS_DirectoryBase* FYetiOsDirectoryIndex::FindDirectory(const FName& InName) const
+{
+	return DirectoriesByName.FindRef(InName);
+}
+
+class UYetiOS_FileBase* FYetiOsDirectoryIndex::FindFile(const FString& InName, const FString& InExtension) const
+{
+	return FilesByName.FindRef(MakeFileKey(InName, InExtension));
+}
+
+void FYetiOsDirectoryIndex::FindFilesWithExtension(const FString& InExtension, TSet<class UYetiOS_FileBase*>& OutFiles) const
+{
+	OutFiles.Reset();
+	for (auto It = FilesByExtension.CreateConstKeyIterator(MakeKey(InExtension)); It; ++It)
+	{
+		OutFiles.Add(It.Value());
+	}
+}
+
+void FYetiOsDirectoryIndex::Reserve(const int32 InNumDirectories, const int32 InNumFiles)
+{
+	DirectoriesByName.Reserve(DirectoriesByName.Num() + InNumDirectories);
+	FilesByName.Reserve(FilesByName.Num() + InNumFiles);
+	FilesByExtension.Reserve(FilesByExtension.Num() + InNumFiles);
+}
+
+void FYetiOsDirectoryIndex::Reset()
+{
+	DirectoriesByName.Empty();
+	FilesByName.Empty();
+	FilesByExtension.Empty();
+}
@@ -0,0 +1,90 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_DirectoryRegistry.h"
+#include "Core/YetiOS_DirectoryBase.h"
+
+int32 FYetiOsDirectoryRegistry::Register(class UYetiOS_DirectoryBase* InDirectory)
+{
+	check(InDirectory);
+	const int32 Local_ID = Directories.Add(InDirectory);
+	NumRegistered++;
+
+	if (InDirectory->IsSystemDirectory())
+	{
+		IDsByType.FindOrAdd(InDirectory->GetDirectoryType()).Add(Local_ID);
+		SystemIDs.Add(Local_ID);
+	}
+
+	return Local_ID;
+}
+
+bool FYetiOsDirectoryRegistry::Unregister(const int32 InDirectoryID)
+{
+	UYetiOS_DirectoryBase* Local_Directory = Find(InDirectoryID);
+	if (Local_Directory == nullptr)
+	{
+		return false;
+	}
+
+	if (Local_Directory->IsSystemDirectory())
+	{
+		if (TArray<int32>* Local_TypeIDs = IDsByType.Find(Local_Directory->GetDirectoryType()))
+		{
+			Local_TypeIDs->Remove(InDirectoryID);
+		}
+
+		SystemIDs.Remove(InDirectoryID);
+	}
+
+	Directories[InDirectoryID] = nullptr;
+	NumRegistered--;
+	return true;
+}
+
+class UYetiOS_DirectoryBase* FYetiOsDirectoryRegistry::Find(const int32 InDirectoryID) const
+{
+	return Directories.IsValidIndex(InDirectoryID) ? Directories[InDirectoryID] : nullptr;
+}
+
+void FYetiOsDirectoryRegistry::FindByType(const EDirectoryType InType, TArray<class UYetiOS_DirectoryBase*>& OutDirectories) const
+{
+	OutDirectories.Reset();
+	if (const TArray<int32>* Local_TypeIDs = IDsByType.Find(InType))
+	{
+		OutDirectories.Reserve(Local_TypeIDs->Num());
+		for (const int32& It : *Local_TypeIDs)
+		{
+			OutDirectories.Add(Directories[It]);
+		}
+	}
+}
+
+void FYetiOsDirectoryRegistry::GetSystemDirectories(TArray<class UYetiOS_DirectoryBase*>& OutDirectories) const
+{
+	OutDirectories.Reset(SystemIDs.Num());
+	for (const int32& It : SystemIDs)
+	{
+		OutDirectories.Add(Directories[It]);
+	}
+}
+
+void FYetiOsDirectoryRegistry::GetAllDirectories(TArray<const class UYetiOS_DirectoryBase*>& OutDirectories) const
+{
+	OutDirectories.Reset(NumRegistered);
+	for (const UYetiOS_DirectoryBase* It : Directories)
+	{
+		if (It)
+		{
+			OutDirectories.Add(It);
+		}
+	}
+}
+
+void FYetiOsDirectoryRegistry::Reset()
+{
+	Directories.Empty();
+	IDsByType.Empty();
+	SystemIDs.Empty();
+	NumRegistered = 0;
+}
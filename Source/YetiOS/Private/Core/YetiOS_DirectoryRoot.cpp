@@ -11,10 +11,30 @@ UYetiOS_DirectoryRoot::UYetiOS_DirectoryRoot()
 	DirectoryType = EDirectoryType::Root;
 }
 
-void UYetiOS_DirectoryRoot::AddSystemDirectory(UYetiOS_DirectoryBase* InDirectoryToAdd)
+void UYetiOS_DirectoryRoot::RegisterDirectory(UYetiOS_DirectoryBase* InDirectory)
 {
-	if (InDirectoryToAdd && ensureMsgf(InDirectoryToAdd->GetDirectoryType() != EDirectoryType::Other, TEXT("%s cannot be added as system directory."), *InDirectoryToAdd->GetDirectoryName().ToString()))
+	if (InDirectory && InDirectory->DirectoryID == INDEX_NONE)
 	{
-		SystemDirectories.Add(InDirectoryToAdd);
-	}	
+		InDirectory->DirectoryID = DirectoryRegistry.Register(InDirectory);
+	}
+}
+
+void UYetiOS_DirectoryRoot::UnregisterDirectory(UYetiOS_DirectoryBase* InDirectory)
+{
+	if (InDirectory && InDirectory->DirectoryID != INDEX_NONE)
+	{
+		DirectoryRegistry.Unregister(InDirectory->DirectoryID);
+		InDirectory->DirectoryID = INDEX_NONE;
+	}
+}
+
+const TArray<UYetiOS_DirectoryBase*> UYetiOS_DirectoryRoot::GetSystemDirectories() const
+{
+	// System directories register themselves when they are created, so create every branch that leads to one.
+	Internal_MaterializeTowards([](const EDirectoryType InType) { return InType != EDirectoryType::Other && InType != EDirectoryType::Root; });
+
+	TArray<UYetiOS_DirectoryBase*> Local_SystemDirectories;
+	DirectoryRegistry.GetSystemDirectories(Local_SystemDirectories);
+	Local_SystemDirectories.Remove(const_cast<UYetiOS_DirectoryRoot*>(this));
+	return Local_SystemDirectories;
 }
@@ -5,6 +5,7 @@
 #include "Core/YetiOS_DirectoryBase.h"
 #include "Core/YetiOS_Core.h"
 #include "Core/YetiOS_BaseProgram.h"
+#include "Core/YetiOS_FileContent.h"
 #include "Widgets/YetiOS_FileWidget.h"
 #include "Widgets/YetiOS_FileIconWidget.h"
 #include "Devices/YetiOS_BaseDevice.h"
@@ -25,6 +26,8 @@ UYetiOS_FileBase::UYetiOS_FileBase()
 	Extension  = FText::AsCultureInvariant("file");
 	Icon = nullptr;
 	FileSizeInMB = 0.f;
+	FileContentClass = UYetiOS_FileContent::StaticClass();
+	FileContent = nullptr;
 	bIsHidden = false;
 	bIsDeletable = true;
 	bIsMovable = true;
@@ -41,15 +44,10 @@ UYetiOS_FileBase* UYetiOS_FileBase::CreateFile(class UYetiOS_DirectoryBase* InPa
 	UYetiOS_FileBase* ProxyFile = NewObject<UYetiOS_FileBase>(InParentDirectory, FileClass);
 	if (ProxyFile->AssociatedProgramClass)
 	{
-		const TSet<UYetiOS_FileBase*>& AllFilesInParent = InParentDirectory->GetDirectoryFiles();
-		for (const auto& It : AllFilesInParent)
+		if (InParentDirectory->FindFileByName(ProxyFile->Name, ProxyFile->Extension))
 		{
-			if (It->IsSameFile(ProxyFile))
-			{
-				ErrorString = FString::Printf(TEXT("File %s exists in directory %s."), *ProxyFile->GetFilename(true).ToString(), *InParentDirectory->GetDirectoryName().ToString());
-				bSuccess = false;
-				break;
-			}
+			ErrorString = FString::Printf(TEXT("File %s exists in directory %s."), *ProxyFile->GetFilename(true).ToString(), *InParentDirectory->GetDirectoryName().ToString());
+			bSuccess = false;
 		}
 
 		if (InParentDirectory->GetOwningOS()->GetOwningDevice()->GetMotherboard()->GetHardDisk()->HasEnoughSpace(ProxyFile->FileSizeInMB) == false)
@@ -67,7 +65,6 @@ UYetiOS_FileBase* UYetiOS_FileBase::CreateFile(class UYetiOS_DirectoryBase* InPa
 
 	if (bSuccess)
 	{
-		ProxyFile->FileIconWidget = UYetiOS_FileIconWidget::CreateFileIconWidget(ProxyFile, OutErrorMessage);
 		ProxyFile->Internal_OnFileCreate();
 		printlog_veryverbose(FString::Printf(TEXT("Created file %s in directory %s"), *ProxyFile->Name.ToString(), *InParentDirectory->GetDirectoryName().ToString()));
 	}
@@ -90,7 +87,7 @@ void UYetiOS_FileBase::CloseFile()
 	if (DelegateHandle_OnAssociatedProgramInstalled.IsValid())
 	{
 		UYetiOS_Core* Local_OS = GetParentDirectory()->GetOwningOS();
-		Local_OS->OnProgramInstalled.Remove(DelegateHandle_OnAssociatedProgramInstalled);
+		Local_OS->OnProgramsInstalled.Remove(DelegateHandle_OnAssociatedProgramInstalled);
 		DelegateHandle_OnAssociatedProgramInstalled.Reset();
 	}
 
@@ -178,6 +175,65 @@ class UYetiOS_FileWidget* UYetiOS_FileBase::GetFileWidget()
 	return FileWidget;
 }
 
+class UYetiOS_FileIconWidget* UYetiOS_FileBase::GetFileIconWidget()
+{
+	if (FileIconWidget == nullptr && FileIconWidgetClass)
+	{
+		FYetiOsError OutError;
+		FileIconWidget = UYetiOS_FileIconWidget::CreateFileIconWidget(this, OutError);
+	}
+
+	return FileIconWidget;
+}
+
+void UYetiOS_FileBase::ReleaseFileIconWidget()
+{
+	if (FileIconWidget)
+	{
+		FileIconWidget->RemoveFromParent();
+		FileIconWidget = nullptr;
+	}
+}
+
+float UYetiOS_FileBase::GetFileSize() const
+{
+	return FileContent ? FileSizeInMB + float(FileContent->GetContentSize()) / 1000000.f : FileSizeInMB;
+}
+
+int64 UYetiOS_FileBase::GetFileSizeInBytes() const
+{
+	const int64 Local_BaseSize = UYetiOS_HardDisk::ConvertMegabyteToByte(FileSizeInMB);
+	return FileContent ? Local_BaseSize + FileContent->GetContentSize() : Local_BaseSize;
+}
+
+bool UYetiOS_FileBase::CopyContentFrom(const UYetiOS_FileBase* InSourceFile, FYetiOsError& OutErrorMessage)
+{
+	if (InSourceFile == nullptr || InSourceFile == this)
+	{
+		return false;
+	}
+
+	UYetiOS_FileContent* Local_SourceContent = const_cast<UYetiOS_FileBase*>(InSourceFile)->GetFileContent();
+	UYetiOS_FileContent* Local_Content = GetFileContent();
+	if (Local_SourceContent == nullptr || Local_Content == nullptr)
+	{
+		OutErrorMessage = GetErrorStruct(FText::FromString("ERR_NO_CONTENT"), FText::FromString(FString::Printf(TEXT("%s has no content to copy."), *InSourceFile->GetFilename(true).ToString())));
+		return false;
+	}
+
+	return Local_Content->CopyFrom(Local_SourceContent, OutErrorMessage);
+}
+
+class UYetiOS_FileContent* UYetiOS_FileBase::GetFileContent_Implementation()
+{
+	if (FileContent == nullptr && FileContentClass)
+	{
+		FileContent = NewObject<UYetiOS_FileContent>(this, FileContentClass);
+	}
+
+	return FileContent;
+}
+
 class UYetiOS_DirectoryBase* UYetiOS_FileBase::GetParentDirectory() const
 {
 	return Cast<class UYetiOS_DirectoryBase>(GetOuter());
@@ -215,19 +271,23 @@ void UYetiOS_FileBase::Internal_OnAssociateProgramClass()
 		Local_OS->IsProgramInstalled(ProgramIdentifier, AssociatedProgram, OutError);
 		if (AssociatedProgram == nullptr)
 		{
-			DelegateHandle_OnAssociatedProgramInstalled = Local_OS->OnProgramInstalled.AddUObject(this, &UYetiOS_FileBase::Internal_OnAssociatedProgramInstalled);
+			DelegateHandle_OnAssociatedProgramInstalled = Local_OS->OnProgramsInstalled.AddUObject(this, &UYetiOS_FileBase::Internal_OnAssociatedProgramInstalled);
 		}
 	}
 }
 
-void UYetiOS_FileBase::Internal_OnAssociatedProgramInstalled(class UYetiOS_BaseProgram* InNewInstalledProgram)
+void UYetiOS_FileBase::Internal_OnAssociatedProgramInstalled(const TArray<class UYetiOS_BaseProgram*>& InNewInstalledPrograms)
 {
-	if (AssociatedProgramClass == InNewInstalledProgram->GetClass())
+	UYetiOS_Core* Local_OS = GetParentDirectory()->GetOwningOS();
+	UYetiOS_BaseProgram* Local_InstalledProgram = Local_OS->GetProgramRegistry().FindByClass(AssociatedProgramClass);
+	if (Local_InstalledProgram)
 	{
-		AssociatedProgram = InNewInstalledProgram;
-		FileIconWidget->AssociatedProgramInstalled();
-		UYetiOS_Core* Local_OS = GetParentDirectory()->GetOwningOS();
-		Local_OS->OnProgramInstalled.Remove(DelegateHandle_OnAssociatedProgramInstalled);
+		AssociatedProgram = Local_InstalledProgram;
+		if (FileIconWidget)
+		{
+			FileIconWidget->AssociatedProgramInstalled();
+		}
+		Local_OS->OnProgramsInstalled.Remove(DelegateHandle_OnAssociatedProgramInstalled);
 		DelegateHandle_OnAssociatedProgramInstalled.Reset();
 	}
 }
@@ -249,23 +309,33 @@ bool UYetiOS_FileBase::RenameFile(const FText& InNewName, FText InNewExtension,
 		return false;
 	}
 
-	const TSet<UYetiOS_FileBase*>& AllFilesInParent = GetParentDirectory()->GetDirectoryFiles();
+	UYetiOS_DirectoryBase* Local_ParentDirectory = GetParentDirectory();
 	if (Name.IsEmptyOrWhitespace() == false && Extension.IsEmptyOrWhitespace() == false)
 	{
-		for (const auto& It : AllFilesInParent)
+		const UYetiOS_FileBase* Local_ExistingFile = Local_ParentDirectory->FindFileByName(InNewName, InNewExtension);
+		if (Local_ExistingFile && Local_ExistingFile != this)
 		{
-			if (It->IsSameFile(this))
-			{
-				const FString Title = "File Exists";
-				const FString Description = FString::Printf(TEXT("File '%s' alrady exists in directory '%s'."), *GetFilename(true).ToString(), *GetParentDirectory()->GetDirectoryName().ToString());
-				OutErrorMessage = GetErrorStruct(FText::FromString("ERR_FILE_EXISTS"), FText::FromString(Title), FText::FromString(Description));
-				return false;
-			}
+			const FString Title = "File Exists";
+			const FString Description = FString::Printf(TEXT("File '%s' alrady exists in directory '%s'."), *NewFileName.ToString(), *Local_ParentDirectory->GetDirectoryName().ToString());
+			OutErrorMessage = GetErrorStruct(FText::FromString("ERR_FILE_EXISTS"), FText::FromString(Title), FText::FromString(Description));
+			return false;
 		}
 	}
 
+	// Index is keyed by name so the file has to be removed before the name changes.
+	Local_ParentDirectory->DirectoryIndex.RemoveFile(this);
+	const FText Local_OldName = Name;
+	const FText Local_OldExtension = Extension;
 	Name = InNewName;
 	Extension = InNewExtension;
+	Local_ParentDirectory->DirectoryIndex.AddFile(this);
+
+	UYetiOS_Core* Local_OS = Local_ParentDirectory->GetOwningOS();
+	Local_OS->NotifyFileChanged(this);
+	if (Local_OS->IsJournalingChanges())
+	{
+		Local_OS->JournalChange(FYetiOsJournalRecord::MakeFileRenamed(this, Local_OldName, Local_OldExtension));
+	}
 	return true;
 }
 
@@ -2,4 +2,450 @@
 
 
 #include "Core/YetiOS_FileContent.h"
+#include "Core/YetiOS_FileBase.h"
+#include "Core/YetiOS_DirectoryBase.h"
+#include "Core/YetiOS_Core.h"
+#include "Devices/YetiOS_BaseDevice.h"
+#include "Hardware/YetiOS_Motherboard.h"
+#include "Hardware/YetiOS_HardDisk.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
 
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsFileContent, All, All)
+
+#define printlog_error(Param1)			UE_LOG(LogYetiOsFileContent, Error, TEXT("%s"), *FString(Param1))
+#define printlog_veryverbose(Param1)	UE_LOG(LogYetiOsFileContent, VeryVerbose, TEXT("%s"), *FString(Param1))
+
+const int32 UYetiOS_FileContent::CHUNK_SIZE = 64 * 1024;
+
+FYetiOsContentSpillFile::FYetiOsContentSpillFile()
+{
+	FileSize = 0;
+}
+
+FYetiOsContentSpillFile::~FYetiOsContentSpillFile()
+{
+	MappedHandles.Empty();
+	if (Filename.IsEmpty() == false)
+	{
+		FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*Filename);
+	}
+}
+
+FYetiOsContentChunk::FYetiOsContentChunk()
+{
+	SpillOffset = 0;
+}
+
+FYetiOsContentChunk::~FYetiOsContentChunk()
+{
+	// Region has to be unmapped before the file handle it came from is closed.
+	MappedRegion.Reset();
+	SpillFile.Reset();
+}
+
+const uint8* FYetiOsContentChunk::GetData() const
+{
+	return IsSpilled() ? MappedRegion->GetMappedPtr() : Data.GetData();
+}
+
+int32 FYetiOsContentChunk::Num() const
+{
+	return IsSpilled() ? static_cast<int32>(MappedRegion->GetMappedSize()) : Data.Num();
+}
+
+UYetiOS_FileContent::UYetiOS_FileContent()
+{
+	SpillThresholdInKB = 1024;
+	ContentSizeInBytes = 0;
+	ConsumedBytes = 0;
+}
+
+void UYetiOS_FileContent::BeginDestroy()
+{
+	// Hard disk may already be gone at this point so only memory is released here. Use EmptyContent to give the space back.
+	Chunks.Empty();
+	SpillFile.Reset();
+	Super::BeginDestroy();
+}
+
+bool UYetiOS_FileContent::SetBytes(const TArray<uint8>& InBytes, FYetiOsError& OutErrorMessage)
+{
+	if (Internal_UpdateConsumedSpace(InBytes.Num(), OutErrorMessage) == false)
+	{
+		return false;
+	}
+
+	Chunks.Reset();
+	ContentSizeInBytes = 0;
+	return Internal_Write(0, InBytes.GetData(), InBytes.Num(), OutErrorMessage);
+}
+
+bool UYetiOS_FileContent::AppendBytes(const TArray<uint8>& InBytes, FYetiOsError& OutErrorMessage)
+{
+	return Internal_Write(ContentSizeInBytes, InBytes.GetData(), InBytes.Num(), OutErrorMessage);
+}
+
+bool UYetiOS_FileContent::WriteBytes(const int64 InOffset, const TArray<uint8>& InBytes, FYetiOsError& OutErrorMessage)
+{
+	return Internal_Write(InOffset, InBytes.GetData(), InBytes.Num(), OutErrorMessage);
+}
+
+bool UYetiOS_FileContent::SetText(const FString& InText, FYetiOsError& OutErrorMessage)
+{
+	const FTCHARToUTF8 Local_Converted(*InText);
+	if (Internal_UpdateConsumedSpace(Local_Converted.Length(), OutErrorMessage) == false)
+	{
+		return false;
+	}
+
+	Chunks.Reset();
+	ContentSizeInBytes = 0;
+	return Internal_Write(0, reinterpret_cast<const uint8*>(Local_Converted.Get()), Local_Converted.Length(), OutErrorMessage);
+}
+
+bool UYetiOS_FileContent::AppendText(const FString& InText, FYetiOsError& OutErrorMessage)
+{
+	const FTCHARToUTF8 Local_Converted(*InText);
+	return Internal_Write(ContentSizeInBytes, reinterpret_cast<const uint8*>(Local_Converted.Get()), Local_Converted.Length(), OutErrorMessage);
+}
+
+bool UYetiOS_FileContent::Truncate(const int64 InNewSize)
+{
+	if (InNewSize < 0 || InNewSize > ContentSizeInBytes)
+	{
+		return false;
+	}
+
+	FYetiOsError Local_Error;
+	Internal_UpdateConsumedSpace(InNewSize, Local_Error);
+
+	const int32 Local_NumChunks = static_cast<int32>(FMath::DivideAndRoundUp<int64>(InNewSize, CHUNK_SIZE));
+	Chunks.SetNum(Local_NumChunks);
+	ContentSizeInBytes = InNewSize;
+
+	const int32 Local_TailSize = static_cast<int32>(InNewSize - static_cast<int64>(Local_NumChunks - 1) * CHUNK_SIZE);
+	if (Local_NumChunks > 0 && Chunks.Last()->Num() != Local_TailSize)
+	{
+		Internal_GetWritableChunk(Local_NumChunks - 1).Data.SetNum(Local_TailSize);
+	}
+	else if (Local_NumChunks == 0)
+	{
+		// Next spill starts a new file. Old one is deleted once copies sharing its chunks let go of them.
+		SpillFile.Reset();
+	}
+
+	Internal_NotifyContentChanged();
+	return true;
+}
+
+void UYetiOS_FileContent::EmptyContent()
+{
+	Truncate(0);
+}
+
+bool UYetiOS_FileContent::CopyFrom(const UYetiOS_FileContent* InSource, FYetiOsError& OutErrorMessage)
+{
+	if (InSource == nullptr || InSource == this)
+	{
+		return false;
+	}
+
+	if (Internal_UpdateConsumedSpace(InSource->ContentSizeInBytes, OutErrorMessage) == false)
+	{
+		return false;
+	}
+
+	Chunks = InSource->Chunks;
+	ContentSizeInBytes = InSource->ContentSizeInBytes;
+	printlog_veryverbose(FString::Printf(TEXT("%s now shares %i chunk(s) with %s."), *GetName(), Chunks.Num(), *InSource->GetName()));
+	Internal_NotifyContentChanged();
+	return true;
+}
+
+bool UYetiOS_FileContent::ReadBytes(const int64 InOffset, const int64 InCount, TArray<uint8>& OutBytes) const
+{
+	OutBytes.Reset();
+	if (InOffset < 0 || InOffset > ContentSizeInBytes)
+	{
+		return false;
+	}
+
+	const int64 Local_Count = FMath::Min(FMath::Max<int64>(InCount, 0), ContentSizeInBytes - InOffset);
+	OutBytes.SetNumUninitialized(static_cast<int32>(Local_Count));
+
+	int64 Local_Read = 0;
+	while (Local_Read < Local_Count)
+	{
+		const int64 Local_Position = InOffset + Local_Read;
+		const FYetiOsContentChunk& Local_Chunk = *Chunks[static_cast<int32>(Local_Position / CHUNK_SIZE)];
+		const int32 Local_ChunkOffset = static_cast<int32>(Local_Position % CHUNK_SIZE);
+		const int32 Local_ToCopy = static_cast<int32>(FMath::Min<int64>(Local_Chunk.Num() - Local_ChunkOffset, Local_Count - Local_Read));
+		FMemory::Memcpy(OutBytes.GetData() + Local_Read, Local_Chunk.GetData() + Local_ChunkOffset, Local_ToCopy);
+		Local_Read += Local_ToCopy;
+	}
+
+	return true;
+}
+
+FString UYetiOS_FileContent::ReadText() const
+{
+	TArray<uint8> Local_Bytes;
+	ReadBytes(0, ContentSizeInBytes, Local_Bytes);
+	const FUTF8ToTCHAR Local_Converted(reinterpret_cast<const ANSICHAR*>(Local_Bytes.GetData()), Local_Bytes.Num());
+	return FString(Local_Converted.Length(), Local_Converted.Get());
+}
+
+int64 UYetiOS_FileContent::GetResidentSize() const
+{
+	int64 Local_Size = 0;
+	for (const FYetiOsContentChunkPtr& It : Chunks)
+	{
+		if (It->IsSpilled() == false)
+		{
+			Local_Size += It->Num();
+		}
+	}
+
+	return Local_Size;
+}
+
+void UYetiOS_FileContent::ForEachChunk(TFunctionRef<bool(const uint8*, const int32)> InVisitor) const
+{
+	for (const FYetiOsContentChunkPtr& It : Chunks)
+	{
+		if (InVisitor(It->GetData(), It->Num()) == false)
+		{
+			break;
+		}
+	}
+}
+
+bool UYetiOS_FileContent::Internal_Write(const int64 InOffset, const uint8* InData, const int64 InCount, FYetiOsError& OutErrorMessage)
+{
+	if (InOffset < 0 || InOffset > ContentSizeInBytes)
+	{
+		OutErrorMessage = GetErrorStruct(FText::FromString("ERR_INVALID_OFFSET"), FText::FromString(FString::Printf(TEXT("Offset %lld is outside of content (%lld bytes)."), InOffset, ContentSizeInBytes)));
+		return false;
+	}
+
+	const int64 Local_NewSize = FMath::Max(ContentSizeInBytes, InOffset + InCount);
+	if (Internal_UpdateConsumedSpace(Local_NewSize, OutErrorMessage) == false)
+	{
+		return false;
+	}
+
+	int64 Local_Written = 0;
+	while (Local_Written < InCount)
+	{
+		const int64 Local_Position = InOffset + Local_Written;
+		const int32 Local_ChunkOffset = static_cast<int32>(Local_Position % CHUNK_SIZE);
+		const int32 Local_ToCopy = static_cast<int32>(FMath::Min<int64>(CHUNK_SIZE - Local_ChunkOffset, InCount - Local_Written));
+
+		FYetiOsContentChunk& Local_Chunk = Internal_GetWritableChunk(static_cast<int32>(Local_Position / CHUNK_SIZE));
+		if (Local_Chunk.Data.Num() < Local_ChunkOffset + Local_ToCopy)
+		{
+			Local_Chunk.Data.SetNumUninitialized(Local_ChunkOffset + Local_ToCopy);
+		}
+
+		FMemory::Memcpy(Local_Chunk.Data.GetData() + Local_ChunkOffset, InData + Local_Written, Local_ToCopy);
+		Local_Written += Local_ToCopy;
+	}
+
+	ContentSizeInBytes = Local_NewSize;
+	Internal_SpillIfNeeded();
+	Internal_NotifyContentChanged();
+	return true;
+}
+
+bool UYetiOS_FileContent::Internal_UpdateConsumedSpace(const int64 InNewSize, FYetiOsError& OutErrorMessage)
+{
+	UYetiOS_HardDisk* Local_HardDisk = Internal_GetHardDisk();
+	if (Local_HardDisk == nullptr)
+	{
+		return true;
+	}
+
+	const int64 Local_Delta = InNewSize - ConsumedBytes;
+	if (Local_Delta > 0 && Local_HardDisk->ConsumeBytes(Local_Delta) == false)
+	{
+		OutErrorMessage = GetErrorStruct(FText::FromString("ERR_NOT_ENOUGH_SPACE"), FText::FromString(FString::Printf(TEXT("Not enough space to write %lld bytes."), Local_Delta)));
+		return false;
+	}
+	else if (Local_Delta < 0)
+	{
+		Local_HardDisk->ReleaseBytes(-Local_Delta);
+	}
+
+	ConsumedBytes = InNewSize;
+	return true;
+}
+
+FYetiOsContentChunk& UYetiOS_FileContent::Internal_GetWritableChunk(const int32 InIndex)
+{
+	check(InIndex >= 0 && InIndex <= Chunks.Num());
+	if (InIndex == Chunks.Num())
+	{
+		FYetiOsContentChunkPtr& Local_NewChunk = Chunks.Add_GetRef(MakeShared<FYetiOsContentChunk, ESPMode::ThreadSafe>());
+		Local_NewChunk->Data.Reserve(CHUNK_SIZE);
+		return *Local_NewChunk;
+	}
+
+	FYetiOsContentChunkPtr& Local_Chunk = Chunks[InIndex];
+	if (Local_Chunk.IsUnique() && Local_Chunk->IsSpilled() == false)
+	{
+		return *Local_Chunk;
+	}
+
+	FYetiOsContentChunkPtr Local_Copy = MakeShared<FYetiOsContentChunk, ESPMode::ThreadSafe>();
+	Local_Copy->Data.Reserve(CHUNK_SIZE);
+	Local_Copy->Data.Append(Local_Chunk->GetData(), Local_Chunk->Num());
+	Local_Chunk = Local_Copy;
+	return *Local_Chunk;
+}
+
+void UYetiOS_FileContent::Internal_SpillIfNeeded()
+{
+	const int64 Local_Threshold = static_cast<int64>(SpillThresholdInKB) * 1024;
+	if (SpillThresholdInKB <= 0 || ContentSizeInBytes <= Local_Threshold || GetResidentSize() <= Local_Threshold)
+	{
+		return;
+	}
+
+	TArray<int32> Local_ToSpill;
+	for (int32 i = 0; i < Chunks.Num() - 1; ++i)
+	{
+		if (Chunks[i]->IsSpilled() == false)
+		{
+			Local_ToSpill.Add(i);
+		}
+	}
+
+	if (Local_ToSpill.Num() == 0)
+	{
+		return;
+	}
+
+	IPlatformFile& Local_PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// Rewritten chunks leave dead bytes behind in an append-only file. Once they outweigh the content a new file is started.
+	if (SpillFile.IsValid() == false || SpillFile->FileSize > ContentSizeInBytes * 2)
+	{
+		const FString Local_SpillPath = Internal_GetSpillPath();
+		if (Local_SpillPath.IsEmpty() || Local_PlatformFile.CreateDirectoryTree(*Local_SpillPath) == false)
+		{
+			return;
+		}
+
+		SpillFile = MakeShared<FYetiOsContentSpillFile, ESPMode::ThreadSafe>();
+		SpillFile->Filename = FPaths::Combine(Local_SpillPath, FGuid::NewGuid().ToString() + TEXT(".chunk"));
+	}
+
+	const int64 Local_AppendOffset = SpillFile->FileSize;
+	{
+		TUniquePtr<IFileHandle> Local_Writer(Local_PlatformFile.OpenWrite(*SpillFile->Filename, true));
+		if (Local_Writer.IsValid() == false)
+		{
+			printlog_error(FString::Printf(TEXT("Failed to open %s for writing. Content stays in memory."), *SpillFile->Filename));
+			SpillFile.Reset();
+			return;
+		}
+
+		for (const int32& It : Local_ToSpill)
+		{
+			if (Local_Writer->Write(Chunks[It]->GetData(), Chunks[It]->Num()) == false)
+			{
+				// Size of a partial write is unknown, so later spills go to a new file.
+				printlog_error(FString::Printf(TEXT("Failed to write %s. Content stays in memory."), *SpillFile->Filename));
+				SpillFile.Reset();
+				return;
+			}
+
+			SpillFile->FileSize += Chunks[It]->Num();
+		}
+	}
+
+	IMappedFileHandle* Local_MappedHandle = Local_PlatformFile.OpenMapped(*SpillFile->Filename);
+	if (Local_MappedHandle == nullptr)
+	{
+		printlog_veryverbose(FString::Printf(TEXT("Memory mapping is not available for %s. Content stays in memory."), *SpillFile->Filename));
+		return;
+	}
+
+	SpillFile->MappedHandles.Emplace(Local_MappedHandle);
+
+	// Spilled chunks are new objects so other contents sharing the resident chunk are not touched.
+	int64 Local_FileOffset = Local_AppendOffset;
+	for (const int32& It : Local_ToSpill)
+	{
+		const int32 Local_Size = Chunks[It]->Num();
+		IMappedFileRegion* Local_Region = Local_MappedHandle->MapRegion(Local_FileOffset, Local_Size);
+		if (Local_Region)
+		{
+			FYetiOsContentChunkPtr Local_Spilled = MakeShared<FYetiOsContentChunk, ESPMode::ThreadSafe>();
+			Local_Spilled->SpillFile = SpillFile;
+			Local_Spilled->SpillOffset = Local_FileOffset;
+			Local_Spilled->MappedRegion.Reset(Local_Region);
+			Chunks[It] = Local_Spilled;
+		}
+
+		Local_FileOffset += Local_Size;
+	}
+
+	printlog_veryverbose(FString::Printf(TEXT("Spilled %i chunk(s) of %s to %s at offset %lld."), Local_ToSpill.Num(), *GetName(), *SpillFile->Filename, Local_AppendOffset));
+}
+
+void UYetiOS_FileContent::Internal_LoadBytes(const TArray<uint8>& InBytes)
+{
+	Chunks.Reset(FMath::DivideAndRoundUp(InBytes.Num(), CHUNK_SIZE));
+	for (int32 Local_Offset = 0; Local_Offset < InBytes.Num(); Local_Offset += CHUNK_SIZE)
+	{
+		FYetiOsContentChunkPtr& Local_Chunk = Chunks.Add_GetRef(MakeShared<FYetiOsContentChunk, ESPMode::ThreadSafe>());
+		Local_Chunk->Data.Append(InBytes.GetData() + Local_Offset, FMath::Min(CHUNK_SIZE, InBytes.Num() - Local_Offset));
+	}
+
+	ContentSizeInBytes = InBytes.Num();
+	ConsumedBytes = InBytes.Num();
+	Internal_SpillIfNeeded();
+}
+
+class UYetiOS_HardDisk* UYetiOS_FileContent::Internal_GetHardDisk() const
+{
+	const UYetiOS_FileBase* Local_OwningFile = Cast<UYetiOS_FileBase>(GetOuter());
+	const UYetiOS_DirectoryBase* Local_Directory = Local_OwningFile ? Local_OwningFile->GetParentDirectory() : nullptr;
+	const UYetiOS_Core* Local_OS = Local_Directory ? Local_Directory->GetOwningOS() : nullptr;
+	if (Local_OS && Local_OS->GetOwningDevice() && Local_OS->GetOwningDevice()->GetMotherboard())
+	{
+		return Local_OS->GetOwningDevice()->GetMotherboard()->GetHardDisk();
+	}
+
+	return nullptr;
+}
+
+void UYetiOS_FileContent::Internal_NotifyContentChanged()
+{
+	UYetiOS_FileBase* Local_OwningFile = Cast<UYetiOS_FileBase>(GetOuter());
+	const UYetiOS_DirectoryBase* Local_Directory = Local_OwningFile ? Local_OwningFile->GetParentDirectory() : nullptr;
+	if (UYetiOS_Core* Local_OS = Local_Directory ? Local_Directory->GetOwningOS() : nullptr)
+	{
+		Local_OS->NotifyFileContentChanged(Local_OwningFile);
+	}
+}
+
+FString UYetiOS_FileContent::Internal_GetSpillPath() const
+{
+	const UYetiOS_FileBase* Local_OwningFile = Cast<UYetiOS_FileBase>(GetOuter());
+	const UYetiOS_DirectoryBase* Local_Directory = Local_OwningFile ? Local_OwningFile->GetParentDirectory() : nullptr;
+	const UYetiOS_Core* Local_OS = Local_Directory ? Local_Directory->GetOwningOS() : nullptr;
+	if (Local_OS && Local_OS->GetOwningDevice())
+	{
+		return UYetiOS_BaseDevice::Internal_GetFileContentPath(Local_OS->GetOwningDevice());
+	}
+
+	return FString();
+}
+
+#undef printlog_error
+#undef printlog_veryverbose
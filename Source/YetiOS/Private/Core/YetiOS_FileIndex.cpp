@@ -0,0 +1,254 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_FileIndex.h"
+#include "Core/YetiOS_FileBase.h"
+#include "Core/YetiOS_FileContent.h"
+#include "Algo/BinarySearch.h"
+
+void FYetiOsFileIndex::SetNameWords(class UYetiOS_FileBase* InFile, const TArray<FString>& InWords)
+{
+	const int32 Local_DocumentID = Internal_FindOrAddDocument(InFile);
+	const TSet<FString> Local_OldWords = Internal_GetWords(Local_DocumentID);
+	Documents[Local_DocumentID].NameWords = InWords;
+	Internal_UpdatePostings(Local_DocumentID, Local_OldWords, Internal_GetWords(Local_DocumentID));
+}
+
+void FYetiOsFileIndex::SetContentWords(class UYetiOS_FileBase* InFile, const TArray<FString>& InWords)
+{
+	const int32 Local_DocumentID = Internal_FindOrAddDocument(InFile);
+	const TSet<FString> Local_OldWords = Internal_GetWords(Local_DocumentID);
+	Documents[Local_DocumentID].ContentWords = InWords;
+	Internal_UpdatePostings(Local_DocumentID, Local_OldWords, Internal_GetWords(Local_DocumentID));
+}
+
+void FYetiOsFileIndex::RemoveFile(const class UYetiOS_FileBase* InFile)
+{
+	int32 Local_DocumentID = INDEX_NONE;
+	if (DocumentIDByFile.RemoveAndCopyValue(InFile, Local_DocumentID) == false)
+	{
+		return;
+	}
+
+	Internal_UpdatePostings(Local_DocumentID, Internal_GetWords(Local_DocumentID), TSet<FString>());
+	Documents[Local_DocumentID] = FDocument();
+	FreeDocumentIDs.Add(Local_DocumentID);
+}
+
+void FYetiOsFileIndex::Query(const FString& InQuery, const int32 InMaxResults, TArray<class UYetiOS_FileBase*>& OutFiles) const
+{
+	OutFiles.Reset();
+
+	TArray<FString> Local_QueryWords;
+	SplitWords(InQuery, 1, Local_QueryWords);
+	if (Local_QueryWords.Num() == 0)
+	{
+		return;
+	}
+
+	// Postings are not ordered, so the limit is applied only after matches are sorted by document ID.
+	TSet<int32> Local_Matches;
+	Internal_FindPrefix(Local_QueryWords[0], Local_Matches);
+	for (int32 i = 1; i < Local_QueryWords.Num() && Local_Matches.Num() > 0; ++i)
+	{
+		TSet<int32> Local_WordMatches;
+		Internal_FindPrefix(Local_QueryWords[i], Local_WordMatches);
+		Local_Matches = Local_Matches.Intersect(Local_WordMatches);
+	}
+
+	TArray<int32> Local_SortedMatches = Local_Matches.Array();
+	Local_SortedMatches.Sort();
+	for (const int32& It : Local_SortedMatches)
+	{
+		if (UYetiOS_FileBase* Local_File = Documents[It].File.Get())
+		{
+			OutFiles.Add(Local_File);
+			if (InMaxResults > 0 && OutFiles.Num() >= InMaxResults)
+			{
+				break;
+			}
+		}
+	}
+}
+
+void FYetiOsFileIndex::ForEachFile(TFunctionRef<void(class UYetiOS_FileBase*, const TArray<FString>&, const TArray<FString>&)> InVisitor) const
+{
+	for (const FDocument& It : Documents)
+	{
+		if (UYetiOS_FileBase* Local_File = It.File.Get())
+		{
+			InVisitor(Local_File, It.NameWords, It.ContentWords);
+		}
+	}
+}
+
+void FYetiOsFileIndex::Reset()
+{
+	Documents.Empty();
+	FreeDocumentIDs.Empty();
+	DocumentIDByFile.Empty();
+	Postings.Empty();
+	SortedWords.Empty();
+}
+
+SIZE_T FYetiOsFileIndex::GetAllocatedSize() const
+{
+	SIZE_T Local_Size = Documents.GetAllocatedSize() + FreeDocumentIDs.GetAllocatedSize() + DocumentIDByFile.GetAllocatedSize() + Postings.GetAllocatedSize() + SortedWords.GetAllocatedSize();
+	for (const FDocument& It : Documents)
+	{
+		Local_Size += It.NameWords.GetAllocatedSize() + It.ContentWords.GetAllocatedSize();
+		for (const FString& Word : It.NameWords)
+		{
+			Local_Size += Word.GetAllocatedSize();
+		}
+		for (const FString& Word : It.ContentWords)
+		{
+			Local_Size += Word.GetAllocatedSize();
+		}
+	}
+
+	for (const auto& It : Postings)
+	{
+		Local_Size += It.Key.GetAllocatedSize() + It.Value.GetAllocatedSize();
+	}
+
+	for (const FString& It : SortedWords)
+	{
+		Local_Size += It.GetAllocatedSize();
+	}
+
+	return Local_Size;
+}
+
+void FYetiOsFileIndex::SplitWords(const FString& InText, const int32 InMinLength, TArray<FString>& OutWords)
+{
+	OutWords.Reset();
+	const FString Local_Text = InText.ToLower();
+	int32 Local_Start = INDEX_NONE;
+	for (int32 i = 0; i <= Local_Text.Len(); ++i)
+	{
+		const bool bLocal_IsWordChar = i < Local_Text.Len() && FChar::IsAlnum(Local_Text[i]);
+		if (bLocal_IsWordChar && Local_Start == INDEX_NONE)
+		{
+			Local_Start = i;
+		}
+		else if (bLocal_IsWordChar == false && Local_Start != INDEX_NONE)
+		{
+			if (i - Local_Start >= InMinLength)
+			{
+				OutWords.AddUnique(Local_Text.Mid(Local_Start, i - Local_Start));
+			}
+			Local_Start = INDEX_NONE;
+		}
+	}
+}
+
+void FYetiOsFileIndex::SplitContentWords(const class UYetiOS_FileContent* InContent, const int64 InMaxBytes, const int32 InMinLength, TArray<FString>& OutWords)
+{
+	OutWords.Reset();
+	if (InContent == nullptr)
+	{
+		return;
+	}
+
+	TSet<FString> Local_Words;
+	TArray<ANSICHAR> Local_Word;
+	auto Local_AddWord = [&Local_Words, &Local_Word, InMinLength]()
+	{
+		if (Local_Word.Num() > 0)
+		{
+			const FUTF8ToTCHAR Local_Converted(Local_Word.GetData(), Local_Word.Num());
+			const FString Local_String = FString(Local_Converted.Length(), Local_Converted.Get());
+			if (Local_String.Len() >= InMinLength)
+			{
+				Local_Words.Add(Local_String.ToLower());
+			}
+			Local_Word.Reset();
+		}
+	};
+
+	// Bytes above 127 belong to multi byte UTF-8 characters and are treated as letters so words in other languages stay whole.
+	int64 Local_Read = 0;
+	InContent->ForEachChunk([&](const uint8* InData, const int32 InSize)
+	{
+		const int32 Local_Size = static_cast<int32>(FMath::Min<int64>(InSize, InMaxBytes - Local_Read));
+		for (int32 i = 0; i < Local_Size; ++i)
+		{
+			const uint8 Local_Byte = InData[i];
+			if (Local_Byte >= 128 || FChar::IsAlnum(static_cast<TCHAR>(Local_Byte)))
+			{
+				Local_Word.Add(static_cast<ANSICHAR>(Local_Byte));
+			}
+			else
+			{
+				Local_AddWord();
+			}
+		}
+
+		Local_Read += Local_Size;
+		return Local_Read < InMaxBytes;
+	});
+
+	Local_AddWord();
+	OutWords = Local_Words.Array();
+}
+
+int32 FYetiOsFileIndex::Internal_FindOrAddDocument(class UYetiOS_FileBase* InFile)
+{
+	if (const int32* Local_Found = DocumentIDByFile.Find(InFile))
+	{
+		return *Local_Found;
+	}
+
+	const int32 Local_DocumentID = FreeDocumentIDs.Num() > 0 ? FreeDocumentIDs.Pop(false) : Documents.AddDefaulted();
+	Documents[Local_DocumentID].File = InFile;
+	DocumentIDByFile.Add(InFile, Local_DocumentID);
+	return Local_DocumentID;
+}
+
+void FYetiOsFileIndex::Internal_UpdatePostings(const int32 InDocumentID, const TSet<FString>& InOldWords, const TSet<FString>& InNewWords)
+{
+	for (const FString& It : InOldWords)
+	{
+		if (InNewWords.Contains(It) == false)
+		{
+			TArray<int32>& Local_Postings = Postings.FindChecked(It);
+			Local_Postings.RemoveSingleSwap(InDocumentID, false);
+			if (Local_Postings.Num() == 0)
+			{
+				Postings.Remove(It);
+				SortedWords.RemoveAt(Algo::LowerBound(SortedWords, It), 1, false);
+			}
+		}
+	}
+
+	for (const FString& It : InNewWords)
+	{
+		if (InOldWords.Contains(It) == false)
+		{
+			TArray<int32>* Local_Postings = Postings.Find(It);
+			if (Local_Postings == nullptr)
+			{
+				Local_Postings = &Postings.Add(It);
+				SortedWords.Insert(It, Algo::LowerBound(SortedWords, It));
+			}
+			Local_Postings->Add(InDocumentID);
+		}
+	}
+}
+
+TSet<FString> FYetiOsFileIndex::Internal_GetWords(const int32 InDocumentID) const
+{
+	TSet<FString> Local_Words;
+	Local_Words.Append(Documents[InDocumentID].NameWords);
+	Local_Words.Append(Documents[InDocumentID].ContentWords);
+	return Local_Words;
+}
+
+void FYetiOsFileIndex::Internal_FindPrefix(const FString& InPrefix, TSet<int32>& OutDocumentIDs) const
+{
+	for (int32 i = Algo::LowerBound(SortedWords, InPrefix); i < SortedWords.Num() && SortedWords[i].StartsWith(InPrefix, ESearchCase::CaseSensitive); ++i)
+	{
+		OutDocumentIDs.Append(Postings.FindChecked(SortedWords[i]));
+	}
+}
@@ -0,0 +1,187 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_NotificationManager.h"
+#include "Core/YetiOS_Core.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsNotificationManager, All, All)
+
+#define printlog_veryverbose(Param1)	UE_LOG(LogYetiOsNotificationManager, VeryVerbose, TEXT("%s"), *FString(Param1))
+
+FYetiOsNotificationManager::FYetiOsNotificationManager(const struct FYetiOsNotificationSettings& InSettings)
+{
+	HistoryCapacity = FMath::Max(1, InSettings.HistoryCapacity);
+	History.Reserve(HistoryCapacity);
+	HistoryHead = 0;
+	NewestHistoryTime = 0.0;
+	CoalesceWindow = InSettings.CoalesceWindow;
+	DefaultRateLimit = InSettings.DefaultRateLimit;
+	SuppressedCount = 0;
+
+	for (const auto& It : InSettings.CategoryRateLimits)
+	{
+		RateLimits.Add(It.Key).Rate = It.Value;
+	}
+}
+
+FYetiOsNotificationManager::~FYetiOsNotificationManager()
+{
+	Reset();
+}
+
+bool FYetiOsNotificationManager::LogNotification(const FYetiOsNotification& InNewNotification)
+{
+	const double Local_Time = FPlatformTime::Seconds();
+	const FString Local_Key = Internal_GetCoalesceKey(InNewNotification);
+	Internal_AddToHistory(InNewNotification, Local_Key, Local_Time);
+
+	// A duplicate of a notification that is already waiting for delivery is merged into it and does not count against the rate limit.
+	if (const int32* Local_PendingIndex = PendingIndexByKey.Find(Local_Key))
+	{
+		FYetiOsNotification& Local_Pending = PendingNotifications[*Local_PendingIndex];
+		Local_Pending.RepeatCount += InNewNotification.RepeatCount;
+		Local_Pending.TimeStamp = InNewNotification.TimeStamp;
+		return true;
+	}
+
+	if (Internal_ConsumeRateLimitToken(InNewNotification.Category, Local_Time) == false)
+	{
+		SuppressedCount++;
+		printlog_veryverbose(FString::Printf(TEXT("Notification %s was rate limited. It is still available in history."), *Local_Key));
+		return HasPendingNotifications();
+	}
+
+	PendingIndexByKey.Add(Local_Key, PendingNotifications.Add(InNewNotification));
+	return true;
+}
+
+void FYetiOsNotificationManager::ConsumePendingNotifications(TArray<FYetiOsNotification>& OutNotifications)
+{
+	OutNotifications = MoveTemp(PendingNotifications);
+	PendingNotifications.Reset();
+	PendingIndexByKey.Reset();
+}
+
+void FYetiOsNotificationManager::Reset()
+{
+	History.Empty(HistoryCapacity);
+	HistoryHead = 0;
+	NewestHistoryKey.Empty();
+	NewestHistoryTime = 0.0;
+	PendingNotifications.Empty();
+	PendingIndexByKey.Empty();
+	for (auto& It : RateLimits)
+	{
+		It.Value.Tokens = 0.0;
+		It.Value.LastRefillTime = 0.0;
+	}
+	SuppressedCount = 0;
+}
+
+const FYetiOsNotification& FYetiOsNotificationManager::GetNotification(const int32 InIndexFromNewest) const
+{
+	check(InIndexFromNewest >= 0 && InIndexFromNewest < History.Num());
+	return History[(HistoryHead - 1 - InIndexFromNewest + HistoryCapacity) % HistoryCapacity];
+}
+
+int32 FYetiOsNotificationManager::GetNotificationsPage(const int32 InPage, const int32 InPageSize, TArray<FYetiOsNotification>& OutNotifications) const
+{
+	OutNotifications.Reset();
+	if (InPageSize <= 0)
+	{
+		return 0;
+	}
+
+	const int32 Local_TotalPages = FMath::DivideAndRoundUp(History.Num(), InPageSize);
+	const int32 Local_Start = InPage * InPageSize;
+	if (InPage < 0 || Local_Start >= History.Num())
+	{
+		return Local_TotalPages;
+	}
+
+	const int32 Local_End = FMath::Min(Local_Start + InPageSize, History.Num());
+	OutNotifications.Reserve(Local_End - Local_Start);
+	for (int32 i = Local_Start; i < Local_End; ++i)
+	{
+		OutNotifications.Add(GetNotification(i));
+	}
+
+	return Local_TotalPages;
+}
+
+void FYetiOsNotificationManager::ForEachNotification(TFunctionRef<bool(const FYetiOsNotification&)> InVisitor) const
+{
+	for (int32 i = 0; i < History.Num(); ++i)
+	{
+		if (InVisitor(GetNotification(i)) == false)
+		{
+			break;
+		}
+	}
+}
+
+FString FYetiOsNotificationManager::Internal_GetCoalesceKey(const FYetiOsNotification& InNotification)
+{
+	// Codes are shared by unrelated events, so only notifications that would show the same text are merged.
+	return FString::Printf(TEXT("%i:%i:%s:%s:%s"), static_cast<int32>(InNotification.Category), static_cast<int32>(InNotification.Level), *InNotification.Code.ToString(), *InNotification.Title.ToString(), *InNotification.Description.ToString());
+}
+
+void FYetiOsNotificationManager::Internal_AddToHistory(const FYetiOsNotification& InNotification, const FString& InKey, const double InTime)
+{
+	if (History.Num() > 0 && NewestHistoryKey == InKey && (InTime - NewestHistoryTime) <= CoalesceWindow)
+	{
+		FYetiOsNotification& Local_Newest = History[(HistoryHead - 1 + HistoryCapacity) % HistoryCapacity];
+		Local_Newest.RepeatCount += InNotification.RepeatCount;
+		Local_Newest.TimeStamp = InNotification.TimeStamp;
+	}
+	else if (History.Num() < HistoryCapacity)
+	{
+		History.Add(InNotification);
+		HistoryHead = History.Num() % HistoryCapacity;
+	}
+	else
+	{
+		History[HistoryHead] = InNotification;
+		HistoryHead = (HistoryHead + 1) % HistoryCapacity;
+	}
+
+	NewestHistoryKey = InKey;
+	NewestHistoryTime = InTime;
+}
+
+bool FYetiOsNotificationManager::Internal_ConsumeRateLimitToken(const EYetiOsNotificationCategory InCategory, const double InTime)
+{
+	FRateLimitBucket* Local_Bucket = RateLimits.Find(InCategory);
+	if (Local_Bucket == nullptr)
+	{
+		Local_Bucket = &RateLimits.Add(InCategory);
+		Local_Bucket->Rate = DefaultRateLimit;
+	}
+
+	if (Local_Bucket->Rate <= 0.f)
+	{
+		return true;
+	}
+
+	// Bucket holds at most one second worth of notifications so a burst can never exceed the configured rate by much.
+	const double Local_MaxTokens = FMath::Max(1.0, static_cast<double>(Local_Bucket->Rate));
+	if (Local_Bucket->LastRefillTime <= 0.0)
+	{
+		Local_Bucket->Tokens = Local_MaxTokens;
+	}
+	else
+	{
+		Local_Bucket->Tokens = FMath::Min(Local_MaxTokens, Local_Bucket->Tokens + (InTime - Local_Bucket->LastRefillTime) * Local_Bucket->Rate);
+	}
+
+	Local_Bucket->LastRefillTime = InTime;
+	if (Local_Bucket->Tokens >= 1.0)
+	{
+		Local_Bucket->Tokens -= 1.0;
+		return true;
+	}
+
+	return false;
+}
+
+#undef printlog_veryverbose
@@ -0,0 +1,79 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_PathResolver.h"
+#include "Core/YetiOS_DirectoryBase.h"
+
+/** Cache is dropped when it grows past this so typing many different paths in terminal cannot grow it forever. */
+static const int32 MAX_RESOLVED_PATHS = 1024;
+
+/** Same as UYetiOS_Core::PATH_DELIMITER. */
+static const TCHAR PATH_DELIMITER_CHAR = TEXT('/');
+
+class UYetiOS_DirectoryBase* FYetiOsPathResolver::Find(const FString& InNormalizedPath) const
+{
+	const TWeakObjectPtr<UYetiOS_DirectoryBase>* Local_Found = ResolvedPaths.Find(InNormalizedPath);
+	return Local_Found ? Local_Found->Get() : nullptr;
+}
+
+void FYetiOsPathResolver::Add(const FString& InNormalizedPath, class UYetiOS_DirectoryBase* InDirectory)
+{
+	if (ResolvedPaths.Num() >= MAX_RESOLVED_PATHS)
+	{
+		ResolvedPaths.Reset();
+	}
+
+	ResolvedPaths.Add(InNormalizedPath, InDirectory);
+}
+
+void FYetiOsPathResolver::Invalidate()
+{
+	ResolvedPaths.Empty();
+}
+
+FString FYetiOsPathResolver::Normalize(const FString& InPath)
+{
+	FString Local_Result;
+	Local_Result.Reserve(InPath.Len() + 1);
+	Local_Result.AppendChar(PATH_DELIMITER_CHAR);
+	for (const TCHAR& It : InPath)
+	{
+		if (It == PATH_DELIMITER_CHAR)
+		{
+			if (Local_Result[Local_Result.Len() - 1] != PATH_DELIMITER_CHAR)
+			{
+				Local_Result.AppendChar(PATH_DELIMITER_CHAR);
+			}
+		}
+		else
+		{
+			Local_Result.AppendChar(FChar::ToLower(It));
+		}
+	}
+
+	if (Local_Result.Len() > 1 && Local_Result[Local_Result.Len() - 1] == PATH_DELIMITER_CHAR)
+	{
+		Local_Result.RemoveAt(Local_Result.Len() - 1, 1, false);
+	}
+
+	return Local_Result;
+}
+
+void FYetiOsPathResolver::Split(const FString& InPath, TArray<FName>& OutComponents)
+{
+	OutComponents.Reset();
+	const TCHAR* Local_Chars = *InPath;
+	int32 Local_Start = 0;
+	for (int32 i = 0; i <= InPath.Len(); ++i)
+	{
+		if (i == InPath.Len() || Local_Chars[i] == PATH_DELIMITER_CHAR)
+		{
+			if (i > Local_Start)
+			{
+				OutComponents.Add(FName(i - Local_Start, Local_Chars + Local_Start));
+			}
+
+			Local_Start = i + 1;
+		}
+	}
+}
@@ -0,0 +1,96 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_ProcessTable.h"
+#include "Core/YetiOS_BaseProgram.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsProcessTable, All, All)
+
+#define printlog_error(Param1)			UE_LOG(LogYetiOsProcessTable, Error, TEXT("%s"), *FString(Param1))
+
+const int32 FYetiOsProcessTable::MIN_PROCESS_ID = 1;
+const int32 FYetiOsProcessTable::MAX_PROCESS_ID = 99999;
+
+FYetiOsProcessTable::FYetiOsProcessTable()
+{
+	UsedProcessIDs.Init(false, MAX_PROCESS_ID + 1);
+}
+
+int32 FYetiOsProcessTable::Add(class UYetiOS_BaseProgram* InProgram)
+{
+	check(InProgram);
+
+	const int32 NewProcessID = Internal_AllocateProcessID();
+	if (NewProcessID != INDEX_NONE)
+	{
+		Processes.Add(NewProcessID, InProgram);
+		ProcessesByIdentifier.Add(InProgram->GetProgramIdentifierName(), InProgram);
+	}
+
+	return NewProcessID;
+}
+
+bool FYetiOsProcessTable::Remove(const int32 InProcessID)
+{
+	UYetiOS_BaseProgram* Local_Program = nullptr;
+	if (Processes.RemoveAndCopyValue(InProcessID, Local_Program))
+	{
+		if (Local_Program)
+		{
+			ProcessesByIdentifier.RemoveSingle(Local_Program->GetProgramIdentifierName(), Local_Program);
+		}
+
+		UsedProcessIDs[InProcessID] = false;
+		return true;
+	}
+
+	return false;
+}
+
+void FYetiOsProcessTable::Reset()
+{
+	Processes.Empty();
+	ProcessesByIdentifier.Empty();
+	UsedProcessIDs.Init(false, MAX_PROCESS_ID + 1);
+}
+
+class UYetiOS_BaseProgram* FYetiOsProcessTable::FindFirstByIdentifier(const FName& InIdentifier) const
+{
+	return ProcessesByIdentifier.FindRef(InIdentifier);
+}
+
+void FYetiOsProcessTable::GetAllByIdentifier(const FName& InIdentifier, TArray<class UYetiOS_BaseProgram*>& OutPrograms) const
+{
+	ProcessesByIdentifier.MultiFind(InIdentifier, OutPrograms);
+}
+
+void FYetiOsProcessTable::GetProcessIDs(TArray<int32>& OutProcessIDs) const
+{
+	Processes.GenerateKeyArray(OutProcessIDs);
+}
+
+int32 FYetiOsProcessTable::Internal_AllocateProcessID()
+{
+	const int32 Local_Range = MAX_PROCESS_ID - MIN_PROCESS_ID + 1;
+	if (Processes.Num() >= Local_Range)
+	{
+		printlog_error("Process table is full. No free process ID left.");
+		return INDEX_NONE;
+	}
+
+	// Random start keeps process IDs looking like a real OS. With a sparse table the first probe almost always hits.
+	const int32 Local_Start = FMath::RandRange(MIN_PROCESS_ID, MAX_PROCESS_ID) - MIN_PROCESS_ID;
+	for (int32 i = 0; i < Local_Range; ++i)
+	{
+		const int32 Local_ProcessID = MIN_PROCESS_ID + ((Local_Start + i) % Local_Range);
+		if (UsedProcessIDs[Local_ProcessID] == false)
+		{
+			UsedProcessIDs[Local_ProcessID] = true;
+			return Local_ProcessID;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+#undef printlog_error
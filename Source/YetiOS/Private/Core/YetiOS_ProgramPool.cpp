@@ -0,0 +1,114 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_ProgramPool.h"
+#include "Core/YetiOS_BaseProgram.h"
+#include "Widgets/YetiOS_DraggableWindowWidget.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsProgramPool, All, All)
+
+#define printlog_veryverbose(Param1)	UE_LOG(LogYetiOsProgramPool, VeryVerbose, TEXT("%s"), *FString(Param1))
+
+bool FYetiOsProgramPool::Acquire(const UClass* InClass, FYetiOsPooledProgram& OutEntry)
+{
+	if (NumOfClass(InClass) == 0)
+	{
+		return false;
+	}
+
+	for (int32 i = Entries.Num() - 1; i >= 0; --i)
+	{
+		if (Entries[i].Program && Entries[i].Program->GetClass() == InClass)
+		{
+			OutEntry = Entries[i];
+			Entries.RemoveAt(i);
+			NumByClass.FindChecked(InClass)--;
+			printlog_veryverbose(FString::Printf(TEXT("Reusing pooled %s."), *OutEntry.Program->GetName()));
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FYetiOsProgramPool::Release(const FYetiOsPooledProgram& InEntry, const int32 InMaxForClass, const int32 InMaxTotal)
+{
+	check(InEntry.Program);
+
+	const UClass* Local_Class = InEntry.Program->GetClass();
+	if (InMaxForClass <= 0 || InMaxTotal <= 0)
+	{
+		DisposeEntry(InEntry);
+		return;
+	}
+
+	// Make room for this class first so a busy program does not evict everything else.
+	for (int32 i = 0; i < Entries.Num() && NumOfClass(Local_Class) >= InMaxForClass; )
+	{
+		if (Entries[i].Program && Entries[i].Program->GetClass() == Local_Class)
+		{
+			Internal_RemoveAt(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	Entries.Add(InEntry);
+	NumByClass.FindOrAdd(Local_Class)++;
+	Trim(InMaxTotal);
+}
+
+int32 FYetiOsProgramPool::Trim(const int32 InMaxToKeep)
+{
+	const int32 Local_ToRemove = Entries.Num() - FMath::Max(0, InMaxToKeep);
+	for (int32 i = 0; i < Local_ToRemove; ++i)
+	{
+		Internal_RemoveAt(0);
+	}
+
+	return FMath::Max(0, Local_ToRemove);
+}
+
+void FYetiOsProgramPool::Reset()
+{
+	for (const FYetiOsPooledProgram& It : Entries)
+	{
+		DisposeEntry(It);
+	}
+
+	Entries.Empty();
+	NumByClass.Empty();
+}
+
+void FYetiOsProgramPool::DisposeEntry(const FYetiOsPooledProgram& InEntry)
+{
+	if (InEntry.Window)
+	{
+		InEntry.Window->RemoveFromParent();
+	}
+
+	if (InEntry.Program && InEntry.Program->IsValidLowLevel())
+	{
+		InEntry.Program->ConditionalBeginDestroy();
+	}
+}
+
+void FYetiOsProgramPool::Internal_RemoveAt(const int32 InIndex)
+{
+	const FYetiOsPooledProgram Local_Entry = Entries[InIndex];
+	Entries.RemoveAt(InIndex);
+	if (Local_Entry.Program)
+	{
+		int32& Local_Count = NumByClass.FindChecked(Local_Entry.Program->GetClass());
+		if (--Local_Count <= 0)
+		{
+			NumByClass.Remove(Local_Entry.Program->GetClass());
+		}
+	}
+
+	DisposeEntry(Local_Entry);
+}
+
+#undef printlog_veryverbose
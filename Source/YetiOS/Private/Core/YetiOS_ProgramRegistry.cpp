@@ -0,0 +1,35 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_ProgramRegistry.h"
+#include "Core/YetiOS_BaseProgram.h"
+
+bool FYetiOsProgramRegistry::Add(class UYetiOS_BaseProgram* InProgram)
+{
+	check(InProgram);
+
+	const FName Local_Identifier = InProgram->GetProgramIdentifierName();
+	const UClass* Local_Class = InProgram->GetClass();
+	if (ProgramsByIdentifier.Contains(Local_Identifier) || ProgramsByClass.Contains(Local_Class))
+	{
+		return false;
+	}
+
+	Programs.Add(InProgram);
+	ProgramsByIdentifier.Add(Local_Identifier, InProgram);
+	ProgramsByClass.Add(Local_Class, InProgram);
+	if (InProgram->IsSystemInstalledProgram())
+	{
+		SystemPrograms.Add(InProgram);
+	}
+
+	return true;
+}
+
+void FYetiOsProgramRegistry::Reset()
+{
+	Programs.Empty();
+	SystemPrograms.Empty();
+	ProgramsByIdentifier.Empty();
+	ProgramsByClass.Empty();
+}
@@ -0,0 +1,196 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_ProgramScheduler.h"
+#include "Core/YetiOS_BaseProgram.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsProgramScheduler, All, All)
+
+#define printlog_veryverbose(Param1)	UE_LOG(LogYetiOsProgramScheduler, VeryVerbose, TEXT("%s"), *FString(Param1))
+
+/** Number of deferred frames that equal one priority step. A Low priority update deferred this many frames competes with a fresh Normal priority update. */
+static const int32 FRAMES_PER_PRIORITY_STEP = 4;
+
+FYetiOsProgramScheduler::FYetiOsProgramScheduler()
+{
+	NextHandle = 0;
+	bIsTicking = false;
+	LastFrameTimeMs = 0.f;
+	LastFrameExecutedCount = 0;
+	LastFrameDeferredCount = 0;
+}
+
+int32 FYetiOsProgramScheduler::Register(class UYetiOS_BaseProgram* InProgram, const FYetiOsProgramUpdateDelegate& InCallback, const EYetiOsProgramUpdatePriority InPriority)
+{
+	if (InProgram == nullptr || InCallback.IsBound() == false)
+	{
+		return INDEX_NONE;
+	}
+
+	FScheduledUpdate& Local_Update = Internal_Add(InProgram, InPriority);
+	Local_Update.Callback = InCallback;
+	return Local_Update.Handle;
+}
+
+bool FYetiOsProgramScheduler::Unregister(const int32 InHandle)
+{
+	bool bLocal_Found = false;
+	for (FScheduledUpdate& It : Updates)
+	{
+		if (It.Handle == InHandle && It.bPendingRemoval == false)
+		{
+			It.bPendingRemoval = true;
+			bLocal_Found = true;
+			break;
+		}
+	}
+
+	if (bLocal_Found == false)
+	{
+		bLocal_Found = PendingUpdates.RemoveAll([InHandle](const FScheduledUpdate& It) { return It.Handle == InHandle; }) > 0;
+	}
+
+	if (bIsTicking == false)
+	{
+		Internal_RemovePending();
+	}
+
+	return bLocal_Found;
+}
+
+int32 FYetiOsProgramScheduler::UnregisterProgram(const class UYetiOS_BaseProgram* InProgram)
+{
+	int32 Local_Count = 0;
+	for (FScheduledUpdate& It : Updates)
+	{
+		if (It.bPendingRemoval == false && It.Program.Get() == InProgram)
+		{
+			It.bPendingRemoval = true;
+			Local_Count++;
+		}
+	}
+
+	Local_Count += PendingUpdates.RemoveAll([InProgram](const FScheduledUpdate& It) { return It.Program.Get() == InProgram; });
+
+	if (bIsTicking == false)
+	{
+		Internal_RemovePending();
+	}
+
+	return Local_Count;
+}
+
+void FYetiOsProgramScheduler::Tick(const float InDeltaTime, const double InBudgetSeconds)
+{
+	check(bIsTicking == false);
+	bIsTicking = true;
+
+	const double Local_StartTime = FPlatformTime::Seconds();
+
+	TArray<int32> Local_Order;
+	Local_Order.Reserve(Updates.Num());
+	for (int32 i = 0; i < Updates.Num(); ++i)
+	{
+		FScheduledUpdate& It = Updates[i];
+		if (It.bPendingRemoval == false && It.Program.IsValid())
+		{
+			It.PendingDeltaTime += InDeltaTime;
+			Local_Order.Add(i);
+		}
+	}
+
+	// Deferred frames are added on top of priority so work that keeps missing the budget eventually runs ahead of everything else.
+	Local_Order.StableSort([this](const int32 A, const int32 B)
+	{
+		const FScheduledUpdate& Local_A = Updates[A];
+		const FScheduledUpdate& Local_B = Updates[B];
+		const int32 Local_RankA = static_cast<int32>(Local_A.Priority) * FRAMES_PER_PRIORITY_STEP + Local_A.DeferredFrames;
+		const int32 Local_RankB = static_cast<int32>(Local_B.Priority) * FRAMES_PER_PRIORITY_STEP + Local_B.DeferredFrames;
+		return Local_RankA > Local_RankB;
+	});
+
+	int32 Local_Executed = 0;
+	int32 Local_Deferred = 0;
+	for (const int32& It : Local_Order)
+	{
+		FScheduledUpdate& Local_Update = Updates[It];
+		if (Local_Update.bPendingRemoval)
+		{
+			continue;
+		}
+
+		if (Local_Executed > 0 && (FPlatformTime::Seconds() - Local_StartTime) >= InBudgetSeconds)
+		{
+			Local_Update.DeferredFrames++;
+			Local_Deferred++;
+			continue;
+		}
+
+		const float Local_DeltaTime = Local_Update.PendingDeltaTime;
+		Local_Update.PendingDeltaTime = 0.f;
+		Local_Update.DeferredFrames = 0;
+		Local_Update.Callback.ExecuteIfBound(Local_DeltaTime);
+
+		Local_Executed++;
+	}
+
+	bIsTicking = false;
+
+	Updates.Append(MoveTemp(PendingUpdates));
+	PendingUpdates.Reset();
+	Internal_RemovePending();
+
+	LastFrameTimeMs = static_cast<float>((FPlatformTime::Seconds() - Local_StartTime) * 1000.0);
+	LastFrameExecutedCount = Local_Executed;
+	LastFrameDeferredCount = Local_Deferred;
+	if (Local_Deferred > 0)
+	{
+		printlog_veryverbose(FString::Printf(TEXT("Ran %i update(s) in %f ms. Deferred %i update(s) to next frame."), Local_Executed, LastFrameTimeMs, Local_Deferred));
+	}
+}
+
+void FYetiOsProgramScheduler::Reset()
+{
+	PendingUpdates.Empty();
+	if (bIsTicking)
+	{
+		// Called from inside a callback. Tick removes these once it finishes.
+		for (FScheduledUpdate& It : Updates)
+		{
+			It.bPendingRemoval = true;
+		}
+		return;
+	}
+
+	Updates.Empty();
+	LastFrameTimeMs = 0.f;
+	LastFrameExecutedCount = 0;
+	LastFrameDeferredCount = 0;
+}
+
+double FYetiOsProgramScheduler::CalculateFrameBudget(const FYetiOsSchedulerSettings& InSettings, const float InCpuSpeedMHZ)
+{
+	const float Local_Scale = InSettings.ReferenceCpuSpeedMHZ > 0.f ? InCpuSpeedMHZ / InSettings.ReferenceCpuSpeedMHZ : 1.f;
+	const float Local_BudgetMs = FMath::Clamp(InSettings.FrameBudgetMs * Local_Scale, InSettings.MinFrameBudgetMs, FMath::Max(InSettings.MinFrameBudgetMs, InSettings.MaxFrameBudgetMs));
+	return Local_BudgetMs / 1000.0;
+}
+
+FYetiOsProgramScheduler::FScheduledUpdate& FYetiOsProgramScheduler::Internal_Add(class UYetiOS_BaseProgram* InProgram, const EYetiOsProgramUpdatePriority InPriority)
+{
+	TArray<FScheduledUpdate>& Local_Target = bIsTicking ? PendingUpdates : Updates;
+	FScheduledUpdate& Local_Update = Local_Target.AddDefaulted_GetRef();
+	Local_Update.Handle = NextHandle++;
+	Local_Update.Program = InProgram;
+	Local_Update.Priority = InPriority;
+	Local_Update.PendingDeltaTime = 0.f;
+	Local_Update.DeferredFrames = 0;
+	Local_Update.bPendingRemoval = false;
+	return Local_Update;
+}
+
+void FYetiOsProgramScheduler::Internal_RemovePending()
+{
+	Updates.RemoveAll([](const FScheduledUpdate& It) { return It.bPendingRemoval || It.Program.IsValid() == false; });
+}
+
+#undef printlog_veryverbose
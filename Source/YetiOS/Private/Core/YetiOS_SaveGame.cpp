@@ -4,28 +4,389 @@
 #include "Core/YetiOS_SaveGame.h"
 #include "Core/YetiOS_Core.h"
 #include "Core/YetiOS_DirectoryBase.h"
+#include "Core/YetiOS_FileBase.h"
+#include "Core/YetiOS_FileContent.h"
 #include "Core/YetiOS_BaseProgram.h"
+#include "Core/YetiOS_SaveStream.h"
+#include "Core/YetiOS_SaveManifest.h"
 #include "Devices/YetiOS_DeviceManagerActor.h"
+#include "Devices/YetiOS_DevicePersistenceSubsystem.h"
 #include "Devices/YetiOS_PortableDevice.h"
 #include "Hardware/YetiOS_Motherboard.h"
 #include "Hardware/YetiOS_HardDisk.h"
 #include "Templates/SubclassOf.h"
 #include "Kismet/GameplayStatics.h"
+#include "Engine/GameInstance.h"
+#include "Async/Async.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Serialization/NameAsStringProxyArchive.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogYetiOsSaveGame, All, All)
 
 #define printlog_error(Param1)			UE_LOG(LogYetiOsSaveGame, Error, TEXT("%s"), *FString(Param1))
 #define printlog_veryverbose(Param1)	UE_LOG(LogYetiOsSaveGame, VeryVerbose, TEXT("%s"), *FString(Param1))
 
-static const float SAVE_VERSION = 2.0;
+static const float SAVE_VERSION = 4.0;
+
+/** Oldest save version that can still be migrated. */
+static const float MIN_MIGRATABLE_SAVE_VERSION = 2.0;
+
+/** First save version that has the binary save tree. */
+static const float SAVE_TREE_VERSION = 3.0;
+
+/** First save version that has file content in the save tree. */
+static const float SAVE_CONTENT_VERSION = 4.0;
+
+/** Uncompressed bytes per chunk of a save stream. */
+static const int32 SAVE_STREAM_CHUNK_SIZE = 256 * 1024;
+
+/** Save slot bytes and their reader while LoadGameAsync moves between worker and game thread. Reader keeps a reference to the bytes so they are kept together. */
+struct FYetiOsAsyncSaveLoad
+{
+	TArray<uint8> SaveData;
+	TUniquePtr<FYetiOsSaveStreamReader> StreamReader;
+};
+
+typedef TSharedRef<FYetiOsAsyncSaveLoad, ESPMode::ThreadSafe> FYetiOsAsyncSaveLoadRef;
 
 UYetiOS_SaveGame::UYetiOS_SaveGame()
 {
 	SaveSlotName = "YetiTech_OperatingSystemSimulator";
 	UserIndex = 0;
+	CompressionFormat = NAME_Zlib;
+	JournalGeneration = 0;
 }
 
 const bool UYetiOS_SaveGame::SaveGame(const class UYetiOS_BaseDevice* InDevice)
+{
+	if (InDevice && InDevice->IsSaving())
+	{
+		// Async save would write an older snapshot over this one after its journal generations were deleted.
+		printlog_error(FString::Printf(TEXT("Cannot save %s while it is saving in background."), *InDevice->GetDeviceName().ToString()));
+		return false;
+	}
+
+	// Journal is compacted the same way as an async save, otherwise loading replays changes this save already has.
+	UYetiOS_Core* Local_OS = InDevice ? InDevice->GetOperatingSystem() : nullptr;
+	if (Local_OS)
+	{
+		Local_OS->Internal_BeginJournalCompaction();
+	}
+
+	bool bLocal_Success = false;
+	UYetiOS_SaveGame* SaveGameInstance = Internal_CreateSnapshot(InDevice);
+	if (SaveGameInstance)
+	{
+		const FYetiOsSaveShard Local_Shard = Internal_MakeShard(InDevice);
+		TArray<uint8> Local_SaveData;
+		if (Internal_WriteToStream(SaveGameInstance, Local_SaveData) && UGameplayStatics::SaveDataToSlot(Local_SaveData, Local_Shard.SlotName, SaveGameInstance->UserIndex))
+		{
+			const AYetiOS_DeviceManagerActor* MyDeviceManager = Cast<AYetiOS_DeviceManagerActor>(InDevice->GetOuter());
+			Internal_RegisterShard(MyDeviceManager ? MyDeviceManager->GetGameInstance() : nullptr, Local_Shard, SaveGameInstance->SaveSlotName, SaveGameInstance->UserIndex);
+			bLocal_Success = true;
+		}
+	}
+
+	if (Local_OS)
+	{
+		Local_OS->Internal_EndJournalCompaction(bLocal_Success);
+	}
+
+	return bLocal_Success;
+}
+
+TFuture<bool> UYetiOS_SaveGame::SaveGameAsync(const class UYetiOS_BaseDevice* InDevice, const FOnYetiOsSaveGameComplete& InOnComplete)
+{
+	const double Local_StartTime = FPlatformTime::Seconds();
+	UYetiOS_SaveGame* SaveGameInstance = Internal_CreateSnapshot(InDevice);
+	if (SaveGameInstance == nullptr)
+	{
+		InOnComplete.ExecuteIfBound(false);
+		return MakeFulfilledPromise<bool>(false).GetFuture();
+	}
+
+	printlog_veryverbose(FString::Printf(TEXT("Captured save game in %f ms."), (FPlatformTime::Seconds() - Local_StartTime) * 1000.0));
+
+	// Nothing else references the snapshot so it is rooted until the worker is done with it. Worker only reads from it.
+	SaveGameInstance->AddToRoot();
+	const FYetiOsSaveShard Local_Shard = Internal_MakeShard(InDevice);
+	const int32 Local_UserIndex = static_cast<int32>(SaveGameInstance->UserIndex);
+	const AYetiOS_DeviceManagerActor* MyDeviceManager = Cast<AYetiOS_DeviceManagerActor>(InDevice->GetOuter());
+	const TWeakObjectPtr<UGameInstance> Local_GameInstance = MyDeviceManager ? MyDeviceManager->GetGameInstance() : nullptr;
+	return Async(EAsyncExecution::ThreadPool, [SaveGameInstance, Local_Shard, Local_UserIndex, Local_GameInstance, InOnComplete]()
+	{
+		TArray<uint8> Local_SaveData;
+		const bool bLocal_Success = Internal_WriteToStream(SaveGameInstance, Local_SaveData) && UGameplayStatics::SaveDataToSlot(Local_SaveData, Local_Shard.SlotName, Local_UserIndex);
+		AsyncTask(ENamedThreads::GameThread, [SaveGameInstance, Local_Shard, Local_UserIndex, Local_GameInstance, bLocal_Success, InOnComplete]()
+		{
+			if (bLocal_Success)
+			{
+				Internal_RegisterShard(Local_GameInstance.Get(), Local_Shard, SaveGameInstance->SaveSlotName, Local_UserIndex);
+			}
+
+			SaveGameInstance->RemoveFromRoot();
+			InOnComplete.ExecuteIfBound(bLocal_Success);
+		});
+
+		return bLocal_Success;
+	});
+}
+
+const UYetiOS_SaveGame* UYetiOS_SaveGame::LoadGame(const class UYetiOS_BaseDevice* InDevice)
+{
+	UYetiOS_SaveGame* Local_SaveLoadInstance = Cast<UYetiOS_SaveGame>(UGameplayStatics::CreateSaveGameObject(InDevice->GetSaveGameClass()));
+	if (Local_SaveLoadInstance)
+	{
+		const FString MySaveSlotName = Internal_GetLoadSlotName(InDevice);
+		const uint32 MyUserIndex = Local_SaveLoadInstance->UserIndex;
+		Local_SaveLoadInstance->ConditionalBeginDestroy();
+		Local_SaveLoadInstance = nullptr;
+
+		TArray<uint8> Local_SaveData;
+		if (UGameplayStatics::DoesSaveGameExist(MySaveSlotName, MyUserIndex) && UGameplayStatics::LoadDataFromSlot(Local_SaveData, MySaveSlotName, MyUserIndex))
+		{
+			Local_SaveLoadInstance = Internal_ReadFromBytes(Local_SaveData);
+			if (Local_SaveLoadInstance && Local_SaveLoadInstance->Internal_Migrate() == false)
+			{
+				Local_SaveLoadInstance->ConditionalBeginDestroy();
+				Local_SaveLoadInstance = nullptr;
+			}
+		}
+	}
+	else
+	{
+		printlog_error("Failed to load game. Load Game Instance was null.");
+	}
+
+	return Local_SaveLoadInstance;
+}
+
+void UYetiOS_SaveGame::LoadGameAsync(const class UYetiOS_BaseDevice* InDevice, const FOnYetiOsLoadGameComplete& InOnComplete)
+{
+	const TSubclassOf<UYetiOS_SaveGame> Local_SaveGameClass = InDevice->GetSaveGameClass();
+	if (Local_SaveGameClass == nullptr)
+	{
+		printlog_error("Failed to load game. Save game class was null.");
+		InOnComplete.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	// Slot is configured on the class so its defaults are enough here. Manifest is read before going to the worker since it is a UObject.
+	const UYetiOS_SaveGame* Local_SaveGameDefaults = Local_SaveGameClass->GetDefaultObject<UYetiOS_SaveGame>();
+	const FString Local_SlotName = Internal_GetLoadSlotName(InDevice);
+	const int32 Local_UserIndex = static_cast<int32>(Local_SaveGameDefaults->UserIndex);
+	const double Local_StartTime = FPlatformTime::Seconds();
+	Async(EAsyncExecution::ThreadPool, [Local_SlotName, Local_UserIndex, Local_StartTime, InOnComplete]()
+	{
+		const FYetiOsAsyncSaveLoadRef Local_Load = MakeShared<FYetiOsAsyncSaveLoad, ESPMode::ThreadSafe>();
+		const bool bLocal_Success = UGameplayStatics::DoesSaveGameExist(Local_SlotName, Local_UserIndex) && UGameplayStatics::LoadDataFromSlot(Local_Load->SaveData, Local_SlotName, Local_UserIndex);
+		if (bLocal_Success && FYetiOsSaveStreamReader::IsSaveStream(Local_Load->SaveData))
+		{
+			Local_Load->StreamReader = MakeUnique<FYetiOsSaveStreamReader>(Local_Load->SaveData);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [Local_Load, bLocal_Success, Local_SlotName, Local_StartTime, InOnComplete]()
+		{
+			// Saves written before save streams are plain UGameplayStatics saves. They are read here in one go and written as streams with the next save.
+			if (bLocal_Success == false || Local_Load->StreamReader.IsValid() == false)
+			{
+				Internal_FinishLoadAsync(bLocal_Success ? Internal_ReadFromBytes(Local_Load->SaveData) : nullptr, Local_SlotName, Local_StartTime, InOnComplete);
+				return;
+			}
+
+			// Properties can reference classes and objects so they are read here. They are small, the save tree holds the bulk of the save.
+			UYetiOS_SaveGame* Local_SaveGame = Local_Load->StreamReader->IsError() ? nullptr : Internal_ReadProperties(*Local_Load->StreamReader);
+			if (Local_SaveGame == nullptr)
+			{
+				Internal_FinishLoadAsync(nullptr, Local_SlotName, Local_StartTime, InOnComplete);
+				return;
+			}
+
+			// Nothing else references the save game until it is handed over, so it is rooted while the worker reads its save tree.
+			Local_SaveGame->AddToRoot();
+			Async(EAsyncExecution::ThreadPool, [Local_Load, Local_SaveGame, Local_SlotName, Local_StartTime, InOnComplete]()
+			{
+				const bool bLocal_TreeRead = Local_SaveGame->Internal_ReadSaveTree(*Local_Load->StreamReader);
+				AsyncTask(ENamedThreads::GameThread, [Local_SaveGame, bLocal_TreeRead, Local_SlotName, Local_StartTime, InOnComplete]()
+				{
+					Local_SaveGame->RemoveFromRoot();
+					if (bLocal_TreeRead == false)
+					{
+						Local_SaveGame->ConditionalBeginDestroy();
+					}
+
+					Internal_FinishLoadAsync(bLocal_TreeRead ? Local_SaveGame : nullptr, Local_SlotName, Local_StartTime, InOnComplete);
+				});
+			});
+		});
+	});
+}
+
+FString UYetiOS_SaveGame::GetDeviceSlotName(const class UYetiOS_BaseDevice* InDevice)
+{
+	const FString Local_BaseSlotName = InDevice->GetSaveGameClass().GetDefaultObject()->SaveSlotName;
+	const AYetiOS_DeviceManagerActor* MyDeviceManager = Cast<AYetiOS_DeviceManagerActor>(InDevice->GetOuter());
+	return MyDeviceManager ? Local_BaseSlotName + TEXT("_") + MyDeviceManager->GetDeviceSaveID() : Local_BaseSlotName;
+}
+
+void UYetiOS_SaveGame::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	if (Ar.IsPersistent())
+	{
+		Internal_SerializeSaveTree(Ar);
+	}
+}
+
+void UYetiOS_SaveGame::Internal_SerializeSaveTree(FArchive& Ar)
+{
+	// Save version is already known here since properties are serialized first. Older saves do not have the tree.
+	if (SaveVersion >= SAVE_TREE_VERSION)
+	{
+		Ar << SaveTree;
+		if (SaveVersion >= SAVE_CONTENT_VERSION)
+		{
+			Ar << SaveTree.Contents;
+		}
+	}
+}
+
+bool UYetiOS_SaveGame::Internal_WriteToStream(UYetiOS_SaveGame* InSaveGame, TArray<uint8>& OutStreamBytes)
+{
+	FYetiOsSaveStreamWriter Local_StreamWriter(OutStreamBytes, InSaveGame->GetClass()->GetPathName(), InSaveGame->CompressionFormat, SAVE_STREAM_CHUNK_SIZE);
+	FObjectAndNameAsStringProxyArchive Local_Archive(Local_StreamWriter, false);
+	InSaveGame->Serialize(Local_Archive);
+	const bool bLocal_Success = Local_StreamWriter.Finish();
+	printlog_veryverbose(FString::Printf(TEXT("Wrote save stream. %lld byte(s) compressed to %i."), Local_StreamWriter.GetHeader().RawSize, OutStreamBytes.Num()));
+	return bLocal_Success;
+}
+
+UYetiOS_SaveGame* UYetiOS_SaveGame::Internal_ReadFromBytes(const TArray<uint8>& InSaveBytes)
+{
+	if (FYetiOsSaveStreamReader::IsSaveStream(InSaveBytes) == false)
+	{
+		// Saves written before save streams are plain UGameplayStatics saves.
+		return Cast<UYetiOS_SaveGame>(UGameplayStatics::LoadGameFromMemory(InSaveBytes));
+	}
+
+	FYetiOsSaveStreamReader Local_StreamReader(InSaveBytes);
+	if (Local_StreamReader.IsError())
+	{
+		return nullptr;
+	}
+
+	UYetiOS_SaveGame* Local_SaveGame = Internal_ReadProperties(Local_StreamReader);
+	if (Local_SaveGame && Local_SaveGame->Internal_ReadSaveTree(Local_StreamReader) == false)
+	{
+		Local_SaveGame->ConditionalBeginDestroy();
+		return nullptr;
+	}
+
+	return Local_SaveGame;
+}
+
+UYetiOS_SaveGame* UYetiOS_SaveGame::Internal_ReadProperties(FYetiOsSaveStreamReader& InStreamReader)
+{
+	UClass* Local_SaveGameClass = FSoftClassPath(InStreamReader.GetHeader().SaveGameClassPath).TryLoadClass<UYetiOS_SaveGame>();
+	if (Local_SaveGameClass == nullptr || Local_SaveGameClass->IsChildOf<UYetiOS_SaveGame>() == false)
+	{
+		printlog_error(FString::Printf(TEXT("Failed to load game. Save game class %s was not found."), *InStreamReader.GetHeader().SaveGameClassPath));
+		return nullptr;
+	}
+
+	// Only the properties are read here. Serialize would read the save tree right after them.
+	UYetiOS_SaveGame* Local_SaveGame = NewObject<UYetiOS_SaveGame>(GetTransientPackage(), Local_SaveGameClass);
+	FObjectAndNameAsStringProxyArchive Local_Archive(InStreamReader, true);
+	Local_SaveGame->Super::Serialize(Local_Archive);
+	if (InStreamReader.IsError())
+	{
+		printlog_error("Failed to load game. Save stream is damaged.");
+		Local_SaveGame->ConditionalBeginDestroy();
+		return nullptr;
+	}
+
+	return Local_SaveGame;
+}
+
+bool UYetiOS_SaveGame::Internal_ReadSaveTree(FYetiOsSaveStreamReader& InStreamReader)
+{
+	// Save tree has no object references, so names are all this archive has to resolve.
+	FNameAsStringProxyArchive Local_Archive(InStreamReader);
+	Internal_SerializeSaveTree(Local_Archive);
+	if (InStreamReader.IsError())
+	{
+		printlog_error("Failed to load game. Save stream is damaged.");
+		return false;
+	}
+
+	return true;
+}
+
+void UYetiOS_SaveGame::Internal_FinishLoadAsync(UYetiOS_SaveGame* InSaveGame, const FString& InSlotName, const double InStartTime, const FOnYetiOsLoadGameComplete& InOnComplete)
+{
+	UYetiOS_SaveGame* Local_SaveLoadInstance = InSaveGame;
+	if (Local_SaveLoadInstance && Local_SaveLoadInstance->Internal_Migrate() == false)
+	{
+		Local_SaveLoadInstance->ConditionalBeginDestroy();
+		Local_SaveLoadInstance = nullptr;
+	}
+
+	printlog_veryverbose(FString::Printf(TEXT("Loaded save game %s in %f ms."), *InSlotName, (FPlatformTime::Seconds() - InStartTime) * 1000.0));
+	InOnComplete.ExecuteIfBound(Local_SaveLoadInstance);
+}
+
+FString UYetiOS_SaveGame::Internal_GetLoadSlotName(const class UYetiOS_BaseDevice* InDevice)
+{
+	const UYetiOS_SaveGame* Local_SaveGameDefaults = InDevice->GetSaveGameClass().GetDefaultObject();
+	const FString Local_SlotName = GetDeviceSlotName(InDevice);
+	const int32 Local_UserIndex = static_cast<int32>(Local_SaveGameDefaults->UserIndex);
+	if (Local_SlotName == Local_SaveGameDefaults->SaveSlotName || UGameplayStatics::DoesSaveGameExist(Local_SlotName, Local_UserIndex))
+	{
+		return Local_SlotName;
+	}
+
+	// Before saves were sharded every device shared one slot. It can only belong to one of them, so the first device loaded without a shard keeps it.
+	if (UGameplayStatics::DoesSaveGameExist(Local_SaveGameDefaults->SaveSlotName, Local_UserIndex))
+	{
+		const AYetiOS_DeviceManagerActor* MyDeviceManager = Cast<AYetiOS_DeviceManagerActor>(InDevice->GetOuter());
+		UYetiOS_SaveManifest* Local_Manifest = Internal_GetManifest(MyDeviceManager->GetGameInstance(), Local_SaveGameDefaults->SaveSlotName, Local_UserIndex);
+		if (Local_Manifest->ClaimLegacySlot(MyDeviceManager->GetDeviceSaveID()))
+		{
+			return Local_SaveGameDefaults->SaveSlotName;
+		}
+	}
+
+	return Local_SlotName;
+}
+
+FYetiOsSaveShard UYetiOS_SaveGame::Internal_MakeShard(const class UYetiOS_BaseDevice* InDevice)
+{
+	FYetiOsSaveShard Local_Shard;
+	const AYetiOS_DeviceManagerActor* MyDeviceManager = Cast<AYetiOS_DeviceManagerActor>(InDevice->GetOuter());
+	Local_Shard.DeviceSaveID = MyDeviceManager ? MyDeviceManager->GetDeviceSaveID() : FString();
+	Local_Shard.SlotName = GetDeviceSlotName(InDevice);
+	Local_Shard.DeviceName = InDevice->GetDeviceName();
+	Local_Shard.DeviceClassPath = InDevice->GetClass()->GetPathName();
+	return Local_Shard;
+}
+
+void UYetiOS_SaveGame::Internal_RegisterShard(class UGameInstance* InGameInstance, const FYetiOsSaveShard& InShard, const FString& InBaseSlotName, const int32 InUserIndex)
+{
+	// Devices without a device manager are saved in the slot of the save game class and are not listed.
+	if (InShard.DeviceSaveID.IsEmpty() == false)
+	{
+		Internal_GetManifest(InGameInstance, InBaseSlotName, InUserIndex)->AddShard(InShard);
+	}
+}
+
+class UYetiOS_SaveManifest* UYetiOS_SaveGame::Internal_GetManifest(class UGameInstance* InGameInstance, const FString& InBaseSlotName, const int32 InUserIndex)
+{
+	UYetiOS_DevicePersistenceSubsystem* Local_PersistenceSubsystem = UGameInstance::GetSubsystem<UYetiOS_DevicePersistenceSubsystem>(InGameInstance);
+	return Local_PersistenceSubsystem ? Local_PersistenceSubsystem->GetSaveManifest(InBaseSlotName, InUserIndex) : UYetiOS_SaveManifest::LoadManifest(InBaseSlotName, InUserIndex);
+}
+
+UYetiOS_SaveGame* UYetiOS_SaveGame::Internal_CreateSnapshot(const class UYetiOS_BaseDevice* InDevice)
 {
 	if (InDevice && InDevice->GetSaveGameClass())
 	{
@@ -48,25 +409,77 @@ const bool UYetiOS_SaveGame::SaveGame(const class UYetiOS_BaseDevice* InDevice)
 			{
 				SaveGameInstance->OsData.SaveLoad_OsUsers = OperatingSystem->GetAllUsers();
 				SaveGameInstance->OsData.SaveLoad_OSVersion = OperatingSystem->GetOsVersion();
+				SaveGameInstance->JournalGeneration = OperatingSystem->GetChangeJournal().GetGeneration();
+				// Directories that were never visited are saved without contents and without the complete flag, so they get their defaults when visited after loading.
 				const TArray<const UYetiOS_DirectoryBase*> AllDirectories = OperatingSystem->GetAllCreatedDirectories();
 
-				for (const auto& It : AllDirectories)
+				// Directories are walked breadth first from root so every parent record is written before its children.
+				FYetiOsSaveTree& Local_Tree = SaveGameInstance->SaveTree;
+				TMap<const UYetiOS_DirectoryBase*, int32> Local_DirectoryRecords;
+				TMap<const UYetiOS_FileBase*, int32> Local_FileRecords;
+				Local_DirectoryRecords.Reserve(AllDirectories.Num());
+				Local_Tree.Directories.Reserve(AllDirectories.Num());
+
+				TArray<const UYetiOS_DirectoryBase*> Local_Queue;
+				Local_Queue.Reserve(AllDirectories.Num());
+				for (const UYetiOS_DirectoryBase* It : AllDirectories)
 				{
-					FYetiOsDirectorySaveLoad DirectorySave;
-					DirectorySave.SaveLoad_DirPath = It->GetFullPath();
-					DirectorySave.SaveLoad_DirectoryName = It->GetDirectoryName();
-					DirectorySave.SaveLoad_DirectoryIcon = It->GetDirectoryIcon();
-					DirectorySave.bSaveLoad_CanCreateNewFolder = It->CanCreateNewFolder();
-					DirectorySave.bSaveLoad_CanCreateNewFile = It->CanCreateNewFile();
-					DirectorySave.bSaveLoad_IsHidden = It->IsHidden();
-					DirectorySave.SaveLoad_Files = It->GetDirectoryFiles();
-					DirectorySave.SaveLoad_ChildDirectoryClasses = It->GetChildDirectories();
-
-					const int32 AddedIndex = SaveGameInstance->DirectoryData.Add(DirectorySave);
-					printlog_veryverbose(FString::Printf(TEXT("Directory [%s] saved at index %i"), *DirectorySave.SaveLoad_DirPath, AddedIndex));
+					if (It->GetParentDirectory() == nullptr)
+					{
+						Local_Queue.Add(It);
+					}
 				}
 
-				const TArray<UYetiOS_BaseProgram*> AllInstalledPrograms = OperatingSystem->GetInstalledPrograms();
+				for (int32 i = 0; i < Local_Queue.Num(); ++i)
+				{
+					const UYetiOS_DirectoryBase* Local_Directory = Local_Queue[i];
+					const int32* Local_ParentRecord = Local_DirectoryRecords.Find(Local_Directory->GetParentDirectory());
+					const bool bLocal_IsRoot = Local_ParentRecord == nullptr;
+					uint8 Local_Flags = Local_Directory->IsHidden() ? EYetiOsSaveRecordFlags::Hidden : EYetiOsSaveRecordFlags::None;
+					if (Local_Directory->IsMaterialized())
+					{
+						Local_Flags |= EYetiOsSaveRecordFlags::Complete;
+					}
+
+					const int32 Local_Record = Local_Tree.AddDirectory(bLocal_IsRoot ? INDEX_NONE : *Local_ParentRecord, bLocal_IsRoot ? FString() : Local_Directory->GetDirectoryName().ToString(), bLocal_IsRoot ? FString() : Local_Directory->GetClass()->GetPathName(), Local_Flags);
+					Local_DirectoryRecords.Add(Local_Directory, Local_Record);
+
+					if (Local_Directory->IsMaterialized() == false)
+					{
+						continue;
+					}
+
+					for (const UYetiOS_FileBase* FileIt : Local_Directory->GetDirectoryFiles())
+					{
+						const uint8 Local_FileFlags = FileIt->IsHidden() ? EYetiOsSaveRecordFlags::Hidden : EYetiOsSaveRecordFlags::None;
+						const int32 Local_FileRecord = Local_Tree.AddFile(Local_Record, FileIt->GetClass()->GetPathName(), FileIt->GetFilename(false).ToString(), FileIt->GetFileExtension().ToString(), Local_FileFlags);
+						Local_FileRecords.Add(FileIt, Local_FileRecord);
+
+						// Chunks are copy on write, so the worker can write them while the file keeps changing.
+						const UYetiOS_FileContent* Local_Content = FileIt->GetCreatedFileContent();
+						if (Local_Content && Local_Content->IsEmpty() == false)
+						{
+							Local_Tree.AddFileContent(Local_FileRecord, Local_Content);
+						}
+					}
+
+					Local_Queue.Append(Local_Directory->GetAllChildDirectories());
+				}
+
+				if (OperatingSystem->IsFileIndexComplete())
+				{
+					OperatingSystem->GetFileIndex().ForEachFile([&Local_Tree, &Local_FileRecords](UYetiOS_FileBase* InFile, const TArray<FString>& InNameWords, const TArray<FString>& InContentWords)
+					{
+						if (const int32* Local_FileRecord = Local_FileRecords.Find(InFile))
+						{
+							Local_Tree.AddFileIndex(*Local_FileRecord, InNameWords, InContentWords);
+						}
+					});
+				}
+
+				printlog_veryverbose(FString::Printf(TEXT("Saved %i directories and %i file(s) with %i unique string(s)."), Local_Tree.Directories.Num(), Local_Tree.Files.Num(), Local_Tree.Strings.Num()));
+
+				const TArray<UYetiOS_BaseProgram*>& AllInstalledPrograms = OperatingSystem->GetProgramRegistry().GetPrograms();
 				for (const auto& It : AllInstalledPrograms)
 				{
 					if (It->IsSystemInstalledProgram() == false)
@@ -85,40 +498,111 @@ const bool UYetiOS_SaveGame::SaveGame(const class UYetiOS_BaseDevice* InDevice)
 				}
 			}
 
-			return UGameplayStatics::SaveGameToSlot(SaveGameInstance, SaveGameInstance->SaveSlotName, SaveGameInstance->UserIndex);
+			return SaveGameInstance;
 		}
 	}
 
-	return false;
+	return nullptr;
 }
 
-const UYetiOS_SaveGame* UYetiOS_SaveGame::LoadGame(const class UYetiOS_BaseDevice* InDevice)
+bool UYetiOS_SaveGame::Internal_Migrate()
 {
-	UYetiOS_SaveGame* Local_SaveLoadInstance = Cast<UYetiOS_SaveGame>(UGameplayStatics::CreateSaveGameObject(InDevice->GetSaveGameClass()));
-	if (Local_SaveLoadInstance)
+	if (SaveVersion > SAVE_VERSION)
 	{
-		const FString MySaveSlotName = Local_SaveLoadInstance->SaveSlotName;
-		const uint32 MyUserIndex = Local_SaveLoadInstance->UserIndex;
-		Local_SaveLoadInstance->ConditionalBeginDestroy();
-		Local_SaveLoadInstance = nullptr;
+		printlog_error(FString::Printf(TEXT("Failed to load save game. It was written by a newer version. Loaded save version: %f. Supported version: %f"), SaveVersion, SAVE_VERSION));
+		return false;
+	}
+
+	if (SaveVersion < MIN_MIGRATABLE_SAVE_VERSION)
+	{
+		printlog_error(FString::Printf(TEXT("Failed to load save game. Save version %f is too old to migrate. Oldest supported version: %f"), SaveVersion, MIN_MIGRATABLE_SAVE_VERSION));
+		return false;
+	}
+
+	while (SaveVersion < SAVE_VERSION)
+	{
+		const float Local_FromVersion = SaveVersion;
+		if (FMath::IsNearlyEqual(SaveVersion, 2.f))
+		{
+			Internal_MigrateFromVersion2();
+		}
+		else if (FMath::IsNearlyEqual(SaveVersion, 3.f))
+		{
+			Internal_MigrateFromVersion3();
+		}
 
-		if (UGameplayStatics::DoesSaveGameExist(MySaveSlotName, MyUserIndex))
+		if (SaveVersion <= Local_FromVersion)
 		{
-			Local_SaveLoadInstance = Cast<UYetiOS_SaveGame>(UGameplayStatics::LoadGameFromSlot(MySaveSlotName, MyUserIndex));
-			if (Local_SaveLoadInstance->SaveVersion != SAVE_VERSION)
+			printlog_error(FString::Printf(TEXT("Failed to load save game. No migration from save version %f."), Local_FromVersion));
+			return false;
+		}
+
+		printlog_veryverbose(FString::Printf(TEXT("Migrated save game from version %f to %f."), Local_FromVersion, SaveVersion));
+	}
+
+	return true;
+}
+
+void UYetiOS_SaveGame::Internal_MigrateFromVersion2()
+{
+	SaveTree.Reset();
+	TMap<FString, int32> Local_DirectoryRecords;
+	TMap<FString, int32> Local_FileRecords;
+	Local_DirectoryRecords.Add(UYetiOS_Core::PATH_DELIMITER, SaveTree.AddDirectory(INDEX_NONE, FString(), FString(), EYetiOsSaveRecordFlags::None));
+
+	// Version 2 stored full paths without classes. Every missing path component becomes a template directory.
+	for (const FYetiOsDirectorySaveLoad& It : DirectoryData)
+	{
+		TArray<FName> Local_Components;
+		FYetiOsPathResolver::Split(It.SaveLoad_DirPath, Local_Components);
+
+		int32 Local_Record = Local_DirectoryRecords.FindChecked(UYetiOS_Core::PATH_DELIMITER);
+		FString Local_Path;
+		for (int32 i = 0; i < Local_Components.Num(); ++i)
+		{
+			Local_Path += UYetiOS_Core::PATH_DELIMITER + Local_Components[i].ToString();
+			if (const int32* Local_Found = Local_DirectoryRecords.Find(Local_Path))
 			{
-				printlog_error(FString::Printf(TEXT("Failed to load save game. Version mismatch. Loaded save version: %f. Expected version: %f"), Local_SaveLoadInstance->SaveVersion, SAVE_VERSION));
-				Local_SaveLoadInstance->ConditionalBeginDestroy();
-				Local_SaveLoadInstance = nullptr;
+				Local_Record = *Local_Found;
+				continue;
+			}
+
+			const bool bLocal_IsSavedDirectory = i == Local_Components.Num() - 1;
+			const uint8 Local_Flags = bLocal_IsSavedDirectory && It.bSaveLoad_IsHidden ? EYetiOsSaveRecordFlags::Hidden : EYetiOsSaveRecordFlags::None;
+			Local_Record = SaveTree.AddDirectory(Local_Record, Local_Components[i].ToString(), FString(), Local_Flags);
+			Local_DirectoryRecords.Add(Local_Path, Local_Record);
+		}
+
+		for (const UYetiOS_FileBase* FileIt : It.SaveLoad_Files)
+		{
+			// Version 2 referenced live file objects which only resolve if they still exist when loading.
+			if (FileIt)
+			{
+				const uint8 Local_FileFlags = FileIt->IsHidden() ? EYetiOsSaveRecordFlags::Hidden : EYetiOsSaveRecordFlags::None;
+				const int32 Local_FileRecord = SaveTree.AddFile(Local_Record, FileIt->GetClass()->GetPathName(), FileIt->GetFilename(false).ToString(), FileIt->GetFileExtension().ToString(), Local_FileFlags);
+				Local_FileRecords.Add(It.SaveLoad_DirPath / FileIt->GetFilename(true).ToString(), Local_FileRecord);
 			}
 		}
 	}
-	else
+
+	for (const FYetiOsFileIndexSaveLoad& It : FileIndexData)
 	{
-		printlog_error("Failed to load game. Load Game Instance was null.");
+		if (const int32* Local_FileRecord = Local_FileRecords.Find(It.SaveLoad_FilePath))
+		{
+			SaveTree.AddFileIndex(*Local_FileRecord, It.SaveLoad_NameWords, It.SaveLoad_ContentWords);
+		}
 	}
 
-	return Local_SaveLoadInstance;
+	DirectoryData.Empty();
+	FileIndexData.Empty();
+	SaveVersion = 3.0;
+}
+
+void UYetiOS_SaveGame::Internal_MigrateFromVersion3()
+{
+	// Version 3 did not save file content. Files load empty.
+	SaveTree.Contents.Empty();
+	SaveVersion = 4.0;
 }
 
 #undef printlog_error
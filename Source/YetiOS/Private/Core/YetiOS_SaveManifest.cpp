@@ -0,0 +1,117 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_SaveManifest.h"
+#include "Kismet/GameplayStatics.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsSaveManifest, All, All)
+
+#define printlog(Param1)				UE_LOG(LogYetiOsSaveManifest, Log, TEXT("%s"), *FString(Param1))
+#define printlog_error(Param1)			UE_LOG(LogYetiOsSaveManifest, Error, TEXT("%s"), *FString(Param1))
+
+UYetiOS_SaveManifest::UYetiOS_SaveManifest()
+{
+	UserIndex = 0;
+	bIsWriting = false;
+	bWriteAgain = false;
+	bLastWriteFailed = false;
+}
+
+UYetiOS_SaveManifest* UYetiOS_SaveManifest::LoadManifest(const FString& InBaseSlotName, const int32 InUserIndex)
+{
+	const FString Local_SlotName = GetManifestSlotName(InBaseSlotName);
+	UYetiOS_SaveManifest* Local_Manifest = nullptr;
+	if (UGameplayStatics::DoesSaveGameExist(Local_SlotName, InUserIndex))
+	{
+		Local_Manifest = Cast<UYetiOS_SaveManifest>(UGameplayStatics::LoadGameFromSlot(Local_SlotName, InUserIndex));
+		if (Local_Manifest == nullptr)
+		{
+			printlog_error(FString::Printf(TEXT("Failed to read save manifest %s. It is written again with the next save."), *Local_SlotName));
+		}
+	}
+
+	if (Local_Manifest == nullptr)
+	{
+		Local_Manifest = Cast<UYetiOS_SaveManifest>(UGameplayStatics::CreateSaveGameObject(UYetiOS_SaveManifest::StaticClass()));
+	}
+
+	Local_Manifest->BaseSlotName = InBaseSlotName;
+	Local_Manifest->UserIndex = InUserIndex;
+	return Local_Manifest;
+}
+
+FString UYetiOS_SaveManifest::GetManifestSlotName(const FString& InBaseSlotName)
+{
+	return InBaseSlotName + TEXT("_Manifest");
+}
+
+bool UYetiOS_SaveManifest::AddShard(const FYetiOsSaveShard& InShard)
+{
+	FYetiOsSaveShard* Local_Existing = Shards.FindByPredicate([&InShard](const FYetiOsSaveShard& It) { return It.DeviceSaveID == InShard.DeviceSaveID; });
+	if (Local_Existing)
+	{
+		if (*Local_Existing == InShard && bLastWriteFailed == false)
+		{
+			return false;
+		}
+
+		*Local_Existing = InShard;
+	}
+	else
+	{
+		Shards.Add(InShard);
+		printlog(FString::Printf(TEXT("Added save shard %s for device %s."), *InShard.SlotName, *InShard.DeviceSaveID));
+	}
+
+	Internal_Write();
+	return true;
+}
+
+const FYetiOsSaveShard* UYetiOS_SaveManifest::FindShard(const FString& InDeviceSaveID) const
+{
+	return Shards.FindByPredicate([&InDeviceSaveID](const FYetiOsSaveShard& It) { return It.DeviceSaveID == InDeviceSaveID; });
+}
+
+bool UYetiOS_SaveManifest::ClaimLegacySlot(const FString& InDeviceSaveID)
+{
+	if (LegacySlotOwner.IsEmpty())
+	{
+		LegacySlotOwner = InDeviceSaveID;
+		Internal_Write();
+		printlog(FString::Printf(TEXT("Device %s loads the unsharded save slot %s."), *InDeviceSaveID, *BaseSlotName));
+	}
+
+	return LegacySlotOwner == InDeviceSaveID;
+}
+
+void UYetiOS_SaveManifest::Internal_Write()
+{
+	// Two writes in flight could finish out of order and leave the older manifest on disk.
+	if (bIsWriting)
+	{
+		bWriteAgain = true;
+		return;
+	}
+
+	bIsWriting = true;
+	bWriteAgain = false;
+	UGameplayStatics::AsyncSaveGameToSlot(this, GetManifestSlotName(BaseSlotName), UserIndex, FAsyncSaveGameToSlotDelegate::CreateUObject(this, &UYetiOS_SaveManifest::Internal_OnWriteComplete));
+}
+
+void UYetiOS_SaveManifest::Internal_OnWriteComplete(const FString& InSlotName, const int32 InUserIndex, bool bInSuccess)
+{
+	bIsWriting = false;
+	bLastWriteFailed = bInSuccess == false;
+	if (bLastWriteFailed)
+	{
+		printlog_error(FString::Printf(TEXT("Failed to write save manifest %s. It is written again with the next change."), *InSlotName));
+	}
+
+	if (bWriteAgain)
+	{
+		Internal_Write();
+	}
+}
+
+#undef printlog
+#undef printlog_error
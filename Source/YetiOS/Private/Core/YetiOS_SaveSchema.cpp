@@ -0,0 +1,211 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_SaveSchema.h"
+
+int32 FYetiOsSaveStringTable::Add(const FString& InString)
+{
+	if (const int32* Local_Found = IndexByString.Find(InString))
+	{
+		return *Local_Found;
+	}
+
+	const int32 Local_Index = Strings.Add(InString);
+	IndexByString.Add(InString, Local_Index);
+	return Local_Index;
+}
+
+const FString& FYetiOsSaveStringTable::Get(const int32 InIndex) const
+{
+	static const FString EmptyString;
+	return Strings.IsValidIndex(InIndex) ? Strings[InIndex] : EmptyString;
+}
+
+void FYetiOsSaveStringTable::Reset()
+{
+	Strings.Empty();
+	IndexByString.Empty();
+}
+
+FArchive& operator<<(FArchive& Ar, FYetiOsSaveStringTable& InTable)
+{
+	Ar << InTable.Strings;
+	if (Ar.IsLoading())
+	{
+		InTable.IndexByString.Empty();
+	}
+
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FYetiOsSaveDirectoryRecord& InRecord)
+{
+	FYetiOsSaveTree::SerializeIndex(Ar, InRecord.ParentIndex);
+	FYetiOsSaveTree::SerializeIndex(Ar, InRecord.NameIndex);
+	FYetiOsSaveTree::SerializeIndex(Ar, InRecord.ClassIndex);
+	Ar << InRecord.Flags;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FYetiOsSaveFileRecord& InRecord)
+{
+	FYetiOsSaveTree::SerializeIndex(Ar, InRecord.DirectoryIndex);
+	FYetiOsSaveTree::SerializeIndex(Ar, InRecord.ClassIndex);
+	FYetiOsSaveTree::SerializeIndex(Ar, InRecord.NameIndex);
+	FYetiOsSaveTree::SerializeIndex(Ar, InRecord.ExtensionIndex);
+	Ar << InRecord.Flags;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FYetiOsSaveFileIndexRecord& InRecord)
+{
+	FYetiOsSaveTree::SerializeIndex(Ar, InRecord.FileIndex);
+	Ar << InRecord.NameWords;
+	Ar << InRecord.ContentWords;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FYetiOsSaveFileContentRecord& InRecord)
+{
+	FYetiOsSaveTree::SerializeIndex(Ar, InRecord.FileIndex);
+	int64 Local_Size = 0;
+	if (Ar.IsLoading())
+	{
+		Ar << Local_Size;
+		if (Local_Size < 0 || Local_Size > MAX_int32)
+		{
+			Ar.SetError();
+			return Ar;
+		}
+
+		InRecord.Bytes.SetNumUninitialized(static_cast<int32>(Local_Size));
+		Ar.Serialize(InRecord.Bytes.GetData(), InRecord.Bytes.Num());
+	}
+	else
+	{
+		for (const FYetiOsContentChunkPtr& It : InRecord.Chunks)
+		{
+			Local_Size += It->Num();
+		}
+
+		// Chunks are written back to back so a load reads the content as one block.
+		Ar << Local_Size;
+		for (const FYetiOsContentChunkPtr& It : InRecord.Chunks)
+		{
+			Ar.Serialize(const_cast<uint8*>(It->GetData()), It->Num());
+		}
+	}
+
+	return Ar;
+}
+
+int32 FYetiOsSaveTree::AddDirectory(const int32 InParentIndex, const FString& InName, const FString& InClassPath, const uint8 InFlags)
+{
+	check(InParentIndex < Directories.Num());
+	FYetiOsSaveDirectoryRecord& Local_Record = Directories.AddDefaulted_GetRef();
+	Local_Record.ParentIndex = InParentIndex;
+	Local_Record.NameIndex = InName.IsEmpty() ? INDEX_NONE : Strings.Add(InName);
+	Local_Record.ClassIndex = InClassPath.IsEmpty() ? INDEX_NONE : Strings.Add(InClassPath);
+	Local_Record.Flags = InFlags;
+	return Directories.Num() - 1;
+}
+
+int32 FYetiOsSaveTree::AddFile(const int32 InDirectoryIndex, const FString& InClassPath, const FString& InName, const FString& InExtension, const uint8 InFlags)
+{
+	FYetiOsSaveFileRecord& Local_Record = Files.AddDefaulted_GetRef();
+	Local_Record.DirectoryIndex = InDirectoryIndex;
+	Local_Record.ClassIndex = Strings.Add(InClassPath);
+	Local_Record.NameIndex = Strings.Add(InName);
+	Local_Record.ExtensionIndex = Strings.Add(InExtension);
+	Local_Record.Flags = InFlags;
+	return Files.Num() - 1;
+}
+
+void FYetiOsSaveTree::AddFileIndex(const int32 InFileIndex, const TArray<FString>& InNameWords, const TArray<FString>& InContentWords)
+{
+	FYetiOsSaveFileIndexRecord& Local_Record = FileIndex.AddDefaulted_GetRef();
+	Local_Record.FileIndex = InFileIndex;
+	Local_Record.NameWords.Reserve(InNameWords.Num());
+	for (const FString& It : InNameWords)
+	{
+		Local_Record.NameWords.Add(Strings.Add(It));
+	}
+
+	Local_Record.ContentWords.Reserve(InContentWords.Num());
+	for (const FString& It : InContentWords)
+	{
+		Local_Record.ContentWords.Add(Strings.Add(It));
+	}
+}
+
+void FYetiOsSaveTree::AddFileContent(const int32 InFileIndex, const class UYetiOS_FileContent* InContent)
+{
+	check(Contents.Num() == 0 || Contents.Last().FileIndex <= InFileIndex);
+	FYetiOsSaveFileContentRecord& Local_Record = Contents.AddDefaulted_GetRef();
+	Local_Record.FileIndex = InFileIndex;
+	Local_Record.Chunks = InContent->GetChunks();
+}
+
+void FYetiOsSaveTree::Reset()
+{
+	Strings.Reset();
+	Directories.Empty();
+	Files.Empty();
+	FileIndex.Empty();
+	Contents.Empty();
+}
+
+void FYetiOsSaveTree::SerializeIndex(FArchive& Ar, int32& InOutIndex)
+{
+	// INDEX_NONE is stored as 0 so every index fits an unsigned packed integer.
+	uint32 Local_Packed = static_cast<uint32>(InOutIndex + 1);
+	Ar.SerializeIntPacked(Local_Packed);
+	InOutIndex = static_cast<int32>(Local_Packed) - 1;
+}
+
+FArchive& operator<<(FArchive& Ar, FYetiOsSaveTree& InTree)
+{
+	Ar << InTree.Strings;
+	Ar << InTree.Directories;
+	Ar << InTree.Files;
+	Ar << InTree.FileIndex;
+	return Ar;
+}
+
+void FYetiOsSaveTreeLoadState::Begin(const FYetiOsSaveTree& InSaveTree)
+{
+	Reset();
+
+	const int32 Local_NumDirectories = InSaveTree.Directories.Num();
+	NumChildDirectories.SetNumZeroed(Local_NumDirectories);
+	NumFiles.SetNumZeroed(Local_NumDirectories);
+	for (const FYetiOsSaveDirectoryRecord& It : InSaveTree.Directories)
+	{
+		if (NumChildDirectories.IsValidIndex(It.ParentIndex))
+		{
+			++NumChildDirectories[It.ParentIndex];
+		}
+	}
+
+	for (const FYetiOsSaveFileRecord& It : InSaveTree.Files)
+	{
+		if (NumFiles.IsValidIndex(It.DirectoryIndex))
+		{
+			++NumFiles[It.DirectoryIndex];
+		}
+	}
+
+	LoadedDirectories.Reserve(Local_NumDirectories);
+	LoadedFiles.Reserve(InSaveTree.Files.Num());
+}
+
+void FYetiOsSaveTreeLoadState::Reset()
+{
+	NumChildDirectories.Empty();
+	NumFiles.Empty();
+	ClassCache.Empty();
+	LoadedDirectories.Empty();
+	LoadedFiles.Empty();
+	NextContentRecord = 0;
+	DirectoriesToReconcile.Empty();
+}
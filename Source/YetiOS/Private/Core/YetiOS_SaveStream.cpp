@@ -0,0 +1,285 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_SaveStream.h"
+#include "Misc/Compression.h"
+#include "UObject/ObjectVersion.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsSaveStream, All, All)
+
+#define printlog_warn(Param1)			UE_LOG(LogYetiOsSaveStream, Warning, TEXT("%s"), *FString(Param1))
+#define printlog_error(Param1)			UE_LOG(LogYetiOsSaveStream, Error, TEXT("%s"), *FString(Param1))
+
+/** "YSAV". Saves written by UGameplayStatics start with "GVAS" instead. */
+static const uint32 SAVE_STREAM_MAGIC = 0x59534156;
+
+static const int32 SAVE_STREAM_VERSION = 1;
+
+/** Smallest chunk size a writer accepts. Smaller chunks compress poorly. */
+static const int32 SAVE_STREAM_MIN_CHUNK_SIZE = 16 * 1024;
+
+FYetiOsSaveStreamHeader::FYetiOsSaveStreamHeader()
+{
+	Magic = SAVE_STREAM_MAGIC;
+	StreamVersion = SAVE_STREAM_VERSION;
+	PackageFileUE4Version = GPackageFileUE4Version;
+	PackageFileLicenseeUE4Version = GPackageFileLicenseeUE4Version;
+	EngineVersion = FEngineVersion::Current();
+	ChunkSize = 0;
+	RawSize = 0;
+	ChunkTableOffset = 0;
+	CustomVersionsOffset = 0;
+}
+
+FArchive& operator<<(FArchive& Ar, FYetiOsSaveStreamHeader& InHeader)
+{
+	Ar << InHeader.Magic;
+	Ar << InHeader.StreamVersion;
+	if (Ar.IsLoading() && (InHeader.Magic != SAVE_STREAM_MAGIC || InHeader.StreamVersion > SAVE_STREAM_VERSION))
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << InHeader.CompressionFormat;
+	Ar << InHeader.PackageFileUE4Version;
+	Ar << InHeader.PackageFileLicenseeUE4Version;
+	Ar << InHeader.EngineVersion;
+	Ar << InHeader.SaveGameClassPath;
+	Ar << InHeader.ChunkSize;
+	Ar << InHeader.RawSize;
+	Ar << InHeader.ChunkTableOffset;
+	Ar << InHeader.CustomVersionsOffset;
+	return Ar;
+}
+
+FYetiOsSaveStreamWriter::FYetiOsSaveStreamWriter(TArray<uint8>& OutStreamBytes, const FString& InSaveGameClassPath, const FName& InCompressionFormat, const int32 InChunkSize)
+	: StreamBytes(OutStreamBytes)
+{
+	SetIsSaving(true);
+	SetIsPersistent(true);
+
+	CompressionFormat = InCompressionFormat;
+	if (CompressionFormat != NAME_None && FCompression::IsFormatValid(CompressionFormat) == false)
+	{
+		printlog_warn(FString::Printf(TEXT("Compression format %s is not available. Save is written uncompressed."), *CompressionFormat.ToString()));
+		CompressionFormat = NAME_None;
+	}
+
+	Header.CompressionFormat = CompressionFormat.ToString();
+	Header.SaveGameClassPath = InSaveGameClassPath;
+	Header.ChunkSize = FMath::Max(InChunkSize, SAVE_STREAM_MIN_CHUNK_SIZE);
+	ChunkBuffer.Reserve(Header.ChunkSize);
+
+	// Offsets are still zero here. Finish writes the header again once they are known, which does not change its size.
+	StreamBytes.Reset();
+	FMemoryWriter Local_Writer(StreamBytes, true);
+	Local_Writer << Header;
+}
+
+bool FYetiOsSaveStreamWriter::Finish()
+{
+	Internal_FlushChunk();
+
+	FMemoryWriter Local_Writer(StreamBytes, true);
+	Local_Writer.Seek(StreamBytes.Num());
+	Header.ChunkTableOffset = StreamBytes.Num();
+	Local_Writer << Chunks;
+
+	// Only versions the payload actually used are known once it is written, so they come after the chunks.
+	Header.CustomVersionsOffset = StreamBytes.Num();
+	FCustomVersionContainer Local_CustomVersions = GetCustomVersions();
+	Local_CustomVersions.Serialize(Local_Writer);
+
+	Local_Writer.Seek(0);
+	Local_Writer << Header;
+	return IsError() == false && Local_Writer.IsError() == false;
+}
+
+void FYetiOsSaveStreamWriter::Serialize(void* Data, int64 Num)
+{
+	const uint8* Local_Data = static_cast<const uint8*>(Data);
+	while (Num > 0)
+	{
+		const int32 Local_Count = static_cast<int32>(FMath::Min<int64>(Num, Header.ChunkSize - ChunkBuffer.Num()));
+		ChunkBuffer.Append(Local_Data, Local_Count);
+		Local_Data += Local_Count;
+		Num -= Local_Count;
+		if (ChunkBuffer.Num() == Header.ChunkSize)
+		{
+			Internal_FlushChunk();
+		}
+	}
+}
+
+void FYetiOsSaveStreamWriter::Internal_FlushChunk()
+{
+	if (ChunkBuffer.Num() == 0)
+	{
+		return;
+	}
+
+	FYetiOsSaveStreamChunk& Local_Chunk = Chunks.AddDefaulted_GetRef();
+	Local_Chunk.RawSize = ChunkBuffer.Num();
+	const int32 Local_ChunkOffset = StreamBytes.Num();
+	if (CompressionFormat != NAME_None)
+	{
+		int32 Local_CompressedSize = FCompression::CompressMemoryBound(CompressionFormat, Local_Chunk.RawSize);
+		StreamBytes.AddUninitialized(Local_CompressedSize);
+		if (FCompression::CompressMemory(CompressionFormat, StreamBytes.GetData() + Local_ChunkOffset, Local_CompressedSize, ChunkBuffer.GetData(), Local_Chunk.RawSize) && Local_CompressedSize < Local_Chunk.RawSize)
+		{
+			Local_Chunk.CompressedSize = Local_CompressedSize;
+		}
+
+		StreamBytes.SetNum(Local_ChunkOffset + Local_Chunk.CompressedSize, false);
+	}
+
+	if (Local_Chunk.CompressedSize == 0)
+	{
+		// Chunks that do not get smaller are stored as they are. Reader tells them apart by equal sizes.
+		Local_Chunk.CompressedSize = Local_Chunk.RawSize;
+		StreamBytes.Append(ChunkBuffer);
+	}
+
+	Header.RawSize += Local_Chunk.RawSize;
+	ChunkBuffer.Reset();
+}
+
+FYetiOsSaveStreamReader::FYetiOsSaveStreamReader(const TArray<uint8>& InStreamBytes)
+	: StreamBytes(InStreamBytes)
+{
+	SetIsLoading(true);
+	SetIsPersistent(true);
+	NextChunkOffset = 0;
+	NextChunkIndex = 0;
+	ChunkPosition = 0;
+	ChunkStart = 0;
+
+	FMemoryReader Local_Reader(StreamBytes, true);
+	Local_Reader << Header;
+	if (Local_Reader.IsError() || Header.ChunkTableOffset < Local_Reader.Tell() || Header.ChunkTableOffset > Header.CustomVersionsOffset || Header.CustomVersionsOffset > StreamBytes.Num())
+	{
+		printlog_error("Save stream header is not valid.");
+		SetError();
+		return;
+	}
+
+	NextChunkOffset = Local_Reader.Tell();
+	Local_Reader.Seek(Header.ChunkTableOffset);
+	Local_Reader << Chunks;
+
+	FCustomVersionContainer Local_CustomVersions;
+	Local_Reader.Seek(Header.CustomVersionsOffset);
+	Local_CustomVersions.Serialize(Local_Reader);
+	if (Local_Reader.IsError())
+	{
+		printlog_error("Save stream tables are damaged.");
+		SetError();
+		return;
+	}
+
+	CompressionFormat = FName(*Header.CompressionFormat);
+	if (CompressionFormat != NAME_None && FCompression::IsFormatValid(CompressionFormat) == false)
+	{
+		printlog_error(FString::Printf(TEXT("Save stream was compressed with %s which is not available."), *Header.CompressionFormat));
+		SetError();
+		return;
+	}
+
+	SetUE4Ver(Header.PackageFileUE4Version);
+	SetLicenseeUE4Ver(Header.PackageFileLicenseeUE4Version);
+	SetEngineVer(Header.EngineVersion);
+	SetCustomVersions(Local_CustomVersions);
+}
+
+bool FYetiOsSaveStreamReader::IsSaveStream(const TArray<uint8>& InBytes)
+{
+	uint32 Local_Magic = 0;
+	if (InBytes.Num() >= sizeof(Local_Magic))
+	{
+		FMemoryReader Local_Reader(InBytes);
+		Local_Reader << Local_Magic;
+	}
+
+	return Local_Magic == SAVE_STREAM_MAGIC;
+}
+
+void FYetiOsSaveStreamReader::Serialize(void* Data, int64 Num)
+{
+	uint8* Local_Data = static_cast<uint8*>(Data);
+	while (Num > 0)
+	{
+		if (IsError() || (ChunkPosition == ChunkBuffer.Num() && Internal_LoadNextChunk() == false))
+		{
+			SetError();
+			FMemory::Memzero(Local_Data, Num);
+			return;
+		}
+
+		const int32 Local_Count = static_cast<int32>(FMath::Min<int64>(Num, ChunkBuffer.Num() - ChunkPosition));
+		FMemory::Memcpy(Local_Data, ChunkBuffer.GetData() + ChunkPosition, Local_Count);
+		ChunkPosition += Local_Count;
+		Local_Data += Local_Count;
+		Num -= Local_Count;
+	}
+}
+
+void FYetiOsSaveStreamReader::Seek(int64 InPos)
+{
+	// Chunks are only decompressed in order so seeking works inside the current chunk and forward.
+	if (InPos < ChunkStart || InPos > Header.RawSize)
+	{
+		printlog_error(FString::Printf(TEXT("Cannot seek save stream back to %lld."), InPos));
+		SetError();
+		return;
+	}
+
+	while (InPos > ChunkStart + ChunkBuffer.Num())
+	{
+		if (Internal_LoadNextChunk() == false)
+		{
+			SetError();
+			return;
+		}
+	}
+
+	ChunkPosition = static_cast<int32>(InPos - ChunkStart);
+}
+
+bool FYetiOsSaveStreamReader::Internal_LoadNextChunk()
+{
+	if (Chunks.IsValidIndex(NextChunkIndex) == false)
+	{
+		return false;
+	}
+
+	const FYetiOsSaveStreamChunk& Local_Chunk = Chunks[NextChunkIndex];
+	if (Local_Chunk.RawSize <= 0 || Local_Chunk.CompressedSize <= 0 || NextChunkOffset + Local_Chunk.CompressedSize > Header.ChunkTableOffset)
+	{
+		printlog_error(FString::Printf(TEXT("Chunk %i of save stream is damaged."), NextChunkIndex));
+		return false;
+	}
+
+	ChunkStart += ChunkBuffer.Num();
+	ChunkPosition = 0;
+	ChunkBuffer.SetNumUninitialized(Local_Chunk.RawSize, false);
+	const uint8* Local_ChunkData = StreamBytes.GetData() + NextChunkOffset;
+	if (Local_Chunk.CompressedSize == Local_Chunk.RawSize)
+	{
+		FMemory::Memcpy(ChunkBuffer.GetData(), Local_ChunkData, Local_Chunk.RawSize);
+	}
+	else if (CompressionFormat == NAME_None || FCompression::UncompressMemory(CompressionFormat, ChunkBuffer.GetData(), Local_Chunk.RawSize, Local_ChunkData, Local_Chunk.CompressedSize) == false)
+	{
+		printlog_error(FString::Printf(TEXT("Failed to decompress chunk %i of save stream."), NextChunkIndex));
+		return false;
+	}
+
+	NextChunkOffset += Local_Chunk.CompressedSize;
+	++NextChunkIndex;
+	return true;
+}
+
+#undef printlog_warn
+#undef printlog_error
@@ -0,0 +1,361 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Core/YetiOS_SearchService.h"
+#include "Core/YetiOS_DirectoryBase.h"
+#include "Core/YetiOS_FileBase.h"
+#include "Core/YetiOS_Core.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsSearchService, All, All)
+
+#define printlog_veryverbose(Param1)	UE_LOG(LogYetiOsSearchService, VeryVerbose, TEXT("%s"), *FString(Param1))
+
+/** Number of snapshot entries matched by one ParallelFor task. */
+static const int32 ENTRIES_PER_BATCH = 512;
+
+/** Maximum number of matches handed to On Results in one frame. */
+static const int32 MAX_RESULTS_PER_DELIVERY = 256;
+
+FYetiOsSearchService::FYetiOsSearchService()
+{
+	NextSearchID = 0;
+}
+
+FYetiOsSearchService::~FYetiOsSearchService()
+{
+	Reset();
+}
+
+int32 FYetiOsSearchService::StartSearch(class UYetiOS_DirectoryBase* InStartDirectory, const FYetiOsSearchQuery& InQuery, const FOnSearchResults& InOnResults, const FOnSearchFinished& InOnFinished)
+{
+	if (InStartDirectory == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	FSearch& Local_Search = Searches.AddDefaulted_GetRef();
+	Local_Search.SearchID = NextSearchID++;
+	Local_Search.State = MakeShared<FSearchState, ESPMode::ThreadSafe>();
+	Local_Search.State->Query = InQuery;
+	Local_Search.OnResults = InOnResults;
+	Local_Search.OnFinished = InOnFinished;
+	Local_Search.PendingDirectories.Add(InStartDirectory);
+	Local_Search.bIsMatching = false;
+
+	if (InQuery.ContentText.IsEmpty() == false)
+	{
+		const FString Local_Text = InQuery.bCaseSensitive ? InQuery.ContentText : InQuery.ContentText.ToLower();
+		const FTCHARToUTF8 Local_Converted(*Local_Text);
+		Local_Search.State->ContentNeedle.Append(reinterpret_cast<const uint8*>(Local_Converted.Get()), Local_Converted.Length());
+	}
+
+	printlog_veryverbose(FString::Printf(TEXT("Started search %i in %s."), Local_Search.SearchID, *InStartDirectory->GetDirectoryName().ToString()));
+	return Local_Search.SearchID;
+}
+
+bool FYetiOsSearchService::CancelSearch(const int32 InSearchID)
+{
+	const int32 Local_Index = Searches.IndexOfByPredicate([InSearchID](const FSearch& It) { return It.SearchID == InSearchID; });
+	if (Local_Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Worker keeps its own reference to the state and stops at the next entry.
+	const FSearch Local_Search = Searches[Local_Index];
+	Local_Search.State->bCancelled = true;
+	Searches.RemoveAt(Local_Index);
+	Local_Search.OnFinished.ExecuteIfBound(InSearchID, true);
+	return true;
+}
+
+void FYetiOsSearchService::Tick(const double InBudgetSeconds)
+{
+	const double Local_Deadline = FPlatformTime::Seconds() + InBudgetSeconds;
+
+	// Delegates can start or cancel searches so work on a copy of the IDs.
+	TArray<int32> Local_SearchIDs;
+	Local_SearchIDs.Reserve(Searches.Num());
+	for (const FSearch& It : Searches)
+	{
+		Local_SearchIDs.Add(It.SearchID);
+	}
+
+	for (const int32& It : Local_SearchIDs)
+	{
+		FSearch* Local_Search = Searches.FindByPredicate([It](const FSearch& Search) { return Search.SearchID == It; });
+		if (Local_Search == nullptr)
+		{
+			continue;
+		}
+
+		if (Local_Search->bIsMatching == false)
+		{
+			if (Internal_Snapshot(*Local_Search, Local_Deadline))
+			{
+				printlog_veryverbose(FString::Printf(TEXT("Search %i matching %i entries."), It, Local_Search->State->Entries.Num()));
+				Local_Search->bIsMatching = true;
+				FSearchStatePtr Local_State = Local_Search->State;
+				Async(EAsyncExecution::ThreadPool, [Local_State]() { Internal_Match(Local_State); });
+			}
+			continue;
+		}
+
+		const bool bLocal_Finished = Local_Search->State->bFinished;
+		Internal_DeliverMatches(*Local_Search);
+
+		Local_Search = Searches.FindByPredicate([It](const FSearch& Search) { return Search.SearchID == It; });
+		if (bLocal_Finished && Local_Search && Local_Search->State->PendingMatches.Num() == 0)
+		{
+			const FOnSearchFinished Local_OnFinished = Local_Search->OnFinished;
+			Searches.RemoveAll([It](const FSearch& Search) { return Search.SearchID == It; });
+			Local_OnFinished.ExecuteIfBound(It, false);
+		}
+	}
+}
+
+void FYetiOsSearchService::Reset()
+{
+	for (FSearch& It : Searches)
+	{
+		It.State->bCancelled = true;
+	}
+
+	Searches.Empty();
+}
+
+bool FYetiOsSearchService::IsSearchRunning(const int32 InSearchID) const
+{
+	return Searches.ContainsByPredicate([InSearchID](const FSearch& It) { return It.SearchID == InSearchID; });
+}
+
+bool FYetiOsSearchService::Internal_Snapshot(FSearch& InSearch, const double InDeadline) const
+{
+	const FYetiOsSearchQuery& Local_Query = InSearch.State->Query;
+	const bool bLocal_SearchContent = InSearch.State->ContentNeedle.Num() > 0;
+	TArray<FSearchEntry>& Local_Entries = InSearch.State->Entries;
+
+	// Always copy at least one directory so a search makes progress even with no budget left.
+	do
+	{
+		if (InSearch.PendingDirectories.Num() == 0)
+		{
+			break;
+		}
+
+		UYetiOS_DirectoryBase* Local_Directory = InSearch.PendingDirectories.Pop(false).Get();
+		if (Local_Directory == nullptr)
+		{
+			continue;
+		}
+
+		Local_Directory->Materialize();
+		const FString Local_DirectoryPath = Local_Directory->GetFullPath();
+		for (UYetiOS_DirectoryBase* It : Local_Directory->ChildDirectories)
+		{
+			if (It && (Local_Query.bIncludeHidden || It->bIsHidden == false))
+			{
+				InSearch.PendingDirectories.Add(It);
+				if (Local_Query.bIncludeDirectories && bLocal_SearchContent == false)
+				{
+					FSearchEntry& Local_Entry = Local_Entries.AddDefaulted_GetRef();
+					Local_Entry.Directory = It;
+					Local_Entry.Name = It->DirectoryName.ToString();
+					Local_Entry.Path = It->GetFullPath();
+				}
+			}
+		}
+
+		for (UYetiOS_FileBase* It : Local_Directory->Files)
+		{
+			if (It == nullptr || (Local_Query.bIncludeHidden == false && It->bIsHidden))
+			{
+				continue;
+			}
+
+			FSearchEntry& Local_Entry = Local_Entries.AddDefaulted_GetRef();
+			Local_Entry.Directory = Local_Directory;
+			Local_Entry.File = It;
+			Local_Entry.Name = It->GetFilename(true).ToString();
+			Local_Entry.Extension = It->Extension.ToString();
+			Local_Entry.Path = Local_DirectoryPath / Local_Entry.Name;
+			if (bLocal_SearchContent && It->FileContent)
+			{
+				Local_Entry.Chunks = It->FileContent->GetChunks();
+			}
+		}
+	}
+	while (FPlatformTime::Seconds() < InDeadline);
+
+	return InSearch.PendingDirectories.Num() == 0;
+}
+
+void FYetiOsSearchService::Internal_DeliverMatches(FSearch& InSearch) const
+{
+	TArray<TPair<int32, int64>> Local_Matches;
+	{
+		FScopeLock Local_Lock(&InSearch.State->MatchesLock);
+		const int32 Local_Count = FMath::Min(InSearch.State->PendingMatches.Num(), MAX_RESULTS_PER_DELIVERY);
+		Local_Matches.Append(InSearch.State->PendingMatches.GetData(), Local_Count);
+		InSearch.State->PendingMatches.RemoveAt(0, Local_Count, false);
+	}
+
+	if (Local_Matches.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FYetiOsSearchResult> Local_Results;
+	Local_Results.Reserve(Local_Matches.Num());
+	for (const TPair<int32, int64>& It : Local_Matches)
+	{
+		const FSearchEntry& Local_Entry = InSearch.State->Entries[It.Key];
+
+		// Entries removed after the snapshot was taken are dropped.
+		UYetiOS_DirectoryBase* Local_Directory = Local_Entry.Directory.Get();
+		UYetiOS_FileBase* Local_File = Local_Entry.File.Get();
+		if (Local_Directory == nullptr || (Local_Entry.File.IsExplicitlyNull() == false && Local_File == nullptr))
+		{
+			continue;
+		}
+
+		FYetiOsSearchResult& Local_Result = Local_Results.AddDefaulted_GetRef();
+		Local_Result.Directory = Local_Directory;
+		Local_Result.File = Local_File;
+		Local_Result.Path = Local_Entry.Path;
+		Local_Result.ContentOffset = It.Value;
+	}
+
+	if (Local_Results.Num() > 0)
+	{
+		InSearch.OnResults.ExecuteIfBound(InSearch.SearchID, Local_Results);
+	}
+}
+
+void FYetiOsSearchService::Internal_Match(const FSearchStatePtr& InState)
+{
+	const FYetiOsSearchQuery& Local_Query = InState->Query;
+	const ESearchCase::Type Local_Case = Local_Query.bCaseSensitive ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase;
+	const bool bLocal_MatchName = Local_Query.NamePattern.IsEmpty() == false && Local_Query.NamePattern != TEXT("*");
+	const bool bLocal_MatchExtension = Local_Query.Extension.IsEmpty() == false && Local_Query.Extension != TEXT("*");
+	const int32 Local_NumBatches = FMath::DivideAndRoundUp(InState->Entries.Num(), ENTRIES_PER_BATCH);
+
+	ParallelFor(Local_NumBatches, [&](const int32 InBatch)
+	{
+		TArray<TPair<int32, int64>> Local_BatchMatches;
+		const int32 Local_End = FMath::Min((InBatch + 1) * ENTRIES_PER_BATCH, InState->Entries.Num());
+		for (int32 i = InBatch * ENTRIES_PER_BATCH; i < Local_End; ++i)
+		{
+			if (InState->bCancelled || (Local_Query.MaxResults > 0 && InState->NumMatches.GetValue() >= Local_Query.MaxResults))
+			{
+				break;
+			}
+
+			const FSearchEntry& Local_Entry = InState->Entries[i];
+			if (bLocal_MatchExtension && Local_Entry.Extension.Equals(Local_Query.Extension, Local_Case) == false)
+			{
+				continue;
+			}
+
+			if (bLocal_MatchName && Local_Entry.Name.MatchesWildcard(Local_Query.NamePattern, Local_Case) == false)
+			{
+				continue;
+			}
+
+			int64 Local_Offset = INDEX_NONE;
+			if (InState->ContentNeedle.Num() > 0)
+			{
+				Local_Offset = Internal_FindInChunks(Local_Entry.Chunks, InState->ContentNeedle, Local_Query.bCaseSensitive, InState->bCancelled);
+				if (Local_Offset == INDEX_NONE)
+				{
+					continue;
+				}
+			}
+
+			const int32 Local_NumMatches = InState->NumMatches.Increment();
+			if (Local_Query.MaxResults > 0 && Local_NumMatches > Local_Query.MaxResults)
+			{
+				break;
+			}
+
+			Local_BatchMatches.Emplace(i, Local_Offset);
+		}
+
+		if (Local_BatchMatches.Num() > 0)
+		{
+			FScopeLock Local_Lock(&InState->MatchesLock);
+			InState->PendingMatches.Append(MoveTemp(Local_BatchMatches));
+		}
+	});
+
+	InState->bFinished = true;
+}
+
+int64 FYetiOsSearchService::Internal_FindInChunks(const TArray<FYetiOsContentChunkPtr>& InChunks, const TArray<uint8>& InNeedle, const bool bCaseSensitive, const FThreadSafeBool& InCancelled)
+{
+	const int32 Local_NeedleSize = InNeedle.Num();
+	auto Local_Find = [&InNeedle, Local_NeedleSize, bCaseSensitive](const uint8* InData, const int32 InSize, const int32 InStart) -> int32
+	{
+		for (int32 i = InStart; i <= InSize - Local_NeedleSize; ++i)
+		{
+			int32 j = 0;
+			for (; j < Local_NeedleSize; ++j)
+			{
+				const uint8 Local_Byte = InData[i + j];
+				const uint8 Local_Folded = (bCaseSensitive == false && Local_Byte >= 'A' && Local_Byte <= 'Z') ? Local_Byte + ('a' - 'A') : Local_Byte;
+				if (Local_Folded != InNeedle[j])
+				{
+					break;
+				}
+			}
+
+			if (j == Local_NeedleSize)
+			{
+				return i;
+			}
+		}
+
+		return INDEX_NONE;
+	};
+
+	// Tail of the previous chunk joined with the head of the current one, so matches across a boundary are found.
+	TArray<uint8> Local_Boundary;
+	int64 Local_ChunkStart = 0;
+	for (const FYetiOsContentChunkPtr& It : InChunks)
+	{
+		if (InCancelled)
+		{
+			return INDEX_NONE;
+		}
+
+		const uint8* Local_Data = It->GetData();
+		const int32 Local_Size = It->Num();
+		if (Local_Boundary.Num() > 0)
+		{
+			const int32 Local_TailSize = Local_Boundary.Num();
+			Local_Boundary.Append(Local_Data, FMath::Min(Local_Size, Local_NeedleSize - 1));
+			const int32 Local_Found = Local_Find(Local_Boundary.GetData(), Local_Boundary.Num(), 0);
+			if (Local_Found != INDEX_NONE)
+			{
+				return Local_ChunkStart - Local_TailSize + Local_Found;
+			}
+		}
+
+		const int32 Local_Found = Local_Find(Local_Data, Local_Size, 0);
+		if (Local_Found != INDEX_NONE)
+		{
+			return Local_ChunkStart + Local_Found;
+		}
+
+		const int32 Local_Keep = FMath::Min(Local_Size, Local_NeedleSize - 1);
+		Local_Boundary.Reset();
+		Local_Boundary.Append(Local_Data + Local_Size - Local_Keep, Local_Keep);
+		Local_ChunkStart += Local_Size;
+	}
+
+	return INDEX_NONE;
+}
+
+#undef printlog_veryverbose
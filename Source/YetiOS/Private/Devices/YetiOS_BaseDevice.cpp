@@ -46,6 +46,16 @@ UYetiOS_BaseDevice::UYetiOS_BaseDevice()
 	CurrentDeviceState = EYetiOsDeviceState::STATE_None;
 	SaveGameClass = UYetiOS_SaveGame::StaticClass();
 	bForceGarbageCollectionWhenDeviceIsDestroyed = false;
+	AutosaveIntervalInSeconds = 0.f;
+	bIsSaving = false;
+	bSaveRequestedWhileSaving = false;
+	bDestroyAfterSave = false;
+	bRestartAfterSave = false;
+	BootFrameBudgetInMs = 8.f;
+	bEnableChangeJournal = true;
+	ChangeJournalCompactionThresholdInKB = 256;
+	BootStage = EYetiOsDeviceBootStage::BOOT_None;
+	BootSaveGame = nullptr;
 }
 
 FText UYetiOS_BaseDevice::GetMonthName(const FDateTime& InDateTime, const bool bShort /*= false*/)
@@ -122,6 +132,7 @@ EYetiOsDeviceStartResult UYetiOS_BaseDevice::StartDevice(FYetiOsError& OutErrorM
 		return EYetiOsDeviceStartResult::DEVICESTART_HardwareFail;
 	}
 
+	Internal_ClearFileContentPath();
 	const UYetiOS_SaveGame* LoadGameInstance = UYetiOS_SaveGame::LoadGame(this);
 	LoadSavedData(LoadGameInstance);
 
@@ -133,7 +144,6 @@ EYetiOsDeviceStartResult UYetiOS_BaseDevice::StartDevice(FYetiOsError& OutErrorM
 		if (OperatingSystem)
 		{
 			OperatingSystem->OnOperatingSystemLoadedFromSaveGame(LoadGameInstance, OutErrorMessage);
-			
 		}
 		else
 		{
@@ -141,16 +151,46 @@ EYetiOsDeviceStartResult UYetiOS_BaseDevice::StartDevice(FYetiOsError& OutErrorM
 		}
 	}
 	
-	CREATE_PHYSICAL_DIR(Internal_GetBasePath());
-	CREATE_PHYSICAL_DIR(Internal_GetSavePath(this));
-	CREATE_PHYSICAL_DIR(Internal_GetLoginWallpapersPath(this));
-	CREATE_PHYSICAL_DIR(Internal_GetDesktopWallpapersPath(this));
-	CREATE_PHYSICAL_DIR(Internal_UserIconsPath(this));
-
+	Internal_CreatePhysicalDirectories();
 	UpdateDeviceState(EYetiOsDeviceState::STATE_Starting);
+	OnFinishStartingDevice();
 	return EYetiOsDeviceStartResult::DEVICESTART_Success;
 }
 
+bool UYetiOS_BaseDevice::StartDeviceAsync()
+{
+	if (IsBooting())
+	{
+		printlog_warn(FString::Printf(TEXT("%s is already booting."), *DeviceName.ToString()));
+		return false;
+	}
+
+	printlog(FString::Printf(TEXT("Trying to start %s in background"), *DeviceName.ToString()));
+	BootErrorMessage = FYetiOsError();
+	BootStage = EYetiOsDeviceBootStage::BOOT_Hardware;
+	Internal_ReportBootProgress();
+	TimerHandle_Boot = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_BaseDevice::Internal_BootTick);
+	return true;
+}
+
+float UYetiOS_BaseDevice::GetBootProgress() const
+{
+	switch (BootStage)
+	{
+		case EYetiOsDeviceBootStage::BOOT_LoadSaveGame:
+			return 0.05f;
+		case EYetiOsDeviceBootStage::BOOT_OperatingSystem:
+			// Building the operating system takes most of the boot.
+			return 0.15f + (OperatingSystem ? OperatingSystem->GetSaveGameLoadProgress(BootSaveGame) * 0.8f : 0.f);
+		case EYetiOsDeviceBootStage::BOOT_Finishing:
+			return 0.95f;
+		default:
+			break;
+	}
+
+	return 0.f;
+}
+
 void UYetiOS_BaseDevice::ChangeOnScreenWidget(class UUserWidget* InNewWidget /*= nullptr*/)
 {
 	if (OnScreenWidget && OnScreenWidget->IsInViewport())
@@ -222,13 +262,17 @@ const bool UYetiOS_BaseDevice::UpdateDeviceState(EYetiOsDeviceState InNewState,
 						UpdateDeviceState(EYetiOsDeviceState::STATE_BSOD);
 						return false;
 					}
+
+					if (AutosaveIntervalInSeconds > 0.f)
+					{
+						GetWorld()->GetTimerManager().SetTimer(TimerHandle_Autosave, this, &UYetiOS_BaseDevice::Internal_Autosave, AutosaveIntervalInSeconds, true);
+					}
 				}
 				break;
 			case EYetiOsDeviceState::STATE_PowerOff:
 				{
 					GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
-					const bool bSaveSuccess = UYetiOS_SaveGame::SaveGame(this);
-					printlog(FString::Printf(TEXT("Save game state: %s"), bSaveSuccess ? *FString("Success!") : *FString("Failed :(")));
+					SaveDevice();
 					OperatingSystem->ShutdownOS();
 					const float TimeToShutdown = FMath::RandRange(1.f, 5.f);
 					FTimerHandle TimerHandle_Dummy;
@@ -239,8 +283,7 @@ const bool UYetiOS_BaseDevice::UpdateDeviceState(EYetiOsDeviceState InNewState,
 			case EYetiOsDeviceState::STATE_Restart:
 				{
 					GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
-					const bool bSaveSuccess = UYetiOS_SaveGame::SaveGame(this);
-					printlog(FString::Printf(TEXT("Save game state: %s"), bSaveSuccess ? *FString("Success!") : *FString("Failed :(")));
+					SaveDevice();
 					OperatingSystem->RestartOS();
 					const float TimeToRestart = FMath::RandRange(1.f, 5.f);
 					GetOuter()->GetWorld()->GetTimerManager().SetTimer(TimerHandle_Restart, this, &UYetiOS_BaseDevice::DestroyYetiDeviceAndRestart, TimeToRestart, false);
@@ -284,6 +327,14 @@ void UYetiOS_BaseDevice::OnFinishInstallingOperatingSystem()
 
 void UYetiOS_BaseDevice::DestroyYetiDevice()
 {
+	// Files and directories referenced by the save game must outlive the write.
+	if (bIsSaving)
+	{
+		printlog(FString::Printf(TEXT("%s is still saving. Shutdown continues once save finishes."), *DeviceName.ToString()));
+		bDestroyAfterSave = true;
+		return;
+	}
+
 	Internal_DestroyDevice();
 	AYetiOS_DeviceManagerActor* OwningDeviceManager = Cast<AYetiOS_DeviceManagerActor>(GetOuter());	
 	OwningDeviceManager->OnCurrentDeviceDestroyed();
@@ -291,13 +342,224 @@ void UYetiOS_BaseDevice::DestroyYetiDevice()
 
 void UYetiOS_BaseDevice::DestroyYetiDeviceAndRestart()
 {
+	if (bIsSaving)
+	{
+		printlog(FString::Printf(TEXT("%s is still saving. Restart continues once save finishes."), *DeviceName.ToString()));
+		bRestartAfterSave = true;
+		return;
+	}
+
 	Internal_DestroyDevice();
 	AYetiOS_DeviceManagerActor* OwningDeviceManager = Cast<AYetiOS_DeviceManagerActor>(GetOuter());
 	OwningDeviceManager->RestartDevice();
 }
 
+bool UYetiOS_BaseDevice::SaveDevice()
+{
+	if (bIsSaving)
+	{
+		bSaveRequestedWhileSaving = true;
+		return true;
+	}
+
+	// Completion runs right away if nothing could be captured, which clears bIsSaving again.
+	bIsSaving = true;
+	if (OperatingSystem)
+	{
+		OperatingSystem->Internal_BeginJournalCompaction();
+	}
+
+	SaveGameFuture = UYetiOS_SaveGame::SaveGameAsync(this, FOnYetiOsSaveGameComplete::CreateUObject(this, &UYetiOS_BaseDevice::Internal_OnSaveComplete));
+	return bIsSaving;
+}
+
+void UYetiOS_BaseDevice::WaitForSave()
+{
+	if (bIsSaving && SaveGameFuture.IsValid())
+	{
+		printlog(FString::Printf(TEXT("Waiting for %s to finish saving..."), *DeviceName.ToString()));
+		SaveGameFuture.Wait();
+	}
+
+	// Completion still reaches the game thread later but there is nothing left for it to do.
+	bIsSaving = false;
+	bSaveRequestedWhileSaving = false;
+	bDestroyAfterSave = false;
+	bRestartAfterSave = false;
+}
+
+void UYetiOS_BaseDevice::Internal_OnSaveComplete(const bool bWasSuccessful)
+{
+	if (bIsSaving == false)
+	{
+		return;
+	}
+
+	bIsSaving = false;
+	SaveGameFuture.Reset();
+	if (OperatingSystem)
+	{
+		OperatingSystem->Internal_EndJournalCompaction(bWasSuccessful);
+	}
+
+	printlog(FString::Printf(TEXT("Save game state: %s"), bWasSuccessful ? *FString("Success!") : *FString("Failed :(")));
+	OnDeviceSaved.Broadcast(bWasSuccessful);
+
+	if (bSaveRequestedWhileSaving)
+	{
+		// Destroy or restart stays pending until this save finishes as well.
+		bSaveRequestedWhileSaving = false;
+		SaveDevice();
+	}
+	else if (bDestroyAfterSave)
+	{
+		bDestroyAfterSave = false;
+		DestroyYetiDevice();
+	}
+	else if (bRestartAfterSave)
+	{
+		bRestartAfterSave = false;
+		DestroyYetiDeviceAndRestart();
+	}
+}
+
+void UYetiOS_BaseDevice::Internal_Autosave()
+{
+	if (CurrentDeviceState == EYetiOsDeviceState::STATE_Running && bIsSaving == false)
+	{
+		SaveDevice();
+	}
+}
+
+void UYetiOS_BaseDevice::Internal_BootTick()
+{
+	TimerHandle_Boot.Invalidate();
+	switch (BootStage)
+	{
+		case EYetiOsDeviceBootStage::BOOT_Hardware:
+			DeviceMotherboard = UYetiOS_Motherboard::CreateMotherboard(this, BootErrorMessage);
+			if (DeviceMotherboard == nullptr)
+			{
+				Internal_FinishBoot(EYetiOsDeviceStartResult::DEVICESTART_HardwareFail);
+				return;
+			}
+
+			// Save game is read and deserialized on a worker thread. Boot continues from the completion callback.
+			Internal_ClearFileContentPath();
+			BootStage = EYetiOsDeviceBootStage::BOOT_LoadSaveGame;
+			Internal_ReportBootProgress();
+			UYetiOS_SaveGame::LoadGameAsync(this, FOnYetiOsLoadGameComplete::CreateUObject(this, &UYetiOS_BaseDevice::Internal_OnBootSaveGameLoaded));
+			return;
+		case EYetiOsDeviceBootStage::BOOT_OperatingSystem:
+			if (OperatingSystem == nullptr)
+			{
+				OperatingSystem = UYetiOS_Core::CreateOperatingSystem(this, BootErrorMessage);
+
+				// If the OS is still null for some reason.
+				if (OperatingSystem == nullptr)
+				{
+					Internal_FinishBoot(EYetiOsDeviceStartResult::DEVICESTART_NoOs);
+					return;
+				}
+
+				if (BootSaveGame)
+				{
+					OperatingSystem->BeginLoadFromSaveGame(BootSaveGame);
+				}
+				else
+				{
+					OperatingSystem->Internal_OpenChangeJournal(nullptr);
+				}
+			}
+
+			if (BootSaveGame == nullptr || OperatingSystem->ContinueLoadFromSaveGame(BootSaveGame, BootFrameBudgetInMs / 1000.0, BootErrorMessage))
+			{
+				BootStage = EYetiOsDeviceBootStage::BOOT_Finishing;
+			}
+			break;
+		case EYetiOsDeviceBootStage::BOOT_Finishing:
+			Internal_CreatePhysicalDirectories();
+			Internal_FinishBoot(EYetiOsDeviceStartResult::DEVICESTART_Success);
+			return;
+		default:
+			return;
+	}
+
+	Internal_ReportBootProgress();
+	TimerHandle_Boot = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_BaseDevice::Internal_BootTick);
+}
+
+void UYetiOS_BaseDevice::Internal_OnBootSaveGameLoaded(class UYetiOS_SaveGame* InLoadedGame)
+{
+	// Device may have been destroyed while the save game was being read.
+	if (BootStage != EYetiOsDeviceBootStage::BOOT_LoadSaveGame)
+	{
+		return;
+	}
+
+	BootSaveGame = InLoadedGame;
+	LoadSavedData(BootSaveGame);
+
+	// Same as StartDevice, an existing OS is kept as it is.
+	BootStage = OperatingSystem ? EYetiOsDeviceBootStage::BOOT_Finishing : EYetiOsDeviceBootStage::BOOT_OperatingSystem;
+	Internal_ReportBootProgress();
+	TimerHandle_Boot = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UYetiOS_BaseDevice::Internal_BootTick);
+}
+
+void UYetiOS_BaseDevice::Internal_FinishBoot(const EYetiOsDeviceStartResult InResult)
+{
+	BootStage = EYetiOsDeviceBootStage::BOOT_None;
+	BootSaveGame = nullptr;
+	if (InResult == EYetiOsDeviceStartResult::DEVICESTART_Success)
+	{
+		if (DeviceWidget)
+		{
+			DeviceWidget->K2_OnBootProgress(EYetiOsDeviceBootStage::BOOT_Finishing, 1.f);
+		}
+
+		UpdateDeviceState(EYetiOsDeviceState::STATE_Starting);
+		OnFinishStartingDevice();
+	}
+	else
+	{
+		printlog_error(FString::Printf(TEXT("Failed to start %s. Reason: %s"), *DeviceName.ToString(), *BootErrorMessage.ErrorException.ToString()));
+	}
+
+	OnDeviceStartFinished.Broadcast(InResult, BootErrorMessage);
+}
+
+void UYetiOS_BaseDevice::Internal_ReportBootProgress()
+{
+	if (DeviceWidget)
+	{
+		DeviceWidget->K2_OnBootProgress(BootStage, GetBootProgress());
+	}
+}
+
+void UYetiOS_BaseDevice::Internal_CreatePhysicalDirectories()
+{
+	CREATE_PHYSICAL_DIR(Internal_GetBasePath());
+	CREATE_PHYSICAL_DIR(Internal_GetSavePath(this));
+	CREATE_PHYSICAL_DIR(Internal_GetLoginWallpapersPath(this));
+	CREATE_PHYSICAL_DIR(Internal_GetDesktopWallpapersPath(this));
+	CREATE_PHYSICAL_DIR(Internal_UserIconsPath(this));
+}
+
+void UYetiOS_BaseDevice::Internal_ClearFileContentPath()
+{
+	// Spilled file content only lives as long as the session that wrote it. Content is spilled again as it is loaded or written.
+	IFileManager::Get().DeleteDirectory(*Internal_GetFileContentPath(this), false, true);
+}
+
 void UYetiOS_BaseDevice::Internal_DestroyDevice()
 {
+	if (IsBooting())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_Boot);
+		BootStage = EYetiOsDeviceBootStage::BOOT_None;
+		BootSaveGame = nullptr;
+	}
+
 	if (OperatingSystem)
 	{
 		OperatingSystem->DestroyOS();
@@ -310,6 +572,60 @@ void UYetiOS_BaseDevice::Internal_DestroyDevice()
 	printlog_veryverbose(FString::Printf(TEXT("Destroyed device '%s'"), *DeviceName.ToString()));
 }
 
+void UYetiOS_BaseDevice::Internal_DetachDevice(UObject* InNewOuter)
+{
+	// Completion would reach the game thread after the level is gone, so it runs here instead.
+	if (bIsSaving && SaveGameFuture.IsValid())
+	{
+		printlog(FString::Printf(TEXT("Waiting for %s to finish saving before detaching..."), *DeviceName.ToString()));
+		bSaveRequestedWhileSaving = false;
+		Internal_OnSaveComplete(SaveGameFuture.Get());
+	}
+
+	OnDeviceDetached();
+	GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
+	TimerHandle_Autosave.Invalidate();
+	OperatingSystem->Internal_DetachFromWorld(DetachedRunningPrograms);
+
+	ChangeOnScreenWidget();
+	DeviceWidget = nullptr;
+	BsodWidget = nullptr;
+
+	// Devices of every manager share the same default names, so a unique one is picked in the new outer.
+	Rename(*MakeUniqueObjectName(InNewOuter, GetClass()).ToString(), InNewOuter, REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional | REN_ForceNoResetLoaders);
+	printlog(FString::Printf(TEXT("Detached device '%s'."), *DeviceName.ToString()));
+}
+
+void UYetiOS_BaseDevice::Internal_AttachDevice(class AYetiOS_DeviceManagerActor* InDeviceManager)
+{
+	Rename(*MakeUniqueObjectName(InDeviceManager, GetClass()).ToString(), InDeviceManager, REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional | REN_ForceNoResetLoaders);
+	DeviceWidget = UYetiOS_DeviceWidget::Internal_CreateDeviceWidget(this);
+	OperatingSystem->Internal_AttachToWorld(DetachedRunningPrograms);
+	DetachedRunningPrograms.Empty();
+	ChangeOnScreenWidget(OperatingSystem->GetOsWidget());
+
+	if (AutosaveIntervalInSeconds > 0.f)
+	{
+		GetWorld()->GetTimerManager().SetTimer(TimerHandle_Autosave, this, &UYetiOS_BaseDevice::Internal_Autosave, AutosaveIntervalInSeconds, true);
+	}
+
+	OnDeviceAttached();
+	printlog(FString::Printf(TEXT("Attached device '%s' to %s."), *DeviceName.ToString(), *InDeviceManager->GetName()));
+}
+
+void UYetiOS_BaseDevice::Internal_DestroyDetachedDevice()
+{
+	if (OperatingSystem)
+	{
+		OperatingSystem->DestroyOS();
+		OperatingSystem = nullptr;
+	}
+
+	DetachedRunningPrograms.Empty();
+	printlog_veryverbose(FString::Printf(TEXT("Destroyed detached device '%s'"), *DeviceName.ToString()));
+	ConditionalBeginDestroy();
+}
+
 const bool UYetiOS_BaseDevice::Internal_InstallHardware(class UYetiOS_BaseHardware* InHardware)
 {
 	if (ensure(InstalledHardwares.Contains(InHardware) == false))
@@ -355,6 +671,14 @@ const FString UYetiOS_BaseDevice::Internal_GetSavePath(const UYetiOS_BaseDevice*
 	return FPaths::Combine(Internal_GetBasePath(), InDevice->OperatingSystem->GetOsName().ToString().Replace(TEXT(" "), TEXT("")));
 }
 
+const FString UYetiOS_BaseDevice::Internal_GetFileContentPath(const UYetiOS_BaseDevice* InDevice)
+{
+	// Keyed by device rather than OS name since devices running the same OS must not share or clear each other's content.
+	const AYetiOS_DeviceManagerActor* MyDeviceManager = Cast<AYetiOS_DeviceManagerActor>(InDevice->GetOuter());
+	const FString Local_DeviceKey = MyDeviceManager ? MyDeviceManager->GetDeviceSaveID() : InDevice->GetName();
+	return FPaths::Combine(Internal_GetBasePath(), *FString("FileContent"), *FPaths::MakeValidFileName(Local_DeviceKey));
+}
+
 const FString UYetiOS_BaseDevice::Internal_GetLoginWallpapersPath(const UYetiOS_BaseDevice* InDevice)
 {
 	return FPaths::Combine(Internal_GetSavePath(InDevice), *FString("LoginWallpapers"));
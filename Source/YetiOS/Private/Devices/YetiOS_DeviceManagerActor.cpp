@@ -3,6 +3,8 @@
 
 #include "Devices/YetiOS_DeviceManagerActor.h"
 #include "Devices/YetiOS_BaseDevice.h"
+#include "Devices/YetiOS_DevicePersistenceSubsystem.h"
+#include "Devices/YetiOS_DeviceRegistrySubsystem.h"
 #include "Widgets/YetiOS_DeviceWidget.h"
 
 #include "Kismet/GameplayStatics.h"
@@ -12,6 +14,9 @@
 #include "Components/SceneComponent.h"
 #endif
 #include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogYetiOsDeviceManager, All, All)
 
@@ -29,6 +34,8 @@ AYetiOS_DeviceManagerActor::AYetiOS_DeviceManagerActor()
 	bAddWidgetsToScreen = true;
 	bExitGameWhenDeviceIsDestroyed = false;
 	bCanSaveGame = true;
+	DeviceSaveID = NAME_None;
+	bKeepDeviceAcrossLevels = false;
 
 	PrimaryActorTick.bCanEverTick = false;
 	PrimaryActorTick.bStartWithTickEnabled = false;
@@ -44,20 +51,40 @@ void AYetiOS_DeviceManagerActor::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (bCreateDeviceOnBeginPlay)
+	if (bKeepDeviceAcrossLevels)
+	{
+		UYetiOS_DevicePersistenceSubsystem* Local_PersistenceSubsystem = UGameInstance::GetSubsystem<UYetiOS_DevicePersistenceSubsystem>(GetGameInstance());
+		CurrentDevice = Local_PersistenceSubsystem ? Local_PersistenceSubsystem->ClaimDevice(this) : nullptr;
+	}
+
+	if (CurrentDevice == nullptr && bCreateDeviceOnBeginPlay)
 	{
 		FYetiOsError ErrorMessage;
 		CreateDevice(ErrorMessage);
 	}
 
 	Internal_OnClockTimerTick();
-	GetWorldTimerManager().SetTimer(TimerHandle_ClockTick, this, &AYetiOS_DeviceManagerActor::Internal_OnClockTimerTick, 1.f, true);
+	UYetiOS_DeviceRegistrySubsystem* Local_DeviceRegistry = GetWorld()->GetSubsystem<UYetiOS_DeviceRegistrySubsystem>();
+	if (Local_DeviceRegistry)
+	{
+		Local_DeviceRegistry->RegisterDeviceManager(this);
+	}
+	else
+	{
+		GetWorldTimerManager().SetTimer(TimerHandle_ClockTick, this, &AYetiOS_DeviceManagerActor::Internal_OnClockTimerTick, 1.f, true);
+	}
 }
 
 void AYetiOS_DeviceManagerActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	OnClockTick.Clear();
 	GetWorldTimerManager().ClearTimer(TimerHandle_ClockTick);
+	UYetiOS_DeviceRegistrySubsystem* Local_DeviceRegistry = GetWorld()->GetSubsystem<UYetiOS_DeviceRegistrySubsystem>();
+	if (Local_DeviceRegistry)
+	{
+		Local_DeviceRegistry->UnregisterDeviceManager(this);
+	}
+
 	Super::EndPlay(EndPlayReason);
 
 	FString EndReasonString = "Unknown";
@@ -85,8 +112,19 @@ void AYetiOS_DeviceManagerActor::EndPlay(const EEndPlayReason::Type EndPlayReaso
 
 	printlog(FString::Printf(TEXT("Ending play on device manager %s. Reason: %s."), *GetName(), *EndReasonString));
 
+	if (CurrentDevice && EndPlayReason == EEndPlayReason::LevelTransition && bKeepDeviceAcrossLevels)
+	{
+		UYetiOS_DevicePersistenceSubsystem* Local_PersistenceSubsystem = UGameInstance::GetSubsystem<UYetiOS_DevicePersistenceSubsystem>(GetGameInstance());
+		if (Local_PersistenceSubsystem && Local_PersistenceSubsystem->ParkDevice(this))
+		{
+			CurrentDevice = nullptr;
+		}
+	}
+
 	if (CurrentDevice)
 	{
+		// Actor is going away so the device cannot wait for its save on the game thread.
+		CurrentDevice->WaitForSave();
 		CurrentDevice->DestroyYetiDevice();
 		CurrentDevice = nullptr;
 	}
@@ -157,6 +195,17 @@ void AYetiOS_DeviceManagerActor::CreateDevice(FYetiOsError& OutErrorMessage)
 	OutErrorMessage.ErrorException = LOCTEXT("YetiOS_CurrentDeviceCreateException", "Current device was already created or Device class was null");
 }
 
+FString AYetiOS_DeviceManagerActor::GetDeviceSaveID() const
+{
+	if (DeviceSaveID.IsNone() == false)
+	{
+		return DeviceSaveID.ToString();
+	}
+
+	// PIE prefix is removed so saves made in editor and in a packaged game end up in the same slot.
+	return FPackageName::GetShortName(UWorld::RemovePIEPrefix(GetOutermost()->GetName())) + TEXT("_") + GetName();
+}
+
 void AYetiOS_DeviceManagerActor::Internal_OnClockTimerTick()
 {
 	K2_OnClockTimerTick();
@@ -0,0 +1,89 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Devices/YetiOS_DevicePersistenceSubsystem.h"
+#include "Devices/YetiOS_BaseDevice.h"
+#include "Devices/YetiOS_DeviceManagerActor.h"
+#include "Core/YetiOS_SaveManifest.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsDevicePersistence, All, All)
+
+#define printlog(Param1)				UE_LOG(LogYetiOsDevicePersistence, Log, TEXT("%s"), *FString(Param1))
+#define printlog_warn(Param1)			UE_LOG(LogYetiOsDevicePersistence, Warning, TEXT("%s"), *FString(Param1))
+
+void UYetiOS_DevicePersistenceSubsystem::Deinitialize()
+{
+	DiscardAllParkedDevices();
+	LoadedManifests.Empty();
+	Super::Deinitialize();
+}
+
+bool UYetiOS_DevicePersistenceSubsystem::ParkDevice(class AYetiOS_DeviceManagerActor* InDeviceManager)
+{
+	UYetiOS_BaseDevice* Local_Device = InDeviceManager->GetDevice();
+	if (Local_Device == nullptr || Local_Device->IsRunning() == false || Local_Device->IsBooting() || Local_Device->GetOperatingSystem() == nullptr)
+	{
+		return false;
+	}
+
+	const FString Local_DeviceSaveID = InDeviceManager->GetDeviceSaveID();
+	if (ParkedDevices.Contains(Local_DeviceSaveID))
+	{
+		printlog_warn(FString::Printf(TEXT("A device is already parked as %s. %s is destroyed instead."), *Local_DeviceSaveID, *Local_Device->GetDeviceName().ToString()));
+		return false;
+	}
+
+	Local_Device->Internal_DetachDevice(this);
+	ParkedDevices.Add(Local_DeviceSaveID, Local_Device);
+	printlog(FString::Printf(TEXT("Parked device %s as %s."), *Local_Device->GetDeviceName().ToString(), *Local_DeviceSaveID));
+	return true;
+}
+
+class UYetiOS_BaseDevice* UYetiOS_DevicePersistenceSubsystem::ClaimDevice(class AYetiOS_DeviceManagerActor* InDeviceManager)
+{
+	UYetiOS_BaseDevice* Local_Device = nullptr;
+	if (ParkedDevices.RemoveAndCopyValue(InDeviceManager->GetDeviceSaveID(), Local_Device) == false)
+	{
+		return nullptr;
+	}
+
+	Local_Device->Internal_AttachDevice(InDeviceManager);
+	return Local_Device;
+}
+
+bool UYetiOS_DevicePersistenceSubsystem::DiscardParkedDevice(const FString& InDeviceSaveID)
+{
+	UYetiOS_BaseDevice* Local_Device = nullptr;
+	if (ParkedDevices.RemoveAndCopyValue(InDeviceSaveID, Local_Device) == false)
+	{
+		return false;
+	}
+
+	Local_Device->Internal_DestroyDetachedDevice();
+	printlog(FString::Printf(TEXT("Discarded parked device %s."), *InDeviceSaveID));
+	return true;
+}
+
+void UYetiOS_DevicePersistenceSubsystem::DiscardAllParkedDevices()
+{
+	TArray<FString> Local_DeviceSaveIDs;
+	ParkedDevices.GenerateKeyArray(Local_DeviceSaveIDs);
+	for (const FString& It : Local_DeviceSaveIDs)
+	{
+		DiscardParkedDevice(It);
+	}
+}
+
+class UYetiOS_SaveManifest* UYetiOS_DevicePersistenceSubsystem::GetSaveManifest(const FString& InBaseSlotName, const int32 InUserIndex)
+{
+	const FString Local_Key = FString::Printf(TEXT("%s_%i"), *UYetiOS_SaveManifest::GetManifestSlotName(InBaseSlotName), InUserIndex);
+	if (UYetiOS_SaveManifest* const* Local_Loaded = LoadedManifests.Find(Local_Key))
+	{
+		return *Local_Loaded;
+	}
+
+	return LoadedManifests.Add(Local_Key, UYetiOS_SaveManifest::LoadManifest(InBaseSlotName, InUserIndex));
+}
+
+#undef printlog
+#undef printlog_warn
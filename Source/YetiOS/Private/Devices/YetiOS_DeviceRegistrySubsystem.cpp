@@ -0,0 +1,279 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Devices/YetiOS_DeviceRegistrySubsystem.h"
+#include "Devices/YetiOS_BaseDevice.h"
+#include "Devices/YetiOS_DeviceManagerActor.h"
+#include "Core/YetiOS_Core.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsDeviceRegistry, All, All)
+
+#define printlog(Param1)				UE_LOG(LogYetiOsDeviceRegistry, Log, TEXT("%s"), *FString(Param1))
+#define printlog_warn(Param1)			UE_LOG(LogYetiOsDeviceRegistry, Warning, TEXT("%s"), *FString(Param1))
+#define printlog_veryverbose(Param1)	UE_LOG(LogYetiOsDeviceRegistry, VeryVerbose, TEXT("%s"), *FString(Param1))
+
+void UYetiOS_DeviceRegistrySubsystem::Deinitialize()
+{
+	if (GetWorld())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_ClockTick);
+	}
+
+	DeviceManagers.Empty();
+	DeviceManagerIndices.Empty();
+	DeviceManagersBySaveID.Empty();
+	DeviceManagersByDeviceName.Empty();
+	DeviceManagersByDeviceClass.Empty();
+	Super::Deinitialize();
+}
+
+void UYetiOS_DeviceRegistrySubsystem::RegisterDeviceManager(class AYetiOS_DeviceManagerActor* InDeviceManager)
+{
+	if (DeviceManagerIndices.Contains(InDeviceManager))
+	{
+		return;
+	}
+
+	DeviceManagerIndices.Add(InDeviceManager, DeviceManagers.Add(InDeviceManager));
+
+	const FString Local_DeviceSaveID = InDeviceManager->GetDeviceSaveID();
+	if (DeviceManagersBySaveID.Contains(Local_DeviceSaveID))
+	{
+		printlog_warn(FString::Printf(TEXT("%s has the same device save ID as %s. Only the first one can be found by %s."), *InDeviceManager->GetName(), *DeviceManagersBySaveID[Local_DeviceSaveID]->GetName(), *Local_DeviceSaveID));
+	}
+	else
+	{
+		DeviceManagersBySaveID.Add(Local_DeviceSaveID, InDeviceManager);
+	}
+
+	const FName Local_DeviceNameKey = Internal_GetDeviceNameKey(InDeviceManager);
+	if (Local_DeviceNameKey.IsNone() == false)
+	{
+		DeviceManagersByDeviceName.FindOrAdd(Local_DeviceNameKey).Add(InDeviceManager);
+	}
+
+	DeviceManagersByDeviceClass.FindOrAdd(InDeviceManager->GetDeviceClass().Get()).Add(InDeviceManager);
+
+	// One timer ticks the clock of every device manager instead of one timer per actor.
+	if (TimerHandle_ClockTick.IsValid() == false)
+	{
+		GetWorld()->GetTimerManager().SetTimer(TimerHandle_ClockTick, this, &UYetiOS_DeviceRegistrySubsystem::Internal_OnClockTimerTick, 1.f, true);
+	}
+
+	printlog_veryverbose(FString::Printf(TEXT("Registered device manager %s as %s."), *InDeviceManager->GetName(), *Local_DeviceSaveID));
+}
+
+void UYetiOS_DeviceRegistrySubsystem::UnregisterDeviceManager(class AYetiOS_DeviceManagerActor* InDeviceManager)
+{
+	int32 Local_Index = INDEX_NONE;
+	if (DeviceManagerIndices.RemoveAndCopyValue(InDeviceManager, Local_Index) == false)
+	{
+		return;
+	}
+
+	DeviceManagers.RemoveAtSwap(Local_Index, 1, false);
+	if (DeviceManagers.IsValidIndex(Local_Index))
+	{
+		DeviceManagerIndices[DeviceManagers[Local_Index]] = Local_Index;
+	}
+
+	const FString Local_DeviceSaveID = InDeviceManager->GetDeviceSaveID();
+	if (DeviceManagersBySaveID.FindRef(Local_DeviceSaveID) == InDeviceManager)
+	{
+		DeviceManagersBySaveID.Remove(Local_DeviceSaveID);
+
+		// A manager with a duplicate ID can be found now that the first one is gone.
+		for (AYetiOS_DeviceManagerActor* It : DeviceManagers)
+		{
+			if (It->GetDeviceSaveID() == Local_DeviceSaveID)
+			{
+				DeviceManagersBySaveID.Add(Local_DeviceSaveID, It);
+				break;
+			}
+		}
+	}
+
+	const FName Local_DeviceNameKey = Internal_GetDeviceNameKey(InDeviceManager);
+	if (TArray<AYetiOS_DeviceManagerActor*>* Local_Managers = DeviceManagersByDeviceName.Find(Local_DeviceNameKey))
+	{
+		Local_Managers->RemoveSwap(InDeviceManager);
+		if (Local_Managers->Num() == 0)
+		{
+			DeviceManagersByDeviceName.Remove(Local_DeviceNameKey);
+		}
+	}
+
+	const UClass* Local_DeviceClass = InDeviceManager->GetDeviceClass().Get();
+	if (TArray<AYetiOS_DeviceManagerActor*>* Local_Managers = DeviceManagersByDeviceClass.Find(Local_DeviceClass))
+	{
+		Local_Managers->RemoveSwap(InDeviceManager);
+		if (Local_Managers->Num() == 0)
+		{
+			DeviceManagersByDeviceClass.Remove(Local_DeviceClass);
+		}
+	}
+
+	if (DeviceManagers.Num() == 0)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_ClockTick);
+	}
+
+	printlog_veryverbose(FString::Printf(TEXT("Unregistered device manager %s."), *InDeviceManager->GetName()));
+}
+
+class AYetiOS_DeviceManagerActor* UYetiOS_DeviceRegistrySubsystem::FindDeviceManager(const FString& InDeviceSaveID) const
+{
+	return DeviceManagersBySaveID.FindRef(InDeviceSaveID);
+}
+
+class UYetiOS_BaseDevice* UYetiOS_DeviceRegistrySubsystem::FindDevice(const FString& InDeviceSaveID) const
+{
+	const AYetiOS_DeviceManagerActor* Local_DeviceManager = DeviceManagersBySaveID.FindRef(InDeviceSaveID);
+	return Local_DeviceManager ? Local_DeviceManager->GetDevice() : nullptr;
+}
+
+TArray<class UYetiOS_BaseDevice*> UYetiOS_DeviceRegistrySubsystem::FindDevicesByName(const FText& InDeviceName) const
+{
+	TArray<UYetiOS_BaseDevice*> ReturnResult;
+	if (const TArray<AYetiOS_DeviceManagerActor*>* Local_Managers = DeviceManagersByDeviceName.Find(FName(*InDeviceName.ToString())))
+	{
+		ReturnResult.Reserve(Local_Managers->Num());
+		for (const AYetiOS_DeviceManagerActor* It : *Local_Managers)
+		{
+			if (It->GetDevice())
+			{
+				ReturnResult.Add(It->GetDevice());
+			}
+		}
+	}
+
+	return ReturnResult;
+}
+
+TArray<class AYetiOS_DeviceManagerActor*> UYetiOS_DeviceRegistrySubsystem::GetDeviceManagersOfClass(TSubclassOf<class UYetiOS_BaseDevice> InDeviceClass, const bool bIncludeChildClasses /*= true*/) const
+{
+	if (bIncludeChildClasses == false)
+	{
+		return DeviceManagersByDeviceClass.FindRef(InDeviceClass.Get());
+	}
+
+	// There are only a few device classes, so walking them is cheap compared to walking every manager.
+	TArray<AYetiOS_DeviceManagerActor*> ReturnResult;
+	for (const auto& It : DeviceManagersByDeviceClass)
+	{
+		if (It.Key && InDeviceClass && It.Key->IsChildOf(InDeviceClass))
+		{
+			ReturnResult.Append(It.Value);
+		}
+	}
+
+	return ReturnResult;
+}
+
+TArray<TSubclassOf<class UYetiOS_BaseDevice>> UYetiOS_DeviceRegistrySubsystem::GetDeviceClasses() const
+{
+	TArray<TSubclassOf<UYetiOS_BaseDevice>> ReturnResult;
+	ReturnResult.Reserve(DeviceManagersByDeviceClass.Num());
+	for (const auto& It : DeviceManagersByDeviceClass)
+	{
+		if (It.Key)
+		{
+			ReturnResult.Add(const_cast<UClass*>(It.Key));
+		}
+	}
+
+	return ReturnResult;
+}
+
+int32 UYetiOS_DeviceRegistrySubsystem::SaveAllDevices()
+{
+	int32 Local_SaveCount = 0;
+	for (const AYetiOS_DeviceManagerActor* It : DeviceManagers)
+	{
+		UYetiOS_BaseDevice* Local_Device = It->GetDevice();
+		if (Local_Device && It->CanSaveGame() && Local_Device->IsRunning() && Local_Device->IsBooting() == false && Local_Device->SaveDevice())
+		{
+			Local_SaveCount++;
+		}
+	}
+
+	printlog(FString::Printf(TEXT("Saving %i of %i device(s)."), Local_SaveCount, DeviceManagers.Num()));
+	return Local_SaveCount;
+}
+
+int32 UYetiOS_DeviceRegistrySubsystem::PowerOffAllDevices()
+{
+	// Shutdown events may destroy device managers, which unregisters them while this runs.
+	const TArray<AYetiOS_DeviceManagerActor*> Local_DeviceManagers = DeviceManagers;
+	int32 Local_PowerOffCount = 0;
+	for (const AYetiOS_DeviceManagerActor* It : Local_DeviceManagers)
+	{
+		UYetiOS_BaseDevice* Local_Device = IsValid(It) ? It->GetDevice() : nullptr;
+		if (Local_Device && Local_Device->IsRunning())
+		{
+			Local_Device->ShutdownYetiDevice();
+			Local_PowerOffCount++;
+		}
+	}
+
+	printlog(FString::Printf(TEXT("Powering off %i of %i device(s)."), Local_PowerOffCount, Local_DeviceManagers.Num()));
+	return Local_PowerOffCount;
+}
+
+FYetiOsDeviceRegistryStats UYetiOS_DeviceRegistrySubsystem::GetDeviceStats() const
+{
+	FYetiOsDeviceRegistryStats ReturnResult;
+	ReturnResult.NumDeviceManagers = DeviceManagers.Num();
+	for (const AYetiOS_DeviceManagerActor* It : DeviceManagers)
+	{
+		const UYetiOS_BaseDevice* Local_Device = It->GetDevice();
+		if (Local_Device == nullptr)
+		{
+			continue;
+		}
+
+		ReturnResult.NumDevices++;
+		ReturnResult.NumRunningDevices += Local_Device->IsRunning() ? 1 : 0;
+		ReturnResult.NumBootingDevices += Local_Device->IsBooting() ? 1 : 0;
+		ReturnResult.NumSavingDevices += Local_Device->IsSaving() ? 1 : 0;
+		ReturnResult.NumDevicesInBsod += Local_Device->IsInBsodState() ? 1 : 0;
+		ReturnResult.NumPortableDevices += Local_Device->IsPortableDevice() ? 1 : 0;
+		if (const UYetiOS_Core* Local_OS = Local_Device->GetOperatingSystem())
+		{
+			ReturnResult.NumRunningPrograms += Local_OS->GetProcessTable().Num();
+		}
+	}
+
+	return ReturnResult;
+}
+
+void UYetiOS_DeviceRegistrySubsystem::Internal_OnClockTimerTick()
+{
+	// Clock events may destroy device managers, which unregisters them while this runs.
+	const TArray<AYetiOS_DeviceManagerActor*> Local_DeviceManagers = DeviceManagers;
+	for (AYetiOS_DeviceManagerActor* It : Local_DeviceManagers)
+	{
+		if (IsValid(It) && DeviceManagerIndices.Contains(It))
+		{
+			It->Internal_OnClockTimerTick();
+		}
+	}
+}
+
+FName UYetiOS_DeviceRegistrySubsystem::Internal_GetDeviceNameKey(const class AYetiOS_DeviceManagerActor* InDeviceManager)
+{
+	const UClass* Local_DeviceClass = InDeviceManager->GetDeviceClass().Get();
+	if (Local_DeviceClass == nullptr)
+	{
+		return NAME_None;
+	}
+
+	const FString Local_DeviceName = Local_DeviceClass->GetDefaultObject<UYetiOS_BaseDevice>()->GetDeviceName().ToString();
+	return Local_DeviceName.IsEmpty() ? NAME_None : FName(*Local_DeviceName);
+}
+
+#undef printlog
+#undef printlog_warn
+#undef printlog_veryverbose
@@ -13,28 +13,51 @@ DEFINE_LOG_CATEGORY_STATIC(LogYetiOsPortableDevice, All, All)
 UYetiOS_PortableDevice::UYetiOS_PortableDevice()
 {
 	bLowBatteryWarned = false;
+	bWasChargingWhenDetached = false;
 	BatteryLevel = 1.f;
 	BatteryConsumeTimerDelay = 120.f;
 }
 
-EYetiOsDeviceStartResult UYetiOS_PortableDevice::StartDevice(FYetiOsError& OutErrorMessage)
+void UYetiOS_PortableDevice::OnFinishStartingDevice()
 {
-	EYetiOsDeviceStartResult Local_StartResult = Super::StartDevice(OutErrorMessage);
-	if (Local_StartResult == EYetiOsDeviceStartResult::DEVICESTART_Success)
+	Super::OnFinishStartingDevice();
+	if (BatteryLevel <= InstalledBattery.LowBatteryWarningLevel)
 	{
-		if (BatteryLevel <= InstalledBattery.LowBatteryWarningLevel)
+		GetOperatingSystem()->NotifyLowBattery(true);
+	}
+
+	GetOperatingSystem()->NotifyBatteryLevelChange(BatteryLevel);
+	GetWorld()->GetTimerManager().SetTimer(TimerHandle_ConsumeBattery, this, &UYetiOS_PortableDevice::Internal_ConsumeBattery, BatteryConsumeTimerDelay, true);
+	Internal_ConsumeBattery();
+
+	printlog(FString::Printf(TEXT("Current battery charge: %f%s. Battery health: %f%s"), BatteryLevel * 100.f, *FString("%"), GetBatteryHealth(false), *FString("%")));
+}
+
+void UYetiOS_PortableDevice::OnDeviceDetached()
+{
+	Super::OnDeviceDetached();
+	bWasChargingWhenDetached = IsDeviceCharging();
+}
+
+void UYetiOS_PortableDevice::OnDeviceAttached()
+{
+	Super::OnDeviceAttached();
+	GetOperatingSystem()->NotifyBatteryLevelChange(BatteryLevel);
+	if (bWasChargingWhenDetached)
+	{
+		GetWorld()->GetTimerManager().SetTimer(TimerHandle_ChargeBattery, this, &UYetiOS_PortableDevice::Internal_ChargeBattery, GetChargingSpeed(), true);
+	}
+	else
+	{
+		if (bLowBatteryWarned)
 		{
 			GetOperatingSystem()->NotifyLowBattery(true);
 		}
 
-		GetOperatingSystem()->NotifyBatteryLevelChange(BatteryLevel);
 		GetWorld()->GetTimerManager().SetTimer(TimerHandle_ConsumeBattery, this, &UYetiOS_PortableDevice::Internal_ConsumeBattery, BatteryConsumeTimerDelay, true);
-		Internal_ConsumeBattery();
-
-		printlog(FString::Printf(TEXT("Current battery charge: %f%s. Battery health: %f%s"), BatteryLevel * 100.f, *FString("%"), GetBatteryHealth(false), *FString("%")));
 	}
 
-	return Local_StartResult;
+	bWasChargingWhenDetached = false;
 }
 
 void UYetiOS_PortableDevice::BeginBatteryCharge()
@@ -30,12 +30,16 @@ int64 UYetiOS_HardDisk::ConvertMegabyteToByte(const float& InMegabyteSize)
 
 bool UYetiOS_HardDisk::ConsumeSpace(const float& SpaceInMB)
 {
-	const int64& InSpaceInBytes = ConvertMegabyteToByte(SpaceInMB);;
-	if (InSpaceInBytes <= RemainingSpaceInBytes)
+	return ConsumeBytes(ConvertMegabyteToByte(SpaceInMB));
+}
+
+bool UYetiOS_HardDisk::ConsumeBytes(const int64& InBytes)
+{
+	if (InBytes <= RemainingSpaceInBytes)
 	{
-		RemainingSpaceInBytes -= InSpaceInBytes;
+		RemainingSpaceInBytes -= InBytes;
 		const float ConvertedToGB = float(RemainingSpaceInBytes) / 1000000000.f;
-		printlog_veryverbose(FString::Printf(TEXT("%s mb (%lld) consumed. Remaining %f GB (%lld)."), *FString::SanitizeFloat(SpaceInMB), InSpaceInBytes, ConvertedToGB, RemainingSpaceInBytes));
+		printlog_veryverbose(FString::Printf(TEXT("%lld bytes consumed. Remaining %f GB (%lld)."), InBytes, ConvertedToGB, RemainingSpaceInBytes));
 		return true;
 	}
 
@@ -43,6 +47,12 @@ bool UYetiOS_HardDisk::ConsumeSpace(const float& SpaceInMB)
 	return false;
 }
 
+void UYetiOS_HardDisk::ReleaseBytes(const int64& InBytes)
+{
+	RemainingSpaceInBytes = FMath::Min(RemainingSpaceInBytes + InBytes, ConvertMegabyteToByte(HddCapacityInMB));
+	printlog_veryverbose(FString::Printf(TEXT("%lld bytes released. Remaining %lld."), InBytes, RemainingSpaceInBytes));
+}
+
 void UYetiOS_HardDisk::Internal_UpdateRemainingSpace(const int64& InSize)
 {
 	RemainingSpaceInBytes = InSize;
@@ -38,21 +38,34 @@ UYetiOS_ProgramSettings* UYetiOS_ProgramSettings::CreateSettings(const class UYe
 
 UYetiOS_ProgramSettings* UYetiOS_ProgramSettings::LoadSettings(const class UYetiOS_BaseProgram* InParentProgram)
 {
-	UYetiOS_ProgramSettings* Local_LoadInstance = Cast<UYetiOS_ProgramSettings>(UGameplayStatics::CreateSaveGameObject(UYetiOS_ProgramSettings::StaticClass()));
-	Local_LoadInstance->ParentProgramIdentifier = InParentProgram->GetProgramIdentifierName();
-	Local_LoadInstance->OwningProgram = const_cast<UYetiOS_BaseProgram*>(InParentProgram);
-	const FString LoadSlotName = Local_LoadInstance->Internal_GetSaveSlotName();
-	const int32 LoadUserIndex = Local_LoadInstance->UserIndex;
+	UYetiOS_Core* Local_OS = InParentProgram->GetOwningOS();
+	FYetiOsProgramSettingsStore& Local_Store = Local_OS->GetProgramSettingsStore();
+	UYetiOS_ProgramSettings* Local_LoadInstance = nullptr;
+	if (const TArray<uint8>* Local_SettingsData = Local_Store.Find(InParentProgram->GetProgramIdentifierName()))
+	{
+		Local_LoadInstance = Cast<UYetiOS_ProgramSettings>(UGameplayStatics::LoadGameFromMemory(*Local_SettingsData));
+	}
+	else if (Local_Store.HasStoreSlot() == false)
+	{
+		Local_LoadInstance = Internal_LoadLegacySettings(InParentProgram);
+		if (Local_LoadInstance)
+		{
+			// Moved into the store so the per program slot is not read again once the store is on disk.
+			TArray<uint8> Local_SettingsData;
+			if (UGameplayStatics::SaveGameToMemory(Local_LoadInstance, Local_SettingsData))
+			{
+				Local_OS->StoreProgramSettings(InParentProgram->GetProgramIdentifierName(), MoveTemp(Local_SettingsData));
+			}
+		}
+	}
 
-	if (UGameplayStatics::DoesSaveGameExist(LoadSlotName, LoadUserIndex))
+	if (Local_LoadInstance)
 	{
-		Local_LoadInstance = Cast<UYetiOS_ProgramSettings>(UGameplayStatics::LoadGameFromSlot(LoadSlotName, LoadUserIndex));
-		Local_LoadInstance->ParentProgramIdentifier = InParentProgram->GetProgramIdentifierName();
 		Local_LoadInstance->OwningProgram = const_cast<UYetiOS_BaseProgram*>(InParentProgram);
-		return Local_LoadInstance;
+		Local_LoadInstance->Internal_SetSaveSlotName();
 	}
 
-	return nullptr;
+	return Local_LoadInstance;
 }
 
 bool UYetiOS_ProgramSettings::SaveProgramSettings(class UYetiOS_BaseProgram* InProgram)
@@ -70,7 +83,12 @@ bool UYetiOS_ProgramSettings::Internal_SaveSettings()
 	if (K2_CanSave())
 	{
 		K2_PreSave();
-		return UGameplayStatics::SaveGameToSlot(this, SaveSlotName, UserIndex);
+		TArray<uint8> Local_SettingsData;
+		if (UGameplayStatics::SaveGameToMemory(this, Local_SettingsData))
+		{
+			OwningProgram->GetOwningOS()->StoreProgramSettings(ParentProgramIdentifier, MoveTemp(Local_SettingsData));
+			return true;
+		}
 	}
 
 	printlog_error(FString::Printf(TEXT("Failed to save settings for %s"), *ParentProgramIdentifier.ToString()));
@@ -87,7 +105,18 @@ void UYetiOS_ProgramSettings::Destroy()
 void UYetiOS_ProgramSettings::Internal_SetSaveSlotName()
 {
 	ParentProgramIdentifier = OwningProgram->GetProgramIdentifierName();	
-	SaveSlotName = Internal_GetSaveSlotName();
+	SaveSlotName = GetStoreSlotName(OwningProgram->GetOwningOS()->GetOwningDevice());
+}
+
+FString UYetiOS_ProgramSettings::GetStoreSlotName(const class UYetiOS_BaseDevice* InDevice)
+{
+	const AYetiOS_DeviceManagerActor* Local_DeviceManager = Cast<AYetiOS_DeviceManagerActor>(InDevice->GetOuter());
+	return FString::Printf(TEXT("ProgramSettings_%s"), Local_DeviceManager ? *Local_DeviceManager->GetDeviceSaveID() : *InDevice->GetDeviceName().ToString());
+}
+
+int32 UYetiOS_ProgramSettings::GetStoreUserIndex()
+{
+	return GetDefault<UYetiOS_ProgramSettings>()->UserIndex;
 }
 
 class UYetiOS_BaseProgram* UYetiOS_ProgramSettings::GetOwningProgram() const
@@ -106,9 +135,17 @@ bool UYetiOS_ProgramSettings::K2_CanSave_Implementation() const
 	return false;
 }
 
-const FString UYetiOS_ProgramSettings::Internal_GetSaveSlotName() const
+UYetiOS_ProgramSettings* UYetiOS_ProgramSettings::Internal_LoadLegacySettings(const class UYetiOS_BaseProgram* InParentProgram)
 {
-	return FString::Printf(TEXT("%s_%s"), *ParentProgramIdentifier.ToString(), *OwningProgram->GetOwningOS()->GetOwningDevice()->GetDeviceName().ToString());
+	const FString Local_SlotName = FString::Printf(TEXT("%s_%s"), *InParentProgram->GetProgramIdentifierName().ToString(), *InParentProgram->GetOwningOS()->GetOwningDevice()->GetDeviceName().ToString());
+	const int32 Local_UserIndex = GetStoreUserIndex();
+	if (UGameplayStatics::DoesSaveGameExist(Local_SlotName, Local_UserIndex))
+	{
+		printlog(FString::Printf(TEXT("Moving settings of %s from slot %s to the settings store."), *InParentProgram->GetProgramIdentifierName().ToString(), *Local_SlotName));
+		return Cast<UYetiOS_ProgramSettings>(UGameplayStatics::LoadGameFromSlot(Local_SlotName, Local_UserIndex));
+	}
+
+	return nullptr;
 }
 
 #undef printlog
@@ -0,0 +1,183 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Misc/YetiOS_ProgramSettingsStore.h"
+#include "Kismet/GameplayStatics.h"
+#include "Async/Async.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsProgramSettingsStore, All, All)
+
+#define printlog_error(Param1)			UE_LOG(LogYetiOsProgramSettingsStore, Error, TEXT("%s"), *FString(Param1))
+#define printlog_veryverbose(Param1)	UE_LOG(LogYetiOsProgramSettingsStore, VeryVerbose, TEXT("%s"), *FString(Param1))
+
+static const int32 PROGRAM_SETTINGS_STORE_VERSION = 1;
+
+FYetiOsProgramSettingsStore::FYetiOsProgramSettingsStore()
+{
+	UserIndex = 0;
+	bIsDirty = false;
+	bHasStoreSlot = false;
+}
+
+void FYetiOsProgramSettingsStore::Open(const FString& InSlotName, const int32 InUserIndex)
+{
+	SlotName = InSlotName;
+	UserIndex = InUserIndex;
+	Entries.Reset();
+	bIsDirty = false;
+	bHasStoreSlot = false;
+	PendingRead = Async(EAsyncExecution::ThreadPool, [InSlotName, InUserIndex]()
+	{
+		TArray<uint8> Local_StoreData;
+		if (UGameplayStatics::DoesSaveGameExist(InSlotName, InUserIndex))
+		{
+			UGameplayStatics::LoadDataFromSlot(Local_StoreData, InSlotName, InUserIndex);
+		}
+
+		return Local_StoreData;
+	});
+}
+
+void FYetiOsProgramSettingsStore::Close()
+{
+	if (IsOpen() == false)
+	{
+		return;
+	}
+
+	// Pending changes wait for the running write, then are written with a write of their own.
+	if (PendingWrite.IsValid())
+	{
+		PendingWrite.Wait();
+	}
+
+	Flush();
+	if (PendingWrite.IsValid())
+	{
+		PendingWrite.Wait();
+		Internal_FinishWrite();
+	}
+
+	if (PendingRead.IsValid())
+	{
+		PendingRead.Wait();
+		PendingRead.Reset();
+	}
+
+	SlotName.Empty();
+	Entries.Empty();
+	bIsDirty = false;
+}
+
+const TArray<uint8>* FYetiOsProgramSettingsStore::Find(const FName& InProgramIdentifier)
+{
+	Internal_FinishRead();
+	return Entries.Find(InProgramIdentifier);
+}
+
+void FYetiOsProgramSettingsStore::Set(const FName& InProgramIdentifier, TArray<uint8>&& InSettingsData)
+{
+	Internal_FinishRead();
+	Entries.Add(InProgramIdentifier, MoveTemp(InSettingsData));
+	bIsDirty = true;
+}
+
+bool FYetiOsProgramSettingsStore::Flush()
+{
+	Internal_FinishWrite();
+	if (PendingWrite.IsValid())
+	{
+		return false;
+	}
+
+	if (bIsDirty == false || IsOpen() == false)
+	{
+		return true;
+	}
+
+	// Serializing blobs that are already in memory is cheap. Only the slot write goes to the worker.
+	TArray<uint8> Local_StoreData;
+	FMemoryWriter Local_Writer(Local_StoreData, true);
+	int32 Local_Version = PROGRAM_SETTINGS_STORE_VERSION;
+	Local_Writer << Local_Version;
+	Local_Writer << Entries;
+	bIsDirty = false;
+
+	const FString Local_SlotName = SlotName;
+	const int32 Local_UserIndex = UserIndex;
+	const int32 Local_EntryCount = Entries.Num();
+	PendingWrite = Async(EAsyncExecution::ThreadPool, [Local_StoreData = MoveTemp(Local_StoreData), Local_SlotName, Local_UserIndex, Local_EntryCount]()
+	{
+		const bool bLocal_Success = UGameplayStatics::SaveDataToSlot(Local_StoreData, Local_SlotName, Local_UserIndex);
+		if (bLocal_Success == false)
+		{
+			printlog_error(FString::Printf(TEXT("Failed to write program settings to %s."), *Local_SlotName));
+		}
+		else
+		{
+			printlog_veryverbose(FString::Printf(TEXT("Wrote settings of %i program(s) to %s."), Local_EntryCount, *Local_SlotName));
+		}
+
+		return bLocal_Success;
+	});
+
+	return false;
+}
+
+void FYetiOsProgramSettingsStore::Internal_FinishWrite()
+{
+	if (PendingWrite.IsValid() == false || PendingWrite.IsReady() == false)
+	{
+		return;
+	}
+
+	if (PendingWrite.Get())
+	{
+		bHasStoreSlot = true;
+	}
+	else
+	{
+		// Entries are still in memory, so the next flush writes them again.
+		bIsDirty = true;
+	}
+
+	PendingWrite.Reset();
+}
+
+void FYetiOsProgramSettingsStore::Internal_FinishRead()
+{
+	if (PendingRead.IsValid() == false)
+	{
+		return;
+	}
+
+	const TArray<uint8> Local_StoreData = PendingRead.Get();
+	PendingRead.Reset();
+	if (Local_StoreData.Num() == 0)
+	{
+		return;
+	}
+
+	bHasStoreSlot = true;
+	FMemoryReader Local_Reader(Local_StoreData, true);
+	int32 Local_Version = 0;
+	Local_Reader << Local_Version;
+	if (Local_Version <= PROGRAM_SETTINGS_STORE_VERSION)
+	{
+		Local_Reader << Entries;
+	}
+
+	if (Local_Reader.IsError() || Local_Version > PROGRAM_SETTINGS_STORE_VERSION)
+	{
+		printlog_error(FString::Printf(TEXT("Program settings in %s could not be read. Programs start with new settings."), *SlotName));
+		Entries.Reset();
+		return;
+	}
+
+	printlog_veryverbose(FString::Printf(TEXT("Read settings of %i program(s) from %s."), Entries.Num(), *SlotName));
+}
+
+#undef printlog_error
+#undef printlog_veryverbose
@@ -0,0 +1,100 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+
+#include "Misc/YetiOS_ProgramsRepository.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogYetiOsProgramsRepository, All, All)
+
+#define printlog_warn(Param1)			UE_LOG(LogYetiOsProgramsRepository, Warning, TEXT("%s"), *FString(Param1))
+#define printlog_veryverbose(Param1)	UE_LOG(LogYetiOsProgramsRepository, VeryVerbose, TEXT("%s"), *FString(Param1))
+
+UYetiOS_ProgramsRepository::UYetiOS_ProgramsRepository()
+{
+	bIndexBuilt = false;
+}
+
+void UYetiOS_ProgramsRepository::PostLoad()
+{
+	Super::PostLoad();
+	Internal_InvalidateIndex();
+}
+
+#if WITH_EDITOR
+void UYetiOS_ProgramsRepository::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	Internal_InvalidateIndex();
+}
+#endif
+
+TSubclassOf<class UYetiOS_BaseProgram> UYetiOS_ProgramsRepository::FindProgramClass(const FName& InProgramIdentifier) const
+{
+	Internal_BuildIndex();
+	return ProgramsByIdentifier.FindRef(InProgramIdentifier);
+}
+
+bool UYetiOS_ProgramsRepository::IsInstalledWithOS(TSubclassOf<class UYetiOS_BaseProgram> InProgramToCheck) const
+{
+	Internal_BuildIndex();
+	return InstallWithOsClasses.Contains(InProgramToCheck.Get());
+}
+
+const TArray<TSubclassOf<class UYetiOS_BaseProgram>>& UYetiOS_ProgramsRepository::GetProgramClasses() const
+{
+	Internal_BuildIndex();
+	return ProgramClasses;
+}
+
+const TArray<TSubclassOf<class UYetiOS_BaseProgram>>& UYetiOS_ProgramsRepository::GetStartupProgramClasses() const
+{
+	Internal_BuildIndex();
+	return StartupProgramClasses;
+}
+
+void UYetiOS_ProgramsRepository::Internal_BuildIndex() const
+{
+	if (bIndexBuilt)
+	{
+		return;
+	}
+
+	ProgramsByIdentifier.Empty(Programs.Num());
+	InstallWithOsClasses.Empty();
+	ProgramClasses.Empty(Programs.Num());
+	StartupProgramClasses.Empty();
+
+	for (const auto& It : Programs)
+	{
+		if (It.ProgramClass == nullptr)
+		{
+			continue;
+		}
+
+		const UYetiOS_BaseProgram* Local_CDO = It.ProgramClass->GetDefaultObject<UYetiOS_BaseProgram>();
+		const FName Local_Identifier = Local_CDO->GetProgramIdentifierName();
+		if (ProgramsByIdentifier.Contains(Local_Identifier))
+		{
+			printlog_warn(FString::Printf(TEXT("Duplicate program identifier %s in %s. %s will be ignored."), *Local_Identifier.ToString(), *GetName(), *It.ProgramClass->GetName()));
+			continue;
+		}
+
+		ProgramsByIdentifier.Add(Local_Identifier, It.ProgramClass);
+		ProgramClasses.Add(It.ProgramClass);
+		if (It.bInstallWithOS)
+		{
+			InstallWithOsClasses.Add(It.ProgramClass.Get());
+			StartupProgramClasses.Add(It.ProgramClass);
+		}
+	}
+
+	bIndexBuilt = true;
+	printlog_veryverbose(FString::Printf(TEXT("Indexed %i program(s) in %s."), ProgramsByIdentifier.Num(), *GetName()));
+}
+
+void UYetiOS_ProgramsRepository::Internal_InvalidateIndex()
+{
+	bIndexBuilt = false;
+}
+
+#undef printlog_warn
+#undef printlog_veryverbose
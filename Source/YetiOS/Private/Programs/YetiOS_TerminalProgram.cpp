@@ -47,7 +47,19 @@ void UYetiOS_TerminalProgram::CloseProgram(FYetiOsError& OutErrorMessage, const
 		ActiveCommandObject = nullptr;
 	}
 
-	Super::CloseProgram(OutErrorMessage);
+	Super::CloseProgram(OutErrorMessage, bIsOperatingSystemShuttingDown);
+}
+
+void UYetiOS_TerminalProgram::ResetForReuse()
+{
+	bIsRunningAsRoot = false;
+	ActiveCommandObject = nullptr;
+	CurrentDirectoryPath.Empty();
+	CurrentDirectory = nullptr;
+	QueuedCommands.Empty();
+	CurrentUser = FYetiOsUser();
+	CommandHistory.Empty();
+	CommandHistoryIndex = INDEX_NONE;
 }
 
 void UYetiOS_TerminalProgram::CheckUserPrompt(const bool bIsYes)
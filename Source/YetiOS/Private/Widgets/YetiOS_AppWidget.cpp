@@ -27,6 +27,12 @@ void UYetiOS_AppWidget::Internal_OnChangeVisibilityState(EYetiOsProgramVisibilit
 	K2_OnChangeVisibilityState(InNewState);
 }
 
+void UYetiOS_AppWidget::Internal_ReuseAppWidget(class UYetiOS_BaseProgram* InParentProgram)
+{
+	OwningProgram = InParentProgram;
+	SetOperatingSystem(InParentProgram->GetOwningOS());
+}
+
 void UYetiOS_AppWidget::DestroyProgramWidget()
 {
 	UnbindEvents();
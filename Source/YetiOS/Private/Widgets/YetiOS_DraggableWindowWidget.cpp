@@ -37,6 +37,7 @@ UYetiOS_DraggableWindowWidget::UYetiOS_DraggableWindowWidget(const FObjectInitia
 	bIsAlignmentAccountedFor = false;
 
 	LastMousePosition = PreResizeAlignment = PreResizeOffset = PreDragSize = FVector2D::ZeroVector;
+	PreParkVisibility = ESlateVisibility::Visible;
 	bIsFocusable = true;
 }
 
@@ -245,6 +246,13 @@ EYetiOsProgramVisibilityState UYetiOS_DraggableWindowWidget::GetCurrentVisibilit
 }
 
 void UYetiOS_DraggableWindowWidget::CloseWindow()
+{
+	Internal_UnbindWindowEvents();
+	ProgramCanvas->ClearChildren();
+	RemoveFromParent();
+}
+
+void UYetiOS_DraggableWindowWidget::Internal_UnbindWindowEvents()
 {
 	OwningOS->OnPeekPreview.Remove(OnPeekPreviewDelegateHandle);
 	OnPeekPreviewDelegateHandle.Reset();
@@ -264,9 +272,29 @@ void UYetiOS_DraggableWindowWidget::CloseWindow()
 	{
 		OutTaskbar->GetTaskbarWidget()->RemoveProgramFromTaskbar(this);
 	}
+}
 
+void UYetiOS_DraggableWindowWidget::Internal_ParkWindow()
+{
+	Internal_UnbindWindowEvents();
+	Internal_OnMouseButtonUpEvent();
 	ProgramCanvas->ClearChildren();
-	RemoveFromParent();
+	OwningProgram = nullptr;
+	PreParkVisibility = GetVisibility();
+	SetVisibility(ESlateVisibility::Collapsed);
+}
+
+void UYetiOS_DraggableWindowWidget::Internal_RestoreWindow(class UYetiOS_BaseProgram* InProgram, class UYetiOS_UserWidget* InWidget, const FVector2D& InOverrideSize)
+{
+	OwningProgram = InProgram;
+	SetVisibility(PreParkVisibility);
+	if (ParentSlot && InOverrideSize.IsZero() == false)
+	{
+		ParentSlot->SetSize(InOverrideSize);
+	}
+
+	AddWidget(InWidget);
+	BringWindowToFront();
 }
 
 bool UYetiOS_DraggableWindowWidget::BringWindowToFront()
@@ -35,7 +35,7 @@ void UYetiOS_OsWidget::FinishOsInstallation()
 	K2_OnFinishInstallation();
 }
 
-void UYetiOS_OsWidget::BeginLoadOS()
+void UYetiOS_OsWidget::Internal_BindThemeChanged()
 {
 	UYetiOS_SystemSettings* OsSystemSettings = OwningOS->GetSystemSettings();
 	if (OsSystemSettings)
@@ -43,10 +43,9 @@ void UYetiOS_OsWidget::BeginLoadOS()
 		K2_OnThemeChanged(OsSystemSettings->GetCurrentTheme());
 		OnThemeChangedDelegateHandle = OsSystemSettings->OnThemeModeChanged.AddUFunction(this, FName("K2_OnThemeChanged"));
 	}
-	K2_OnBeginLoadingOS();
 }
 
-void UYetiOS_OsWidget::BeginShutdownOS()
+void UYetiOS_OsWidget::Internal_UnbindThemeChanged()
 {
 	UYetiOS_SystemSettings* OsSystemSettings = OwningOS->GetSystemSettings();
 	if (OsSystemSettings)
@@ -54,6 +53,28 @@ void UYetiOS_OsWidget::BeginShutdownOS()
 		OsSystemSettings->OnThemeModeChanged.Remove(OnThemeChangedDelegateHandle);
 		OnThemeChangedDelegateHandle.Reset();
 	}
+}
+
+void UYetiOS_OsWidget::BeginLoadOS()
+{
+	Internal_BindThemeChanged();
+	K2_OnBeginLoadingOS();
+}
+
+void UYetiOS_OsWidget::ResumeOS()
+{
+	Internal_BindThemeChanged();
+	K2_OnResumeOS();
+}
+
+void UYetiOS_OsWidget::K2_OnResumeOS_Implementation()
+{
+	K2_OnBeginLoadingOS();
+}
+
+void UYetiOS_OsWidget::BeginShutdownOS()
+{
+	Internal_UnbindThemeChanged();
 	K2_OnBeginShuttingdownOS();
 }
 
@@ -87,6 +108,19 @@ void UYetiOS_OsWidget::ReceiveNotification(const FYetiOsNotification InNotificat
 	K2_OnReceivedNotification(InNotification);
 }
 
+void UYetiOS_OsWidget::ReceiveNotifications(const TArray<FYetiOsNotification>& InNotifications)
+{
+	K2_OnReceivedNotifications(InNotifications);
+}
+
+void UYetiOS_OsWidget::K2_OnReceivedNotifications_Implementation(const TArray<FYetiOsNotification>& NewNotifications)
+{
+	for (const FYetiOsNotification& It : NewNotifications)
+	{
+		K2_OnReceivedNotification(It);
+	}
+}
+
 class UYetiOS_DraggableWindowWidget* UYetiOS_OsWidget::CreateNewWindow(class UYetiOS_BaseProgram* InProgram, class UYetiOS_UserWidget* InWidget, const FVector2D& OverrideSize)
 {
 	return K2_CreateWindow(InProgram, InWidget, OverrideSize);
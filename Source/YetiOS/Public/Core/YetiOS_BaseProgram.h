@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "YetiOS_Types.h"
+#include "Core/YetiOS_ProgramScheduler.h"
 #include "Widgets/YetiOS_AppIconWidget.h"
 #include "Widgets/YetiOS_AppWidget.h"
 #include "YetiOS_BaseProgram.generated.h"
@@ -113,6 +114,14 @@ protected:
 	UPROPERTY(EditDefaultsOnly, AdvancedDisplay, Category = "Yeti OS Base Program")
 	uint8 bCanRunOnPortableDevice : 1;
 
+	/** If true, closed instances of this program are kept with their widget and window and reused on next launch. Blueprint variables are reset to installed values on reuse. C++ subclasses must override ResetForReuse() to clear their native state before enabling this. */
+	UPROPERTY(EditDefaultsOnly, AdvancedDisplay, Category = "Yeti OS Base Program")
+	uint8 bCanBePooled : 1;
+
+	/** Number of instances (with app widget) to create ahead of time when this program is installed so the first launches do not allocate. */
+	UPROPERTY(EditDefaultsOnly, AdvancedDisplay, Category = "Yeti OS Base Program", meta = (EditCondition = "bCanBePooled", ClampMin = "0", UIMin = "0", UIMax = "4"))
+	int32 PoolWarmCount;
+
 	/** If true, then C++ can call K2_OnCreate function. Implement OnCreate event in Blueprint Graph */
 	UPROPERTY(EditDefaultsOnly, AdvancedDisplay, Category = "Yeti OS Base Program")
 	uint8 bCanCallOnCreate : 1;
@@ -208,6 +217,26 @@ private:
 	**/
 	UYetiOS_BaseProgram* Internal_StartProgram(FYetiOsError& OutErrorMessage);
 
+	/**
+	* private UYetiOS_BaseProgram::Internal_DuplicateProgram
+	* Creates a new running instance of this installed program.
+	* @return [UYetiOS_BaseProgram*] New instance.
+	**/
+	UYetiOS_BaseProgram* Internal_DuplicateProgram();
+
+	/**
+	* private UYetiOS_BaseProgram::Internal_ResetForReuse
+	* Resets a pooled instance to the state of the installed program it was created from.
+	* @param InInstalledProgram [const UYetiOS_BaseProgram*] Installed program this instance is started from.
+	**/
+	void Internal_ResetForReuse(const UYetiOS_BaseProgram* InInstalledProgram);
+
+	/**
+	* private UYetiOS_BaseProgram::Internal_WarmInstancePool
+	* Creates instances of this installed program in program pool until PoolWarmCount is reached.
+	**/
+	void Internal_WarmInstancePool();
+
 public:
 
 	/**
@@ -264,6 +293,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Yeti OS Base Program")
 	virtual void CloseProgram(FYetiOsError& OutErrorMessage, const bool bIsOperatingSystemShuttingDown = false);
 
+	/**
+	* public UYetiOS_BaseProgram::RegisterUpdate
+	* Registers an event that runs every frame while this program is running. Use this instead of looping timers so the Operating System can keep per frame cost within the device budget.
+	* The event may be deferred to a later frame if the budget is used up. Delta Time is always the time since the event last ran.
+	* @param Callback [const FOnProgramUpdate&] Event to run.
+	* @param Priority [const EYetiOsProgramUpdatePriority] Higher priority events run first.
+	* @return [int32] Handle to unregister with. -1 if this program is not running.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS Base Program")
+	int32 RegisterUpdate(const FOnProgramUpdate& Callback, const EYetiOsProgramUpdatePriority Priority = EYetiOsProgramUpdatePriority::PRIORITY_Normal);
+
+	/**
+	* public UYetiOS_BaseProgram::UnregisterUpdate
+	* Unregisters an event registered with RegisterUpdate. All events are unregistered automatically when this program closes.
+	* @param Handle [const int32] Handle returned by RegisterUpdate.
+	* @return [bool] True if the event was unregistered.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS Base Program")
+	bool UnregisterUpdate(const int32 Handle);
+
 	/**
 	* public UYetiOS_BaseProgram::GetProgramWidget const
 	* Returns the widget that was created using Program Widget Class.
@@ -297,12 +346,19 @@ public:
 	bool IsRunning() const;
 
 	/**
-	* public UYetiOS_BaseProgram::GetProgramIconWidget const
-	* Returns Program Icon Widget.
+	* public UYetiOS_BaseProgram::GetProgramIconWidget
+	* Returns Program Icon Widget. Widget is created the first time this is called and kept until ReleaseProgramIconWidget is called.
 	* @return [class UYetiOS_AppIconWidget*] Program Icon Widget.
 	**/
-	UFUNCTION(BlueprintPure, Category = "Yeti OS Base Program")	
-	class UYetiOS_AppIconWidget* GetProgramIconWidget() const { return ProgramIconWidget; }
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS Base Program")	
+	class UYetiOS_AppIconWidget* GetProgramIconWidget();
+
+	/**
+	* public UYetiOS_BaseProgram::ReleaseProgramIconWidget
+	* Removes the program icon widget from its parent and drops the reference. Views should call this when the program is no longer shown.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS Base Program")
+	void ReleaseProgramIconWidget();
 
 	/**
 	* public UYetiOS_BaseProgram::GetProgramVersion const
@@ -323,6 +379,13 @@ private:
 	bool Internal_LoadProgramSettings();
 
 protected:
+
+	/**
+	* virtual protected UYetiOS_BaseProgram::ResetForReuse
+	* Called when a pooled instance is taken for a new launch, after Blueprint variables are restored.
+	* Override to clear native state set while the previous instance was running.
+	**/
+	virtual void ResetForReuse() {}
 		
 	/**
 	* protected UYetiOS_BaseProgram::K2_OnCreate
@@ -405,8 +468,11 @@ public:
 	FORCEINLINE const bool CanShowPostInstallNotification() const { return bCreateInstallationNotification; }
 	FORCEINLINE const bool RequireMinimumOsVersion() const { return bRequireMinimumOperatingSystemVersion; }
 	FORCEINLINE const bool SupportsStore() const { return bSupportStore; }
+	FORCEINLINE const bool CanBePooled() const { return bCanBePooled; }
+	FORCEINLINE const int32 GetPoolWarmCount() const { return PoolWarmCount; }
 	FORCEINLINE const EYetiOsProgramVisibilityState GetCurrentVisibilityState() const { return CurrentVisibilityState; }
 	FORCEINLINE class UYetiOS_DraggableWindowWidget* GetOwningWindow() const { return OwningWindow; }
 	FORCEINLINE FYetiOsStoreDetail GetStoreDetail() const { return StoreDetail; }
 	FORCEINLINE FYetiOS_Version GetMinimumOsVersionRequired() const { return MinimumOperatingSystemVersionRequired; }
+	FORCEINLINE const TSet<TSoftClassPtr<class UYetiOS_BaseProgram>>& GetDependantPrograms() const { return DependantPrograms; }
 };
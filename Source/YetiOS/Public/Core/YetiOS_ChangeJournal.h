@@ -0,0 +1,212 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Kinds of changes stored in the change journal. Values are written to disk so new ops are only added at the end.
+* A change that has no op here has to be compacted into a save game right away (@See UYetiOS_BaseDevice::SaveDevice), otherwise replaying the journal loses it.
+**/
+namespace EYetiOsJournalOp
+{
+	enum Type : uint8
+	{
+		/** Strings: parent directory path, directory name, directory class path. Flags: EYetiOsSaveRecordFlags. */
+		DirectoryCreated,
+
+		/** Strings: directory path, new directory name. */
+		DirectoryRenamed,
+
+		/** Strings: directory path, file class path, file name, file extension. Flags: EYetiOsSaveRecordFlags. */
+		FileCreated,
+
+		/** Strings: directory path, file name, file extension. */
+		FileDeleted,
+
+		/** Strings: directory path, old file name, old file extension, new file name, new file extension. */
+		FileRenamed,
+
+		/** Strings: program class path. */
+		ProgramInstalled,
+
+		/** Data: FYetiOsOperatingSystemSaveLoad. */
+		OsData,
+
+		/** Data: FYetiOsDeviceSaveLoad. */
+		DeviceData,
+
+		/** Strings: directory path, file name, file extension. Data: whole file content. Written once per flush no matter how often the content changed. */
+		FileContentChanged,
+
+		Max
+	};
+}
+
+/** A single change. Records only keep strings and property data so they never reference live objects. */
+struct YETIOS_API FYetiOsJournalRecord
+{
+	EYetiOsJournalOp::Type Op;
+
+	/** EYetiOsSaveRecordFlags bits. */
+	uint8 Flags;
+
+	TArray<FString> Strings;
+
+	/** Tagged property data of a struct. @See SetStructData */
+	TArray<uint8> Data;
+
+	FYetiOsJournalRecord()
+	{
+		Op = EYetiOsJournalOp::Max;
+		Flags = 0;
+	}
+
+	FYetiOsJournalRecord(const EYetiOsJournalOp::Type InOp)
+	{
+		Op = InOp;
+		Flags = 0;
+	}
+
+	static FYetiOsJournalRecord MakeDirectoryCreated(const class UYetiOS_DirectoryBase* InDirectory);
+	static FYetiOsJournalRecord MakeDirectoryRenamed(const FString& InOldPath, const FText& InNewName);
+	static FYetiOsJournalRecord MakeFileCreated(const class UYetiOS_FileBase* InFile);
+	static FYetiOsJournalRecord MakeFileDeleted(const class UYetiOS_FileBase* InFile);
+	static FYetiOsJournalRecord MakeFileRenamed(const class UYetiOS_FileBase* InFile, const FText& InOldName, const FText& InOldExtension);
+	static FYetiOsJournalRecord MakeProgramInstalled(const class UYetiOS_BaseProgram* InProgram);
+	static FYetiOsJournalRecord MakeFileContentChanged(const class UYetiOS_FileBase* InFile, const class UYetiOS_FileContent* InContent);
+
+	/**
+	* public FYetiOsJournalRecord::SetStructData
+	* Stores properties of the given struct in Data. Object references are stored as paths like in a save game.
+	* @param InStruct [const UScriptStruct*] Struct type.
+	* @param InStructData [const void*] Struct to store.
+	**/
+	void SetStructData(const UScriptStruct* InStruct, const void* InStructData);
+
+	/**
+	* public FYetiOsJournalRecord::GetStructData const
+	* Reads properties stored by SetStructData into the given struct.
+	* @param InStruct [const UScriptStruct*] Struct type.
+	* @param OutStructData [void*] Struct to fill.
+	* @return [bool] True if Data was not empty.
+	**/
+	bool GetStructData(const UScriptStruct* InStruct, void* OutStructData) const;
+
+	FORCEINLINE const FString& GetString(const int32 InIndex) const
+	{
+		static const FString EmptyString;
+		return Strings.IsValidIndex(InIndex) ? Strings[InIndex] : EmptyString;
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FYetiOsJournalRecord& InRecord);
+};
+
+/*************************************************************************
+* File Information:
+YetiOS_ChangeJournal.h
+
+* Description:
+Append only log of changes made to an operating system since its last
+save game. Each generation of the journal is its own file. A save game
+remembers the generation that was current when it was captured, so
+loading replays that generation and every newer one on top of the save.
+Compaction is just a save that starts a new generation. Once the save is
+written older generations are deleted.
+Every record is written with its size and checksum. Reading stops at the
+first record that does not match so a write cut short by a crash only
+loses that record.
+*************************************************************************/
+struct YETIOS_API FYetiOsChangeJournal
+{
+private:
+
+	/** Directory journal files are written to. Empty while closed. */
+	FString JournalDirectory;
+
+	/** Prefix of journal file names. */
+	FString JournalName;
+
+	/** Generation new records are appended to. */
+	uint32 Generation;
+
+	/** Framed records waiting to be appended. */
+	TArray<uint8> PendingBytes;
+
+	/** Bytes of all generations on disk. */
+	int64 JournalSize;
+
+public:
+
+	FYetiOsChangeJournal();
+
+	/**
+	* public FYetiOsChangeJournal::Open
+	* Starts appending to the given generation.
+	* @param InDirectory [const FString&] Directory journal files are written to.
+	* @param InName [const FString&] Prefix of journal file names.
+	* @param InGeneration [const uint32] Generation to append to.
+	**/
+	void Open(const FString& InDirectory, const FString& InName, const uint32 InGeneration);
+
+	/**
+	* public FYetiOsChangeJournal::Close
+	* Drops pending records and stops appending. Files on disk are kept.
+	**/
+	void Close();
+
+	/**
+	* public FYetiOsChangeJournal::Append
+	* Queues a record. Nothing is written until Flush.
+	* @param InRecord [const FYetiOsJournalRecord&] Record to append.
+	**/
+	void Append(const FYetiOsJournalRecord& InRecord);
+
+	/**
+	* public FYetiOsChangeJournal::Flush
+	* Appends queued records to the file of the current generation.
+	* @return [bool] True if nothing was pending or everything was written.
+	**/
+	bool Flush();
+
+	/**
+	* public FYetiOsChangeJournal::Rotate
+	* Flushes and starts a new generation.
+	* @return [uint32] New generation.
+	**/
+	uint32 Rotate();
+
+	/**
+	* public FYetiOsChangeJournal::DeleteGenerationsBefore
+	* Deletes files of generations older than the given one.
+	* @param InGeneration [const uint32] Oldest generation to keep.
+	**/
+	void DeleteGenerationsBefore(const uint32 InGeneration);
+
+	/**
+	* public FYetiOsChangeJournal::ReadRecords const
+	* Reads records of the given generation and every newer one in the order they were appended.
+	* @param InFromGeneration [const uint32] Oldest generation to read.
+	* @param OutRecords [TArray<FYetiOsJournalRecord>&] Records read.
+	* @return [uint32] Newest generation found on disk or InFromGeneration if there is none.
+	**/
+	uint32 ReadRecords(const uint32 InFromGeneration, TArray<FYetiOsJournalRecord>& OutRecords) const;
+
+private:
+
+	/**
+	* private FYetiOsChangeJournal::Internal_GetGenerations const
+	* Finds generations that have a file on disk.
+	* @param OutGenerations [TArray<uint32>&] Generations sorted from oldest to newest.
+	**/
+	void Internal_GetGenerations(TArray<uint32>& OutGenerations) const;
+
+	FString Internal_GetFilePath(const uint32 InGeneration) const;
+
+public:
+
+	FORCEINLINE const bool IsOpen() const { return JournalDirectory.IsEmpty() == false; }
+	FORCEINLINE const bool HasPendingRecords() const { return PendingBytes.Num() > 0; }
+	FORCEINLINE const uint32 GetGeneration() const { return Generation; }
+	FORCEINLINE const int64 GetSize() const { return JournalSize; }
+};
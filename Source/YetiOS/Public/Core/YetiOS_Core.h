@@ -5,10 +5,36 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "YetiOS_Types.h"
+#include "Core/YetiOS_ProcessTable.h"
+#include "Core/YetiOS_ProgramRegistry.h"
+#include "Core/YetiOS_NotificationManager.h"
+#include "Core/YetiOS_ProgramScheduler.h"
+#include "Core/YetiOS_ProgramPool.h"
+#include "Core/YetiOS_PathResolver.h"
+#include "Core/YetiOS_SearchService.h"
+#include "Core/YetiOS_FileIndex.h"
+#include "Core/YetiOS_SaveSchema.h"
+#include "Core/YetiOS_ChangeJournal.h"
+#include "Misc/YetiOS_ProgramSettingsStore.h"
 #include "YetiOS_Core.generated.h"
 
 class UYetiOS_StartMenu;
 class UYetiOS_AppIconWidget;
+
+/** Steps of loading the OS from a save game. @See UYetiOS_Core::ContinueLoadFromSaveGame */
+namespace EYetiOsSaveGameLoadStep
+{
+	enum Type : uint8
+	{
+		Directories,
+		Files,
+		Programs,
+		FileIndex,
+		Journal,
+		Done
+	};
+}
+
 USTRUCT()
 struct FYetiOsNotificationSettings
 {
@@ -34,6 +60,22 @@ struct FYetiOsNotificationSettings
 	UPROPERTY(EditAnywhere, Category = "Notification Settings", meta = (EditCondition = "bEnableNotifications && bPlayNotificationSound"))
 	class USoundBase* NotificationSoundError;
 
+	/** Maximum number of notifications kept in history. Oldest notifications are dropped once this is reached. */
+	UPROPERTY(EditAnywhere, Category = "Notification Settings", meta = (EditCondition = "bEnableNotifications", ClampMin = "1", UIMin = "1"))
+	int32 HistoryCapacity;
+
+	/** Identical notifications (same Category, Level, Code, Title and Description) received within this many seconds are merged into one. */
+	UPROPERTY(EditAnywhere, Category = "Notification Settings", meta = (EditCondition = "bEnableNotifications", ClampMin = "0", UIMin = "0"))
+	float CoalesceWindow;
+
+	/** Maximum notifications shown per second for each category. Zero means unlimited. Rate limited notifications are still kept in history. */
+	UPROPERTY(EditAnywhere, Category = "Notification Settings", meta = (EditCondition = "bEnableNotifications", ClampMin = "0", UIMin = "0"))
+	float DefaultRateLimit;
+
+	/** Per category override for DefaultRateLimit. */
+	UPROPERTY(EditAnywhere, Category = "Notification Settings", meta = (EditCondition = "bEnableNotifications"))
+	TMap<EYetiOsNotificationCategory, float> CategoryRateLimits;
+
 	FYetiOsNotificationSettings()
 	{
 		bEnableNotifications = true;
@@ -41,12 +83,16 @@ struct FYetiOsNotificationSettings
 		NotificationSoundDefault = nullptr;
 		NotificationSoundWarning = nullptr;
 		NotificationSoundError = nullptr;
+		HistoryCapacity = 256;
+		CoalesceWindow = 2.f;
+		DefaultRateLimit = 5.f;
 	}
 };
 
 DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnInstallProgramFinishedDelegate, class UYetiOS_BaseProgram*, _Program, const FYetiOsError&, _ErrorMessage, UYetiOS_AppIconWidget*, _IconWidget);
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnProgramInstalled, class UYetiOS_BaseProgram*)
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnProgramsInstalled, const TArray<class UYetiOS_BaseProgram*>&)
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnPeekPreview, const bool)
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnToggleFileLockForUser, const bool, bIsLocked, class UYetiOS_FileBase*, _File, const FYetiOsUser&, _User);
@@ -65,12 +111,18 @@ class YETIOS_API UYetiOS_Core : public UObject
 	GENERATED_BODY()
 	
 	friend class UYetiOS_BaseDevice;
+	friend class UYetiOS_SaveGame;
 	
 #if WITH_EDITOR
 	friend class UYetiOS_ThumbnailRenderer;
 #endif
 	
 	FTimerHandle TimerHandle_OsInstallation;
+	FTimerHandle TimerHandle_ProgramScheduler;
+	FTimerHandle TimerHandle_SearchService;
+	FTimerHandle TimerHandle_FileIndex;
+	FTimerHandle TimerHandle_ChangeJournal;
+	FTimerHandle TimerHandle_ProgramSettings;
 
 	FDelegateHandle DelegateHandle_Lock;
 	FDelegateHandle DelegateHandle_Unlock;
@@ -121,6 +173,18 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS")
 	FYetiOsNotificationSettings NotificationSettings;
 
+	/** Settings for the program scheduler that runs per frame updates of running programs. */
+	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS", AdvancedDisplay)
+	FYetiOsSchedulerSettings SchedulerSettings;
+
+	/** Settings for reusing closed programs. */
+	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS", AdvancedDisplay)
+	FYetiOsProgramPoolSettings ProgramPoolSettings;
+
+	/** Settings for the index used by QueryFileIndex. */
+	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS", AdvancedDisplay)
+	FYetiOsFileIndexSettings FileIndexSettings;
+
 	/** A root user for this OS. Defaults to root. */
 	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS", AdvancedDisplay)
 	FYetiOsUser RootUser;
@@ -157,26 +221,25 @@ private:
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	class UYetiOS_OsWidget* OsWidget;
 
-	/** List of actively running programs. */
+	/** Table of actively running programs indexed by process ID and identifier. */
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
-	TMap<int32, class UYetiOS_BaseProgram*> RunningPrograms;
+	FYetiOsProcessTable ProcessTable;
 
-	/** List of installed programs. */
+	/** Registry of installed programs indexed by identifier and class. */
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
-	TArray<class UYetiOS_BaseProgram*> InstalledPrograms;
+	FYetiOsProgramRegistry InstalledPrograms;
 
 	/** The main root directory. Cannot be null. */
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	mutable class UYetiOS_DirectoryRoot* RootDirectory;
 
+	/** Cache of resolved directory paths. */
+	mutable FYetiOsPathResolver PathResolver;
+
 	/** The user that is currently active. */
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	FYetiOsUser CurrentActiveUser;
 
-	/** List of all created directories. Used for save game information. */
-	UPROPERTY(VisibleInstanceOnly, Category = Debug)
-	TArray<const UYetiOS_DirectoryBase*> AllCreatedDirectories;
-
 	/** Taskbar that was created if Taskbar Class was not null. */
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	class UYetiOS_Taskbar* Taskbar;
@@ -202,11 +265,60 @@ private:
 	/** Weak pointer to the desktop directory. */
 	TWeakObjectPtr<UYetiOS_DirectoryBase> DesktopDirectory;
 
+	/** Program classes queued for installation in the current install batch. @See BeginInstallBatch */
+	TArray<TSubclassOf<class UYetiOS_BaseProgram>> PendingInstallBatch;
+
+	/** True if an install batch is open. */
+	uint8 bIsInstallBatchOpen : 1;
+
+	/** True if pending notifications are scheduled to be delivered to OS widget on next tick. */
+	uint8 bIsNotificationFlushPending : 1;
+
+	/** Runs per frame updates registered by running programs within the device frame budget. */
+	FYetiOsProgramScheduler ProgramScheduler;
+
+	/** Closed programs kept with their widget and window for reuse. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	FYetiOsProgramPool ProgramPool;
+
+	/** Runs find and grep searches over the directory tree on worker threads. */
+	FYetiOsSearchService SearchService;
+
+	/** Words of file names and content mapped to files. Only used if File Index Settings has bEnableFileIndex. */
+	FYetiOsFileIndex FileIndex;
+
+	/** Files whose content changed since the index was last updated. */
+	TSet<TWeakObjectPtr<class UYetiOS_FileBase>> PendingContentIndexUpdates;
+
+	/** Files whose content changed since the change journal was last flushed. */
+	TSet<TWeakObjectPtr<class UYetiOS_FileBase>> PendingJournalContents;
+
+	/** True once every file of the directory tree was added to FileIndex. Files created after that are added as they are created. */
+	uint8 bIsFileIndexComplete : 1;
+
+	/** Directories and files loaded so far while loading from a save game. */
+	FYetiOsSaveTreeLoadState SaveTreeLoadState;
+
+	/** Current step of loading from a save game. */
+	EYetiOsSaveGameLoadStep::Type SaveGameLoadStep;
+
+	/** Changes made since the last save game. Only open if the device enables the change journal. */
+	FYetiOsChangeJournal ChangeJournal;
+
+	/** First journal generation that is not part of the save game being written. */
+	uint32 CompactingJournalGeneration;
+
+	/** Settings of every program on this device. Read when this OS is created and written in batches. */
+	FYetiOsProgramSettingsStore ProgramSettingsStore;
+
 public:
 
-	/** Delegate called when program is installed. @See InstallProgram */
+	/** Delegate called when program is installed. Called for each program of a batch as well. @See InstallProgram, CommitInstallBatch */
 	FOnProgramInstalled OnProgramInstalled;
 
+	/** Delegate called once with all programs installed together. Called for single installs as well. @See InstallProgram, CommitInstallBatch */
+	FOnProgramsInstalled OnProgramsInstalled;
+
 	/** Delegate called when peek desktop is activated. @See UYetiOS_Taskbar::PeekDesktop */
 	FOnPeekPreview OnPeekPreview;
 
@@ -356,6 +468,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Yeti OS")	
 	void CreateOsNotification(const FYetiOsNotification InNewNotification);
 
+	/**
+	* public UYetiOS_Core::GetNotificationHistoryCount const
+	* Returns the number of notifications currently kept in history.
+	* @return [int32] Number of notifications in history.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS")
+	int32 GetNotificationHistoryCount() const;
+
+	/**
+	* public UYetiOS_Core::GetNotificationHistoryPage const
+	* Outputs one page of notification history, newest first.
+	* @param InPage [const int32] Zero based page index.
+	* @param InPageSize [const int32] Number of notifications per page.
+	* @param OutNotifications [TArray<FYetiOsNotification>&] Notifications in this page.
+	* @return [int32] Total number of pages.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS")
+	int32 GetNotificationHistoryPage(const int32 InPage, const int32 InPageSize, TArray<FYetiOsNotification>& OutNotifications) const;
+
 	/**
 	* public UYetiOS_Core::ToggleLockOnFile
 	* Toggles lock state on target file.
@@ -427,6 +558,37 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Yeti OS")	
 	UYetiOS_BaseProgram* InstallProgram(TSubclassOf<UYetiOS_BaseProgram> InProgramToInstall, FYetiOsError& OutErrorMessage, UYetiOS_AppIconWidget*& OutIconWidget);
 
+	/**
+	* public UYetiOS_Core::BeginInstallBatch
+	* Opens an install batch. Programs added with AddToInstallBatch are installed together when CommitInstallBatch is called.
+	* @return [bool] True if a new batch was opened. False if a batch is already open.
+	**/
+	bool BeginInstallBatch();
+
+	/**
+	* public UYetiOS_Core::AddToInstallBatch
+	* Queues the given program class to the open install batch.
+	* @param InProgramToInstall [TSubclassOf<UYetiOS_BaseProgram>] Program to install.
+	* @return [bool] True if the program was queued.
+	**/
+	bool AddToInstallBatch(TSubclassOf<UYetiOS_BaseProgram> InProgramToInstall);
+
+	/**
+	* public UYetiOS_Core::CommitInstallBatch
+	* Installs all queued programs. Disk space is checked and consumed once for the whole batch. If there is not enough space nothing is installed.
+	* Icon widgets are created after all programs are installed, then one summary notification and one OnProgramsInstalled broadcast are sent.
+	* @param OutErrorMessage [FYetiOsError&] Outputs error message (if any).
+	* @param bShowSummaryNotification [const bool] If true, show a single notification summarizing the batch.
+	* @return [int32] Number of programs that were installed.
+	**/
+	int32 CommitInstallBatch(FYetiOsError& OutErrorMessage, const bool bShowSummaryNotification = true);
+
+	/**
+	* public UYetiOS_Core::CancelInstallBatch
+	* Discards the open install batch without installing anything.
+	**/
+	void CancelInstallBatch();
+
 	/**
 	* public UYetiOS_Core::InstallProgramFromPackage
 	* Install a given program (or package) from the repository. A valid repository library should be defined and the program you are looking must have a valid identifier.
@@ -502,6 +664,159 @@ public:
 	**/
 	virtual void CloseRunningProgram(class UYetiOS_BaseProgram* InProgram, FYetiOsError& OutErrorMessage);
 
+	/**
+	* public UYetiOS_Core::RegisterProgramUpdate
+	* Registers a native callback that runs every frame while the given program is running. Callbacks are unregistered automatically when the program closes.
+	* @param InProgram [class UYetiOS_BaseProgram*] Running program that owns the callback.
+	* @param InCallback [const FYetiOsProgramUpdateDelegate&] Callback to run. Receives time since it last ran.
+	* @param InPriority [const EYetiOsProgramUpdatePriority] Higher priority callbacks run first when the frame budget is tight.
+	* @return [int32] Handle to unregister with or INDEX_NONE if the program is not running.
+	**/
+	int32 RegisterProgramUpdate(class UYetiOS_BaseProgram* InProgram, const FYetiOsProgramUpdateDelegate& InCallback, const EYetiOsProgramUpdatePriority InPriority = EYetiOsProgramUpdatePriority::PRIORITY_Normal);
+
+	/** @See RegisterProgramUpdate(class UYetiOS_BaseProgram*, const FYetiOsProgramUpdateDelegate&, const EYetiOsProgramUpdatePriority) */
+	int32 RegisterProgramUpdate(class UYetiOS_BaseProgram* InProgram, const FOnProgramUpdate& InCallback, const EYetiOsProgramUpdatePriority InPriority = EYetiOsProgramUpdatePriority::PRIORITY_Normal);
+
+	/**
+	* public UYetiOS_Core::UnregisterProgramUpdate
+	* Unregisters a callback registered with RegisterProgramUpdate.
+	* @param InHandle [const int32] Handle returned by RegisterProgramUpdate.
+	* @return [bool] True if the callback was unregistered.
+	**/
+	bool UnregisterProgramUpdate(const int32 InHandle);
+
+	/**
+	* public UYetiOS_Core::GetProgramUpdateBudget const
+	* Returns the time running programs can use per frame on this device. Scales with total CPU speed of the device.
+	* @return [float] Budget in milliseconds.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS")
+	float GetProgramUpdateBudget() const;
+
+	/**
+	* public UYetiOS_Core::CanPoolProgram const
+	* Checks if closed instances of the given program can be kept for reuse.
+	* @param InProgram [const class UYetiOS_BaseProgram*] Program to check.
+	* @return [bool] True if pooling is enabled and the program supports it.
+	**/
+	bool CanPoolProgram(const class UYetiOS_BaseProgram* InProgram) const;
+
+	/**
+	* public UYetiOS_Core::AcquirePooledProgram
+	* Takes the most recently closed instance of the given program class out of the pool.
+	* @param InProgramClass [const UClass*] Program class to look for.
+	* @param OutEntry [FYetiOsPooledProgram&] Pooled program with its widget and window.
+	* @return [bool] True if a pooled instance was found.
+	**/
+	bool AcquirePooledProgram(const UClass* InProgramClass, FYetiOsPooledProgram& OutEntry);
+
+	/**
+	* public UYetiOS_Core::ReleaseProgramToPool
+	* Keeps a closed program for reuse. Destroys it instead if it cannot be pooled. Least recently used programs are destroyed to stay within pool limits.
+	* @param InEntry [const FYetiOsPooledProgram&] Closed program with its widget and window.
+	**/
+	void ReleaseProgramToPool(const FYetiOsPooledProgram& InEntry);
+
+	/**
+	* public UYetiOS_Core::StartSearch
+	* Searches the given directory and everything under it for files (and optionally directories) matching the query. Directory tree is copied over a few frames within the program update budget and matched on worker threads.
+	* @param InStartDirectory [UYetiOS_DirectoryBase*] Directory to search. Searches from root directory if null.
+	* @param InQuery [const FYetiOsSearchQuery&] Name, extension and content to look for.
+	* @param OnResults [const FOnSearchResults&] Called every frame matches were found with the new matches.
+	* @param OnFinished [const FOnSearchFinished&] Called once all matches were delivered or the search was cancelled.
+	* @return [int32] Search ID to cancel with.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS")
+	int32 StartSearch(UYetiOS_DirectoryBase* InStartDirectory, const FYetiOsSearchQuery& InQuery, const FOnSearchResults& OnResults, const FOnSearchFinished& OnFinished);
+
+	/**
+	* public UYetiOS_Core::CancelSearch
+	* Stops a running search. On Finished is called right away.
+	* @param InSearchID [const int32] Search ID returned by StartSearch.
+	* @return [bool] True if the search was running.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS")
+	bool CancelSearch(const int32 InSearchID);
+
+	/**
+	* public UYetiOS_Core::IsSearchRunning const
+	* Checks if the given search has not finished yet.
+	* @param InSearchID [const int32] Search ID returned by StartSearch.
+	* @return [bool] True if running.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS")
+	bool IsSearchRunning(const int32 InSearchID) const;
+
+	/**
+	* public UYetiOS_Core::QueryFileIndex
+	* Finds files that have a word starting with every word of the query in their name (or content if content indexing is enabled). First call indexes the whole directory tree.
+	* @param InQuery [const FString&] Text to look for. Example: "rep tx" finds report.txt.
+	* @param OutFiles [TArray<class UYetiOS_FileBase*>&] Files found.
+	* @param InMaxResults [const int32] Maximum number of files to return. 0 means no limit.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS")
+	void QueryFileIndex(const FString& InQuery, TArray<class UYetiOS_FileBase*>& OutFiles, const int32 InMaxResults = 50);
+
+	/**
+	* public UYetiOS_Core::RebuildFileIndex
+	* Clears the file index and indexes every file of the directory tree again.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS")
+	void RebuildFileIndex();
+
+	/**
+	* public UYetiOS_Core::GetFileIndexMemoryUsage const
+	* Returns memory used by the file index.
+	* @return [int64] Size in bytes.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS")
+	int64 GetFileIndexMemoryUsage() const;
+
+	/**
+	* public UYetiOS_Core::NotifyFileChanged
+	* Updates the file index after the given file was created or renamed.
+	* @param InFile [class UYetiOS_FileBase*] File that changed.
+	**/
+	void NotifyFileChanged(class UYetiOS_FileBase* InFile);
+
+	/**
+	* public UYetiOS_Core::NotifyFileContentChanged
+	* Schedules the content of the given file to be indexed and written to the change journal on the next frame.
+	* @param InFile [class UYetiOS_FileBase*] File whose content changed.
+	**/
+	void NotifyFileContentChanged(class UYetiOS_FileBase* InFile);
+
+	/**
+	* public UYetiOS_Core::NotifyFileRemoved
+	* Removes the given file from the file index.
+	* @param InFile [const class UYetiOS_FileBase*] File that was deleted.
+	**/
+	void NotifyFileRemoved(const class UYetiOS_FileBase* InFile);
+
+	/**
+	* public UYetiOS_Core::JournalChange
+	* Appends a change to the change journal. Journal is written to disk on the next frame.
+	* @param InRecord [const FYetiOsJournalRecord&] Change to append.
+	**/
+	void JournalChange(const FYetiOsJournalRecord& InRecord);
+
+	/**
+	* public UYetiOS_Core::StoreProgramSettings
+	* Keeps saved settings of a program in memory. Settings changed within a short delay are written together on a worker thread.
+	* @param InProgramIdentifier [const FName&] Identifier of the program.
+	* @param InSettingsData [TArray<uint8>&&] Saved settings object. @See UGameplayStatics::SaveGameToMemory
+	**/
+	void StoreProgramSettings(const FName& InProgramIdentifier, TArray<uint8>&& InSettingsData);
+
+	/**
+	* public UYetiOS_Core::TrimProgramPool
+	* Destroys least recently used pooled programs until at most the given number remain.
+	* @param InMaxToKeep [const int32] Number of pooled programs to keep. 0 empties the pool.
+	* @return [int32] Number of pooled programs destroyed.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS")
+	int32 TrimProgramPool(const int32 InMaxToKeep = 0);
+
 	/**
 	* public UYetiOS_Core::SetActiveUser
 	* Sets the given user to active user.
@@ -602,10 +917,144 @@ private:
 
 	/**
 	* private UYetiOS_Core::Internal_InstallStartupPrograms
-	* Installs all programs defined in ProgramsToInstall.
+	* Queues all programs defined in ProgramsToInstall to the open install batch, or installs them in a new batch if none is open.
 	**/
 	void Internal_InstallStartupPrograms();
 
+	/**
+	* private UYetiOS_Core::Internal_FlushNotifications
+	* Delivers all pending notifications to OS widget in a single batch. Scheduled at most once per tick from CreateOsNotification.
+	**/
+	void Internal_FlushNotifications();
+
+	/**
+	* private UYetiOS_Core::Internal_TickProgramScheduler
+	* Runs registered program updates for this frame and schedules the next frame while any update is registered.
+	**/
+	void Internal_TickProgramScheduler();
+
+	/**
+	* private UYetiOS_Core::Internal_TickSearchService
+	* Continues running searches for this frame and schedules the next frame while any search is running.
+	**/
+	void Internal_TickSearchService();
+
+	/**
+	* private UYetiOS_Core::Internal_FlushFileIndexUpdates
+	* Indexes content of every file that changed since the last flush.
+	**/
+	void Internal_FlushFileIndexUpdates();
+
+	/**
+	* private UYetiOS_Core::Internal_FlushChangeJournal
+	* Writes changes of this frame to the change journal and starts a save once the journal grows past the compaction threshold of the device.
+	**/
+	void Internal_FlushChangeJournal();
+
+	/**
+	* private UYetiOS_Core::Internal_FlushProgramSettings
+	* Starts writing changed program settings. Tries again later if the previous write is still running.
+	**/
+	void Internal_FlushProgramSettings();
+
+	/**
+	* private UYetiOS_Core::Internal_DetachFromWorld
+	* Drops everything that belongs to the current world so this OS can outlive it. Running programs are closed, widgets and
+	* timers are released and pending journal and settings changes are written. Called when the device is kept across a level transition.
+	* @param OutRunningPrograms [TArray<FName>&] Identifiers of programs that were running. Pass them to Internal_AttachToWorld.
+	**/
+	void Internal_DetachFromWorld(TArray<FName>& OutRunningPrograms);
+
+	/**
+	* private UYetiOS_Core::Internal_AttachToWorld
+	* Creates widgets of this OS in the world of its device again and starts programs that were running when it was detached.
+	* @param InRunningPrograms [const TArray<FName>&] Identifiers of programs to start.
+	**/
+	void Internal_AttachToWorld(const TArray<FName>& InRunningPrograms);
+
+	/**
+	* private UYetiOS_Core::Internal_JournalOsData
+	* Appends users and version of this OS to the change journal.
+	**/
+	void Internal_JournalOsData();
+
+	/**
+	* private UYetiOS_Core::Internal_JournalDeviceData
+	* Appends installed state and remaining space of the device to the change journal.
+	**/
+	void Internal_JournalDeviceData();
+
+	/**
+	* private UYetiOS_Core::Internal_OpenChangeJournal
+	* Replays changes journaled after the given save game and opens the journal for new changes.
+	* @param InLoadGameInstance [const class UYetiOS_SaveGame*] Save game this OS was loaded from. Null if there is none, which discards the journal.
+	**/
+	void Internal_OpenChangeJournal(const class UYetiOS_SaveGame* InLoadGameInstance);
+
+	/**
+	* private UYetiOS_Core::Internal_ReplayChangeJournal
+	* Applies journaled changes in order. Changes that no longer apply are skipped.
+	* @param InRecords [const TArray<FYetiOsJournalRecord>&] Records to apply.
+	**/
+	void Internal_ReplayChangeJournal(const TArray<FYetiOsJournalRecord>& InRecords);
+
+	/**
+	* private UYetiOS_Core::Internal_BeginJournalCompaction
+	* Starts a new journal generation. Called right before a save game is captured.
+	**/
+	void Internal_BeginJournalCompaction();
+
+	/**
+	* private UYetiOS_Core::Internal_EndJournalCompaction
+	* Deletes journal generations that are part of the save game that was just written.
+	* @param bWasSuccessful [const bool] True if the save game was written.
+	**/
+	void Internal_EndJournalCompaction(const bool bWasSuccessful);
+
+	/**
+	* private UYetiOS_Core::Internal_IndexFileContent
+	* Replaces content words of the given file in the file index.
+	* @param InFile [class UYetiOS_FileBase*] File to index.
+	**/
+	void Internal_IndexFileContent(class UYetiOS_FileBase* InFile);
+
+	/**
+	* private UYetiOS_Core::Internal_ResolveSavedClass
+	* Returns class of the given class path string ID. Each class path is only resolved once per load.
+	* @param InSaveTree [const struct FYetiOsSaveTree&] Saved tree.
+	* @param InClassIndex [const int32] String ID of the class path.
+	* @return [UClass*] Class or nullptr if it could not be loaded.
+	**/
+	UClass* Internal_ResolveSavedClass(const struct FYetiOsSaveTree& InSaveTree, const int32 InClassIndex);
+
+	/**
+	* private UYetiOS_Core::Internal_LoadSavedDirectory
+	* Builds the next saved directory. Skips permission and space checks and notifications.
+	* @param InSaveTree [const struct FYetiOsSaveTree&] Saved tree. Directory records must be sorted by depth.
+	**/
+	void Internal_LoadSavedDirectory(const struct FYetiOsSaveTree& InSaveTree);
+
+	/**
+	* private UYetiOS_Core::Internal_LoadSavedFile
+	* Builds the next saved file and loads its saved content. Skips permission and space checks and notifications.
+	* @param InSaveTree [const struct FYetiOsSaveTree&] Saved tree. All directories must be loaded.
+	**/
+	void Internal_LoadSavedFile(const struct FYetiOsSaveTree& InSaveTree);
+
+	/**
+	* private UYetiOS_Core::Internal_RemoveUnsavedFiles
+	* Removes default files from complete saved directories that were created before the load but are not in the save.
+	**/
+	void Internal_RemoveUnsavedFiles();
+
+	/**
+	* private UYetiOS_Core::Internal_LoadFileIndex
+	* Restores the file index from save data without reading file content again.
+	* @param InSaveTree [const struct FYetiOsSaveTree&] Saved tree with file index records.
+	* @param InLoadedFiles [const TArray<class UYetiOS_FileBase*>&] Loaded file of each file record. Null if the file could not be loaded.
+	**/
+	void Internal_LoadFileIndex(const struct FYetiOsSaveTree& InSaveTree, const TArray<class UYetiOS_FileBase*>& InLoadedFiles);
+
 public:
 
 	/**
@@ -617,6 +1066,32 @@ public:
 	**/
 	void OnOperatingSystemLoadedFromSaveGame(const class UYetiOS_SaveGame*& LoadGameInstance, FYetiOsError& OutErrorMessage);
 
+	/**
+	* public UYetiOS_Core::BeginLoadFromSaveGame
+	* Restores OS data from a save state and prepares loading of directories, files and programs. @See ContinueLoadFromSaveGame
+	* @param LoadGameInstance [const class UYetiOS_SaveGame*] Load game instance.
+	**/
+	void BeginLoadFromSaveGame(const class UYetiOS_SaveGame* LoadGameInstance);
+
+	/**
+	* public UYetiOS_Core::ContinueLoadFromSaveGame
+	* Loads saved directories, files, programs and the file index until the time budget is used up. Call this every frame until it returns true.
+	* @See UYetiOS_BaseDevice::StartDeviceAsync
+	* @param LoadGameInstance [const class UYetiOS_SaveGame*] Same load game instance that was given to BeginLoadFromSaveGame.
+	* @param InTimeBudgetSeconds [const double] Time this call may take. At least one record is loaded per call. 0 or less loads everything.
+	* @param OutErrorMessage [FYetiOsError&] Any error message.
+	* @return [const bool] True once everything was loaded.
+	**/
+	const bool ContinueLoadFromSaveGame(const class UYetiOS_SaveGame* LoadGameInstance, const double InTimeBudgetSeconds, FYetiOsError& OutErrorMessage);
+
+	/**
+	* public UYetiOS_Core::GetSaveGameLoadProgress const
+	* Returns how much of the save game was loaded. Programs and the file index count as one record each.
+	* @param LoadGameInstance [const class UYetiOS_SaveGame*] Load game instance that is being loaded.
+	* @return [const float] Progress between 0 and 1.
+	**/
+	const float GetSaveGameLoadProgress(const class UYetiOS_SaveGame* LoadGameInstance) const;
+
 	/**
 	* public UYetiOS_Core::NotifyBatteryLevelChange
 	* Notifies the operating system that this device consumed or charged battery.
@@ -652,10 +1127,38 @@ public:
 	
 	/**
 	* public UYetiOS_Core::AddToCreatedDirectories
-	* Adds the given directory to AllCreatedDirectories array.
-	* @param InDirectory [const UYetiOS_DirectoryBase*] Directory to add.
+	* Registers the given directory with the directory registry of the root directory.
+	* @param InDirectory [UYetiOS_DirectoryBase*] Directory to add.
+	**/
+	void AddToCreatedDirectories(UYetiOS_DirectoryBase* InDirectory);
+
+	/**
+	* public UYetiOS_Core::GetAllCreatedDirectories const
+	* Returns every directory that was created so far in creation order. Used for save game information.
+	* @return [const TArray<const UYetiOS_DirectoryBase*>] Created directories.
+	**/
+	const TArray<const UYetiOS_DirectoryBase*> GetAllCreatedDirectories() const;
+
+	/**
+	* public UYetiOS_Core::FindDirectoryByID const
+	* Returns the directory with given ID.
+	* @param InDirectoryID [const int32] ID of the directory. @See UYetiOS_DirectoryBase::GetDirectoryID
+	* @return [UYetiOS_DirectoryBase*] Directory or null if no directory has this ID.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS")
+	UYetiOS_DirectoryBase* FindDirectoryByID(const int32 InDirectoryID) const;
+
+	/**
+	* public UYetiOS_Core::MaterializeAllDirectories const
+	* Creates every directory, file and program of the directory tree that was not accessed yet. After this GetAllCreatedDirectories returns the whole tree.
 	**/
-	void AddToCreatedDirectories(const UYetiOS_DirectoryBase* InDirectory);
+	void MaterializeAllDirectories() const;
+
+	/**
+	* public UYetiOS_Core::InvalidateResolvedPaths
+	* Drops every cached path lookup. Called when a directory is renamed or moved.
+	**/
+	void InvalidateResolvedPaths();
 
 	/**
 	* public UYetiOS_Core::HasRepositoryLibrary const
@@ -868,7 +1371,16 @@ public:
 	/** Returns a reference to the Operating system widget created using OsWidgetClass. */
 	FORCEINLINE UYetiOS_OsWidget* GetOsWidget() const { return OsWidget; }	
 
-	FORCEINLINE const TArray<const UYetiOS_DirectoryBase*> GetAllCreatedDirectories() const { return AllCreatedDirectories; }
+	FORCEINLINE const FYetiOsProcessTable& GetProcessTable() const { return ProcessTable; }
+	FORCEINLINE const FYetiOsProgramRegistry& GetProgramRegistry() const { return InstalledPrograms; }
+	FORCEINLINE const FYetiOsNotificationManager* GetNotificationManager() const { return NotificationManager; }
+	FORCEINLINE const FYetiOsProgramScheduler& GetProgramScheduler() const { return ProgramScheduler; }
+	FORCEINLINE const FYetiOsFileIndex& GetFileIndex() const { return FileIndex; }
+	FORCEINLINE const bool IsFileIndexComplete() const { return bIsFileIndexComplete; }
+	FORCEINLINE const FYetiOsChangeJournal& GetChangeJournal() const { return ChangeJournal; }
+	FORCEINLINE const bool IsJournalingChanges() const { return ChangeJournal.IsOpen(); }
+	FORCEINLINE FYetiOsProgramSettingsStore& GetProgramSettingsStore() { return ProgramSettingsStore; }
+	FORCEINLINE const FYetiOsProgramPool& GetProgramPool() const { return ProgramPool; }
 	FORCEINLINE const FText GetRootCommand() const { return RootCommand; }
 	FORCEINLINE class USoundBase* GetNotificationSound(const FYetiOsNotification& InNotification) const
 	{
@@ -892,39 +1404,3 @@ public:
 		return MySound;
 	}
 };
-
-class YETIOS_API FYetiOsNotificationManager
-{
-private:
-
-	TArray<FYetiOsNotification> Notifications;
-
-public:
-
-	FYetiOsNotificationManager() {}
-
-	~FYetiOsNotificationManager()
-	{
-		Notifications.Empty();
-	}
-
-	static FORCEINLINE FYetiOsNotificationManager* CreateNotificationManager()
-	{
-		return new FYetiOsNotificationManager();
-	}
-
-	static FORCEINLINE void Destroy(FYetiOsNotificationManager* InNotificationManager)
-	{
-		delete InNotificationManager;
-	}
-
-	FORCEINLINE void LogNotification(const FYetiOsNotification InNewNotification)
-	{
-		Notifications.Add(InNewNotification);
-	}
-
-	FORCEINLINE const TArray<FYetiOsNotification> GetNotifications() const
-	{
-		return Notifications;
-	}
-};
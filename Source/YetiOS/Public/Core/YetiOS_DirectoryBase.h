@@ -6,6 +6,7 @@
 #include "UObject/NoExportTypes.h"
 #include "YetiOS_Types.h"
 #include "Templates/SubclassOf.h"
+#include "Core/YetiOS_DirectoryIndex.h"
 #include "YetiOS_DirectoryBase.generated.h"
 
 /*************************************************************************
@@ -24,6 +25,24 @@ class YETIOS_API UYetiOS_DirectoryBase : public UObject
 	friend class UYetiOS_ThumbnailRenderer;
 #endif
 
+	friend class UYetiOS_Core;
+	friend class UYetiOS_FileBase;
+	friend class UYetiOS_DirectoryRoot;
+	friend class FYetiOsSearchService;
+
+	/** ID given by the directory registry of the root directory. INDEX_NONE if not registered. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	int32 DirectoryID;
+
+	/** Case-insensitive lookup of child directories and files. Kept in sync with ChildDirectories and Files. */
+	FYetiOsDirectoryIndex DirectoryIndex;
+
+	/** Full path of this directory. Empty until first requested and cleared when this or any parent directory is renamed or moved. */
+	mutable FString CachedFullPath;
+
+	/** Same as CachedFullPath with the leading home directory removed. */
+	mutable FString CachedFullPathWithoutHome;
+
 protected:
 
 	/** Name of this directory. */
@@ -84,6 +103,10 @@ protected:
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	class UYetiOS_Core* OwningOS;
 
+	/** True once files, programs and child directories of this directory were created. Until then child directories only exist as Child Directory Classes. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	uint8 bIsMaterialized : 1;
+
 public:
 
 	UYetiOS_DirectoryBase();
@@ -159,7 +182,7 @@ public:
 	* @return [TArray<UYetiDirectoryBase*>] An array of all child directories.
 	**/
 	UFUNCTION(BlueprintPure, Category = "Yeti Directory Base")
-	TArray<class UYetiOS_DirectoryBase*> GetAllChildDirectories() const { return ChildDirectories; }
+	TArray<class UYetiOS_DirectoryBase*> GetAllChildDirectories() const;
 
 	/**
 	* public UYetiOS_Directory::GetDirectoryFiles const
@@ -170,8 +193,35 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Yeti Directory Base")
 	TSet<class UYetiOS_FileBase*> GetDirectoryFiles(const FString WithExtension = "*") const;
 
+	/**
+	* public UYetiOS_DirectoryBase::FindFileByName const
+	* Finds a file in this directory by name and extension. Case is ignored.
+	* @param InName [const FText&] File name without extension.
+	* @param InExtension [const FText&] File extension.
+	* @return [class UYetiOS_FileBase*] File with given name or nullptr.
+	**/
 	UFUNCTION(BlueprintPure, Category = "Yeti Directory Base")
-	TArray<class UYetiOS_BaseProgram*> GetPrograms() const { return Programs.Array(); }
+	class UYetiOS_FileBase* FindFileByName(const FText& InName, const FText& InExtension) const;
+
+	UFUNCTION(BlueprintPure, Category = "Yeti Directory Base")
+	TArray<class UYetiOS_BaseProgram*> GetPrograms() const;
+
+	/**
+	* public UYetiOS_DirectoryBase::GetIconWidgets
+	* Returns icon widgets for files and programs in this directory, creating them if required. Views should call ReleaseIconWidgets once they stop showing this directory.
+	* @param OutFileIconWidgets [TArray<class UYetiOS_FileIconWidget*>&] Icon widgets of files.
+	* @param OutProgramIconWidgets [TArray<class UYetiOS_AppIconWidget*>&] Icon widgets of programs.
+	* @param bIncludeHiddenFiles [const bool] If true, icons are created for hidden files too.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti Directory Base")
+	void GetIconWidgets(TArray<class UYetiOS_FileIconWidget*>& OutFileIconWidgets, TArray<class UYetiOS_AppIconWidget*>& OutProgramIconWidgets, const bool bIncludeHiddenFiles = false);
+
+	/**
+	* public UYetiOS_DirectoryBase::ReleaseIconWidgets
+	* Releases icon widgets of files and programs in this directory. Child directories are not affected.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti Directory Base")
+	void ReleaseIconWidgets();
 
 	/**
 	* public UYetiOS_Directory::IsHidden const
@@ -189,6 +239,22 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Yeti Directory Base")
 	UYetiOS_DirectoryBase* GetParentDirectory() const { return ParentDirectory; }
 
+	/**
+	* public UYetiOS_DirectoryBase::GetDirectoryID const
+	* Returns the ID of this directory. IDs are unique within an Operating System and do not change while the directory exists.
+	* @return [int32] Directory ID or -1 (INDEX_NONE in C++) if not registered.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti Directory Base")
+	int32 GetDirectoryID() const { return DirectoryID; }
+
+	/**
+	* public UYetiOS_DirectoryBase::IsInsideDirectory const
+	* Checks if this directory is somewhere below the given directory.
+	* @param InDirectory [const UYetiOS_DirectoryBase*] Possible ancestor.
+	* @return [bool] True if given directory is a parent, grand parent etc. of this directory.
+	**/
+	bool IsInsideDirectory(const UYetiOS_DirectoryBase* InDirectory) const;
+
 	/**
 	* virtual public UYetiOS_DirectoryRoot::ToggleLock
 	* Given user will be locked for this file and won't be able to open it.
@@ -225,12 +291,12 @@ public:
 	/**
 	* public UYetiOS_DirectoryBase::CreateNativeChildDirectories
 	* Create default child directories specified in this class. @See ChildDirectoryClasses variable.
-	* @See Internal_CreateChildDirectories() method.
+	* @See Materialize() method.
 	* @param InOwningOS [const UYetiOS_Core*] OS that owns this directory.
 	* @param OutErrorMessage [FYetiOsError&] Outputs error message (if any).
-	* @param bForceCreate [const bool] Forcefully creates child directory even if this folder cannot create new directory. Ignores bCanCreateNewFolder.
-	* @param bCreateGrandChildDirectories [const bool] Continue to create child directories inside child directories.
-	* @return [TArray<UYetiOS_DirectoryBase*>] Reference to the list of newly created child directories. This does not include grand child directories.
+	* @param bForceCreate [const bool] Unused. Default child directories are part of the directory template and are always created.
+	* @param bCreateGrandChildDirectories [const bool] Materialize the whole tree below this directory instead of only one level.
+	* @return [TArray<UYetiOS_DirectoryBase*>] Reference to the list of child directories. This does not include grand child directories.
 	**/
 	TArray<UYetiOS_DirectoryBase*> CreateNativeChildDirectories(class UYetiOS_Core* InOwningOS, FYetiOsError& OutErrorMessage, const bool bForceCreate = false, const bool bCreateGrandChildDirectories = true);
 
@@ -246,6 +312,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Yeti Directory Base")	
 	bool CreateNewFileByClass(TSubclassOf<class UYetiOS_FileBase> InNewFileClass, class UYetiOS_FileBase*& OutFile, FYetiOsError& OutErrorMessage, const bool bRequirePermission = false);
 
+	/**
+	* public UYetiOS_DirectoryBase::DeleteFileFromDirectory
+	* Closes and removes the given file from this directory and releases its content.
+	* @param InFile [class UYetiOS_FileBase*] File to delete.
+	* @param OutErrorMessage [FYetiOsError&] Outputs error message (if any).
+	* @param bRequirePermission [const bool] Forcefully deletes the file even if it is not deletable.
+	* @return [bool] Returns true if the file was deleted.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti Directory Base")
+	bool DeleteFileFromDirectory(class UYetiOS_FileBase* InFile, FYetiOsError& OutErrorMessage, const bool bRequirePermission = false);
+
 	/**
 	* public UYetiOS_DirectoryBase::GetAllParentDirectories const
 	* Returns an array of all parent directories.
@@ -279,8 +356,64 @@ public:
 	**/
 	void EnsureOS(const class UYetiOS_Core* InOS);
 
+	/**
+	* public UYetiOS_DirectoryBase::Materialize const
+	* Creates programs, files and child directories of this directory if that was not done yet. Child directories are created empty and
+	* materialize themselves when they are entered, listed or resolved. Called automatically by every method that reads directory contents.
+	* @param bRecursive [const bool] Materialize every directory below this one too.
+	**/
+	void Materialize(const bool bRecursive = false) const;
+
+protected:
+
+	/**
+	* protected UYetiOS_DirectoryBase::Internal_MaterializeTowards const
+	* Materializes only the branches that lead to directories matching the given predicate.
+	* @param InPredicate [TFunctionRef<bool(const EDirectoryType)>] Returns true for directory types to look for.
+	**/
+	void Internal_MaterializeTowards(TFunctionRef<bool(const EDirectoryType)> InPredicate) const;
+
+	/**
+	* protected UYetiOS_DirectoryBase::Internal_CanContainDirectory const
+	* Checks if any directory below this one matches the given predicate. Branches that are not materialized are checked using their class defaults.
+	* @param InPredicate [TFunctionRef<bool(const EDirectoryType)>] Returns true for directory types to look for.
+	* @return [bool] True if a matching directory exists or will exist once materialized.
+	**/
+	bool Internal_CanContainDirectory(TFunctionRef<bool(const EDirectoryType)> InPredicate) const;
+
 private:
 
+	/**
+	* private static UYetiOS_DirectoryBase::Internal_ClassCanContainDirectory
+	* Checks if the default child directory classes of given class (or any of theirs) match the given predicate.
+	* @param InDirectoryClass [TSubclassOf<UYetiOS_DirectoryBase>] Directory class to check.
+	* @param InPredicate [TFunctionRef<bool(const EDirectoryType)>] Returns true for directory types to look for.
+	* @return [bool] True if a matching directory would be created.
+	**/
+	static bool Internal_ClassCanContainDirectory(TSubclassOf<UYetiOS_DirectoryBase> InDirectoryClass, TFunctionRef<bool(const EDirectoryType)> InPredicate);
+
+	/**
+	* private UYetiOS_DirectoryBase::Internal_Materialize
+	* Creates programs, files and empty child directories from the class defaults.
+	**/
+	void Internal_Materialize();
+
+	/**
+	* private UYetiOS_DirectoryBase::Internal_CreateDefaultPrograms
+	* Creates programs of ProgramClasses and adds them to this directory.
+	**/
+	void Internal_CreateDefaultPrograms();
+
+	/**
+	* private UYetiOS_DirectoryBase::Internal_AddChildDirectory
+	* Creates a single empty child directory and registers it with the OS.
+	* @param InOwningOS [class UYetiOS_Core*] OS that owns this directory.
+	* @param InDirectoryClass [TSubclassOf<UYetiOS_DirectoryBase>] Class of the child directory.
+	* @param InDirectoryName [const FText&] Override default directory name with this name. Ignored if empty.
+	* @return [UYetiOS_DirectoryBase*] Newly created child directory.
+	**/
+	UYetiOS_DirectoryBase* Internal_AddChildDirectory(class UYetiOS_Core* InOwningOS, TSubclassOf<UYetiOS_DirectoryBase> InDirectoryClass, const FText& InDirectoryName);
+
 	/**
 	* private UYetiOS_DirectoryBase::Internal_CreateChildDirectories
 	* Creates child directories from given classes.
@@ -299,6 +432,38 @@ private:
 		const bool bCreateGrandChildDirectories = true, 
 		const FText& CheckDirectoryName = FText::GetEmpty());
 
+	/**
+	* private UYetiOS_DirectoryBase::Internal_ReserveForLoad
+	* Prepares this directory for saved child directories and files that are about to be loaded and makes room for them.
+	* A complete directory is marked as materialized without creating default files and child directories. Otherwise saved entries are merged with the defaults.
+	* @param InNumChildDirectories [const int32] Saved child directories of this directory.
+	* @param InNumFiles [const int32] Saved files of this directory.
+	* @param bIsComplete [const bool] True if the save has every file and child directory of this directory.
+	* @return [bool] True if this directory is complete but already had its default files. Default files that are not in the save have to be removed after loading.
+	**/
+	bool Internal_ReserveForLoad(const int32 InNumChildDirectories, const int32 InNumFiles, const bool bIsComplete);
+
+	/**
+	* private UYetiOS_DirectoryBase::Internal_LoadChildDirectory
+	* Returns the child directory with given name, adding it if needed. Unlike CreateChildDirectory this skips permission checks and notifications.
+	* @param InDirectoryClass [TSubclassOf<UYetiOS_DirectoryBase>] Class of the child directory if it has to be added.
+	* @param InDirectoryName [const FString&] Name of the child directory.
+	* @param bHidden [const bool] Hide the child directory if it has to be added.
+	* @return [UYetiOS_DirectoryBase*] Existing or added child directory.
+	**/
+	UYetiOS_DirectoryBase* Internal_LoadChildDirectory(TSubclassOf<UYetiOS_DirectoryBase> InDirectoryClass, const FString& InDirectoryName, const bool bHidden);
+
+	/**
+	* private UYetiOS_DirectoryBase::Internal_LoadFile
+	* Returns the file with given name, adding it if needed. Unlike CreateNewFileByClass this skips space and permission checks and does not update the file index.
+	* @param InFileClass [TSubclassOf<class UYetiOS_FileBase>] Class of the file if it has to be added.
+	* @param InName [const FText&] File name without extension.
+	* @param InExtension [const FText&] File extension.
+	* @param bHidden [const bool] Hide the file if it has to be added.
+	* @return [class UYetiOS_FileBase*] Existing or added file.
+	**/
+	class UYetiOS_FileBase* Internal_LoadFile(TSubclassOf<class UYetiOS_FileBase> InFileClass, const FText& InName, const FText& InExtension, const bool bHidden);
+
 public:
 
 	/**
@@ -323,6 +488,22 @@ public:
 	**/
 	inline FString GetFullPath(const bool bDoNoIncludeHome = false) const;
 
+	/**
+	* public UYetiOS_DirectoryBase::InvalidateCachedPath
+	* Clears the cached full path of this directory and every child directory. Must be called when this directory is renamed or moved.
+	**/
+	void InvalidateCachedPath();
+
+	/**
+	* public UYetiOS_DirectoryBase::RenameDirectory
+	* Renames this directory. System directories and the root directory cannot be renamed.
+	* @param InNewName [const FText&] New name of this directory.
+	* @param OutErrorMessage [FYetiOsError&] Outputs error message (if any).
+	* @return [bool] True if directory was renamed.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti Directory Base")
+	bool RenameDirectory(const FText& InNewName, FYetiOsError& OutErrorMessage);
+
 	/**
 	* public UYetiOS_DirectoryBase::HasChildDirectory const
 	* Checks if this directory has a child directory with given name.
@@ -338,4 +519,5 @@ public:
 	FORCEINLINE const TArray<TSubclassOf<UYetiOS_DirectoryBase>> GetChildDirectories() const { return ChildDirectoryClasses; }
 	FORCEINLINE const EDirectoryType GetDirectoryType() const  { return DirectoryType; }
 	FORCEINLINE class UYetiOS_Core* GetOwningOS() const { return OwningOS; }
+	FORCEINLINE const bool IsMaterialized() const { return bIsMaterialized; }
 };
@@ -0,0 +1,125 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*************************************************************************
+* File Information:
+YetiOS_DirectoryIndex.h
+
+* Description:
+Lookup tables owned by a directory. Child directories are indexed by
+name and files by full name (name.extension) and by extension. Directory
+names are interned as FName so path components can be looked up without
+building strings. All keys are case-insensitive. The index only keeps
+raw pointers; the directory keeps the objects alive through its
+ChildDirectories and Files properties and must keep both in sync.
+*************************************************************************/
+struct YETIOS_API FYetiOsDirectoryIndex
+{
+private:
+
+	/** Child directories by name. FName comparison ignores case. */
+	TMultiMap<FName, class UYetiOS_DirectoryBase*> DirectoriesByName;
+
+	/** Files by case-folded full name. */
+	TMultiMap<FString, class UYetiOS_FileBase*> FilesByName;
+
+	/** Files by case-folded extension. */
+	TMultiMap<FString, class UYetiOS_FileBase*> FilesByExtension;
+
+public:
+
+	/**
+	* public FYetiOsDirectoryIndex::AddDirectory
+	* Indexes the given child directory under its current name.
+	* @param InDirectory [class UYetiOS_DirectoryBase*] Directory to add.
+	**/
+	void AddDirectory(class UYetiOS_DirectoryBase* InDirectory);
+
+	/**
+	* public FYetiOsDirectoryIndex::RemoveDirectory
+	* Removes the given child directory. Must be called before the directory name changes.
+	* @param InDirectory [class UYetiOS_DirectoryBase*] Directory to remove.
+	**/
+	void RemoveDirectory(class UYetiOS_DirectoryBase* InDirectory);
+
+	/**
+	* public FYetiOsDirectoryIndex::AddFile
+	* Indexes the given file under its current name and extension.
+	* @param InFile [class UYetiOS_FileBase*] File to add.
+	**/
+	void AddFile(class UYetiOS_FileBase* InFile);
+
+	/**
+	* public FYetiOsDirectoryIndex::RemoveFile
+	* Removes the given file. Must be called before the file name or extension changes.
+	* @param InFile [class UYetiOS_FileBase*] File to remove.
+	**/
+	void RemoveFile(class UYetiOS_FileBase* InFile);
+
+	/**
+	* public FYetiOsDirectoryIndex::FindDirectories const
+	* Finds all child directories with given name.
+	* @param InName [const FName&] Directory name. Case is ignored.
+	* @param OutDirectories [TArray<class UYetiOS_DirectoryBase*>&] All child directories with that name.
+	**/
+	void FindDirectories(const FName& InName, TArray<class UYetiOS_DirectoryBase*>& OutDirectories) const;
+
+	/**
+	* public FYetiOsDirectoryIndex::FindDirectory const
+	* Finds a child directory by name.
+	* @param InName [const FName&] Directory name. Case is ignored.
+	* @return [class UYetiOS_DirectoryBase*] First directory with that name or nullptr.
+	**/
+	class UYetiOS_DirectoryBase* FindDirectory(const FName& InName) const;
+
+	/**
+	* public FYetiOsDirectoryIndex::FindFile const
+	* Finds a file by name and extension.
+	* @param InName [const FString&] File name without extension. Case is ignored.
+	* @param InExtension [const FString&] File extension. Case is ignored.
+	* @return [class UYetiOS_FileBase*] First file with that full name or nullptr.
+	**/
+	class UYetiOS_FileBase* FindFile(const FString& InName, const FString& InExtension) const;
+
+	/**
+	* public FYetiOsDirectoryIndex::FindFilesWithExtension const
+	* Finds all files with given extension.
+	* @param InExtension [const FString&] Extension to look for. Case is ignored.
+	* @param OutFiles [TSet<class UYetiOS_FileBase*>&] Files with that extension.
+	**/
+	void FindFilesWithExtension(const FString& InExtension, TSet<class UYetiOS_FileBase*>& OutFiles) const;
+
+	/**
+	* public FYetiOsDirectoryIndex::Reserve
+	* Makes room for the given number of additional child directories and files.
+	* @param InNumDirectories [const int32] Child directories that will be added.
+	* @param InNumFiles [const int32] Files that will be added.
+	**/
+	void Reserve(const int32 InNumDirectories, const int32 InNumFiles);
+
+	/**
+	* public FYetiOsDirectoryIndex::Reset
+	* Removes everything from the index.
+	**/
+	void Reset();
+
+	/**
+	* public static FYetiOsDirectoryIndex::MakeKey
+	* Returns the case-folded key used for the given name.
+	* @param InName [const FString&] Name to fold.
+	* @return [FString] Key.
+	**/
+	static FORCEINLINE FString MakeKey(const FString& InName) { return InName.ToLower(); }
+
+	/**
+	* public static FYetiOsDirectoryIndex::MakeFileKey
+	* Returns the case-folded key used for the given file name and extension.
+	* @param InName [const FString&] File name without extension.
+	* @param InExtension [const FString&] File extension.
+	* @return [FString] Key.
+	**/
+	static FORCEINLINE FString MakeFileKey(const FString& InName, const FString& InExtension) { return MakeKey(FString::Printf(TEXT("%s.%s"), *InName, *InExtension)); }
+};
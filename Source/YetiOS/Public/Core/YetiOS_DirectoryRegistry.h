@@ -0,0 +1,99 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "YetiOS_Types.h"
+#include "YetiOS_DirectoryRegistry.generated.h"
+
+/*************************************************************************
+* File Information:
+YetiOS_DirectoryRegistry.h
+
+* Description:
+Registry of every created directory owned by the root directory. Each
+directory gets an ID that is its slot in the registry. IDs are never
+reused, so a removed directory leaves an empty slot and the IDs of other
+directories do not change. System directories are also indexed by type.
+*************************************************************************/
+USTRUCT()
+struct YETIOS_API FYetiOsDirectoryRegistry
+{
+	GENERATED_USTRUCT_BODY();
+
+private:
+
+	/** Registered directories by ID. Slots of removed directories are null. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	TArray<class UYetiOS_DirectoryBase*> Directories;
+
+	/** IDs of system directories keyed by type in registration order. */
+	TMap<EDirectoryType, TArray<int32>> IDsByType;
+
+	/** IDs of all system directories in registration order. */
+	TArray<int32> SystemIDs;
+
+	/** Number of directories currently registered. */
+	int32 NumRegistered;
+
+public:
+
+	FYetiOsDirectoryRegistry()
+	{
+		NumRegistered = 0;
+	}
+
+	/**
+	* public FYetiOsDirectoryRegistry::Register
+	* Registers the given directory and returns its new ID.
+	* @param InDirectory [class UYetiOS_DirectoryBase*] Directory to register.
+	* @return [int32] ID of the directory.
+	**/
+	int32 Register(class UYetiOS_DirectoryBase* InDirectory);
+
+	/**
+	* public FYetiOsDirectoryRegistry::Unregister
+	* Removes the directory with given ID. The ID is not given to another directory.
+	* @param InDirectoryID [const int32] ID to remove.
+	* @return [bool] True if a directory was removed.
+	**/
+	bool Unregister(const int32 InDirectoryID);
+
+	/**
+	* public FYetiOsDirectoryRegistry::Find const
+	* Returns the directory with given ID.
+	* @param InDirectoryID [const int32] ID to look for.
+	* @return [class UYetiOS_DirectoryBase*] Directory or nullptr if ID is not registered.
+	**/
+	class UYetiOS_DirectoryBase* Find(const int32 InDirectoryID) const;
+
+	/**
+	* public FYetiOsDirectoryRegistry::FindByType const
+	* Returns all registered directories of given system type.
+	* @param InType [const EDirectoryType] Type to look for. Other is not indexed.
+	* @param OutDirectories [TArray<class UYetiOS_DirectoryBase*>&] Directories in registration order.
+	**/
+	void FindByType(const EDirectoryType InType, TArray<class UYetiOS_DirectoryBase*>& OutDirectories) const;
+
+	/**
+	* public FYetiOsDirectoryRegistry::GetSystemDirectories const
+	* Returns all registered system directories.
+	* @param OutDirectories [TArray<class UYetiOS_DirectoryBase*>&] System directories in registration order.
+	**/
+	void GetSystemDirectories(TArray<class UYetiOS_DirectoryBase*>& OutDirectories) const;
+
+	/**
+	* public FYetiOsDirectoryRegistry::GetAllDirectories const
+	* Returns all registered directories.
+	* @param OutDirectories [TArray<const class UYetiOS_DirectoryBase*>&] Directories in ID (creation) order.
+	**/
+	void GetAllDirectories(TArray<const class UYetiOS_DirectoryBase*>& OutDirectories) const;
+
+	/**
+	* public FYetiOsDirectoryRegistry::Reset
+	* Removes all directories and starts IDs from zero again.
+	**/
+	void Reset();
+
+	FORCEINLINE const int32 Num() const { return NumRegistered; }
+};
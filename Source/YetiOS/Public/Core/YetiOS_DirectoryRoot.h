@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Core/YetiOS_DirectoryBase.h"
+#include "Core/YetiOS_DirectoryRegistry.h"
 #include "YetiOS_DirectoryRoot.generated.h"
 
 /*************************************************************************
@@ -13,7 +14,8 @@ YetiOS_DirectoryRoot.h
 * Description:
 This is the main root directory for the OS (if OS requires root directory).
 Note that this is inherited from the base class because we don't want any
-properties of a normal directory.
+properties of a normal directory. Root directory also owns the registry
+of every directory created in this tree.
 *************************************************************************/
 UCLASS(DisplayName = "Root Directory")
 class YETIOS_API UYetiOS_DirectoryRoot : public UYetiOS_DirectoryBase
@@ -22,24 +24,35 @@ class YETIOS_API UYetiOS_DirectoryRoot : public UYetiOS_DirectoryBase
 
 private:
 
-	/** Array of system directories. */
+	/** Every directory created in this tree, including this one. */
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
-	TArray<UYetiOS_DirectoryBase*> SystemDirectories;
+	FYetiOsDirectoryRegistry DirectoryRegistry;
 	
 public:
 
 	UYetiOS_DirectoryRoot();
 
-	/** Add given directory as system. 
-	* Will trigger an ensure assert if directory cannot be added. 
-	*/
-	void AddSystemDirectory(UYetiOS_DirectoryBase* InDirectoryToAdd);
+	/**
+	* public UYetiOS_DirectoryRoot::RegisterDirectory
+	* Adds the given directory to the registry and assigns its ID. Does nothing if the directory is already registered.
+	* @param InDirectory [UYetiOS_DirectoryBase*] Directory to register.
+	**/
+	void RegisterDirectory(UYetiOS_DirectoryBase* InDirectory);
+
+	/**
+	* public UYetiOS_DirectoryRoot::UnregisterDirectory
+	* Removes the given directory from the registry. Its ID is not reused.
+	* @param InDirectory [UYetiOS_DirectoryBase*] Directory to unregister.
+	**/
+	void UnregisterDirectory(UYetiOS_DirectoryBase* InDirectory);
 
 	/**
 	* public UYetiOS_DirectoryRoot::GetSystemDirectories const
-	* Returns an array of system directories.
-	* @return [FORCEINLINE const TArray<UYetiOS_DirectoryBase*>] 
+	* Returns an array of system directories. Materializes the branches that lead to system directories that were not created yet.
+	* @return [const TArray<UYetiOS_DirectoryBase*>] 
 	**/
-	FORCEINLINE const TArray<UYetiOS_DirectoryBase*> GetSystemDirectories() const { return SystemDirectories; }
+	const TArray<UYetiOS_DirectoryBase*> GetSystemDirectories() const;
+
+	FORCEINLINE const FYetiOsDirectoryRegistry& GetDirectoryRegistry() const { return DirectoryRegistry; }
 	
 };
@@ -19,6 +19,9 @@ class YETIOS_API UYetiOS_FileBase : public UObject
 {
 	GENERATED_BODY()
 
+	friend class FYetiOsSearchService;
+	friend class UYetiOS_DirectoryBase;
+
 	FDelegateHandle DelegateHandle_OnAssociatedProgramInstalled;
 	
 protected:
@@ -35,7 +38,7 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Yeti OS File", meta = (DisplayThumbnail = "true", AllowedClasses = "Texture,MaterialInterface"))
 	class UObject* Icon;
 
-	/** Size in MB */
+	/** Size in MB. Bytes written to File Content are added on top of this. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Yeti OS File", meta = (UIMin = "0", ClampMin = "0", UIMax = "10000"))
 	float FileSizeInMB;
 
@@ -51,6 +54,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS File")
 	TSubclassOf<class UYetiOS_BaseProgram> AssociatedProgramClass;
 
+	/** Class of the content object that stores bytes of this file. */
+	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS File")
+	TSubclassOf<class UYetiOS_FileContent> FileContentClass;
+
 	/** If true, file is hidden. */
 	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS File")
 	uint8 bIsHidden : 1;
@@ -80,10 +87,14 @@ protected:
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	class UYetiOS_FileWidget* FileWidget;
 
-	/** Reference to the icon widget that was created. */
+	/** Reference to the icon widget that was created. Only valid while a view is showing this file. */
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	class UYetiOS_FileIconWidget* FileIconWidget;
 
+	/** Content of this file. Created the first time it is requested. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	class UYetiOS_FileContent* FileContent;
+
 	/** Is the file currently open */
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	uint8 bIsOpen : 1;
@@ -164,11 +175,29 @@ public:
 
 	/**
 	* public UYetiOS_FileBase::GetFileSize const
-	* Returns the file size in MB.
+	* Returns the file size in MB including its content.
 	* @return [float] File size.
 	**/
 	UFUNCTION(BlueprintPure, Category = "Yeti OS File")	
-	float GetFileSize() const { return FileSizeInMB; }
+	float GetFileSize() const;
+
+	/**
+	* public UYetiOS_FileBase::GetFileSizeInBytes const
+	* Returns the file size in bytes including its content.
+	* @return [int64] File size in bytes.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS File")
+	int64 GetFileSizeInBytes() const;
+
+	/**
+	* public UYetiOS_FileBase::CopyContentFrom
+	* Replaces content of this file with content of the given file. Bytes are shared until either file writes to them, so this is cheap even for large files.
+	* @param InSourceFile [const UYetiOS_FileBase*] File to copy content from.
+	* @param OutErrorMessage [FYetiOsError&] Error message (if any).
+	* @return [bool] True if content was copied.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File")
+	bool CopyContentFrom(const UYetiOS_FileBase* InSourceFile, FYetiOsError& OutErrorMessage);
 
 	/**
 	* public UYetiOS_FileBase::IsHidden const
@@ -195,12 +224,19 @@ public:
 	bool IsMovable() const { return bIsMovable; }
 
 	/**
-	* public UYetiOS_FileBase::GetFileIconWidget const
-	* Returns file icon widget.
+	* public UYetiOS_FileBase::GetFileIconWidget
+	* Returns file icon widget. Widget is created the first time this is called and kept until ReleaseFileIconWidget is called.
 	* @return [class UYetiOS_FileIconWidget*] File Icon Widget.
 	**/
-	UFUNCTION(BlueprintPure, Category = "Yeti OS File")
-	class UYetiOS_FileIconWidget* GetFileIconWidget() const { return FileIconWidget; }
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File")
+	class UYetiOS_FileIconWidget* GetFileIconWidget();
+
+	/**
+	* public UYetiOS_FileBase::ReleaseFileIconWidget
+	* Removes the file icon widget from its parent and drops the reference. Views should call this when the file is no longer shown.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File")
+	void ReleaseFileIconWidget();
 
 	/**
 	* public UYetiOS_FileBase::IsOpen const
@@ -275,11 +311,11 @@ private:
 
 	/**
 	* private UYetiOS_FileBase::Internal_OnAssociatedProgramInstalled
-	* Automatically called when the associated program is installed on Operating System.
-	* @param InNewInstalledProgram [class UYetiOS_BaseProgram*] Program which was installed.
+	* Automatically called when programs are installed on Operating System. Checks if the associated program is one of them.
+	* @param InNewInstalledPrograms [const TArray<class UYetiOS_BaseProgram*>&] Programs which were installed.
 	**/
 	UFUNCTION()	
-	void Internal_OnAssociatedProgramInstalled(class UYetiOS_BaseProgram* InNewInstalledProgram);
+	void Internal_OnAssociatedProgramInstalled(const TArray<class UYetiOS_BaseProgram*>& InNewInstalledPrograms);
 
 protected:
 
@@ -304,15 +340,18 @@ public:
 
 	/**
 	* public UYetiOS_FileBase::GetFileContent
-	* The actual file content. Must be implemented in Blueprint.
+	* The actual file content. By default creates File Content Class the first time it is called. Can be overridden in Blueprint.
 	* @return [class UYetiOS_FileContent*] File Content.
 	**/
-	UFUNCTION(BlueprintImplementableEvent, BlueprintPure, Category = "Yeti OS File")	
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Yeti OS File")	
 	class UYetiOS_FileContent* GetFileContent();
+	virtual class UYetiOS_FileContent* GetFileContent_Implementation();
 
 public:
 
 	FORCEINLINE TSubclassOf<class UYetiOS_FileIconWidget> GetFileIconWidgetClass() const { return FileIconWidgetClass; }
+	FORCEINLINE const bool HasFileIconWidget() const { return FileIconWidget != nullptr; }
+	FORCEINLINE class UYetiOS_FileContent* GetCreatedFileContent() const { return FileContent; }
 	FORCEINLINE const bool CanOpenInSameInstance() const {; return bOpenInSameInstance; }
 	FORCEINLINE const bool IsSameFile(const UYetiOS_FileBase* OtherFile) const
 	{
@@ -4,18 +4,293 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "YetiOS_Types.h"
 #include "YetiOS_FileContent.generated.h"
 
+/** Append-only physical file that holds spilled chunks of one content. Deleted once the content and the last chunk mapped from it are gone. */
+struct YETIOS_API FYetiOsContentSpillFile
+{
+	/** Full physical path of this file. */
+	FString Filename;
+
+	/** Bytes written to this file so far. Next chunks are appended at this offset. */
+	int64 FileSize;
+
+	/** Mapped handles of this file. A handle only maps the size the file had when it was opened, so every append adds one. */
+	TArray<TUniquePtr<class IMappedFileHandle>> MappedHandles;
+
+	FYetiOsContentSpillFile();
+	~FYetiOsContentSpillFile();
+};
+
+/** Block of file content. Shared by every content object that holds it and only written in place while nothing else refers to it. */
+struct YETIOS_API FYetiOsContentChunk
+{
+	/** Bytes of this chunk. Empty once the chunk is spilled. */
+	TArray<uint8> Data;
+
+	/** Spill file this chunk was mapped from. Null if resident. */
+	TSharedPtr<FYetiOsContentSpillFile, ESPMode::ThreadSafe> SpillFile;
+
+	/** Offset of this chunk in the spill file. */
+	int64 SpillOffset;
+
+	/** Mapped region of spill file. Null if resident. */
+	TUniquePtr<class IMappedFileRegion> MappedRegion;
+
+	FYetiOsContentChunk();
+	~FYetiOsContentChunk();
+
+	/**
+	* public FYetiOsContentChunk::GetData const
+	* Returns bytes of this chunk, either resident or mapped.
+	* @return [const uint8*] Bytes of this chunk.
+	**/
+	const uint8* GetData() const;
+
+	/**
+	* public FYetiOsContentChunk::Num const
+	* Returns size of this chunk in bytes.
+	* @return [int32] Size in bytes.
+	**/
+	int32 Num() const;
+
+	FORCEINLINE const bool IsSpilled() const { return MappedRegion.IsValid(); }
+};
+
+typedef TSharedPtr<FYetiOsContentChunk, ESPMode::ThreadSafe> FYetiOsContentChunkPtr;
+
 /*************************************************************************
 * File Information:
 YetiOS_FileContent.h
 
 * Description:
-Base class for file content.
+Byte content of a file. Content is stored as fixed size chunks that are
+shared between copies and only duplicated when one copy writes to them,
+so copying a file never copies its bytes. Every byte is accounted
+against the hard disk of the owning device. Once content grows past the
+spill threshold, full chunks are appended to one memory mapped file per
+content under the device save path so large documents do not stay
+resident.
 *************************************************************************/
-UCLASS(Abstract, Blueprintable, DisplayName = "File Content")
+UCLASS(Blueprintable, DisplayName = "File Content")
 class YETIOS_API UYetiOS_FileContent : public UObject
 {
 	GENERATED_BODY()
-	
+
+	friend class UYetiOS_Core;
+
+public:
+
+	/** Size of one chunk in bytes. Every chunk except the last one is full. */
+	static const int32 CHUNK_SIZE;
+
+protected:
+
+	/** Once resident content is larger than this (in KB), full chunks are moved out of memory into the mapped spill file. 0 keeps everything in memory. */
+	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS File Content", meta = (UIMin = "0", ClampMin = "0"))
+	int32 SpillThresholdInKB;
+
+private:
+
+	/** Chunks of this content in order. */
+	TArray<FYetiOsContentChunkPtr> Chunks;
+
+	/** File chunks of this content are spilled to. Created on the first spill. */
+	TSharedPtr<FYetiOsContentSpillFile, ESPMode::ThreadSafe> SpillFile;
+
+	/** Size of this content in bytes. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	int64 ContentSizeInBytes;
+
+	/** Bytes this content has consumed from the hard disk. Zero if content is not owned by a file on a device. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	int64 ConsumedBytes;
+
+public:
+
+	UYetiOS_FileContent();
+
+	virtual void BeginDestroy() override;
+
+	/**
+	* public UYetiOS_FileContent::SetBytes
+	* Replaces the whole content with given bytes.
+	* @param InBytes [const TArray<uint8>&] New content.
+	* @param OutErrorMessage [FYetiOsError&] Error message (if any).
+	* @return [bool] True if there was enough space.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File Content")
+	bool SetBytes(const TArray<uint8>& InBytes, FYetiOsError& OutErrorMessage);
+
+	/**
+	* public UYetiOS_FileContent::AppendBytes
+	* Adds given bytes at the end of this content.
+	* @param InBytes [const TArray<uint8>&] Bytes to add.
+	* @param OutErrorMessage [FYetiOsError&] Error message (if any).
+	* @return [bool] True if there was enough space.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File Content")
+	bool AppendBytes(const TArray<uint8>& InBytes, FYetiOsError& OutErrorMessage);
+
+	/**
+	* public UYetiOS_FileContent::WriteBytes
+	* Overwrites content at given offset. Content grows if bytes go past the end.
+	* @param InOffset [const int64] Offset in bytes. Must not be greater than content size.
+	* @param InBytes [const TArray<uint8>&] Bytes to write.
+	* @param OutErrorMessage [FYetiOsError&] Error message (if any).
+	* @return [bool] True if bytes were written.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File Content")
+	bool WriteBytes(const int64 InOffset, const TArray<uint8>& InBytes, FYetiOsError& OutErrorMessage);
+
+	/**
+	* public UYetiOS_FileContent::SetText
+	* Replaces the whole content with given text stored as UTF-8.
+	* @param InText [const FString&] New content.
+	* @param OutErrorMessage [FYetiOsError&] Error message (if any).
+	* @return [bool] True if there was enough space.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File Content")
+	bool SetText(const FString& InText, FYetiOsError& OutErrorMessage);
+
+	/**
+	* public UYetiOS_FileContent::AppendText
+	* Adds given text stored as UTF-8 at the end of this content.
+	* @param InText [const FString&] Text to add.
+	* @param OutErrorMessage [FYetiOsError&] Error message (if any).
+	* @return [bool] True if there was enough space.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File Content")
+	bool AppendText(const FString& InText, FYetiOsError& OutErrorMessage);
+
+	/**
+	* public UYetiOS_FileContent::Truncate
+	* Shrinks this content to given size and gives the freed space back to the hard disk.
+	* @param InNewSize [const int64] New size in bytes. Must not be greater than content size.
+	* @return [bool] True if content was truncated.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File Content")
+	bool Truncate(const int64 InNewSize);
+
+	/**
+	* public UYetiOS_FileContent::EmptyContent
+	* Removes all bytes and gives the space back to the hard disk.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File Content")
+	void EmptyContent();
+
+	/**
+	* public UYetiOS_FileContent::CopyFrom
+	* Replaces this content with the content of given source. Chunks are shared and only duplicated when either side writes.
+	* @param InSource [const UYetiOS_FileContent*] Content to copy.
+	* @param OutErrorMessage [FYetiOsError&] Error message (if any).
+	* @return [bool] True if there was enough space.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File Content")
+	bool CopyFrom(const UYetiOS_FileContent* InSource, FYetiOsError& OutErrorMessage);
+
+	/**
+	* public UYetiOS_FileContent::ReadBytes const
+	* Reads bytes from this content.
+	* @param InOffset [const int64] Offset in bytes to start reading from.
+	* @param InCount [const int64] Number of bytes to read. Clamped to content size.
+	* @param OutBytes [TArray<uint8>&] Bytes that were read.
+	* @return [bool] True if offset was inside the content.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS File Content")
+	bool ReadBytes(const int64 InOffset, const int64 InCount, TArray<uint8>& OutBytes) const;
+
+	/**
+	* public UYetiOS_FileContent::ReadText const
+	* Reads the whole content as UTF-8 text.
+	* @return [FString] Content as text.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS File Content")
+	FString ReadText() const;
+
+	/**
+	* public UYetiOS_FileContent::GetResidentSize const
+	* Returns number of bytes currently held in memory. Spilled chunks are not counted.
+	* @return [int64] Resident size in bytes.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS File Content")
+	int64 GetResidentSize() const;
+
+	/**
+	* public UYetiOS_FileContent::ForEachChunk const
+	* Visits every chunk in order without copying.
+	* @param InVisitor [TFunctionRef<bool(const uint8*, const int32)>] Called with bytes and size of each chunk. Return false to stop.
+	**/
+	void ForEachChunk(TFunctionRef<bool(const uint8*, const int32)> InVisitor) const;
+
+private:
+
+	/**
+	* private UYetiOS_FileContent::Internal_Write
+	* Writes bytes at given offset, duplicating any chunk that is shared or spilled.
+	* @param InOffset [const int64] Offset in bytes. Must not be greater than content size.
+	* @param InData [const uint8*] Bytes to write.
+	* @param InCount [const int64] Number of bytes to write.
+	* @param OutErrorMessage [FYetiOsError&] Error message (if any).
+	* @return [bool] True if bytes were written.
+	**/
+	bool Internal_Write(const int64 InOffset, const uint8* InData, const int64 InCount, FYetiOsError& OutErrorMessage);
+
+	/**
+	* private UYetiOS_FileContent::Internal_UpdateConsumedSpace
+	* Consumes or releases space on the hard disk so it matches the given content size.
+	* @param InNewSize [const int64] Content size in bytes.
+	* @param OutErrorMessage [FYetiOsError&] Error message (if any).
+	* @return [bool] True if there was enough space.
+	**/
+	bool Internal_UpdateConsumedSpace(const int64 InNewSize, FYetiOsError& OutErrorMessage);
+
+	/**
+	* private UYetiOS_FileContent::Internal_GetWritableChunk
+	* Returns chunk at given index that only this content refers to. Shared or spilled chunks are duplicated into memory first.
+	* @param InIndex [const int32] Chunk index. Can be equal to number of chunks to add a new one.
+	* @return [FYetiOsContentChunk&] Writable chunk.
+	**/
+	FYetiOsContentChunk& Internal_GetWritableChunk(const int32 InIndex);
+
+	/**
+	* private UYetiOS_FileContent::Internal_SpillIfNeeded
+	* Appends full resident chunks to the spill file and maps them if resident content is larger than spill threshold. Last chunk always stays resident.
+	**/
+	void Internal_SpillIfNeeded();
+
+	/**
+	* private UYetiOS_FileContent::Internal_LoadBytes
+	* Replaces the whole content with saved bytes. Saved remaining space of the hard disk already includes them, so no space is consumed.
+	* @param InBytes [const TArray<uint8>&] Saved content.
+	**/
+	void Internal_LoadBytes(const TArray<uint8>& InBytes);
+
+	/**
+	* private UYetiOS_FileContent::Internal_GetHardDisk const
+	* Returns hard disk of the device that owns this content.
+	* @return [class UYetiOS_HardDisk*] Hard disk or nullptr if this content is not owned by a file on a device.
+	**/
+	class UYetiOS_HardDisk* Internal_GetHardDisk() const;
+
+	/**
+	* private UYetiOS_FileContent::Internal_NotifyContentChanged
+	* Tells the OS that owns this content to index it again.
+	**/
+	void Internal_NotifyContentChanged();
+
+	/**
+	* private UYetiOS_FileContent::Internal_GetSpillPath const
+	* Returns physical directory spilled chunks are written to.
+	* @return [FString] Spill directory or empty if this content is not owned by a file on a device.
+	**/
+	FString Internal_GetSpillPath() const;
+
+public:
+
+	FORCEINLINE const int64 GetContentSize() const { return ContentSizeInBytes; }
+	FORCEINLINE const int32 NumChunks() const { return Chunks.Num(); }
+	FORCEINLINE const bool IsEmpty() const { return ContentSizeInBytes == 0; }
+	FORCEINLINE const TArray<FYetiOsContentChunkPtr>& GetChunks() const { return Chunks; }
 };
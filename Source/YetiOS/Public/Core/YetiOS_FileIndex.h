@@ -0,0 +1,188 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "YetiOS_FileIndex.generated.h"
+
+USTRUCT()
+struct FYetiOsFileIndexSettings
+{
+	GENERATED_USTRUCT_BODY();
+
+	/** If true, file names are kept in an inverted index so QueryFileIndex answers without walking the directory tree. */
+	UPROPERTY(EditAnywhere, Category = "File Index Settings")
+	uint8 bEnableFileIndex : 1;
+
+	/** If true, words in file content are indexed as well. Content is indexed on the next frame after it changes. */
+	UPROPERTY(EditAnywhere, Category = "File Index Settings", meta = (EditCondition = "bEnableFileIndex"))
+	uint8 bIndexContent : 1;
+
+	/** Only this many KB from the start of each file content are indexed. */
+	UPROPERTY(EditAnywhere, Category = "File Index Settings", meta = (EditCondition = "bEnableFileIndex", ClampMin = "1", UIMin = "1"))
+	int32 MaxIndexedContentInKB;
+
+	/** Words in file content shorter than this are not indexed. File name words are always indexed. */
+	UPROPERTY(EditAnywhere, Category = "File Index Settings", meta = (EditCondition = "bEnableFileIndex", ClampMin = "1", UIMin = "1"))
+	int32 MinContentWordLength;
+
+	FYetiOsFileIndexSettings()
+	{
+		bEnableFileIndex = true;
+		bIndexContent = false;
+		MaxIndexedContentInKB = 256;
+		MinContentWordLength = 3;
+	}
+};
+
+/*************************************************************************
+* File Information:
+YetiOS_FileIndex.h
+
+* Description:
+Inverted index owned by the Operating System that maps lower case words
+of file names and file content to the files that contain them. Words are
+kept sorted so every word starting with a prefix is found with a binary
+search. Name and content words of a file are tracked separately so a
+rename does not require indexing content again.
+*************************************************************************/
+struct YETIOS_API FYetiOsFileIndex
+{
+private:
+
+	struct FDocument
+	{
+		TWeakObjectPtr<class UYetiOS_FileBase> File;
+		TArray<FString> NameWords;
+		TArray<FString> ContentWords;
+	};
+
+	/** Indexed files. Index is the document ID. Removed slots are reused. */
+	TArray<FDocument> Documents;
+
+	/** Document IDs of removed slots. */
+	TArray<int32> FreeDocumentIDs;
+
+	/** Document ID of each indexed file. */
+	TMap<const class UYetiOS_FileBase*, int32> DocumentIDByFile;
+
+	/** Document IDs that contain each word. */
+	TMap<FString, TArray<int32>> Postings;
+
+	/** All words in Postings sorted for prefix lookups. Words are inserted and removed at their sorted position as they change. */
+	TArray<FString> SortedWords;
+
+public:
+
+	/**
+	* public FYetiOsFileIndex::SetNameWords
+	* Replaces the name words of the given file. Adds the file to the index if needed.
+	* @param InFile [class UYetiOS_FileBase*] File to update.
+	* @param InWords [const TArray<FString>&] Lower case words of the file name.
+	**/
+	void SetNameWords(class UYetiOS_FileBase* InFile, const TArray<FString>& InWords);
+
+	/**
+	* public FYetiOsFileIndex::SetContentWords
+	* Replaces the content words of the given file. Adds the file to the index if needed.
+	* @param InFile [class UYetiOS_FileBase*] File to update.
+	* @param InWords [const TArray<FString>&] Lower case words of the file content.
+	**/
+	void SetContentWords(class UYetiOS_FileBase* InFile, const TArray<FString>& InWords);
+
+	/**
+	* public FYetiOsFileIndex::RemoveFile
+	* Removes the given file and all of its words.
+	* @param InFile [const class UYetiOS_FileBase*] File to remove.
+	**/
+	void RemoveFile(const class UYetiOS_FileBase* InFile);
+
+	/**
+	* public FYetiOsFileIndex::Query const
+	* Finds files that have a word starting with every word of the given query. Example: "rep tx" finds report.txt.
+	* @param InQuery [const FString&] Query text. Split into words the same way file names are.
+	* @param InMaxResults [const int32] Stop after this many files. 0 means no limit.
+	* @param OutFiles [TArray<class UYetiOS_FileBase*>&] Files that matched in the order they were indexed.
+	**/
+	void Query(const FString& InQuery, const int32 InMaxResults, TArray<class UYetiOS_FileBase*>& OutFiles) const;
+
+	/**
+	* public FYetiOsFileIndex::ForEachFile const
+	* Visits every indexed file that is still valid.
+	* @param InVisitor [TFunctionRef<void(class UYetiOS_FileBase*, const TArray<FString>&, const TArray<FString>&)>] Called with file, name words and content words.
+	**/
+	void ForEachFile(TFunctionRef<void(class UYetiOS_FileBase*, const TArray<FString>&, const TArray<FString>&)> InVisitor) const;
+
+	/**
+	* public FYetiOsFileIndex::Reset
+	* Removes everything from the index.
+	**/
+	void Reset();
+
+	/**
+	* public FYetiOsFileIndex::GetAllocatedSize const
+	* Returns memory used by the index including all words.
+	* @return [SIZE_T] Size in bytes.
+	**/
+	SIZE_T GetAllocatedSize() const;
+
+	/**
+	* public static FYetiOsFileIndex::SplitWords
+	* Splits text into unique lower case words. Anything that is not a letter or digit separates words.
+	* @param InText [const FString&] Text to split.
+	* @param InMinLength [const int32] Shorter words are skipped.
+	* @param OutWords [TArray<FString>&] Unique words.
+	**/
+	static void SplitWords(const FString& InText, const int32 InMinLength, TArray<FString>& OutWords);
+
+	/**
+	* public static FYetiOsFileIndex::SplitContentWords
+	* Splits UTF-8 file content into unique lower case words without converting the whole content to text.
+	* @param InContent [const class UYetiOS_FileContent*] Content to split.
+	* @param InMaxBytes [const int64] Only this many bytes from the start are read.
+	* @param InMinLength [const int32] Shorter words are skipped.
+	* @param OutWords [TArray<FString>&] Unique words.
+	**/
+	static void SplitContentWords(const class UYetiOS_FileContent* InContent, const int64 InMaxBytes, const int32 InMinLength, TArray<FString>& OutWords);
+
+private:
+
+	/**
+	* private FYetiOsFileIndex::Internal_FindOrAddDocument
+	* Returns document ID of the given file, adding a new document if needed.
+	* @param InFile [class UYetiOS_FileBase*] File to look for.
+	* @return [int32] Document ID.
+	**/
+	int32 Internal_FindOrAddDocument(class UYetiOS_FileBase* InFile);
+
+	/**
+	* private FYetiOsFileIndex::Internal_UpdatePostings
+	* Moves the document from postings of words it no longer has to postings of words it now has.
+	* @param InDocumentID [const int32] Document to update.
+	* @param InOldWords [const TSet<FString>&] Words the document had.
+	* @param InNewWords [const TSet<FString>&] Words the document has now.
+	**/
+	void Internal_UpdatePostings(const int32 InDocumentID, const TSet<FString>& InOldWords, const TSet<FString>& InNewWords);
+
+	/**
+	* private FYetiOsFileIndex::Internal_GetWords const
+	* Returns name and content words of the given document as one set.
+	* @param InDocumentID [const int32] Document to read.
+	* @return [TSet<FString>] All words.
+	**/
+	TSet<FString> Internal_GetWords(const int32 InDocumentID) const;
+
+	/**
+	* private FYetiOsFileIndex::Internal_FindPrefix const
+	* Collects document IDs of every word starting with the given prefix.
+	* @param InPrefix [const FString&] Lower case prefix.
+	* @param OutDocumentIDs [TSet<int32>&] Documents found.
+	**/
+	void Internal_FindPrefix(const FString& InPrefix, TSet<int32>& OutDocumentIDs) const;
+
+public:
+
+	FORCEINLINE const int32 Num() const { return DocumentIDByFile.Num(); }
+	FORCEINLINE const int32 NumWords() const { return Postings.Num(); }
+	FORCEINLINE const bool Contains(const class UYetiOS_FileBase* InFile) const { return DocumentIDByFile.Contains(InFile); }
+};
@@ -0,0 +1,169 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "YetiOS_Types.h"
+
+/*************************************************************************
+* File Information:
+YetiOS_NotificationManager.h
+
+* Description:
+Notification service owned by the Operating System. Keeps a fixed size
+history of notifications in a ring buffer, coalesces duplicates (same
+Category, Level, Code, Title and Description), applies per category
+rate limits and queues the notifications that should be shown so they
+can be delivered to the Operating System widget once per frame.
+*************************************************************************/
+class YETIOS_API FYetiOsNotificationManager
+{
+	/** Token bucket used to rate limit one notification category. */
+	struct FRateLimitBucket
+	{
+		/** Notifications allowed per second. Zero or less means unlimited. */
+		float Rate;
+
+		/** Remaining tokens. One token is consumed per shown notification. */
+		double Tokens;
+
+		/** Time in seconds when tokens were last refilled. */
+		double LastRefillTime;
+
+		FRateLimitBucket()
+		{
+			Rate = 0.f;
+			Tokens = 0.0;
+			LastRefillTime = 0.0;
+		}
+	};
+
+	/** Ring buffer of logged notifications. Grows until it reaches HistoryCapacity, then oldest entries are overwritten. */
+	TArray<FYetiOsNotification> History;
+
+	/** Index in History where the next notification will be written. */
+	int32 HistoryHead;
+
+	/** Maximum number of notifications kept in History. */
+	int32 HistoryCapacity;
+
+	/** Coalescing key of the newest notification in History. */
+	FString NewestHistoryKey;
+
+	/** Time in seconds when the newest notification in History was logged. */
+	double NewestHistoryTime;
+
+	/** Duplicates logged within this many seconds of the newest notification are coalesced into it. */
+	float CoalesceWindow;
+
+	/** Notifications waiting to be delivered to the Operating System widget. */
+	TArray<FYetiOsNotification> PendingNotifications;
+
+	/** Index into PendingNotifications keyed by coalescing key. */
+	TMap<FString, int32> PendingIndexByKey;
+
+	/** Rate limiting state for each category. */
+	TMap<EYetiOsNotificationCategory, FRateLimitBucket> RateLimits;
+
+	/** Default rate for categories without an override. */
+	float DefaultRateLimit;
+
+	/** Number of notifications that were logged but not shown because of rate limits. */
+	int32 SuppressedCount;
+
+public:
+
+	FYetiOsNotificationManager(const struct FYetiOsNotificationSettings& InSettings);
+	~FYetiOsNotificationManager();
+
+	static FORCEINLINE FYetiOsNotificationManager* CreateNotificationManager(const struct FYetiOsNotificationSettings& InSettings)
+	{
+		return new FYetiOsNotificationManager(InSettings);
+	}
+
+	static FORCEINLINE void Destroy(FYetiOsNotificationManager* InNotificationManager)
+	{
+		delete InNotificationManager;
+	}
+
+	/**
+	* public FYetiOsNotificationManager::LogNotification
+	* Adds the notification to history and queues it for delivery unless it is coalesced or rate limited.
+	* @param InNewNotification [const FYetiOsNotification&] Notification to log.
+	* @return [bool] True if there are notifications waiting to be delivered.
+	**/
+	bool LogNotification(const FYetiOsNotification& InNewNotification);
+
+	/**
+	* public FYetiOsNotificationManager::ConsumePendingNotifications
+	* Moves all notifications waiting for delivery to the given array.
+	* @param OutNotifications [TArray<FYetiOsNotification>&] Notifications to deliver, in the order they were first logged.
+	**/
+	void ConsumePendingNotifications(TArray<FYetiOsNotification>& OutNotifications);
+
+	/**
+	* public FYetiOsNotificationManager::Reset
+	* Clears history, pending notifications and rate limit state.
+	**/
+	void Reset();
+
+	/**
+	* public FYetiOsNotificationManager::GetNotification const
+	* Returns a notification from history without copying.
+	* @param InIndexFromNewest [const int32] 0 is the newest notification. Must be less than Num().
+	* @return [const FYetiOsNotification&] Notification at the given index.
+	**/
+	const FYetiOsNotification& GetNotification(const int32 InIndexFromNewest) const;
+
+	/**
+	* public FYetiOsNotificationManager::GetNotificationsPage const
+	* Copies one page of history, newest first.
+	* @param InPage [const int32] Zero based page index.
+	* @param InPageSize [const int32] Number of notifications per page.
+	* @param OutNotifications [TArray<FYetiOsNotification>&] Notifications in the requested page.
+	* @return [int32] Total number of pages.
+	**/
+	int32 GetNotificationsPage(const int32 InPage, const int32 InPageSize, TArray<FYetiOsNotification>& OutNotifications) const;
+
+	/**
+	* public FYetiOsNotificationManager::ForEachNotification const
+	* Visits history newest first without copying.
+	* @param InVisitor [TFunctionRef<bool(const FYetiOsNotification&)>] Return false to stop visiting.
+	**/
+	void ForEachNotification(TFunctionRef<bool(const FYetiOsNotification&)> InVisitor) const;
+
+private:
+
+	/**
+	* private static FYetiOsNotificationManager::Internal_GetCoalesceKey
+	* Key used to detect duplicates. Uses Category, Level, Code, Title and Description, so merged notifications only differ in time.
+	* @param InNotification [const FYetiOsNotification&] Notification to get key for.
+	* @return [FString] Coalescing key.
+	**/
+	static FString Internal_GetCoalesceKey(const FYetiOsNotification& InNotification);
+
+	/**
+	* private FYetiOsNotificationManager::Internal_AddToHistory
+	* Adds the notification to history, coalescing it into the newest entry if it is a recent duplicate.
+	* @param InNotification [const FYetiOsNotification&] Notification to add.
+	* @param InKey [const FString&] Coalescing key.
+	* @param InTime [const double] Current time in seconds.
+	**/
+	void Internal_AddToHistory(const FYetiOsNotification& InNotification, const FString& InKey, const double InTime);
+
+	/**
+	* private FYetiOsNotificationManager::Internal_ConsumeRateLimitToken
+	* Refills the bucket for the given category and consumes one token.
+	* @param InCategory [const EYetiOsNotificationCategory] Category of the notification.
+	* @param InTime [const double] Current time in seconds.
+	* @return [bool] True if the notification can be shown.
+	**/
+	bool Internal_ConsumeRateLimitToken(const EYetiOsNotificationCategory InCategory, const double InTime);
+
+public:
+
+	FORCEINLINE const int32 Num() const { return History.Num(); }
+	FORCEINLINE const int32 GetHistoryCapacity() const { return HistoryCapacity; }
+	FORCEINLINE const int32 GetSuppressedCount() const { return SuppressedCount; }
+	FORCEINLINE const bool HasPendingNotifications() const { return PendingNotifications.Num() > 0; }
+};
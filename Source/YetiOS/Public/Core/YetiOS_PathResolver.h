@@ -0,0 +1,67 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*************************************************************************
+* File Information:
+YetiOS_PathResolver.h
+
+* Description:
+Path helpers and resolved path cache owned by the Operating System.
+Paths are normalized to a single lower case form (/home/desktop) which is
+used as cache key, and split into interned FName components so walking
+the tree compares names without building strings. Cached directories are
+held weakly and the whole cache is dropped whenever a directory is
+renamed or moved.
+*************************************************************************/
+struct YETIOS_API FYetiOsPathResolver
+{
+private:
+
+	/** Directories by normalized absolute path. */
+	TMap<FString, TWeakObjectPtr<class UYetiOS_DirectoryBase>> ResolvedPaths;
+
+public:
+
+	/**
+	* public FYetiOsPathResolver::Find const
+	* Returns the cached directory for given normalized path.
+	* @param InNormalizedPath [const FString&] Path returned by Normalize.
+	* @return [class UYetiOS_DirectoryBase*] Cached directory or nullptr if not cached or no longer valid.
+	**/
+	class UYetiOS_DirectoryBase* Find(const FString& InNormalizedPath) const;
+
+	/**
+	* public FYetiOsPathResolver::Add
+	* Caches the directory for given normalized path.
+	* @param InNormalizedPath [const FString&] Path returned by Normalize.
+	* @param InDirectory [class UYetiOS_DirectoryBase*] Directory the path resolves to.
+	**/
+	void Add(const FString& InNormalizedPath, class UYetiOS_DirectoryBase* InDirectory);
+
+	/**
+	* public FYetiOsPathResolver::Invalidate
+	* Drops every cached path.
+	**/
+	void Invalidate();
+
+	/**
+	* public static FYetiOsPathResolver::Normalize
+	* Returns the path in lower case with a leading delimiter, no repeated delimiters and no trailing delimiter. Example: Home//Desktop/ becomes /home/desktop
+	* @param InPath [const FString&] Path to normalize.
+	* @return [FString] Normalized path.
+	**/
+	static FString Normalize(const FString& InPath);
+
+	/**
+	* public static FYetiOsPathResolver::Split
+	* Splits the path into interned components. Empty components are skipped.
+	* @param InPath [const FString&] Path to split.
+	* @param OutComponents [TArray<FName>&] Components from the top most directory down.
+	**/
+	static void Split(const FString& InPath, TArray<FName>& OutComponents);
+
+	FORCEINLINE const int32 Num() const { return ResolvedPaths.Num(); }
+};
@@ -0,0 +1,103 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "YetiOS_ProcessTable.generated.h"
+
+/*************************************************************************
+* File Information:
+YetiOS_ProcessTable.h
+
+* Description:
+Process table owned by the Operating System. Allocates process IDs from
+a bitmap and keeps running programs indexed by process ID and identifier.
+*************************************************************************/
+USTRUCT()
+struct YETIOS_API FYetiOsProcessTable
+{
+	GENERATED_USTRUCT_BODY();
+
+	static const int32 MIN_PROCESS_ID;
+	static const int32 MAX_PROCESS_ID;
+
+private:
+
+	/** Running programs keyed by process ID. Also keeps the programs referenced for garbage collection. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	TMap<int32, class UYetiOS_BaseProgram*> Processes;
+
+	/** Running program instances keyed by program identifier. */
+	TMultiMap<FName, class UYetiOS_BaseProgram*> ProcessesByIdentifier;
+
+	/** One bit per process ID. Set if the ID is in use. */
+	TBitArray<> UsedProcessIDs;
+
+public:
+
+	FYetiOsProcessTable();
+
+	/**
+	* public FYetiOsProcessTable::Add
+	* Allocates a free process ID and registers the given program under it.
+	* @param InProgram [class UYetiOS_BaseProgram*] Program to register.
+	* @return [int32] New process ID or INDEX_NONE if the table is full.
+	**/
+	int32 Add(class UYetiOS_BaseProgram* InProgram);
+
+	/**
+	* public FYetiOsProcessTable::Remove
+	* Removes the program running under the given process ID and frees the ID.
+	* @param InProcessID [const int32] Process ID to free.
+	* @return [bool] True if a program was removed.
+	**/
+	bool Remove(const int32 InProcessID);
+
+	/**
+	* public FYetiOsProcessTable::Reset
+	* Removes all processes and frees all process IDs.
+	**/
+	void Reset();
+
+	/**
+	* public FYetiOsProcessTable::FindFirstByIdentifier const
+	* Finds any running instance of a program with the given identifier.
+	* @param InIdentifier [const FName&] Identifier to look for.
+	* @return [class UYetiOS_BaseProgram*] Running instance or nullptr.
+	**/
+	class UYetiOS_BaseProgram* FindFirstByIdentifier(const FName& InIdentifier) const;
+
+	/**
+	* public FYetiOsProcessTable::GetAllByIdentifier const
+	* Outputs all running instances of a program with the given identifier.
+	* @param InIdentifier [const FName&] Identifier to look for.
+	* @param OutPrograms [TArray<class UYetiOS_BaseProgram*>&] Running instances.
+	**/
+	void GetAllByIdentifier(const FName& InIdentifier, TArray<class UYetiOS_BaseProgram*>& OutPrograms) const;
+
+	/**
+	* public FYetiOsProcessTable::GetProcessIDs const
+	* Outputs all process IDs that are currently in use.
+	* @param OutProcessIDs [TArray<int32>&] Process IDs in use.
+	**/
+	void GetProcessIDs(TArray<int32>& OutProcessIDs) const;
+
+private:
+
+	/**
+	* private FYetiOsProcessTable::Internal_AllocateProcessID
+	* Picks a random starting ID and probes the bitmap for the next free one.
+	* @return [int32] Free process ID or INDEX_NONE if none are left.
+	**/
+	int32 Internal_AllocateProcessID();
+
+public:
+
+	FORCEINLINE class UYetiOS_BaseProgram* Find(const int32 InProcessID) const { return Processes.FindRef(InProcessID); }
+	FORCEINLINE const bool Contains(const int32 InProcessID) const { return Processes.Contains(InProcessID); }
+	FORCEINLINE const bool ContainsIdentifier(const FName& InIdentifier) const { return ProcessesByIdentifier.Contains(InIdentifier); }
+	FORCEINLINE const int32 Num() const { return Processes.Num(); }
+
+	/** Returns the running programs without copying. Do not add or remove processes while iterating. */
+	FORCEINLINE const TMap<int32, class UYetiOS_BaseProgram*>& GetProcesses() const { return Processes; }
+};
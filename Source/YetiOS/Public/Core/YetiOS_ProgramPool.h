@@ -0,0 +1,137 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "YetiOS_ProgramPool.generated.h"
+
+USTRUCT()
+struct FYetiOsProgramPoolSettings
+{
+	GENERATED_USTRUCT_BODY();
+
+	/** If true, closed programs are kept together with their widget and window and reused on next launch instead of being duplicated again. */
+	UPROPERTY(EditAnywhere, Category = "Program Pool Settings")
+	uint8 bEnablePooling : 1;
+
+	/** Maximum number of closed programs kept in pool. Least recently used programs are destroyed first. */
+	UPROPERTY(EditAnywhere, Category = "Program Pool Settings", meta = (EditCondition = "bEnablePooling", ClampMin = "0", UIMin = "0"))
+	int32 MaxPooledPrograms;
+
+	/** Maximum number of closed instances kept for each program class. Programs with a higher Pool Warm Count use that instead. */
+	UPROPERTY(EditAnywhere, Category = "Program Pool Settings", meta = (EditCondition = "bEnablePooling", ClampMin = "0", UIMin = "0"))
+	int32 MaxPooledInstancesPerClass;
+
+	FYetiOsProgramPoolSettings()
+	{
+		bEnablePooling = true;
+		MaxPooledPrograms = 16;
+		MaxPooledInstancesPerClass = 2;
+	}
+};
+
+USTRUCT()
+struct FYetiOsPooledProgram
+{
+	GENERATED_USTRUCT_BODY();
+
+	/** Closed program instance. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	class UYetiOS_BaseProgram* Program;
+
+	/** App widget that was used by Program. Can be null. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	class UYetiOS_AppWidget* ProgramWidget;
+
+	/** Collapsed window that was used by Program. Can be null. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	class UYetiOS_DraggableWindowWidget* Window;
+
+	FYetiOsPooledProgram()
+	{
+		Program = nullptr;
+		ProgramWidget = nullptr;
+		Window = nullptr;
+	}
+};
+
+/*************************************************************************
+* File Information:
+YetiOS_ProgramPool.h
+
+* Description:
+Pool of closed program instances owned by the Operating System. Each
+entry keeps the program object together with its app widget and window
+so launching the same program again does not allocate new objects.
+Entries are kept in least recently used order and trimmed from the
+oldest end.
+*************************************************************************/
+USTRUCT()
+struct YETIOS_API FYetiOsProgramPool
+{
+	GENERATED_USTRUCT_BODY();
+
+private:
+
+	/** Pooled programs. Oldest released first. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	TArray<FYetiOsPooledProgram> Entries;
+
+	/** Number of pooled entries for each program class. */
+	TMap<const UClass*, int32> NumByClass;
+
+public:
+
+	/**
+	* public FYetiOsProgramPool::Acquire
+	* Removes the most recently released entry of given class from the pool.
+	* @param InClass [const UClass*] Program class to look for.
+	* @param OutEntry [FYetiOsPooledProgram&] Entry that was removed.
+	* @return [bool] True if an entry was found.
+	**/
+	bool Acquire(const UClass* InClass, FYetiOsPooledProgram& OutEntry);
+
+	/**
+	* public FYetiOsProgramPool::Release
+	* Adds the entry as most recently used. Destroys least recently used entries of the same class and then of any class to stay within limits.
+	* @param InEntry [const FYetiOsPooledProgram&] Entry to add. Program must not be null.
+	* @param InMaxForClass [const int32] Maximum entries kept for the program class.
+	* @param InMaxTotal [const int32] Maximum entries kept in total.
+	**/
+	void Release(const FYetiOsPooledProgram& InEntry, const int32 InMaxForClass, const int32 InMaxTotal);
+
+	/**
+	* public FYetiOsProgramPool::Trim
+	* Destroys least recently used entries until at most given number of entries remain.
+	* @param InMaxToKeep [const int32] Number of entries to keep.
+	* @return [int32] Number of entries destroyed.
+	**/
+	int32 Trim(const int32 InMaxToKeep);
+
+	/**
+	* public FYetiOsProgramPool::Reset
+	* Destroys all pooled entries.
+	**/
+	void Reset();
+
+	/**
+	* public static FYetiOsProgramPool::DisposeEntry
+	* Destroys the program and removes the window of given entry.
+	* @param InEntry [const FYetiOsPooledProgram&] Entry to destroy.
+	**/
+	static void DisposeEntry(const FYetiOsPooledProgram& InEntry);
+
+private:
+
+	/**
+	* private FYetiOsProgramPool::Internal_RemoveAt
+	* Removes and destroys the entry at given index.
+	* @param InIndex [const int32] Index in Entries.
+	**/
+	void Internal_RemoveAt(const int32 InIndex);
+
+public:
+
+	FORCEINLINE const int32 Num() const { return Entries.Num(); }
+	FORCEINLINE const int32 NumOfClass(const UClass* InClass) const { return NumByClass.FindRef(InClass); }
+};
@@ -0,0 +1,65 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "YetiOS_ProgramRegistry.generated.h"
+
+/*************************************************************************
+* File Information:
+YetiOS_ProgramRegistry.h
+
+* Description:
+Registry of installed programs owned by the Operating System. Keeps the
+installed set indexed by identifier and class along with the subset of
+programs that were installed with the Operating System.
+*************************************************************************/
+USTRUCT()
+struct YETIOS_API FYetiOsProgramRegistry
+{
+	GENERATED_USTRUCT_BODY();
+
+private:
+
+	/** Installed programs in installation order. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	TArray<class UYetiOS_BaseProgram*> Programs;
+
+	/** Installed programs that were installed with the Operating System. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	TArray<class UYetiOS_BaseProgram*> SystemPrograms;
+
+	/** Installed programs keyed by program identifier. */
+	TMap<FName, class UYetiOS_BaseProgram*> ProgramsByIdentifier;
+
+	/** Installed programs keyed by program class. */
+	TMap<const UClass*, class UYetiOS_BaseProgram*> ProgramsByClass;
+
+public:
+
+	/**
+	* public FYetiOsProgramRegistry::Add
+	* Registers the given program as installed.
+	* @param InProgram [class UYetiOS_BaseProgram*] Program to register.
+	* @return [bool] True if the program was added. False if a program with same identifier or class is already registered.
+	**/
+	bool Add(class UYetiOS_BaseProgram* InProgram);
+
+	/**
+	* public FYetiOsProgramRegistry::Reset
+	* Removes all installed programs from this registry.
+	**/
+	void Reset();
+
+	FORCEINLINE class UYetiOS_BaseProgram* FindByIdentifier(const FName& InIdentifier) const { return ProgramsByIdentifier.FindRef(InIdentifier); }
+	FORCEINLINE class UYetiOS_BaseProgram* FindByClass(const UClass* InClass) const { return ProgramsByClass.FindRef(InClass); }
+	FORCEINLINE const bool ContainsIdentifier(const FName& InIdentifier) const { return ProgramsByIdentifier.Contains(InIdentifier); }
+	FORCEINLINE const bool ContainsClass(const UClass* InClass) const { return ProgramsByClass.Contains(InClass); }
+	FORCEINLINE const int32 Num() const { return Programs.Num(); }
+
+	/** Returns all installed programs without copying. */
+	FORCEINLINE const TArray<class UYetiOS_BaseProgram*>& GetPrograms() const { return Programs; }
+
+	/** Returns programs installed with the Operating System without copying. */
+	FORCEINLINE const TArray<class UYetiOS_BaseProgram*>& GetSystemPrograms() const { return SystemPrograms; }
+};
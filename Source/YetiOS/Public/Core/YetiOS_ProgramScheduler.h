@@ -0,0 +1,182 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "YetiOS_Types.h"
+#include "YetiOS_ProgramScheduler.generated.h"
+
+DECLARE_DELEGATE_OneParam(FYetiOsProgramUpdateDelegate, const float)
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnProgramUpdate, const float, DeltaTime);
+
+USTRUCT()
+struct FYetiOsSchedulerSettings
+{
+	GENERATED_USTRUCT_BODY();
+
+	/** Game thread time (in milliseconds) running programs can use per frame on a device with Reference Cpu Speed. */
+	UPROPERTY(EditAnywhere, Category = "Scheduler Settings", meta = (ClampMin = "0.01", UIMin = "0.01"))
+	float FrameBudgetMs;
+
+	/** Total CPU speed (in MHz) that gets exactly Frame Budget Ms. Faster devices get a proportionally larger budget and slower devices a smaller one. */
+	UPROPERTY(EditAnywhere, Category = "Scheduler Settings", meta = (ClampMin = "1", UIMin = "1"))
+	float ReferenceCpuSpeedMHZ;
+
+	/** Budget will never be lower than this (in milliseconds). */
+	UPROPERTY(EditAnywhere, Category = "Scheduler Settings", meta = (ClampMin = "0.01", UIMin = "0.01"))
+	float MinFrameBudgetMs;
+
+	/** Budget will never be higher than this (in milliseconds). */
+	UPROPERTY(EditAnywhere, Category = "Scheduler Settings", meta = (ClampMin = "0.01", UIMin = "0.01"))
+	float MaxFrameBudgetMs;
+
+	FYetiOsSchedulerSettings()
+	{
+		FrameBudgetMs = 2.f;
+		ReferenceCpuSpeedMHZ = 3000.f;
+		MinFrameBudgetMs = 0.25f;
+		MaxFrameBudgetMs = 8.f;
+	}
+};
+
+/*************************************************************************
+* File Information:
+YetiOS_ProgramScheduler.h
+
+* Description:
+Cooperative scheduler owned by the Operating System. Running programs
+register update callbacks with a priority and the scheduler runs them
+once per frame within a time budget. Callbacks that do not fit in the
+budget are deferred to the next frame, and every frame a callback waits
+raises its priority so no program is starved.
+*************************************************************************/
+USTRUCT()
+struct YETIOS_API FYetiOsProgramScheduler
+{
+	GENERATED_USTRUCT_BODY();
+
+private:
+
+	struct FScheduledUpdate
+	{
+		/** Handle returned to the caller. */
+		int32 Handle;
+
+		/** Program that registered this update. */
+		TWeakObjectPtr<class UYetiOS_BaseProgram> Program;
+
+		/** Priority given at registration time. */
+		EYetiOsProgramUpdatePriority Priority;
+
+		/** Callback to run. Blueprint callbacks are wrapped in a native delegate by the Operating System. */
+		FYetiOsProgramUpdateDelegate Callback;
+
+		/** Time accumulated since this update last ran. Passed as delta time so deferred updates do not lose time. */
+		float PendingDeltaTime;
+
+		/** Number of consecutive frames this update was deferred. */
+		int32 DeferredFrames;
+
+		/** True if this update was unregistered. Removed at the end of the current Tick. */
+		uint8 bPendingRemoval : 1;
+	};
+
+	/** All registered updates. */
+	TArray<FScheduledUpdate> Updates;
+
+	/** Updates registered while Tick is running. Added to Updates once Tick finishes so callbacks can safely register new updates. */
+	TArray<FScheduledUpdate> PendingUpdates;
+
+	/** Handle that will be given to the next registered update. */
+	int32 NextHandle;
+
+	/** True while Tick is running callbacks. */
+	uint8 bIsTicking : 1;
+
+	/** Time (in milliseconds) spent running callbacks last frame. */
+	float LastFrameTimeMs;
+
+	/** Number of updates that ran last frame. */
+	int32 LastFrameExecutedCount;
+
+	/** Number of updates that were deferred last frame. */
+	int32 LastFrameDeferredCount;
+
+public:
+
+	FYetiOsProgramScheduler();
+
+	/**
+	* public FYetiOsProgramScheduler::Register
+	* Registers an update callback for the given program.
+	* @param InProgram [class UYetiOS_BaseProgram*] Program that owns the callback.
+	* @param InCallback [const FYetiOsProgramUpdateDelegate&] Callback to run every frame.
+	* @param InPriority [const EYetiOsProgramUpdatePriority] Higher priority callbacks run first.
+	* @return [int32] Handle to unregister with or INDEX_NONE if callback is not bound.
+	**/
+	int32 Register(class UYetiOS_BaseProgram* InProgram, const FYetiOsProgramUpdateDelegate& InCallback, const EYetiOsProgramUpdatePriority InPriority);
+
+	/**
+	* public FYetiOsProgramScheduler::Unregister
+	* Unregisters the update with given handle.
+	* @param InHandle [const int32] Handle returned by Register.
+	* @return [bool] True if an update was unregistered.
+	**/
+	bool Unregister(const int32 InHandle);
+
+	/**
+	* public FYetiOsProgramScheduler::UnregisterProgram
+	* Unregisters all updates owned by the given program.
+	* @param InProgram [const class UYetiOS_BaseProgram*] Program to unregister.
+	* @return [int32] Number of updates that were unregistered.
+	**/
+	int32 UnregisterProgram(const class UYetiOS_BaseProgram* InProgram);
+
+	/**
+	* public FYetiOsProgramScheduler::Tick
+	* Runs registered updates in priority order until the budget is used up. At least one update runs every frame.
+	* @param InDeltaTime [const float] Frame delta time in seconds.
+	* @param InBudgetSeconds [const double] Time in seconds that can be spent this frame.
+	**/
+	void Tick(const float InDeltaTime, const double InBudgetSeconds);
+
+	/**
+	* public FYetiOsProgramScheduler::Reset
+	* Removes all registered updates.
+	**/
+	void Reset();
+
+	/**
+	* public static FYetiOsProgramScheduler::CalculateFrameBudget
+	* Calculates frame budget for a device with the given total CPU speed.
+	* @param InSettings [const FYetiOsSchedulerSettings&] Scheduler settings.
+	* @param InCpuSpeedMHZ [const float] Total CPU speed of the device in MHz.
+	* @return [double] Budget in seconds.
+	**/
+	static double CalculateFrameBudget(const FYetiOsSchedulerSettings& InSettings, const float InCpuSpeedMHZ);
+
+private:
+
+	/**
+	* private FYetiOsProgramScheduler::Internal_Add
+	* Adds a new update entry and returns it.
+	* @param InProgram [class UYetiOS_BaseProgram*] Program that owns the update.
+	* @param InPriority [const EYetiOsProgramUpdatePriority] Priority of the update.
+	* @return [FScheduledUpdate&] New entry.
+	**/
+	FScheduledUpdate& Internal_Add(class UYetiOS_BaseProgram* InProgram, const EYetiOsProgramUpdatePriority InPriority);
+
+	/**
+	* private FYetiOsProgramScheduler::Internal_RemovePending
+	* Removes updates that were unregistered or whose program is gone.
+	**/
+	void Internal_RemovePending();
+
+public:
+
+	FORCEINLINE const int32 Num() const { return Updates.Num() + PendingUpdates.Num(); }
+	FORCEINLINE const bool HasUpdates() const { return Num() > 0; }
+	FORCEINLINE const float GetLastFrameTimeMs() const { return LastFrameTimeMs; }
+	FORCEINLINE const int32 GetLastFrameExecutedCount() const { return LastFrameExecutedCount; }
+	FORCEINLINE const int32 GetLastFrameDeferredCount() const { return LastFrameDeferredCount; }
+};
@@ -5,8 +5,13 @@
 #include "CoreMinimal.h"
 #include "GameFramework/SaveGame.h"
 #include "YetiOS_Types.h"
+#include "Core/YetiOS_SaveSchema.h"
+#include "Async/Future.h"
 #include "YetiOS_SaveGame.generated.h"
 
+DECLARE_DELEGATE_OneParam(FOnYetiOsSaveGameComplete, const bool /* bWasSuccessful */);
+DECLARE_DELEGATE_OneParam(FOnYetiOsLoadGameComplete, class UYetiOS_SaveGame* /* LoadedGame */);
+
 /**
  * 
  */
@@ -25,7 +30,11 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS Save Game")
 	uint32 UserIndex;
 
-	/** Static save version. DO NOT CHANGE if not required. Newer save versions are NOT compatible with previous ones. */
+	/** FCompression format save files are compressed with, like Zlib or Oodle. None writes chunks uncompressed. Saves are read with the format they were written with. */
+	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS Save Game", AdvancedDisplay = "true")
+	FName CompressionFormat;
+
+	/** Version this save was written with. Older saves are migrated on load. Saves from a newer plugin version cannot be loaded. */
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	float SaveVersion;
 
@@ -37,7 +46,7 @@ private:
 	UPROPERTY()
 	FYetiOsOperatingSystemSaveLoad OsData;
 
-	/** Directories to save */
+	/** Directories of save version 2. Only read by migration. */
 	UPROPERTY()
 	TArray<FYetiOsDirectorySaveLoad> DirectoryData;
 
@@ -45,6 +54,17 @@ private:
 	UPROPERTY()
 	TArray<FYetiOsProgramSaveLoad> ProgramData;
 
+	/** File index of save version 2. Only read by migration. */
+	UPROPERTY()
+	TArray<FYetiOsFileIndexSaveLoad> FileIndexData;
+
+	/** Oldest change journal generation that is not part of this save. Journaled changes from this generation on are replayed after loading. */
+	UPROPERTY()
+	uint32 JournalGeneration;
+
+	/** Directories, files and file index. Written as binary after the properties above. @See Serialize() */
+	FYetiOsSaveTree SaveTree;
+
 public:
 
 	UYetiOS_SaveGame();
@@ -57,6 +77,15 @@ public:
 	**/
 	static const bool SaveGame(const class UYetiOS_BaseDevice* InDevice);
 
+	/**
+	* public static UYetiOS_SaveGame::SaveGameAsync
+	* Captures the given device into a new save game object on the game thread, then serializes and writes it on a worker thread.
+	* @param InDevice [const class UYetiOS_BaseDevice*] Device class to save game from.
+	* @param InOnComplete [const FOnYetiOsSaveGameComplete&] Called on game thread once the write finished. Called right away if nothing could be captured.
+	* @return [TFuture<bool>] Result of the write. Wait on this only if the game thread cannot continue without the save, like on end play.
+	**/
+	static TFuture<bool> SaveGameAsync(const class UYetiOS_BaseDevice* InDevice, const FOnYetiOsSaveGameComplete& InOnComplete);
+
 	/**
 	* public static UYetiOS_SaveGame::LoadGame
 	* Load game for given device.
@@ -65,8 +94,147 @@ public:
 	**/
 	static const UYetiOS_SaveGame* LoadGame(const class UYetiOS_BaseDevice* InDevice);
 
+	/**
+	* public static UYetiOS_SaveGame::LoadGameAsync
+	* Reads the save file of given device and deserializes its save tree on worker threads. Only properties of the save game and migration run on game thread.
+	* @param InDevice [const class UYetiOS_BaseDevice*] Device to load.
+	* @param InOnComplete [const FOnYetiOsLoadGameComplete&] Called on game thread with the loaded save game. nullptr if there is no save game or it could not be loaded.
+	**/
+	static void LoadGameAsync(const class UYetiOS_BaseDevice* InDevice, const FOnYetiOsLoadGameComplete& InOnComplete);
+
+	/**
+	* public static UYetiOS_SaveGame::GetDeviceSlotName
+	* Returns the slot the given device is saved in. Every device manager has its own slot next to the slot of the save game class.
+	* @See AYetiOS_DeviceManagerActor::GetDeviceSaveID
+	* @param InDevice [const class UYetiOS_BaseDevice*] Device to get the slot for.
+	* @return [FString] Slot name. Slot of the save game class if the device has no device manager.
+	**/
+	static FString GetDeviceSlotName(const class UYetiOS_BaseDevice* InDevice);
+
+	virtual void Serialize(FArchive& Ar) override;
+
+private:
+
+	/**
+	* private static UYetiOS_SaveGame::Internal_CreateSnapshot
+	* Copies everything that needs to be saved from the given device into a new save game object. Must run on game thread.
+	* @param InDevice [const class UYetiOS_BaseDevice*] Device class to save game from.
+	* @return [UYetiOS_SaveGame*] New save game object or nullptr if this device cannot be saved.
+	**/
+	static UYetiOS_SaveGame* Internal_CreateSnapshot(const class UYetiOS_BaseDevice* InDevice);
+
+	/**
+	* private static UYetiOS_SaveGame::Internal_WriteToStream
+	* Serializes the given save game into a compressed save stream. Safe on a worker thread as long as nothing else modifies the save game.
+	* @param InSaveGame [UYetiOS_SaveGame*] Save game to write.
+	* @param OutStreamBytes [TArray<uint8>&] Stream that can be written to a save slot.
+	* @return [bool] True if the stream was written.
+	**/
+	static bool Internal_WriteToStream(UYetiOS_SaveGame* InSaveGame, TArray<uint8>& OutStreamBytes);
+
+	/**
+	* private static UYetiOS_SaveGame::Internal_ReadFromBytes
+	* Creates a save game from bytes of a save slot. Chunks of a save stream are decompressed as they are deserialized. Must run on game thread.
+	* @param InSaveBytes [const TArray<uint8>&] Bytes of a save slot. Saves written before save streams are read as well.
+	* @return [UYetiOS_SaveGame*] Loaded save game or nullptr if the bytes could not be read.
+	**/
+	static UYetiOS_SaveGame* Internal_ReadFromBytes(const TArray<uint8>& InSaveBytes);
+
+	/**
+	* private static UYetiOS_SaveGame::Internal_ReadProperties
+	* Creates a save game of the class in the stream header and reads its properties. Save tree is left in the stream. Must run on game thread.
+	* @param InStreamReader [FYetiOsSaveStreamReader&] Reader positioned at the start of the payload.
+	* @return [UYetiOS_SaveGame*] Save game with its properties read or nullptr if they could not be read.
+	**/
+	static UYetiOS_SaveGame* Internal_ReadProperties(class FYetiOsSaveStreamReader& InStreamReader);
+
+	/**
+	* private UYetiOS_SaveGame::Internal_ReadSaveTree
+	* Reads the save tree that follows the properties. Save tree is plain data so this is safe on a worker thread as long as nothing else uses this save game.
+	* @param InStreamReader [FYetiOsSaveStreamReader&] Reader positioned right after the properties.
+	* @return [bool] True if the save tree was read.
+	**/
+	bool Internal_ReadSaveTree(class FYetiOsSaveStreamReader& InStreamReader);
+
+	/**
+	* private UYetiOS_SaveGame::Internal_SerializeSaveTree
+	* Writes or reads the save tree and its file contents if the save version has them.
+	* @param Ar [FArchive&] Archive to use.
+	**/
+	void Internal_SerializeSaveTree(FArchive& Ar);
+
+	/**
+	* private static UYetiOS_SaveGame::Internal_FinishLoadAsync
+	* Migrates the loaded save game and calls the completion delegate of LoadGameAsync. Must run on game thread.
+	* @param InSaveGame [UYetiOS_SaveGame*] Loaded save game or nullptr if loading failed.
+	* @param InSlotName [const FString&] Slot that was loaded.
+	* @param InStartTime [const double] Time the load started at.
+	* @param InOnComplete [const FOnYetiOsLoadGameComplete&] Delegate to call.
+	**/
+	static void Internal_FinishLoadAsync(UYetiOS_SaveGame* InSaveGame, const FString& InSlotName, const double InStartTime, const FOnYetiOsLoadGameComplete& InOnComplete);
+
+	/**
+	* private static UYetiOS_SaveGame::Internal_GetLoadSlotName
+	* Returns the slot to load the given device from. A device that was never saved in its own slot takes over the unsharded slot of older versions, if no other device did. Must run on game thread.
+	* @param InDevice [const class UYetiOS_BaseDevice*] Device to load.
+	* @return [FString] Slot name.
+	**/
+	static FString Internal_GetLoadSlotName(const class UYetiOS_BaseDevice* InDevice);
+
+	/**
+	* private static UYetiOS_SaveGame::Internal_MakeShard
+	* Describes the save slot of the given device for the save manifest. Must run on game thread.
+	* @param InDevice [const class UYetiOS_BaseDevice*] Device that is saved.
+	* @return [FYetiOsSaveShard] Shard of the device.
+	**/
+	static FYetiOsSaveShard Internal_MakeShard(const class UYetiOS_BaseDevice* InDevice);
+
+	/**
+	* private static UYetiOS_SaveGame::Internal_RegisterShard
+	* Adds the given shard to the save manifest. Manifest is only written if the shard is new or changed. Must run on game thread.
+	* @param InGameInstance [class UGameInstance*] Game instance that keeps the manifest. Manifest is loaded without being kept if null.
+	* @param InShard [const FYetiOsSaveShard&] Shard that was saved.
+	* @param InBaseSlotName [const FString&] Slot name of the save game class.
+	* @param InUserIndex [const int32] User index of the save game class.
+	**/
+	static void Internal_RegisterShard(class UGameInstance* InGameInstance, const FYetiOsSaveShard& InShard, const FString& InBaseSlotName, const int32 InUserIndex);
+
+	/**
+	* private static UYetiOS_SaveGame::Internal_GetManifest
+	* Returns the save manifest kept by the given game instance. Must run on game thread.
+	* @param InGameInstance [class UGameInstance*] Game instance that keeps the manifest. Manifest is loaded without being kept if null.
+	* @param InBaseSlotName [const FString&] Slot name of the save game class.
+	* @param InUserIndex [const int32] User index of the save game class.
+	* @return [class UYetiOS_SaveManifest*] Manifest.
+	**/
+	static class UYetiOS_SaveManifest* Internal_GetManifest(class UGameInstance* InGameInstance, const FString& InBaseSlotName, const int32 InUserIndex);
+
+	/**
+	* private UYetiOS_SaveGame::Internal_Migrate
+	* Runs migrations until this save reaches the current save version.
+	* @return [bool] False if this save is too old or was written by a newer version and cannot be loaded.
+	**/
+	bool Internal_Migrate();
+
+	/**
+	* private UYetiOS_SaveGame::Internal_MigrateFromVersion2
+	* Converts full path directories and file index of version 2 into the save tree.
+	**/
+	void Internal_MigrateFromVersion2();
+
+	/**
+	* private UYetiOS_SaveGame::Internal_MigrateFromVersion3
+	* Version 3 has the same save tree without file content.
+	**/
+	void Internal_MigrateFromVersion3();
+
+public:
+
+
 	FORCEINLINE const FYetiOsDeviceSaveLoad GetDeviceLoadData() const { return DeviceData; }
 	FORCEINLINE const FYetiOsOperatingSystemSaveLoad GetOsLoadData() const { return OsData; }
-	FORCEINLINE const TArray<FYetiOsDirectorySaveLoad> GetDirectoriesData() const { return DirectoryData; }
 	FORCEINLINE const TArray<FYetiOsProgramSaveLoad> GetProgramData() const { return ProgramData; }
+	FORCEINLINE const FYetiOsSaveTree& GetSaveTree() const { return SaveTree; }
+	FORCEINLINE const uint32 GetJournalGeneration() const { return JournalGeneration; }
+	FORCEINLINE const FString& GetSaveSlotName() const { return SaveSlotName; }
 };
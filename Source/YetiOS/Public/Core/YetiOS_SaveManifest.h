@@ -0,0 +1,121 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "YetiOS_Types.h"
+#include "YetiOS_SaveManifest.generated.h"
+
+/*************************************************************************
+* File Information:
+YetiOS_SaveManifest.h
+
+* Description:
+Every device is saved in its own slot, named after the slot of its save
+game class and the save ID of its device manager. The manifest is a small
+slot next to them that lists those shards, so saves can be found without
+loading any of them. It also remembers which device took over the single
+slot every device shared before saves were sharded.
+
+Manifests are read from disk once per game instance and kept by
+UYetiOS_DevicePersistenceSubsystem after that. Changes are written
+asynchronously so saving a device never blocks the game thread on the
+manifest.
+*************************************************************************/
+UCLASS()
+class YETIOS_API UYetiOS_SaveManifest : public USaveGame
+{
+	GENERATED_BODY()
+
+private:
+
+	/** Save slot of every device that was saved at least once. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	TArray<FYetiOsSaveShard> Shards;
+
+	/** Save ID of the device that loads the unsharded slot of older versions. Empty until a device claims it. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	FString LegacySlotOwner;
+
+	/** Slot of the save game class this manifest belongs to. */
+	FString BaseSlotName;
+
+	int32 UserIndex;
+
+	/** True while an asynchronous write of this manifest is in flight. */
+	uint8 bIsWriting : 1;
+
+	/** True if the manifest changed while it was being written. It is written again once the current write completes. */
+	uint8 bWriteAgain : 1;
+
+	/** True if the last write failed. The next shard that is added writes the manifest even if nothing changed. */
+	uint8 bLastWriteFailed : 1;
+
+public:
+
+	UYetiOS_SaveManifest();
+
+	/**
+	* public static UYetiOS_SaveManifest::LoadManifest
+	* Loads the manifest of the given save slot. Creates an empty one if it was never written. Must run on game thread.
+	* @See UYetiOS_DevicePersistenceSubsystem::GetSaveManifest to share one loaded manifest across a game instance.
+	* @param InBaseSlotName [const FString&] Slot name of the save game class.
+	* @param InUserIndex [const int32] User index of the save game class.
+	* @return [UYetiOS_SaveManifest*] Manifest.
+	**/
+	static UYetiOS_SaveManifest* LoadManifest(const FString& InBaseSlotName, const int32 InUserIndex);
+
+	/**
+	* public static UYetiOS_SaveManifest::GetManifestSlotName
+	* Returns slot name of the manifest for the given save slot.
+	* @param InBaseSlotName [const FString&] Slot name of the save game class.
+	* @return [FString] Manifest slot name.
+	**/
+	static FString GetManifestSlotName(const FString& InBaseSlotName);
+
+	/**
+	* public UYetiOS_SaveManifest::AddShard
+	* Adds or updates the shard of a device and writes the manifest asynchronously if anything changed.
+	* @param InShard [const FYetiOsSaveShard&] Shard to add.
+	* @return [bool] True if the manifest changed.
+	**/
+	bool AddShard(const FYetiOsSaveShard& InShard);
+
+	/**
+	* public UYetiOS_SaveManifest::FindShard const
+	* Finds the shard of the given device.
+	* @param InDeviceSaveID [const FString&] Save ID of the device manager.
+	* @return [const FYetiOsSaveShard*] Shard or nullptr if the device was never saved.
+	**/
+	const FYetiOsSaveShard* FindShard(const FString& InDeviceSaveID) const;
+
+	/**
+	* public UYetiOS_SaveManifest::ClaimLegacySlot
+	* Lets the first device that asks load the unsharded slot of older versions. Writes the manifest when the slot is claimed.
+	* @param InDeviceSaveID [const FString&] Save ID of the device manager asking.
+	* @return [bool] True if the given device owns the legacy slot.
+	**/
+	bool ClaimLegacySlot(const FString& InDeviceSaveID);
+
+private:
+
+	/**
+	* private UYetiOS_SaveManifest::Internal_Write
+	* Starts an asynchronous write of this manifest to its slot. If a write is already in flight the manifest is written again once it completes.
+	**/
+	void Internal_Write();
+
+	/**
+	* private UYetiOS_SaveManifest::Internal_OnWriteComplete
+	* Called on game thread when the asynchronous write completes.
+	* @param InSlotName [const FString&] Slot that was written.
+	* @param InUserIndex [const int32] User index that was written.
+	* @param bInSuccess [bool] True if the slot was written.
+	**/
+	void Internal_OnWriteComplete(const FString& InSlotName, const int32 InUserIndex, bool bInSuccess);
+
+public:
+
+	FORCEINLINE const TArray<FYetiOsSaveShard>& GetShards() const { return Shards; }
+};
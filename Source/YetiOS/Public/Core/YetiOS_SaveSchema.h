@@ -0,0 +1,278 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/YetiOS_FileContent.h"
+
+/** Bits stored in Flags of directory and file records. */
+namespace EYetiOsSaveRecordFlags
+{
+	enum Type : uint8
+	{
+		None		= 0,
+		Hidden		= 1 << 0,
+		/** Directory only. Saved files and child directories are all it has, so default ones are not created again on load. */
+		Complete	= 1 << 1
+	};
+}
+
+/*************************************************************************
+* File Information:
+YetiOS_SaveSchema.h
+
+* Description:
+Compact binary layout of the directory tree inside a save game. Names,
+extensions, class paths and index words are stored once in a string
+table and records refer to them by index. Directories point to their
+parent record instead of storing a full path. Parents are always written
+before their children so a load can create the tree in record order.
+Indices are written as packed integers so small trees stay small.
+*************************************************************************/
+struct YETIOS_API FYetiOsSaveStringTable
+{
+private:
+
+	/** Unique strings. Index is the string ID stored in records. */
+	TArray<FString> Strings;
+
+	/** String ID of each string. Only filled while saving. */
+	TMap<FString, int32> IndexByString;
+
+public:
+
+	/**
+	* public FYetiOsSaveStringTable::Add
+	* Returns ID of the given string, adding it if needed.
+	* @param InString [const FString&] String to add.
+	* @return [int32] String ID.
+	**/
+	int32 Add(const FString& InString);
+
+	/**
+	* public FYetiOsSaveStringTable::Get const
+	* Returns string with the given ID.
+	* @param InIndex [const int32] String ID.
+	* @return [const FString&] String or empty string if ID is not valid.
+	**/
+	const FString& Get(const int32 InIndex) const;
+
+	/**
+	* public FYetiOsSaveStringTable::Reset
+	* Removes all strings.
+	**/
+	void Reset();
+
+	friend FArchive& operator<<(FArchive& Ar, FYetiOsSaveStringTable& InTable);
+
+	FORCEINLINE const int32 Num() const { return Strings.Num(); }
+};
+
+struct FYetiOsSaveDirectoryRecord
+{
+	/** Record index of the parent directory. INDEX_NONE for root. */
+	int32 ParentIndex;
+
+	/** String ID of the directory name. Empty for root. */
+	int32 NameIndex;
+
+	/** String ID of the directory class path. INDEX_NONE to use the template directory of the OS. */
+	int32 ClassIndex;
+
+	/** EYetiOsSaveRecordFlags bits. */
+	uint8 Flags;
+
+	FYetiOsSaveDirectoryRecord()
+	{
+		ParentIndex = INDEX_NONE;
+		NameIndex = INDEX_NONE;
+		ClassIndex = INDEX_NONE;
+		Flags = EYetiOsSaveRecordFlags::None;
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FYetiOsSaveDirectoryRecord& InRecord);
+};
+
+struct FYetiOsSaveFileRecord
+{
+	/** Record index of the directory this file is in. */
+	int32 DirectoryIndex;
+
+	/** String ID of the file class path. */
+	int32 ClassIndex;
+
+	/** String ID of the file name without extension. */
+	int32 NameIndex;
+
+	/** String ID of the file extension. */
+	int32 ExtensionIndex;
+
+	/** EYetiOsSaveRecordFlags bits. */
+	uint8 Flags;
+
+	FYetiOsSaveFileRecord()
+	{
+		DirectoryIndex = INDEX_NONE;
+		ClassIndex = INDEX_NONE;
+		NameIndex = INDEX_NONE;
+		ExtensionIndex = INDEX_NONE;
+		Flags = EYetiOsSaveRecordFlags::None;
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FYetiOsSaveFileRecord& InRecord);
+};
+
+struct FYetiOsSaveFileIndexRecord
+{
+	/** Record index of the indexed file. */
+	int32 FileIndex;
+
+	/** String IDs of the name words. */
+	TArray<int32> NameWords;
+
+	/** String IDs of the content words. */
+	TArray<int32> ContentWords;
+
+	FYetiOsSaveFileIndexRecord()
+	{
+		FileIndex = INDEX_NONE;
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FYetiOsSaveFileIndexRecord& InRecord);
+};
+
+struct FYetiOsSaveFileContentRecord
+{
+	/** Record index of the file this content belongs to. */
+	int32 FileIndex;
+
+	/** Chunks of the content while saving. Shared with the file content so capturing a save does not copy bytes. */
+	TArray<FYetiOsContentChunkPtr> Chunks;
+
+	/** Bytes of the content after loading. */
+	TArray<uint8> Bytes;
+
+	FYetiOsSaveFileContentRecord()
+	{
+		FileIndex = INDEX_NONE;
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FYetiOsSaveFileContentRecord& InRecord);
+};
+
+struct YETIOS_API FYetiOsSaveTree
+{
+	FYetiOsSaveStringTable Strings;
+
+	/** Directory records. Parents always come before their children and root is the first record. */
+	TArray<FYetiOsSaveDirectoryRecord> Directories;
+
+	TArray<FYetiOsSaveFileRecord> Files;
+
+	/** File index of the OS. Empty if the index was disabled or not built when saving. */
+	TArray<FYetiOsSaveFileIndexRecord> FileIndex;
+
+	/** Content of files that are not empty, in file record order. Serialized by the save game since older saves do not have it. */
+	TArray<FYetiOsSaveFileContentRecord> Contents;
+
+	/**
+	* public FYetiOsSaveTree::AddDirectory
+	* Adds a directory record. Parent must already be added.
+	* @param InParentIndex [const int32] Record index of the parent. INDEX_NONE for root.
+	* @param InName [const FString&] Directory name.
+	* @param InClassPath [const FString&] Directory class path. Empty to use the template directory of the OS.
+	* @param InFlags [const uint8] EYetiOsSaveRecordFlags bits.
+	* @return [int32] Record index.
+	**/
+	int32 AddDirectory(const int32 InParentIndex, const FString& InName, const FString& InClassPath, const uint8 InFlags);
+
+	/**
+	* public FYetiOsSaveTree::AddFile
+	* Adds a file record.
+	* @param InDirectoryIndex [const int32] Record index of the directory this file is in.
+	* @param InClassPath [const FString&] File class path.
+	* @param InName [const FString&] File name without extension.
+	* @param InExtension [const FString&] File extension.
+	* @param InFlags [const uint8] EYetiOsSaveRecordFlags bits.
+	* @return [int32] Record index.
+	**/
+	int32 AddFile(const int32 InDirectoryIndex, const FString& InClassPath, const FString& InName, const FString& InExtension, const uint8 InFlags);
+
+	/**
+	* public FYetiOsSaveTree::AddFileIndex
+	* Adds index words of a file.
+	* @param InFileIndex [const int32] Record index of the file.
+	* @param InNameWords [const TArray<FString>&] Name words.
+	* @param InContentWords [const TArray<FString>&] Content words.
+	**/
+	void AddFileIndex(const int32 InFileIndex, const TArray<FString>& InNameWords, const TArray<FString>& InContentWords);
+
+	/**
+	* public FYetiOsSaveTree::AddFileContent
+	* Adds content of a file. Chunks are shared, not copied.
+	* @param InFileIndex [const int32] Record index of the file. Must not be lower than the file of the last added content.
+	* @param InContent [const class UYetiOS_FileContent*] Content to add.
+	**/
+	void AddFileContent(const int32 InFileIndex, const class UYetiOS_FileContent* InContent);
+
+	/**
+	* public FYetiOsSaveTree::Reset
+	* Removes all records and strings.
+	**/
+	void Reset();
+
+	/**
+	* public static FYetiOsSaveTree::SerializeIndex
+	* Writes or reads an index that can be INDEX_NONE as a packed integer.
+	* @param Ar [FArchive&] Archive to use.
+	* @param InOutIndex [int32&] Index to write or read.
+	**/
+	static void SerializeIndex(FArchive& Ar, int32& InOutIndex);
+
+	friend FArchive& operator<<(FArchive& Ar, FYetiOsSaveTree& InTree);
+
+	FORCEINLINE const bool IsEmpty() const { return Directories.Num() == 0; }
+};
+
+/** Where a load of FYetiOsSaveTree is at. Records are loaded in order so the tree can be built over several frames. */
+struct YETIOS_API FYetiOsSaveTreeLoadState
+{
+	/** Number of child directory records of each directory record. */
+	TArray<int32> NumChildDirectories;
+
+	/** Number of file records of each directory record. */
+	TArray<int32> NumFiles;
+
+	/** Resolved class of each class path string ID. Explicitly null if the class could not be loaded. */
+	TMap<int32, TWeakObjectPtr<UClass>> ClassCache;
+
+	/** Loaded directory of each directory record loaded so far. Null if the directory could not be loaded. Owned by the directory tree. */
+	TArray<class UYetiOS_DirectoryBase*> LoadedDirectories;
+
+	/** Loaded file of each file record loaded so far. Null if the file could not be loaded. Owned by the directory tree. */
+	TArray<class UYetiOS_FileBase*> LoadedFiles;
+
+	/** Index of the next content record to load. */
+	int32 NextContentRecord;
+
+	FYetiOsSaveTreeLoadState()
+	{
+		NextContentRecord = 0;
+	}
+
+	/** Complete directories that already had their default files before the load. Default files the save does not have are removed once files are loaded. */
+	TArray<class UYetiOS_DirectoryBase*> DirectoriesToReconcile;
+
+	/**
+	* public FYetiOsSaveTreeLoadState::Begin
+	* Counts entries of every directory so containers are sized once while loading.
+	* @param InSaveTree [const FYetiOsSaveTree&] Tree that will be loaded.
+	**/
+	void Begin(const FYetiOsSaveTree& InSaveTree);
+
+	/**
+	* public FYetiOsSaveTreeLoadState::Reset
+	* Forgets everything about the current load.
+	**/
+	void Reset();
+};
@@ -0,0 +1,193 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersion.h"
+#include "Serialization/CustomVersion.h"
+
+/** Written at the start of every save stream header. */
+struct YETIOS_API FYetiOsSaveStreamHeader
+{
+	uint32 Magic;
+
+	/** Layout version of the stream itself. Independent of the save version of the save game. */
+	int32 StreamVersion;
+
+	/** Name of the FCompression format chunks were compressed with. None if chunks are stored uncompressed. */
+	FString CompressionFormat;
+
+	int32 PackageFileUE4Version;
+	int32 PackageFileLicenseeUE4Version;
+	FEngineVersion EngineVersion;
+
+	/** Path of the save game class. */
+	FString SaveGameClassPath;
+
+	/** Uncompressed size of every chunk but the last one. */
+	int32 ChunkSize;
+
+	/** Uncompressed size of the whole payload. */
+	int64 RawSize;
+
+	/** Byte offset of the chunk table in the stream. */
+	int64 ChunkTableOffset;
+
+	/** Byte offset of the custom versions used by the payload in the stream. */
+	int64 CustomVersionsOffset;
+
+	FYetiOsSaveStreamHeader();
+
+	friend FArchive& operator<<(FArchive& Ar, FYetiOsSaveStreamHeader& InHeader);
+};
+
+struct FYetiOsSaveStreamChunk
+{
+	/** Bytes of the chunk in the stream. Equal to RawSize if the chunk is stored uncompressed. */
+	int32 CompressedSize;
+
+	int32 RawSize;
+
+	FYetiOsSaveStreamChunk()
+	{
+		CompressedSize = 0;
+		RawSize = 0;
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FYetiOsSaveStreamChunk& InChunk)
+	{
+		Ar << InChunk.CompressedSize;
+		Ar << InChunk.RawSize;
+		return Ar;
+	}
+};
+
+/*************************************************************************
+* File Information:
+YetiOS_SaveStream.h
+
+* Description:
+Compressed save file layout. A stream is a header, the payload split in
+fixed size chunks that are compressed one at a time, a table with the
+size of every chunk and the custom versions the payload was written
+with. Header and tables are never compressed so the codec and chunk
+layout can be read before anything is decompressed.
+The writer compresses each chunk as soon as it is full and the reader
+decompresses one chunk at a time as the deserializer asks for bytes, so
+raw payload is never held in memory as a whole.
+*************************************************************************/
+class YETIOS_API FYetiOsSaveStreamWriter : public FArchive
+{
+private:
+
+	/** Stream is written here. */
+	TArray<uint8>& StreamBytes;
+
+	FYetiOsSaveStreamHeader Header;
+
+	/** FCompression format. None stores chunks uncompressed. */
+	FName CompressionFormat;
+
+	/** Bytes of the chunk that is being filled. */
+	TArray<uint8> ChunkBuffer;
+
+	TArray<FYetiOsSaveStreamChunk> Chunks;
+
+public:
+
+	/**
+	* public FYetiOsSaveStreamWriter::FYetiOsSaveStreamWriter
+	* Starts a stream. Header is written with its final size right away and updated by Finish.
+	* @param OutStreamBytes [TArray<uint8>&] Stream is written here. Must outlive this writer.
+	* @param InSaveGameClassPath [const FString&] Path of the class of the save game being written.
+	* @param InCompressionFormat [const FName&] FCompression format. Falls back to uncompressed chunks if the format is not available.
+	* @param InChunkSize [const int32] Uncompressed bytes per chunk.
+	**/
+	FYetiOsSaveStreamWriter(TArray<uint8>& OutStreamBytes, const FString& InSaveGameClassPath, const FName& InCompressionFormat, const int32 InChunkSize);
+
+	/**
+	* public FYetiOsSaveStreamWriter::Finish
+	* Compresses the last chunk and writes the chunk table, custom versions and final header.
+	* @return [bool] True if every chunk was written.
+	**/
+	bool Finish();
+
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual int64 Tell() override { return Header.RawSize + ChunkBuffer.Num(); }
+	virtual int64 TotalSize() override { return Tell(); }
+	virtual FString GetArchiveName() const override { return TEXT("FYetiOsSaveStreamWriter"); }
+
+	FORCEINLINE const FYetiOsSaveStreamHeader& GetHeader() const { return Header; }
+
+private:
+
+	/**
+	* private FYetiOsSaveStreamWriter::Internal_FlushChunk
+	* Compresses the chunk buffer and appends it to the stream.
+	**/
+	void Internal_FlushChunk();
+};
+
+class YETIOS_API FYetiOsSaveStreamReader : public FArchive
+{
+private:
+
+	/** Stream that is read. */
+	const TArray<uint8>& StreamBytes;
+
+	FYetiOsSaveStreamHeader Header;
+
+	/** FCompression format chunks were written with. */
+	FName CompressionFormat;
+
+	TArray<FYetiOsSaveStreamChunk> Chunks;
+
+	/** Byte offset of the next chunk in the stream. */
+	int64 NextChunkOffset;
+
+	/** Index of the next chunk to decompress. */
+	int32 NextChunkIndex;
+
+	/** Decompressed bytes of the current chunk. */
+	TArray<uint8> ChunkBuffer;
+
+	/** Read position inside ChunkBuffer. */
+	int32 ChunkPosition;
+
+	/** Raw offset of the first byte of ChunkBuffer. */
+	int64 ChunkStart;
+
+public:
+
+	/**
+	* public FYetiOsSaveStreamReader::FYetiOsSaveStreamReader
+	* Reads header and tables of a stream and applies the versions it was written with. Sets an error if the stream is not valid.
+	* @param InStreamBytes [const TArray<uint8>&] Stream to read. Must outlive this reader.
+	**/
+	FYetiOsSaveStreamReader(const TArray<uint8>& InStreamBytes);
+
+	/**
+	* public static FYetiOsSaveStreamReader::IsSaveStream
+	* Returns true if the given bytes start with a save stream header.
+	* @param InBytes [const TArray<uint8>&] Bytes to check.
+	* @return [bool] True if the bytes are a save stream. False for saves written by UGameplayStatics.
+	**/
+	static bool IsSaveStream(const TArray<uint8>& InBytes);
+
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual void Seek(int64 InPos) override;
+	virtual int64 Tell() override { return ChunkStart + ChunkPosition; }
+	virtual int64 TotalSize() override { return Header.RawSize; }
+	virtual FString GetArchiveName() const override { return TEXT("FYetiOsSaveStreamReader"); }
+
+	FORCEINLINE const FYetiOsSaveStreamHeader& GetHeader() const { return Header; }
+
+private:
+
+	/**
+	* private FYetiOsSaveStreamReader::Internal_LoadNextChunk
+	* Decompresses the next chunk into the chunk buffer.
+	* @return [bool] False if there are no chunks left or the chunk could not be decompressed.
+	**/
+	bool Internal_LoadNextChunk();
+};
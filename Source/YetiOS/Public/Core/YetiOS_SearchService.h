@@ -0,0 +1,254 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/YetiOS_FileContent.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "YetiOS_SearchService.generated.h"
+
+USTRUCT(BlueprintType)
+struct FYetiOsSearchQuery
+{
+	GENERATED_USTRUCT_BODY();
+
+	/** Wildcard pattern matched against file name with extension or directory name. Example *report*. Empty matches everything. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Search Query")
+	FString NamePattern;
+
+	/** Only files with this extension match. Empty or * matches any extension. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Search Query")
+	FString Extension;
+
+	/** Only files whose content contains this text match. Empty skips content matching. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Search Query")
+	FString ContentText;
+
+	/** If true, name and content matching is case sensitive. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Search Query")
+	uint8 bCaseSensitive : 1;
+
+	/** If true, hidden files and directories are searched as well. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Search Query")
+	uint8 bIncludeHidden : 1;
+
+	/** If true, directories can match Name Pattern as well. Ignored when searching content. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Search Query")
+	uint8 bIncludeDirectories : 1;
+
+	/** Search stops after this many results. 0 means no limit. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Search Query", meta = (ClampMin = "0", UIMin = "0"))
+	int32 MaxResults;
+
+	FYetiOsSearchQuery()
+	{
+		NamePattern = FString();
+		Extension = FString();
+		ContentText = FString();
+		bCaseSensitive = false;
+		bIncludeHidden = false;
+		bIncludeDirectories = false;
+		MaxResults = 0;
+	}
+};
+
+USTRUCT(BlueprintType)
+struct FYetiOsSearchResult
+{
+	GENERATED_USTRUCT_BODY();
+
+	/** Directory that matched or the directory of the file that matched. */
+	UPROPERTY(BlueprintReadOnly, Category = "Search Result")
+	class UYetiOS_DirectoryBase* Directory;
+
+	/** File that matched. Null if a directory matched. */
+	UPROPERTY(BlueprintReadOnly, Category = "Search Result")
+	class UYetiOS_FileBase* File;
+
+	/** Full path of the match at the time search started. */
+	UPROPERTY(BlueprintReadOnly, Category = "Search Result")
+	FString Path;
+
+	/** Byte offset of the first content match. INDEX_NONE if content was not searched. */
+	UPROPERTY(BlueprintReadOnly, Category = "Search Result")
+	int64 ContentOffset;
+
+	FYetiOsSearchResult()
+	{
+		Directory = nullptr;
+		File = nullptr;
+		Path = FString();
+		ContentOffset = INDEX_NONE;
+	}
+};
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnSearchResults, const int32, SearchID, const TArray<FYetiOsSearchResult>&, Results);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnSearchFinished, const int32, SearchID, const bool, bWasCancelled);
+
+/*************************************************************************
+* File Information:
+YetiOS_SearchService.h
+
+* Description:
+Find and grep service owned by the Operating System. A search first
+copies the directory tree into a snapshot on the game thread, a few
+directories per frame. The snapshot is then matched on worker threads
+with ParallelFor and matches are handed back to the game thread in
+batches every frame until the search finishes or is cancelled. Workers
+never touch UObjects, only copied names and shared content chunks.
+*************************************************************************/
+class YETIOS_API FYetiOsSearchService
+{
+private:
+
+	/** Copy of one file or directory taken on the game thread. */
+	struct FSearchEntry
+	{
+		TWeakObjectPtr<class UYetiOS_DirectoryBase> Directory;
+		TWeakObjectPtr<class UYetiOS_FileBase> File;
+
+		/** Name matched against Name Pattern. File names include extension. */
+		FString Name;
+
+		FString Extension;
+		FString Path;
+
+		/** Content chunks of the file. Shared with the file so no bytes are copied. */
+		TArray<FYetiOsContentChunkPtr> Chunks;
+	};
+
+	/** State shared between the game thread and the worker. */
+	struct FSearchState
+	{
+		FYetiOsSearchQuery Query;
+
+		/** UTF-8 bytes of Content Text. Lower case if search is not case sensitive. */
+		TArray<uint8> ContentNeedle;
+
+		TArray<FSearchEntry> Entries;
+
+		/** Set by game thread to stop the worker. */
+		FThreadSafeBool bCancelled;
+
+		/** Set by worker once all entries were matched. */
+		FThreadSafeBool bFinished;
+
+		/** Number of matches found so far. */
+		FThreadSafeCounter NumMatches;
+
+		/** Guards PendingMatches. */
+		FCriticalSection MatchesLock;
+
+		/** Entry index and content offset of matches not yet delivered to game thread. */
+		TArray<TPair<int32, int64>> PendingMatches;
+	};
+
+	typedef TSharedPtr<FSearchState, ESPMode::ThreadSafe> FSearchStatePtr;
+
+	struct FSearch
+	{
+		int32 SearchID;
+		FSearchStatePtr State;
+		FOnSearchResults OnResults;
+		FOnSearchFinished OnFinished;
+
+		/** Directories not yet copied into the snapshot. Empty once worker has started. */
+		TArray<TWeakObjectPtr<class UYetiOS_DirectoryBase>> PendingDirectories;
+
+		/** True once the snapshot is complete and the worker was started. */
+		uint8 bIsMatching : 1;
+	};
+
+	/** Searches that are being snapshotted or matched. */
+	TArray<FSearch> Searches;
+
+	/** ID given to the next search. */
+	int32 NextSearchID;
+
+public:
+
+	FYetiOsSearchService();
+	~FYetiOsSearchService();
+
+	/**
+	* public FYetiOsSearchService::StartSearch
+	* Starts a search under the given directory. Nothing is matched until the next Tick.
+	* @param InStartDirectory [class UYetiOS_DirectoryBase*] Directory to search recursively.
+	* @param InQuery [const FYetiOsSearchQuery&] What to look for.
+	* @param InOnResults [const FOnSearchResults&] Called on game thread with every batch of matches.
+	* @param InOnFinished [const FOnSearchFinished&] Called on game thread once search finished or was cancelled.
+	* @return [int32] Search ID or INDEX_NONE if start directory is null.
+	**/
+	int32 StartSearch(class UYetiOS_DirectoryBase* InStartDirectory, const FYetiOsSearchQuery& InQuery, const FOnSearchResults& InOnResults, const FOnSearchFinished& InOnFinished);
+
+	/**
+	* public FYetiOsSearchService::CancelSearch
+	* Stops the given search. On Finished is called right away with bWasCancelled set. Matches not yet delivered are dropped.
+	* @param InSearchID [const int32] Search ID returned by StartSearch.
+	* @return [bool] True if search was running.
+	**/
+	bool CancelSearch(const int32 InSearchID);
+
+	/**
+	* public FYetiOsSearchService::Tick
+	* Continues snapshots within the given budget, starts workers for completed snapshots and delivers pending matches.
+	* @param InBudgetSeconds [const double] Game thread time in seconds snapshots can use this frame.
+	**/
+	void Tick(const double InBudgetSeconds);
+
+	/**
+	* public FYetiOsSearchService::Reset
+	* Cancels all searches without calling any delegates.
+	**/
+	void Reset();
+
+	/**
+	* public FYetiOsSearchService::IsSearchRunning const
+	* Checks if the given search is still running.
+	* @param InSearchID [const int32] Search ID returned by StartSearch.
+	* @return [bool] True if running.
+	**/
+	bool IsSearchRunning(const int32 InSearchID) const;
+
+private:
+
+	/**
+	* private FYetiOsSearchService::Internal_Snapshot
+	* Copies pending directories of the given search into its snapshot until the deadline.
+	* @param InSearch [FSearch&] Search to continue.
+	* @param InDeadline [const double] Platform time in seconds to stop at.
+	* @return [bool] True if the snapshot is complete.
+	**/
+	bool Internal_Snapshot(FSearch& InSearch, const double InDeadline) const;
+
+	/**
+	* private FYetiOsSearchService::Internal_DeliverMatches
+	* Hands matches found by the worker to On Results.
+	* @param InSearch [FSearch&] Search to deliver matches of.
+	**/
+	void Internal_DeliverMatches(FSearch& InSearch) const;
+
+	/**
+	* private static FYetiOsSearchService::Internal_Match
+	* Matches all snapshot entries with ParallelFor. Runs on a worker thread.
+	* @param InState [const FSearchStatePtr&] Search to match.
+	**/
+	static void Internal_Match(const FSearchStatePtr& InState);
+
+	/**
+	* private static FYetiOsSearchService::Internal_FindInChunks
+	* Finds the needle in the given chunks. Matches that cross a chunk boundary are found as well.
+	* @param InChunks [const TArray<FYetiOsContentChunkPtr>&] Chunks to search.
+	* @param InNeedle [const TArray<uint8>&] Bytes to look for.
+	* @param bCaseSensitive [const bool] If false, ASCII letters are compared case insensitive. Needle must already be lower case.
+	* @param InCancelled [const FThreadSafeBool&] Stops searching once set.
+	* @return [int64] Byte offset of the first match or INDEX_NONE.
+	**/
+	static int64 Internal_FindInChunks(const TArray<FYetiOsContentChunkPtr>& InChunks, const TArray<uint8>& InNeedle, const bool bCaseSensitive, const FThreadSafeBool& InCancelled);
+
+public:
+
+	FORCEINLINE const int32 Num() const { return Searches.Num(); }
+	FORCEINLINE const bool HasSearches() const { return Searches.Num() > 0; }
+};
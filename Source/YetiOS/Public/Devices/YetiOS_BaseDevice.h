@@ -5,8 +5,12 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "YetiOS_Types.h"
+#include "Async/Future.h"
 #include "YetiOS_BaseDevice.generated.h"
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnYetiOsDeviceSaved, const bool, bWasSuccessful);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnYetiOsDeviceStartFinished, EYetiOsDeviceStartResult, StartResult, const FYetiOsError&, ErrorMessage);
+
 /*************************************************************************
 * File Information:
 YetiOS_BaseDevice.h
@@ -21,8 +25,15 @@ class YETIOS_API UYetiOS_BaseDevice : public UObject
 
 	friend class UYetiOS_Core;
 	friend class UYetiOS_BaseHardware;
+	friend class UYetiOS_FileContent;
+	friend class UYetiOS_DevicePersistenceSubsystem;
 
 	FTimerHandle TimerHandle_Restart;
+	FTimerHandle TimerHandle_Autosave;
+	FTimerHandle TimerHandle_Boot;
+
+	/** Result of the save game that is being written. */
+	TFuture<bool> SaveGameFuture;
 
 private:
 
@@ -50,6 +61,22 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS Base Device", AdvancedDisplay = "true")
 	TSubclassOf<class UYetiOS_SaveGame> SaveGameClass;
 
+	/** Seconds between automatic saves while the device is running. Saves are written on a worker thread. 0 disables autosave. */
+	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS Base Device", meta = (ClampMin = "0", UIMin = "0"))
+	float AutosaveIntervalInSeconds;
+
+	/** Milliseconds per frame StartDeviceAsync may spend creating directories, files and programs. */
+	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS Base Device", AdvancedDisplay = "true", meta = (ClampMin = "1", UIMin = "1"))
+	float BootFrameBudgetInMs;
+
+	/** Kilobytes the change journal may grow to before it is compacted into the save game. 0 only compacts on regular saves. */
+	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS Base Device", AdvancedDisplay = "true", meta = (EditCondition = "bEnableChangeJournal", ClampMin = "0", UIMin = "0"))
+	int32 ChangeJournalCompactionThresholdInKB;
+
+	/** If true, changes to files, directories, programs and users are appended to a journal as they happen and replayed on top of the save game when loading. */
+	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS Base Device", AdvancedDisplay = "true")
+	uint8 bEnableChangeJournal : 1;
+
 	/** If true, then skip installation of operating system simulating the effect that OS is pre-installed */
 	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS Base Device")
 	uint8 bOperatingSystemIsPreInstalled : 1;
@@ -62,6 +89,19 @@ private:
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	uint8 bOperatingSystemInstalled : 1;
 
+	/** True while a save game is being written on a worker thread. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	uint8 bIsSaving : 1;
+
+	/** True if SaveDevice was called while a save was being written. Device saves again once the current save finishes. */
+	uint8 bSaveRequestedWhileSaving : 1;
+
+	/** True if the device should be destroyed once the current save finishes. */
+	uint8 bDestroyAfterSave : 1;
+
+	/** True if the device should be destroyed and restarted once the current save finishes. */
+	uint8 bRestartAfterSave : 1;
+
 	/** Motherboard. */
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	class UYetiOS_Motherboard* DeviceMotherboard;
@@ -87,8 +127,30 @@ private:
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	TArray<class UYetiOS_BaseHardware*> InstalledHardwares;
 
+	/** Current stage of StartDeviceAsync. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	EYetiOsDeviceBootStage BootStage;
+
+	/** Save game that is being loaded by StartDeviceAsync. Kept here so it stays alive between frames. */
+	UPROPERTY(Transient)
+	class UYetiOS_SaveGame* BootSaveGame;
+
+	/** Error message of StartDeviceAsync. */
+	FYetiOsError BootErrorMessage;
+
+	/** Identifiers of programs that were running when this device was detached from its level. Started again when attached. */
+	TArray<FName> DetachedRunningPrograms;
+
 public:
 
+	/** Called once a save game started by SaveDevice was written. */
+	UPROPERTY(BlueprintAssignable, Category = "Yeti OS Base Device")
+	FOnYetiOsDeviceSaved OnDeviceSaved;
+
+	/** Called once StartDeviceAsync finished, either successfully or not. */
+	UPROPERTY(BlueprintAssignable, Category = "Yeti OS Base Device")
+	FOnYetiOsDeviceStartFinished OnDeviceStartFinished;
+
 	UYetiOS_BaseDevice();
 
 	/**
@@ -128,6 +190,24 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Yeti OS Base Device")
 	virtual EYetiOsDeviceStartResult StartDevice(FYetiOsError& OutErrorMessage);
 
+	/**
+	* public UYetiOS_BaseDevice::StartDeviceAsync
+	* Starts this device without freezing the game. Save game is read on a worker thread and the operating system is built over several frames.
+	* Progress is reported to the device widget. @See UYetiOS_DeviceWidget::K2_OnBootProgress
+	* @See: OnDeviceStartFinished
+	* @return [bool] True if the boot was started. False if this device is already booting.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS Base Device")
+	bool StartDeviceAsync();
+
+	/**
+	* public UYetiOS_BaseDevice::GetBootProgress const
+	* Returns overall progress of StartDeviceAsync.
+	* @return [float] Progress between 0 and 1. 0 if device is not booting.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS Base Device")
+	float GetBootProgress() const;
+
 	/**
 	* public UYetiOS_BaseDevice::ChangeOnScreenWidget
 	* Changes the on screen widget.
@@ -246,14 +326,101 @@ public:
 	**/
 	virtual void DestroyYetiDeviceAndRestart();
 
+	/**
+	* public UYetiOS_BaseDevice::SaveDevice
+	* Saves this device without blocking the game thread. Only capturing the data happens on the game thread, serialization and disk write run on a worker thread.
+	* If a save is already being written, another save starts once it finishes.
+	* @See: OnDeviceSaved
+	* @return [bool] True if a save was started or queued.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS Base Device")
+	bool SaveDevice();
+
+	/**
+	* public UYetiOS_BaseDevice::WaitForSave
+	* Blocks until the save game that is being written finishes. Only use this when the device cannot be kept alive, like on end play.
+	**/
+	void WaitForSave();
+
 private:
 
+	/**
+	* private UYetiOS_BaseDevice::Internal_OnSaveComplete
+	* Called on game thread once the save game was written. Runs destroy or restart that was waiting for the save.
+	* @param bWasSuccessful [const bool] True if the save game was written.
+	**/
+	void Internal_OnSaveComplete(const bool bWasSuccessful);
+
+	/**
+	* private UYetiOS_BaseDevice::Internal_Autosave
+	* Called by autosave timer. Saves the device if it is running and not already saving.
+	**/
+	void Internal_Autosave();
+
+	/**
+	* private UYetiOS_BaseDevice::Internal_BootTick
+	* Runs the current boot stage of StartDeviceAsync and schedules the next frame.
+	**/
+	void Internal_BootTick();
+
+	/**
+	* private UYetiOS_BaseDevice::Internal_OnBootSaveGameLoaded
+	* Called on game thread once the save game was read by StartDeviceAsync.
+	* @param InLoadedGame [class UYetiOS_SaveGame*] Loaded save game. nullptr if there is no save game.
+	**/
+	void Internal_OnBootSaveGameLoaded(class UYetiOS_SaveGame* InLoadedGame);
+
+	/**
+	* private UYetiOS_BaseDevice::Internal_FinishBoot
+	* Ends StartDeviceAsync and notifies listeners.
+	* @param InResult [const EYetiOsDeviceStartResult] Start result.
+	**/
+	void Internal_FinishBoot(const EYetiOsDeviceStartResult InResult);
+
+	/**
+	* private UYetiOS_BaseDevice::Internal_ReportBootProgress
+	* Sends current boot stage and progress to the device widget.
+	**/
+	void Internal_ReportBootProgress();
+
+	/**
+	* private UYetiOS_BaseDevice::Internal_CreatePhysicalDirectories
+	* Creates physical save directories of this device.
+	**/
+	void Internal_CreatePhysicalDirectories();
+
+	/**
+	* private UYetiOS_BaseDevice::Internal_ClearFileContentPath
+	* Deletes file content this device spilled in the last session. Called before the save game is loaded since loaded content can spill right away.
+	**/
+	void Internal_ClearFileContentPath();
+
 	/**
 	* private UYetiOS_BaseDevice::Internal_DestroyDevice
 	* Destroys this device.
 	**/
 	void Internal_DestroyDevice();
 
+	/**
+	* private UYetiOS_BaseDevice::Internal_DetachDevice
+	* Releases widgets and timers of this device and its OS and moves it out of its device manager so it survives a level transition.
+	* @param InNewOuter [UObject*] Object that keeps this device while no level owns it.
+	**/
+	void Internal_DetachDevice(UObject* InNewOuter);
+
+	/**
+	* private UYetiOS_BaseDevice::Internal_AttachDevice
+	* Moves a detached device into the given device manager and shows it in its state before it was detached.
+	* @param InDeviceManager [class AYetiOS_DeviceManagerActor*] Device manager of the new level.
+	**/
+	void Internal_AttachDevice(class AYetiOS_DeviceManagerActor* InDeviceManager);
+
+	/**
+	* private UYetiOS_BaseDevice::Internal_DestroyDetachedDevice
+	* Destroys a detached device that was never attached again. Journal and program settings are written, so the next load has every change.
+	**/
+	void Internal_DestroyDetachedDevice();
+
 	/** [EXPERIMENTAL]
 	* private UYetiOS_BaseDevice::Internal_InstallHardware
 	* Installs the given hardware to this device.
@@ -280,6 +447,7 @@ private:
 	static const FString Internal_GetLoginWallpapersPath(const UYetiOS_BaseDevice* InDevice);
 	static const FString Internal_GetDesktopWallpapersPath(const UYetiOS_BaseDevice* InDevice);
 	static const FString Internal_UserIconsPath(const UYetiOS_BaseDevice* InDevice);
+	static const FString Internal_GetFileContentPath(const UYetiOS_BaseDevice* InDevice);
 
 	/**
 	* private static UYetiOS_BaseDevice::Internal_GetFiles
@@ -307,6 +475,24 @@ protected:
 	**/
 	virtual void LoadSavedData(const class UYetiOS_SaveGame* InLoadGameInstance);
 
+	/**
+	* virtual protected UYetiOS_BaseDevice::OnFinishStartingDevice
+	* Called after the device started successfully with either StartDevice or StartDeviceAsync.
+	**/
+	virtual void OnFinishStartingDevice() {}
+
+	/**
+	* virtual protected UYetiOS_BaseDevice::OnDeviceDetached
+	* Called before this device is detached from its level. World timers of this device are cleared right after this.
+	**/
+	virtual void OnDeviceDetached() {}
+
+	/**
+	* virtual protected UYetiOS_BaseDevice::OnDeviceAttached
+	* Called after this device was attached to the device manager of a new level and its OS is showing again.
+	**/
+	virtual void OnDeviceAttached() {}
+
 	/**
 	* virtual protected UYetiOS_BaseDevice::GetHardDisk const
 	* Returns the HDD of this device.
@@ -404,7 +590,13 @@ public:
 	FORCEINLINE const bool IsOperatingSystemPreInstalled() const { return bOperatingSystemIsPreInstalled; }
 	FORCEINLINE const bool IsOperatingSystemInstalled() const { return bOperatingSystemInstalled; }
 	FORCEINLINE const bool IsInBsodState() const { return CurrentDeviceState == EYetiOsDeviceState::STATE_BSOD; }
+	FORCEINLINE const bool IsRunning() const { return CurrentDeviceState == EYetiOsDeviceState::STATE_Running; }
 	FORCEINLINE const bool CanGarbageCollect() const { return bForceGarbageCollectionWhenDeviceIsDestroyed; }
+	FORCEINLINE const bool IsSaving() const { return bIsSaving; }
+	FORCEINLINE const bool IsChangeJournalEnabled() const { return bEnableChangeJournal; }
+	FORCEINLINE const int32 GetChangeJournalCompactionThresholdInKB() const { return ChangeJournalCompactionThresholdInKB; }
+	FORCEINLINE const bool IsBooting() const { return BootStage != EYetiOsDeviceBootStage::BOOT_None; }
+	FORCEINLINE const EYetiOsDeviceBootStage GetBootStage() const { return BootStage; }
 	FORCEINLINE TSubclassOf<class UYetiOS_DeviceWidget> GetDeviceWidgetClass() const { return DeviceWidgetClass; }
 	FORCEINLINE const FYetiOS_DeviceClasses& GetDeviceClasses() const { return DeviceClasses; }
 	FORCEINLINE TSubclassOf<class UYetiOS_SaveGame> GetSaveGameClass() const { return SaveGameClass; }
@@ -21,6 +21,8 @@ class YETIOS_API AYetiOS_DeviceManagerActor : public AActor
 {
 	GENERATED_BODY()
 
+	friend class UYetiOS_DeviceRegistrySubsystem;
+
 	FTimerHandle TimerHandle_ClockTick;
 	
 private:
@@ -44,6 +46,14 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Yeti OS Device Manager Actor", AdvancedDisplay)
 	uint8 bCanSaveGame : 1;
 
+	/** Identifies the save slot of this device. If None, it is derived from the level and actor name, which only stays the same for placed actors. Set this for spawned device managers. */
+	UPROPERTY(EditAnywhere, Category = "Yeti OS Device Manager Actor", AdvancedDisplay)
+	FName DeviceSaveID;
+
+	/** If true, a running device is kept in memory on level transition and the device manager with the same Device Save ID in the next level continues it without booting. Set the same Device Save ID on the managers of both levels. @See UYetiOS_DevicePersistenceSubsystem */
+	UPROPERTY(EditAnywhere, Category = "Yeti OS Device Manager Actor", AdvancedDisplay)
+	uint8 bKeepDeviceAcrossLevels : 1;
+
 	/** Device class to create. */	
 	UPROPERTY(EditAnywhere, Category = "Yeti OS Device Manager Actor")
 	TSubclassOf<class UYetiOS_BaseDevice> DeviceClass;	
@@ -54,7 +64,7 @@ private:
 	
 public:	
 
-	/** Delegate that ticks every second until EndPlay is called. */
+	/** Delegate that ticks every second until EndPlay is called. Device managers of a world share one clock timer. @See UYetiOS_DeviceRegistrySubsystem */
 	UPROPERTY(BlueprintAssignable, Category = "Yeti OS Device Manager|Delegates")
 	FOnClockTimerTick OnClockTick;
 	
@@ -114,6 +124,14 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Yeti Device Manager")	
 	class UYetiOS_BaseDevice* GetDevice() const { return CurrentDevice; }
 
+	/**
+	* public AYetiOS_DeviceManagerActor::GetDeviceSaveID const
+	* Returns the ID the device of this manager is saved with. Each ID is saved in its own slot.
+	* @return [FString] Device save ID if set, otherwise level name and actor name.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti Device Manager")
+	FString GetDeviceSaveID() const;
+
 protected:
 		
 	/**
@@ -144,7 +162,7 @@ private:
 
 	/**
 	* private AYetiOS_DeviceManagerActor::Internal_OnClockTimerTick
-	* Automatically called every second from BeginPlay until EndPlay.
+	* Automatically called every second from BeginPlay until EndPlay, by the device registry of the world if there is one.
 	**/
 	UFUNCTION()	
 	void Internal_OnClockTimerTick();
@@ -158,4 +176,5 @@ public:
 	**/
 	FORCEINLINE const bool AddWidgetsToScreen() const { return bAddWidgetsToScreen; }
 	FORCEINLINE const bool CanSaveGame() const { return bCanSaveGame; }
+	FORCEINLINE TSubclassOf<class UYetiOS_BaseDevice> GetDeviceClass() const { return DeviceClass; }
 };
@@ -0,0 +1,96 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "YetiOS_DevicePersistenceSubsystem.generated.h"
+
+/*************************************************************************
+* File Information:
+YetiOS_DevicePersistenceSubsystem.h
+
+* Description:
+Keeps running devices in memory while the game travels to another level.
+Device managers with Keep Device Across Levels hand their device over on
+a level transition instead of destroying it. The device manager with the
+same save ID in the next level takes it back, so the device continues
+without loading its save game or booting again. Widgets are created again
+in the new level and programs that were running are started again.
+Devices nobody takes back stay parked until DiscardParkedDevice is called
+or the game instance shuts down.
+Save manifests are kept here as well, so each one is read from disk once
+per game instance and released with it.
+*************************************************************************/
+UCLASS()
+class YETIOS_API UYetiOS_DevicePersistenceSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+private:
+
+	/** Detached devices by save ID of the device manager that parked them. @See AYetiOS_DeviceManagerActor::GetDeviceSaveID */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	TMap<FString, class UYetiOS_BaseDevice*> ParkedDevices;
+
+	/** Save manifests loaded by this game instance, by manifest slot name and user index. @See UYetiOS_SaveManifest */
+	UPROPERTY(Transient)
+	TMap<FString, class UYetiOS_SaveManifest*> LoadedManifests;
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/**
+	* public UYetiOS_DevicePersistenceSubsystem::ParkDevice
+	* Detaches the device of the given manager from its level and keeps it until a manager with the same save ID takes it back.
+	* Only running devices that are not booting can be parked.
+	* @param InDeviceManager [class AYetiOS_DeviceManagerActor*] Device manager that is ending play.
+	* @return [bool] True if the device was parked. If false, the manager destroys the device as usual.
+	**/
+	bool ParkDevice(class AYetiOS_DeviceManagerActor* InDeviceManager);
+
+	/**
+	* public UYetiOS_DevicePersistenceSubsystem::ClaimDevice
+	* Attaches the device parked with the save ID of the given manager to that manager.
+	* @param InDeviceManager [class AYetiOS_DeviceManagerActor*] Device manager that begins play.
+	* @return [class UYetiOS_BaseDevice*] Attached device or nullptr if no device was parked with that save ID.
+	**/
+	class UYetiOS_BaseDevice* ClaimDevice(class AYetiOS_DeviceManagerActor* InDeviceManager);
+
+	/**
+	* public UYetiOS_DevicePersistenceSubsystem::IsDeviceParked const
+	* Checks if a device is parked with the given save ID.
+	* @param InDeviceSaveID [const FString&] Save ID of a device manager.
+	* @return [bool] True if a device is waiting to be taken back.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS Device Persistence")
+	bool IsDeviceParked(const FString& InDeviceSaveID) const { return ParkedDevices.Contains(InDeviceSaveID); }
+
+	/**
+	* public UYetiOS_DevicePersistenceSubsystem::DiscardParkedDevice
+	* Destroys the device parked with the given save ID. Its changes since the last save stay in the change journal.
+	* @param InDeviceSaveID [const FString&] Save ID of a device manager.
+	* @return [bool] True if a device was parked with that save ID.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS Device Persistence")
+	bool DiscardParkedDevice(const FString& InDeviceSaveID);
+
+	/**
+	* public UYetiOS_DevicePersistenceSubsystem::DiscardAllParkedDevices
+	* Destroys every parked device.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS Device Persistence")
+	void DiscardAllParkedDevices();
+
+	/**
+	* public UYetiOS_DevicePersistenceSubsystem::GetSaveManifest
+	* Returns the save manifest of the given save slot. Only the first call for a slot reads it from disk, later calls return the same object.
+	* @param InBaseSlotName [const FString&] Slot name of the save game class.
+	* @param InUserIndex [const int32] User index of the save game class.
+	* @return [class UYetiOS_SaveManifest*] Manifest.
+	**/
+	class UYetiOS_SaveManifest* GetSaveManifest(const FString& InBaseSlotName, const int32 InUserIndex);
+
+	FORCEINLINE const int32 GetNumParkedDevices() const { return ParkedDevices.Num(); }
+};
@@ -0,0 +1,161 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "YetiOS_Types.h"
+#include "YetiOS_DeviceRegistrySubsystem.generated.h"
+
+/*************************************************************************
+* File Information:
+YetiOS_DeviceRegistrySubsystem.h
+
+* Description:
+Registry of every device manager in a world. Device managers register on
+BeginPlay and unregister on EndPlay, so devices can be found by save ID
+or device name and listed by device class without scanning actors.
+The registry also drives the clock tick of all device managers from a
+single timer and runs save, power off and stats over every device.
+*************************************************************************/
+UCLASS()
+class YETIOS_API UYetiOS_DeviceRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	FTimerHandle TimerHandle_ClockTick;
+
+private:
+
+	/** Every registered device manager. */
+	UPROPERTY(VisibleInstanceOnly, Category = Debug)
+	TArray<class AYetiOS_DeviceManagerActor*> DeviceManagers;
+
+	/** Index of each device manager in DeviceManagers. */
+	TMap<const class AYetiOS_DeviceManagerActor*, int32> DeviceManagerIndices;
+
+	/** Device managers by device save ID. @See AYetiOS_DeviceManagerActor::GetDeviceSaveID */
+	TMap<FString, class AYetiOS_DeviceManagerActor*> DeviceManagersBySaveID;
+
+	/** Device managers by name of the device class they create. */
+	TMap<FName, TArray<class AYetiOS_DeviceManagerActor*>> DeviceManagersByDeviceName;
+
+	/** Device managers by the device class they create. */
+	TMap<const UClass*, TArray<class AYetiOS_DeviceManagerActor*>> DeviceManagersByDeviceClass;
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/**
+	* public UYetiOS_DeviceRegistrySubsystem::RegisterDeviceManager
+	* Adds the given device manager to the registry and to the shared clock tick.
+	* @param InDeviceManager [class AYetiOS_DeviceManagerActor*] Device manager that begins play.
+	**/
+	void RegisterDeviceManager(class AYetiOS_DeviceManagerActor* InDeviceManager);
+
+	/**
+	* public UYetiOS_DeviceRegistrySubsystem::UnregisterDeviceManager
+	* Removes the given device manager from the registry.
+	* @param InDeviceManager [class AYetiOS_DeviceManagerActor*] Device manager that ends play.
+	**/
+	void UnregisterDeviceManager(class AYetiOS_DeviceManagerActor* InDeviceManager);
+
+	/**
+	* public UYetiOS_DeviceRegistrySubsystem::FindDeviceManager const
+	* Finds the device manager with the given save ID.
+	* @param InDeviceSaveID [const FString&] Save ID of the device manager.
+	* @return [class AYetiOS_DeviceManagerActor*] Device manager or nullptr if none is registered with that ID.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS Device Registry")
+	class AYetiOS_DeviceManagerActor* FindDeviceManager(const FString& InDeviceSaveID) const;
+
+	/**
+	* public UYetiOS_DeviceRegistrySubsystem::FindDevice const
+	* Finds the device of the device manager with the given save ID.
+	* @param InDeviceSaveID [const FString&] Save ID of the device manager.
+	* @return [class UYetiOS_BaseDevice*] Device or nullptr if there is no such manager or it has no device right now.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS Device Registry")
+	class UYetiOS_BaseDevice* FindDevice(const FString& InDeviceSaveID) const;
+
+	/**
+	* public UYetiOS_DeviceRegistrySubsystem::FindDevicesByName const
+	* Finds all devices with the given device name. Case is ignored.
+	* @param InDeviceName [const FText&] Device name. @See UYetiOS_BaseDevice::GetDeviceName
+	* @return [TArray<class UYetiOS_BaseDevice*>] Devices that were created with that name.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS Device Registry")
+	TArray<class UYetiOS_BaseDevice*> FindDevicesByName(const FText& InDeviceName) const;
+
+	/**
+	* public UYetiOS_DeviceRegistrySubsystem::GetDeviceManagersOfClass const
+	* Returns device managers that create devices of the given class.
+	* @param InDeviceClass [TSubclassOf<class UYetiOS_BaseDevice>] Device class.
+	* @param bIncludeChildClasses [const bool] If true, managers of child classes are included.
+	* @return [TArray<class AYetiOS_DeviceManagerActor*>] Device managers of that class.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS Device Registry")
+	TArray<class AYetiOS_DeviceManagerActor*> GetDeviceManagersOfClass(TSubclassOf<class UYetiOS_BaseDevice> InDeviceClass, const bool bIncludeChildClasses = true) const;
+
+	/**
+	* public UYetiOS_DeviceRegistrySubsystem::GetDeviceClasses const
+	* Returns every device class that at least one registered device manager creates.
+	* @return [TArray<TSubclassOf<class UYetiOS_BaseDevice>>] Device classes.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS Device Registry")
+	TArray<TSubclassOf<class UYetiOS_BaseDevice>> GetDeviceClasses() const;
+
+	/**
+	* public UYetiOS_DeviceRegistrySubsystem::GetAllDeviceManagers const
+	* Returns every registered device manager.
+	* @return [TArray<class AYetiOS_DeviceManagerActor*>] Device managers.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS Device Registry")
+	TArray<class AYetiOS_DeviceManagerActor*> GetAllDeviceManagers() const { return DeviceManagers; }
+
+	/**
+	* public UYetiOS_DeviceRegistrySubsystem::SaveAllDevices
+	* Starts a save of every running device whose manager supports save game.
+	* @return [int32] Number of devices that started or queued a save.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS Device Registry")
+	int32 SaveAllDevices();
+
+	/**
+	* public UYetiOS_DeviceRegistrySubsystem::PowerOffAllDevices
+	* Shuts down every running device.
+	* @return [int32] Number of devices that began shutting down.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Yeti OS Device Registry")
+	int32 PowerOffAllDevices();
+
+	/**
+	* public UYetiOS_DeviceRegistrySubsystem::GetDeviceStats const
+	* Counts devices by state and running programs across every registered device manager.
+	* @return [FYetiOsDeviceRegistryStats] Stats.
+	**/
+	UFUNCTION(BlueprintPure, Category = "Yeti OS Device Registry")
+	FYetiOsDeviceRegistryStats GetDeviceStats() const;
+
+private:
+
+	/**
+	* private UYetiOS_DeviceRegistrySubsystem::Internal_OnClockTimerTick
+	* Ticks the clock of every registered device manager. Runs every second while any device manager is registered.
+	**/
+	void Internal_OnClockTimerTick();
+
+	/**
+	* private static UYetiOS_DeviceRegistrySubsystem::Internal_GetDeviceNameKey
+	* Returns the key the given device manager is stored with in DeviceManagersByDeviceName.
+	* @param InDeviceManager [const class AYetiOS_DeviceManagerActor*] Device manager.
+	* @return [FName] Name of the device class default object. None if the manager has no device class.
+	**/
+	static FName Internal_GetDeviceNameKey(const class AYetiOS_DeviceManagerActor* InDeviceManager);
+
+public:
+
+	FORCEINLINE const TArray<class AYetiOS_DeviceManagerActor*>& GetDeviceManagers() const { return DeviceManagers; }
+	FORCEINLINE const int32 GetNumDeviceManagers() const { return DeviceManagers.Num(); }
+};
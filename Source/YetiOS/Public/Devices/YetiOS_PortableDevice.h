@@ -39,14 +39,15 @@ private:
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	uint8 bLowBatteryWarned : 1;
 
+	/** True if the device was charging when it was detached from its level. */
+	uint8 bWasChargingWhenDetached : 1;
+
 public:
 
 	UYetiOS_PortableDevice();
 
 	virtual const bool IsPortableDevice() const override final { return true; }
 
-	virtual EYetiOsDeviceStartResult StartDevice(FYetiOsError& OutErrorMessage) override final;
-
 	/**
 	* public UYetiOS_PortableDevice::BeginBatteryCharge
 	* Start charging timer.
@@ -112,6 +113,24 @@ protected:
 	**/
 	virtual void LoadSavedData(const class UYetiOS_SaveGame* InLoadGameInstance) override final;
 
+	/**
+	* virtual protected UYetiOS_PortableDevice::OnFinishStartingDevice
+	* Starts consuming battery once the device started.
+	**/
+	virtual void OnFinishStartingDevice() override final;
+
+	/**
+	* virtual protected UYetiOS_PortableDevice::OnDeviceDetached
+	* Remembers if the device was charging. Battery timers are cleared with the other timers of the device.
+	**/
+	virtual void OnDeviceDetached() override final;
+
+	/**
+	* virtual protected UYetiOS_PortableDevice::OnDeviceAttached
+	* Continues charging or consuming battery where it stopped when the device was detached.
+	**/
+	virtual void OnDeviceAttached() override final;
+
 protected:
 
 	/**
@@ -63,6 +63,21 @@ public:
 	**/
 	bool ConsumeSpace(const float& SpaceInMB);
 
+	/**
+	* public UYetiOS_HardDisk::ConsumeBytes
+	* Tries to consume the given number of bytes from this HDD.
+	* @param InBytes [const int64&] Bytes to consume.
+	* @return [bool] True if there was enough space to reduce.
+	**/
+	bool ConsumeBytes(const int64& InBytes);
+
+	/**
+	* public UYetiOS_HardDisk::ReleaseBytes
+	* Gives the given number of bytes back to this HDD. Remaining space never goes above capacity.
+	* @param InBytes [const int64&] Bytes to release.
+	**/
+	void ReleaseBytes(const int64& InBytes);
+
 private:
 
 	void Internal_UpdateRemainingSpace(const int64& InSize);
@@ -24,11 +24,11 @@ private:
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	FName ParentProgramIdentifier;
 
-	/** Auto generated save slot name. */
+	/** Slot settings of the owning device are written to. @See GetStoreSlotName */
 	UPROPERTY(VisibleInstanceOnly, Category = Debug)
 	FString SaveSlotName;
 
-	/** For some platforms, master user index to identify the user doing the saving */
+	/** For some platforms, master user index to identify the user doing the saving. Settings store uses the value of this base class. */
 	UPROPERTY(EditDefaultsOnly, Category = "Program Settings")
 	int32 UserIndex;
 
@@ -90,14 +90,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Yeti Global")	
 	static bool SaveProgramSettings(class UYetiOS_BaseProgram* InProgram);
 
+	/**
+	* public static UYetiOS_ProgramSettings::GetStoreSlotName
+	* Returns the slot settings of all programs of the given device are written to.
+	* @param InDevice [const class UYetiOS_BaseDevice*] Device to get the slot for.
+	* @return [FString] Slot name in format ProgramSettings_DeviceSaveID. Device name is used if the device has no device manager.
+	**/
+	static FString GetStoreSlotName(const class UYetiOS_BaseDevice* InDevice);
+
+	/**
+	* public static UYetiOS_ProgramSettings::GetStoreUserIndex
+	* Returns the user index settings stores are written with.
+	* @return [int32] User index of this class.
+	**/
+	static int32 GetStoreUserIndex();
+
 private:
 	/**
 	* private UYetiOS_ProgramSettings::Internal_SaveSettings
 	* DO NOT CALL THIS DIRECTLY. Use SaveProgramSettings instead.
-	* Save settings to file. Make sure to implement Pre Save event. Calling this function will first call Can Save (K2_CanSave in C++) to make sure settings can be saved.
+	* Save settings to the settings store of the device. Make sure to implement Pre Save event. Calling this function will first call Can Save (K2_CanSave in C++) to make sure settings can be saved.
 	* @See Can Save - Native implementation checks if the owning program is allowed to save and for most cases it should be fine but you can override Can Save event to have any custom implementation.
 	* @See Pre Save - An event that you have to implement in Blueprint to collect whatever data you want to save.
-	* @return [bool] Returns if UGameplayStatics::SaveGameToSlot call was success or not.
+	* @return [bool] Returns if UGameplayStatics::SaveGameToMemory call was success or not. Settings are written to disk later on a worker thread.
 	**/
 	bool Internal_SaveSettings();
 
@@ -145,9 +160,10 @@ protected:
 private:
 
 	/**
-	* private UYetiOS_ProgramSettings::Internal_GetSaveSlotName const
-	* Auto generates the save slot name in format ProgramIdentifier_OwningDeviceName.
-	* @return [const FString] 
+	* private static UYetiOS_ProgramSettings::Internal_LoadLegacySettings
+	* Loads settings older versions saved in a slot per program, in format ProgramIdentifier_OwningDeviceName.
+	* @param InParentProgram [const class UYetiOS_BaseProgram*] Program to load settings for.
+	* @return [UYetiOS_ProgramSettings*] Loaded settings or nullptr if there are none.
 	**/
-	inline const FString Internal_GetSaveSlotName() const;
+	static UYetiOS_ProgramSettings* Internal_LoadLegacySettings(const class UYetiOS_BaseProgram* InParentProgram);
 };
@@ -0,0 +1,104 @@
+// Copyright 2019 YetiTech Studios, Pvt Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+/*************************************************************************
+* File Information:
+YetiOS_ProgramSettingsStore.h
+
+* Description:
+Settings of every program of a device, kept in memory. The store slot is
+read on a worker thread when the operating system is created. Programs
+read and write settings only in memory. Changes are written back as one
+batch on a worker thread. Only one write runs at a time, and changes made
+during a write go into the next one.
+*************************************************************************/
+struct YETIOS_API FYetiOsProgramSettingsStore
+{
+private:
+
+	/** Slot all settings of the device are written to. Empty while closed. */
+	FString SlotName;
+
+	int32 UserIndex;
+
+	/** Saved settings object of each program identifier. @See UGameplayStatics::SaveGameToMemory */
+	TMap<FName, TArray<uint8>> Entries;
+
+	/** Bytes of the store slot while they are still being read. */
+	TFuture<TArray<uint8>> PendingRead;
+
+	/** Write whose result was not taken yet. */
+	TFuture<bool> PendingWrite;
+
+	/** True if entries changed since they were last written. */
+	uint8 bIsDirty : 1;
+
+	/** True once the store slot exists on disk. Until then settings may still be in the per program slots of older versions. */
+	uint8 bHasStoreSlot : 1;
+
+public:
+
+	FYetiOsProgramSettingsStore();
+
+	/**
+	* public FYetiOsProgramSettingsStore::Open
+	* Starts reading the given slot on a worker thread. Returns right away.
+	* @param InSlotName [const FString&] Slot of the store.
+	* @param InUserIndex [const int32] User index of the slot.
+	**/
+	void Open(const FString& InSlotName, const int32 InUserIndex);
+
+	/**
+	* public FYetiOsProgramSettingsStore::Close
+	* Writes pending changes and waits until they are on disk. Only called when the operating system is destroyed.
+	**/
+	void Close();
+
+	/**
+	* public FYetiOsProgramSettingsStore::Find
+	* Returns saved settings of the given program. Waits for the boot read if it has not finished yet.
+	* @param InProgramIdentifier [const FName&] Identifier of the program.
+	* @return [const TArray<uint8>*] Saved settings object or nullptr if the program has none.
+	**/
+	const TArray<uint8>* Find(const FName& InProgramIdentifier);
+
+	/**
+	* public FYetiOsProgramSettingsStore::Set
+	* Replaces saved settings of the given program in memory and marks the store dirty.
+	* @param InProgramIdentifier [const FName&] Identifier of the program.
+	* @param InSettingsData [TArray<uint8>&&] Saved settings object.
+	**/
+	void Set(const FName& InProgramIdentifier, TArray<uint8>&& InSettingsData);
+
+	/**
+	* public FYetiOsProgramSettingsStore::Flush
+	* Starts writing all settings on a worker thread if they changed. Settings of a failed write are marked dirty again and written with the next flush.
+	* @return [bool] True once all changes are on disk. False while a write is running or was just started. Call again later.
+	**/
+	bool Flush();
+
+private:
+
+	/**
+	* private FYetiOsProgramSettingsStore::Internal_FinishRead
+	* Takes entries from the boot read. Blocks only if the read is still running.
+	**/
+	void Internal_FinishRead();
+
+	/**
+	* private FYetiOsProgramSettingsStore::Internal_FinishWrite
+	* Takes the result of the last write if it has finished. Never blocks.
+	**/
+	void Internal_FinishWrite();
+
+public:
+
+	FORCEINLINE const bool IsOpen() const { return SlotName.IsEmpty() == false; }
+	FORCEINLINE const bool IsDirty() const { return bIsDirty; }
+	FORCEINLINE const bool IsWriting() const { return PendingWrite.IsValid(); }
+	FORCEINLINE const bool HasStoreSlot() const { return bHasStoreSlot; }
+};
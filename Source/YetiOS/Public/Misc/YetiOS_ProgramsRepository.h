@@ -32,23 +32,81 @@ private:
 	/** Installers for the store */
 	UPROPERTY(EditDefaultsOnly, Category = "Yeti OS Programs Repository")
 	TSet<TSubclassOf<class UYetiOS_AppInstaller>> StoreInstallers;
+
+	/** Program classes keyed by their identifier. Built from class default objects. */
+	mutable TMap<FName, TSubclassOf<class UYetiOS_BaseProgram>> ProgramsByIdentifier;
+
+	/** Program classes that should be installed with the Operating System. */
+	mutable TSet<const UClass*> InstallWithOsClasses;
+
+	/** Valid program classes in repository order. */
+	mutable TArray<TSubclassOf<class UYetiOS_BaseProgram>> ProgramClasses;
+
+	/** Valid program classes that should be installed with the Operating System in repository order. */
+	mutable TArray<TSubclassOf<class UYetiOS_BaseProgram>> StartupProgramClasses;
+
+	/** True if the lookup index is up to date with Programs. */
+	mutable uint8 bIndexBuilt : 1;
 	
+public:
+
+	UYetiOS_ProgramsRepository();
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/**
+	* public UYetiOS_ProgramsRepository::FindProgramClass const
+	* Finds the program class with the given identifier without creating any objects.
+	* @param InProgramIdentifier [const FName&] Identifier to look for.
+	* @return [TSubclassOf<class UYetiOS_BaseProgram>] Program class or nullptr if not found.
+	**/
+	TSubclassOf<class UYetiOS_BaseProgram> FindProgramClass(const FName& InProgramIdentifier) const;
+
+	/**
+	* public UYetiOS_ProgramsRepository::IsInstalledWithOS const
+	* Checks if the given program class should be installed with the Operating System.
+	* @param InProgramToCheck [TSubclassOf<class UYetiOS_BaseProgram>] Program class to check.
+	* @return [bool] True if program is installed with the Operating System.
+	**/
+	bool IsInstalledWithOS(TSubclassOf<class UYetiOS_BaseProgram> InProgramToCheck) const;
+
+	/**
+	* public UYetiOS_ProgramsRepository::GetProgramClasses const
+	* Returns all valid program classes in this repository.
+	* @return [const TArray<TSubclassOf<class UYetiOS_BaseProgram>>&] Program classes.
+	**/
+	const TArray<TSubclassOf<class UYetiOS_BaseProgram>>& GetProgramClasses() const;
+
+	/**
+	* public UYetiOS_ProgramsRepository::GetStartupProgramClasses const
+	* Returns all valid program classes that should be installed with the Operating System.
+	* @return [const TArray<TSubclassOf<class UYetiOS_BaseProgram>>&] Program classes.
+	**/
+	const TArray<TSubclassOf<class UYetiOS_BaseProgram>>& GetStartupProgramClasses() const;
+
+private:
+
+	/**
+	* private UYetiOS_ProgramsRepository::Internal_BuildIndex const
+	* Builds the identifier lookup from class default objects if it is out of date.
+	**/
+	void Internal_BuildIndex() const;
+
+	/**
+	* private UYetiOS_ProgramsRepository::Internal_InvalidateIndex
+	* Marks the lookup index as out of date so it is rebuilt on next use.
+	**/
+	void Internal_InvalidateIndex();
+
 public:
 	
-	FORCEINLINE TSet<FYetiOS_RepoProgram> GetProgramsFromRepository() const { return Programs; }
+	FORCEINLINE const TSet<FYetiOS_RepoProgram>& GetProgramsFromRepository() const { return Programs; }
+	FORCEINLINE const bool HasPrograms() const { return Programs.Num() > 0; }
 	FORCEINLINE TArray<TSubclassOf<class UYetiOS_AppInstaller>> GetStoreInstallers() const { return StoreInstallers.Array(); }
-	FORCEINLINE bool IsInstalledWithOS(TSubclassOf<class UYetiOS_BaseProgram> InProgramToCheck) const
-	{
-		for (const auto& It : Programs)
-		{
-			if (It.ProgramClass == InProgramToCheck)
-			{
-				return It.bInstallWithOS;
-			}
-		}
-
-		return false;
-	}
 
 	FORCEINLINE TArray<UYetiOS_BaseProgram*> GetDefaultProgramObjects(const bool bIgnoreInstalledWithOS) const
 	{
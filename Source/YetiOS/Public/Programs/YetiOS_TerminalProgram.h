@@ -229,6 +229,8 @@ private:
 
 protected:
 
+	virtual void ResetForReuse() override;
+
 	/**
 	* protected UYetiOS_TerminalProgram::GetCurrentDirectory const
 	* Gets the current directory this terminal is operating on.
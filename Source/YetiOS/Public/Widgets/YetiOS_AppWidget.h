@@ -47,6 +47,13 @@ private:
 	**/
 	void Internal_OnChangeVisibilityState(EYetiOsProgramVisibilityState InNewState);
 
+	/**
+	* private UYetiOS_AppWidget::Internal_ReuseAppWidget
+	* Assigns a pooled application widget to the given program. @See DestroyProgramWidget
+	* @param InParentProgram [class UYetiOS_BaseProgram*] Program that now owns this widget.
+	**/
+	void Internal_ReuseAppWidget(class UYetiOS_BaseProgram* InParentProgram);
+
 public:
 		
 	/**
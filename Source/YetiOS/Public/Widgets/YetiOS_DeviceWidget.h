@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "YetiOS_Types.h"
 #include "YetiOS_DeviceWidget.generated.h"
 
 /*************************************************************************
@@ -33,5 +34,16 @@ private:
 	* @return [UYetiOS_DeviceWidget*] Newly created device widget.
 	**/
 	static UYetiOS_DeviceWidget* Internal_CreateDeviceWidget(UYetiOS_BaseDevice* InDevice);
+
+protected:
+
+	/**
+	* protected UYetiOS_DeviceWidget::K2_OnBootProgress
+	* Event called every frame while the device boots with StartDeviceAsync. Use this to drive a boot screen.
+	* @param Stage [EYetiOsDeviceBootStage] Current boot stage.
+	* @param Progress [float] Overall boot progress between 0 and 1.
+	**/
+	UFUNCTION(BlueprintImplementableEvent, Category = "Yeti OS Device Widget", DisplayName = "On Boot Progress")
+	void K2_OnBootProgress(EYetiOsDeviceBootStage Stage, float Progress);
 	
 };
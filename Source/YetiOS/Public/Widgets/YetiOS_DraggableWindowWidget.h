@@ -18,6 +18,8 @@ class YETIOS_API UYetiOS_DraggableWindowWidget : public UUserWidget
 {
 	GENERATED_BODY()
 
+	friend class UYetiOS_BaseProgram;
+
 	FDelegateHandle OnThemeChangedDelegateHandle;
 	FDelegateHandle OnShowProgramIconDelegateHandle;
 	FDelegateHandle OnPeekPreviewDelegateHandle;
@@ -82,6 +84,9 @@ private:
 	FVector2D PreResizeOffset;
 	FVector2D PreDragSize;
 
+	/** Visibility this window had before it was parked in program pool. */
+	ESlateVisibility PreParkVisibility;
+
 public:
 
 	UYetiOS_DraggableWindowWidget(const FObjectInitializer& ObjectInitializer);
@@ -111,6 +116,27 @@ private:
 	**/
 	const FVector2D Internal_DetermineNewSize(const FVector2D& InDelta) const;
 
+	/**
+	* private UYetiOS_DraggableWindowWidget::Internal_UnbindWindowEvents
+	* Unbinds Operating System events and removes this window from taskbar.
+	**/
+	void Internal_UnbindWindowEvents();
+
+	/**
+	* private UYetiOS_DraggableWindowWidget::Internal_ParkWindow
+	* Closes this window without removing it from parent. Window is collapsed so it can be reused by the program pool.
+	**/
+	void Internal_ParkWindow();
+
+	/**
+	* private UYetiOS_DraggableWindowWidget::Internal_RestoreWindow
+	* Reuses a parked window for the given program.
+	* @param InProgram [class UYetiOS_BaseProgram*] Program that now owns this window.
+	* @param InWidget [class UYetiOS_UserWidget*] Widget to add to this window.
+	* @param InOverrideSize [const FVector2D&] If not zero, window is resized to this.
+	**/
+	void Internal_RestoreWindow(class UYetiOS_BaseProgram* InProgram, class UYetiOS_UserWidget* InWidget, const FVector2D& InOverrideSize);
+
 protected:
 
 	/** Event called when mouse button up is detected on WindowTitleBorder */
@@ -52,6 +52,18 @@ private:
 	**/
 	static UYetiOS_OsWidget* Internal_CreateOsWidget(const UYetiOS_Core* OsCore);
 
+	/**
+	* private UYetiOS_OsWidget::Internal_BindThemeChanged
+	* Applies the current theme and listens for theme changes of the owning OS.
+	**/
+	void Internal_BindThemeChanged();
+
+	/**
+	* private UYetiOS_OsWidget::Internal_UnbindThemeChanged
+	* Stops listening for theme changes of the owning OS.
+	**/
+	void Internal_UnbindThemeChanged();
+
 public:
 
 	/**
@@ -73,6 +85,13 @@ public:
 	**/
 	void BeginLoadOS();
 
+	/**
+	* public UYetiOS_OsWidget::ResumeOS
+	* Shows an Operating System that was already running, after its device was moved to a new level.
+	* @See UYetiOS_DevicePersistenceSubsystem
+	**/
+	void ResumeOS();
+
 	/**
 	* public UYetiOS_OsWidget::BeginShutdownOS
 	* Begin simulating shutting down of Operating System.
@@ -120,6 +139,13 @@ public:
 	**/
 	void ReceiveNotification(const FYetiOsNotification InNotification);
 
+	/**
+	* public UYetiOS_OsWidget::ReceiveNotifications
+	* Receive all notifications the Operating System collected during the last frame.
+	* @param InNotifications [const TArray<FYetiOsNotification>&] Notifications that were received, oldest first.
+	**/
+	void ReceiveNotifications(const TArray<FYetiOsNotification>& InNotifications);
+
 	/**
 	* public UYetiOS_OsWidget::CreateNewWindow
 	* Create a new draggable window for this widget.
@@ -190,6 +216,14 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCosmetic, Category = "Yeti OS Widget", DisplayName = "OnBeginLoadingOS")	
 	void K2_OnBeginLoadingOS();	
 
+	/**
+	* protected UYetiOS_OsWidget::K2_OnResumeOS
+	* Event called instead of OnBeginLoadingOS when a running OS was moved to a new level. Programs that were running are started again after this.
+	* Native implementation calls OnBeginLoadingOS. Override to go straight to the desktop of the current user.
+	**/
+	UFUNCTION(BlueprintNativeEvent, BlueprintCosmetic, Category = "Yeti OS Widget", DisplayName = "OnResumeOS")
+	void K2_OnResumeOS();
+
 	/**
 	* protected UYetiOS_OsWidget::K2_OnAddDesktopShortcut
 	* Event called when app icon widget is added to desktop.
@@ -228,6 +262,15 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCosmetic, Category = "Yeti OS Widget", DisplayName = "OnReceivedNotification")	
 	void K2_OnReceivedNotification(const FYetiOsNotification NewNotification);
 
+	/**
+	* protected UYetiOS_OsWidget::K2_OnReceivedNotifications
+	* Event called once per frame with all notifications received in that frame. Duplicates are already merged (@See FYetiOsNotification::RepeatCount).
+	* Native implementation calls OnReceivedNotification for each notification. Override to update the widget once for the whole batch.
+	* @param NewNotifications [const TArray<FYetiOsNotification>&] Notifications received, oldest first.
+	**/
+	UFUNCTION(BlueprintNativeEvent, BlueprintCosmetic, Category = "Yeti OS Widget", DisplayName = "OnReceivedNotifications")
+	void K2_OnReceivedNotifications(const TArray<FYetiOsNotification>& NewNotifications);
+
 	/**
 	* protected UYetiOS_OsWidget::K2_OnBatteryLevelChanged
 	* Event called when battery level changed.
@@ -54,6 +54,14 @@ enum class EYetiOsNotificationCategory : uint8
 	CATEGORY_App						UMETA(DisplayName = "App")
 };
 
+UENUM(BlueprintType)
+enum class EYetiOsProgramUpdatePriority : uint8
+{
+	PRIORITY_Low						UMETA(DisplayName = "Low"),
+	PRIORITY_Normal						UMETA(DisplayName = "Normal"),
+	PRIORITY_High						UMETA(DisplayName = "High")
+};
+
 UENUM(BlueprintType)
 enum class EYetiOsTerminalMessageLevel : uint8
 {
@@ -143,6 +151,26 @@ enum class EYetiOsDeviceStartResult : uint8
 	DEVICESTART_Success					UMETA(DisplayName = "Success")
 };
 
+/** @See: UYetiOS_BaseDevice::StartDeviceAsync */
+UENUM(BlueprintType)
+enum class EYetiOsDeviceBootStage : uint8
+{
+	/** Device is not booting. */
+	BOOT_None							UMETA(DisplayName = "None"),
+
+	/** Creating motherboard and hardware. */
+	BOOT_Hardware						UMETA(DisplayName = "Hardware"),
+
+	/** Reading save game from disk on a worker thread. */
+	BOOT_LoadSaveGame					UMETA(DisplayName = "Loading Save Game"),
+
+	/** Creating operating system, directories, files and programs over several frames. */
+	BOOT_OperatingSystem				UMETA(DisplayName = "Operating System"),
+
+	/** Creating physical save directories. */
+	BOOT_Finishing						UMETA(DisplayName = "Finishing")
+};
+
 UENUM(BlueprintType)
 enum class EYetiOsHardwareInstallResult : uint8
 {
@@ -900,6 +928,10 @@ struct FYetiOsNotification
 	UPROPERTY(BlueprintReadWrite, Category = "Yeti OS Notification")
 	float Duration;
 
+	/** Number of identical notifications (same Category, Level, Code, Title and Description) coalesced into this one. */
+	UPROPERTY(BlueprintReadOnly, Category = "Yeti OS Notification")
+	int32 RepeatCount;
+
 public:
 
 	FYetiOsNotification()
@@ -911,6 +943,7 @@ public:
 		Level = EYetiOsNotificationType::TYPE_Info;
 		Category = EYetiOsNotificationCategory::CATEGORY_OS;
 		Duration = DEFAULT_DURATION;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -925,6 +958,7 @@ public:
 		Level = EYetiOsNotificationType::TYPE_Info;
 		Category = EYetiOsNotificationCategory::CATEGORY_OS;
 		Duration = DEFAULT_DURATION;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -939,6 +973,7 @@ public:
 		Level = EYetiOsNotificationType::TYPE_Info;
 		Category = EYetiOsNotificationCategory::CATEGORY_OS;
 		Duration = DEFAULT_DURATION;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -953,6 +988,7 @@ public:
 		Level = EYetiOsNotificationType::TYPE_Info;
 		Category = EYetiOsNotificationCategory::CATEGORY_OS;
 		Duration = DEFAULT_DURATION;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -967,6 +1003,7 @@ public:
 		Level = EYetiOsNotificationType::TYPE_Info;
 		Category = InCategory;
 		Duration = DEFAULT_DURATION;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -981,6 +1018,7 @@ public:
 		Level = EYetiOsNotificationType::TYPE_Info;
 		Category = InCategory;
 		Duration = DEFAULT_DURATION;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -995,6 +1033,7 @@ public:
 		Level = EYetiOsNotificationType::TYPE_Info;
 		Category = InCategory;
 		Duration = DEFAULT_DURATION;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -1009,6 +1048,7 @@ public:
 		Level = EYetiOsNotificationType::TYPE_Info;
 		Category = InCategory;
 		Duration = InDuration;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -1023,6 +1063,7 @@ public:
 		Level = EYetiOsNotificationType::TYPE_Info;
 		Category = InCategory;
 		Duration = DEFAULT_DURATION;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -1037,6 +1078,7 @@ public:
 		Level = InLevel;
 		Category = InCategory;
 		Duration = DEFAULT_DURATION;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -1051,6 +1093,7 @@ public:
 		Level = InLevel;
 		Category = InCategory;
 		Duration = DEFAULT_DURATION;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -1065,6 +1108,7 @@ public:
 		Level = InLevel;
 		Category = InCategory;
 		Duration = DEFAULT_DURATION;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -1079,6 +1123,7 @@ public:
 		Level = InLevel;
 		Category = InCategory;
 		Duration = InDuration;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
@@ -1093,12 +1138,85 @@ public:
 		Level = InLevel;
 		Category = InCategory;
 		Duration = InDuration;
+		RepeatCount = 1;
 
 		FDateTime Now = FDateTime::Now();
 		TimeStamp = FText::AsCultureInvariant(Now.ToString());
 	}
 };
 
+/** Save slot of one device. @See UYetiOS_SaveManifest */
+USTRUCT(BlueprintType)
+struct FYetiOsSaveShard
+{
+	GENERATED_USTRUCT_BODY();
+
+	/** Stable ID of the device manager that owns the device. @See AYetiOS_DeviceManagerActor::GetDeviceSaveID */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Save Shard")
+	FString DeviceSaveID;
+
+	/** Slot the device is saved in. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Save Shard")
+	FString SlotName;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Save Shard")
+	FText DeviceName;
+
+	/** Path of the device class. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Save Shard")
+	FString DeviceClassPath;
+
+	FORCEINLINE bool operator==(const FYetiOsSaveShard& Other) const
+	{
+		return DeviceSaveID == Other.DeviceSaveID && SlotName == Other.SlotName && DeviceName.EqualTo(Other.DeviceName) && DeviceClassPath == Other.DeviceClassPath;
+	}
+};
+
+/** Counts across every device of a world. @See UYetiOS_DeviceRegistrySubsystem::GetDeviceStats */
+USTRUCT(BlueprintType)
+struct FYetiOsDeviceRegistryStats
+{
+	GENERATED_USTRUCT_BODY();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Device Registry Stats")
+	int32 NumDeviceManagers;
+
+	/** Device managers that currently have a device. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Device Registry Stats")
+	int32 NumDevices;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Device Registry Stats")
+	int32 NumRunningDevices;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Device Registry Stats")
+	int32 NumBootingDevices;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Device Registry Stats")
+	int32 NumSavingDevices;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Device Registry Stats")
+	int32 NumDevicesInBsod;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Device Registry Stats")
+	int32 NumPortableDevices;
+
+	/** Programs running on all devices together. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Yeti OS Device Registry Stats")
+	int32 NumRunningPrograms;
+
+	FYetiOsDeviceRegistryStats()
+	{
+		NumDeviceManagers = 0;
+		NumDevices = 0;
+		NumRunningDevices = 0;
+		NumBootingDevices = 0;
+		NumSavingDevices = 0;
+		NumDevicesInBsod = 0;
+		NumPortableDevices = 0;
+		NumRunningPrograms = 0;
+	}
+};
+
 USTRUCT()
 struct FYetiOsDeviceSaveLoad
 {
@@ -1181,6 +1299,21 @@ struct FYetiOsProgramSaveLoad
 	bool bSaveLoad_SingleInstanceOnly;
 };
 
+USTRUCT()
+struct FYetiOsFileIndexSaveLoad
+{
+	GENERATED_USTRUCT_BODY();
+
+	UPROPERTY()
+	FString SaveLoad_FilePath;
+
+	UPROPERTY()
+	TArray<FString> SaveLoad_NameWords;
+
+	UPROPERTY()
+	TArray<FString> SaveLoad_ContentWords;
+};
+
 USTRUCT()
 struct FYetiOS_DeviceCPU
 {
@@ -1282,7 +1415,7 @@ public:
 
 	friend uint32 GetTypeHash(const FYetiOS_RepoProgram& Other)
 	{
-		return GetTypeHash(Other.bInstallWithOS);
+		return HashCombine(GetTypeHash(Other.ProgramClass.Get()), GetTypeHash(static_cast<uint8>(Other.bInstallWithOS)));
 	}
 	
 	FYetiOS_RepoProgram()